@@ -1291,6 +1291,7 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
+        QueuedBatchedConnection,
         UniqueConnection =  0x80
     };
 
@@ -106,12 +106,12 @@ extern "C" NSString *NSTemporaryDirectory();
 #    undef SYS_statx
 #    undef STATX_BASIC_STATS
 #  else
-#    if !QT_CONFIG(renameat2) && defined(SYS_renameat2)
+#    if !QT_CONFIG(renameat2) && defined(SYS_renameat2) && !defined(RENAME_NOREPLACE) // LOCALBUILDFIX
 static int renameat2(int oldfd, const char *oldpath, int newfd, const char *newpath, unsigned flags)
 { return syscall(SYS_renameat2, oldfd, oldpath, newfd, newpath, flags); }
 #    endif
 
-#    if !QT_CONFIG(statx) && defined(SYS_statx)
+#    if !QT_CONFIG(statx) && defined(SYS_statx) && !defined(STATX_BASIC_STATS) // LOCALBUILDFIX
 static int statx(int dirfd, const char *pathname, int flag, unsigned mask, struct statx *statxbuf)
 { return syscall(SYS_statx, dirfd, pathname, flag, mask, statxbuf); }
 #    elif !QT_CONFIG(statx) && !defined(SYS_statx)
@@ -372,6 +372,8 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
+    QMutexLocker locker(&currentThreadData->postEventList.mutex);
+    currentThreadData->drainPostEventInbox();
     return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
 }
 
@@ -520,6 +522,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         QMutexLocker locker(&threadData->postEventList.mutex);
+        threadData->drainPostEventInbox();
         for (int i = 0; i < threadData->postEventList.size(); ++i) {
             const QPostEvent &pe = threadData->postEventList.at(i);
             if (pe.event) {
@@ -1455,6 +1458,41 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    if (event->type() == QEvent::MetaCall) {
+        // Queued slot invocations are never compressed, so there is no need
+        // to look at the list: push the event onto the lock-free inbox and
+        // let the receiving thread move it into the list in order. The
+        // reference keeps data alive if the object is moved to another
+        // thread and its old thread exits while we are posting.
+        data->ref();
+        if (Q_LIKELY(data == *pdata)) {
+            QScopedPointer<QEvent> eventDeleter(event);
+            QPostEventInbox::Node *node = new QPostEventInbox::Node(QPostEvent(receiver, event, priority));
+            eventDeleter.take();
+            event->posted = true;
+            data->postEventList.inbox.push(node);
+
+            if (Q_UNLIKELY(data != *pdata)) {
+                // the object was moved to another thread while we were posting,
+                // possibly after moveToThread() forwarded the inbox: do it again
+                QMutexLocker locker(&data->postEventList.mutex);
+                data->drainPostEventInbox();
+            } else if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire()) {
+                dispatcher->wakeUp();
+            }
+            data->deref();
+            return;
+        }
+        data->deref();
+
+        // the object is being moved to another thread, follow it below
+        data = *pdata;
+        if (!data) {
+            delete event;
+            return;
+        }
+    }
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1474,6 +1512,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QMutexUnlocker locker(&data->postEventList.mutex);
 
+    // keep the order with the events posted without locking
+    data->drainPostEventInbox();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1616,6 +1657,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->drainPostEventInbox();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1670,6 +1712,11 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     CleanUp cleanup(receiver, event_type, data);
 
     while (i < data->postEventList.size()) {
+        // queue the events posted without locking since the last iteration
+        // like the others posted during this pass
+        if (!data->postEventList.inbox.isEmpty())
+            data->drainPostEventInbox();
+
         // avoid live-lock
         if (i >= data->postEventList.insertionOffset)
             break;
@@ -1776,6 +1823,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     QMutexLocker locker(&data->postEventList.mutex);
+    data->drainPostEventInbox();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1841,6 +1889,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->drainPostEventInbox();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -55,6 +55,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <limits>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
@@ -223,17 +225,199 @@ int QThreadPipe::check(const pollfd &pfd)
 }
 
 QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
+#if QT_CONFIG(epoll)
+    : epollFd(-1)
+#endif
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Can not continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    // falls back to poll(2) if the epoll instance cannot be set up
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd != -1)
+        qt_safe_close(epollFd);
+#endif
+}
+
+#if QT_CONFIG(epoll)
+static inline quint32 pollToEpollEvents(short events)
+{
+    quint32 result = 0;
+
+    if (events & POLLIN)
+        result |= EPOLLIN;
+
+    if (events & POLLOUT)
+        result |= EPOLLOUT;
+
+    if (events & POLLPRI)
+        result |= EPOLLPRI;
+
+    return result;
+}
+
+static inline short epollToPollEvents(quint32 events)
+{
+    short result = 0;
+
+    if (events & EPOLLIN)
+        result |= POLLIN;
+
+    if (events & EPOLLOUT)
+        result |= POLLOUT;
+
+    if (events & EPOLLPRI)
+        result |= POLLPRI;
+
+    if (events & EPOLLHUP)
+        result |= POLLHUP;
+
+    if (events & EPOLLERR)
+        result |= POLLERR;
+
+    return result;
+}
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+        return false;
+    }
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = 0;
+    ev.data.fd = threadPipe.fds[0];
+
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        perror("QEventDispatcherUNIXPrivate: Unable to watch the thread pipe with epoll");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
 }
 
+/*
+    Keeps the kernel-side interest set in sync with socketNotifiers, so that
+    processEvents() does not have to resubmit every descriptor on each
+    iteration as the poll(2) backend does.
+*/
+void QEventDispatcherUNIXPrivate::updateEpollRegistration(int fd, short oldEvents, short newEvents)
+{
+    if (epollFd == -1 || oldEvents == newEvents)
+        return;
+
+    if (alwaysReadyFds.contains(fd)) {
+        if (!newEvents)
+            alwaysReadyFds.removeOne(fd);
+        return;
+    }
+
+    epoll_event ev;
+    ev.events = pollToEpollEvents(newEvents);
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
+
+    const int op = !newEvents ? EPOLL_CTL_DEL
+                              : (!oldEvents ? EPOLL_CTL_ADD : EPOLL_CTL_MOD);
+    int ret = epoll_ctl(epollFd, op, fd, &ev);
+
+    // closing a descriptor silently drops it from the interest set, and its
+    // number may have been reused since; repair the registration
+    if (ret == -1 && op == EPOLL_CTL_MOD && errno == ENOENT)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    else if (ret == -1 && op == EPOLL_CTL_ADD && errno == EEXIST)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+
+    if (ret == -1 && op != EPOLL_CTL_DEL) {
+        if (errno == EPERM)
+            alwaysReadyFds.append(fd);
+        else if (errno == EBADF && !invalidFds.contains(fd))
+            invalidFds.append(fd);
+        else if (errno != EBADF)
+            qErrnoWarning("QEventDispatcherUNIX: Unable to update epoll registration for socket %d", fd);
+    }
+}
+
+/*
+    Waits for events on the epoll instance and fills pollfds with the ready
+    socket notifier descriptors. Returns the number of thread pipe wakeups
+    that were consumed, or -1 on error.
+*/
+int QEventDispatcherUNIXPrivate::epollWait(const timespec *tm)
+{
+    int timeout = -1;
+    if (!alwaysReadyFds.isEmpty() || !invalidFds.isEmpty()) {
+        timeout = 0;
+    } else if (tm) {
+        // round up, so that we do not wake up before the next timer is due
+        const qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+        timeout = int(qMin<qint64>(msecs, std::numeric_limits<int>::max()));
+    }
+
+    const int maxEvents = socketNotifiers.size() + 1;
+    if (epollEvents.size() < maxEvents)
+        epollEvents.resize(maxEvents);
+
+    int ready = epoll_wait(epollFd, epollEvents.data(), maxEvents, timeout);
+    if (ready == -1) {
+        // treat a signal as a spurious wakeup, the caller recalculates the timeout
+        return errno == EINTR ? 0 : -1;
+    }
+
+    pollfds.clear();
+    int nevents = 0;
+
+    for (int i = 0; i < ready; ++i) {
+        const epoll_event &ev = epollEvents.at(i);
+        if (ev.data.fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = epollToPollEvents(ev.events);
+            nevents += threadPipe.check(pfd);
+        } else if (socketNotifiers.contains(ev.data.fd)) {
+            pollfd pfd = qt_make_pollfd(ev.data.fd, 0);
+            pfd.revents = epollToPollEvents(ev.events);
+            // the descriptor may have been closed while another one still
+            // refers to the same file, which keeps it in the interest set
+            if ((ev.events & (EPOLLERR | EPOLLHUP)) && ::fcntl(ev.data.fd, F_GETFD) == -1
+                    && errno == EBADF) {
+                pfd.revents = POLLNVAL;
+            }
+            pollfds.append(pfd);
+        }
+    }
+
+    for (int fd : qAsConst(invalidFds)) {
+        if (!socketNotifiers.contains(fd))
+            continue;
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = POLLNVAL;
+        pollfds.append(pfd);
+    }
+    invalidFds.clear();
+
+    for (int fd : qAsConst(alwaysReadyFds)) {
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = socketNotifiers.value(fd).events() & (POLLIN | POLLOUT);
+        pollfds.append(pfd);
+    }
+
+    return nevents;
+}
+#endif // QT_CONFIG(epoll)
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -406,12 +590,19 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
 
     Q_D(QEventDispatcherUNIX);
     QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
 
     if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    d->updateEpollRegistration(sockfd, oldEvents, sn_set.events());
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -450,8 +641,16 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    d->updateEpollRegistration(sockfd, oldEvents, sn_set.events());
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -485,29 +684,44 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
-    d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
-
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
-
-    // This must be last, as it's popped off the end below
-    d->pollfds.append(d->threadPipe.prepare());
-
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
-    case -1:
-        perror("qt_safe_poll");
-        break;
-    case 0:
-        break;
-    default:
-        nevents += d->threadPipe.check(d->pollfds.takeLast());
-        if (include_notifiers)
+#if QT_CONFIG(epoll)
+    // when socket notifiers are excluded, only the thread pipe is of
+    // interest and the poll(2) path below handles that just as well
+    if (d->epollFd != -1 && include_notifiers) {
+        const int wakeUps = d->epollWait(tm);
+        if (wakeUps == -1) {
+            perror("epoll_wait");
+        } else {
+            nevents += wakeUps;
             nevents += d->activateSocketNotifiers();
-        break;
+        }
+    } else
+#endif
+    {
+        d->pollfds.clear();
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+
+        // This must be last, as it's popped off the end below
+        d->pollfds.append(d->threadPipe.prepare());
+
+        switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(d->pollfds.takeLast());
+            if (include_notifiers)
+                nevents += d->activateSocketNotifiers();
+            break;
+        }
     }
 
     if (include_timers)
@@ -58,6 +58,10 @@
 #include "QtCore/qvarlengtharray.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -140,6 +144,20 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollRegistration(int fd, short oldEvents, short newEvents);
+    int epollWait(const timespec *tm);
+
+    // -1 unless QT_EVENT_DISPATCHER_EPOLL selected the epoll backend
+    int epollFd;
+    QVector<epoll_event> epollEvents;
+    // descriptors epoll refuses (e.g. regular files); poll(2) reports them always ready
+    QVector<int> alwaysReadyFds;
+    // closed descriptors, reported as POLLNVAL by the next epollWait() like poll(2) does
+    QVector<int> invalidFds;
+#endif
+
     QThreadPipe threadPipe;
     QVector<pollfd> pollfds;
 
@@ -1504,6 +1504,8 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
     QThread *objectThread = object->thread();
     if (type == Qt::AutoConnection)
         type = (currentThread == objectThread) ? Qt::DirectConnection : Qt::QueuedConnection;
+    else if (type == Qt::QueuedBatchedConnection) // a single call has nothing to batch with
+        type = Qt::QueuedConnection;
 
     void *argv[] = { ret };
 
@@ -2255,6 +2257,9 @@ bool QMetaMethod::invoke(QObject *object,
         connectionType = currentThread == objectThread
                          ? Qt::DirectConnection
                          : Qt::QueuedConnection;
+    } else if (connectionType == Qt::QueuedBatchedConnection) {
+        // a single call has nothing to batch with
+        connectionType = Qt::QueuedConnection;
     }
 
 #ifdef QT_NO_THREAD
@@ -61,6 +61,8 @@
 #include <qset.h>
 #include <qsemaphore.h>
 #include <qsharedpointer.h>
+#include <qpointer.h>
+#include <qmath.h>
 
 #include <private/qorderedmutexlocker_p.h>
 #include <private/qhooks_p.h>
@@ -251,7 +253,8 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    // events in the inbox are only counted once they are moved to the list
+    if (postedEvents || !threadData->postEventList.inbox.isEmpty())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     threadData->deref();
@@ -499,16 +502,240 @@ QMetaCallEvent::~QMetaCallEvent()
     \internal
  */
 void QMetaCallEvent::placeMetaCall(QObject *object)
+{
+    invokeSlot(object, args_);
+}
+
+/*!
+    \internal
+    Calls the slot on \a object with the arguments \a args.
+ */
+void QMetaCallEvent::invokeSlot(QObject *object, void **args)
 {
     if (slotObj_) {
-        slotObj_->call(object, args_);
+        slotObj_->call(object, args);
     } else if (callFunction_ && method_offset_ <= object->metaObject()->methodOffset()) {
-        callFunction_(object, QMetaObject::InvokeMetaMethod, method_relative_, args_);
+        callFunction_(object, QMetaObject::InvokeMetaMethod, method_relative_, args);
+    } else {
+        QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod, method_offset_ + method_relative_, args);
+    }
+}
+
+/*
+    QMetaCallBatch holds the arguments of the emissions through a
+    Qt::QueuedBatchedConnection that have not been delivered yet. It is shared
+    by the connection and the QBatchedMetaCallEvent posted to the receiver:
+    only one such event is pending at a time, and the emissions made until the
+    receiver's thread delivers it are appended to the batch.
+
+    The arguments of each emission are copy-constructed in place into a flat
+    buffer. The receiving thread swaps the buffer for a spare one, and hands it
+    back once it has delivered the emissions, so there are no allocations per
+    emission once the buffers have grown to the size of a burst.
+*/
+class QMetaCallBatch
+{
+public:
+    struct Buffer
+    {
+        char *data;
+        int count;      // emissions
+        int capacity;   // emissions
+    };
+
+    explicit QMetaCallBatch(const int *argumentTypes);
+    ~QMetaCallBatch();
+
+    void ref() { ref_.ref(); }
+    void deref()
+    {
+        if (!ref_.deref())
+            delete this;
+    }
+
+    bool append(void **argv);
+    Buffer take();
+    void recycle(Buffer buffer);
+
+    int argumentCount() const { return types.size(); }
+    void *argument(const Buffer &buffer, int emission, int n) const
+    { return buffer.data + emission * stride + offsets.at(n); }
+
+private:
+    Q_DISABLE_COPY(QMetaCallBatch)
+    void grow();
+    void destroyArguments(const Buffer &buffer);
+
+    QAtomicInt ref_;
+    QMutex mutex;
+    QVarLengthArray<int, 4> types;
+    QVarLengthArray<int, 4> offsets;
+    int stride;
+    bool relocatable;
+    bool eventPosted;
+    Buffer pending;
+    Buffer spare;
+};
+
+QMetaCallBatch::QMetaCallBatch(const int *argumentTypes)
+    : ref_(1), stride(0), relocatable(true), eventPosted(false),
+      pending{nullptr, 0, 0}, spare{nullptr, 0, 0}
+{
+    union MaxAlign { long double ld; qint64 i; void *p; };
+    const int maxAlignment = int(Q_ALIGNOF(MaxAlign));
+
+    // align each argument to its size rounded up to a power of two, which
+    // is a multiple of its real alignment
+    int alignment = 1;
+    for (const int *type = argumentTypes; *type; ++type) {
+        const int size = qMax(QMetaType::sizeOf(*type), 1);
+        const int align = qMin(int(qNextPowerOfTwo(quint32(size - 1))), maxAlignment);
+        stride = (stride + align - 1) & ~(align - 1);
+        types.append(*type);
+        offsets.append(stride);
+        stride += size;
+        alignment = qMax(alignment, align);
+        if (!(QMetaType::typeFlags(*type) & QMetaType::MovableType))
+            relocatable = false;
+    }
+    stride = (stride + alignment - 1) & ~(alignment - 1);
+}
+
+QMetaCallBatch::~QMetaCallBatch()
+{
+    destroyArguments(pending);
+    free(pending.data);
+    free(spare.data);
+}
+
+void QMetaCallBatch::destroyArguments(const Buffer &buffer)
+{
+    for (int i = 0; i < buffer.count; ++i) {
+        for (int n = 0; n < types.size(); ++n)
+            QMetaType::destruct(types.at(n), argument(buffer, i, n));
+    }
+}
+
+void QMetaCallBatch::grow()
+{
+    const int capacity = qMax(8, pending.capacity * 2);
+    if (!stride) {
+        pending.capacity = capacity;
+        return;
+    }
+
+    char *data;
+    if (relocatable) {
+        data = static_cast<char *>(realloc(pending.data, size_t(capacity) * stride));
+        Q_CHECK_PTR(data);
     } else {
-        QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod, method_offset_ + method_relative_, args_);
+        data = static_cast<char *>(malloc(size_t(capacity) * stride));
+        Q_CHECK_PTR(data);
+        Buffer moved = { data, pending.count, capacity };
+        for (int i = 0; i < pending.count; ++i) {
+            for (int n = 0; n < types.size(); ++n)
+                QMetaType::construct(types.at(n), argument(moved, i, n), argument(pending, i, n));
+        }
+        destroyArguments(pending);
+        free(pending.data);
     }
+    pending.data = data;
+    pending.capacity = capacity;
+}
+
+/*
+    Appends the arguments \a argv of an emission (\c{argv[0]} being the return
+    value) and returns \c true if the caller needs to post the event that
+    delivers them.
+*/
+bool QMetaCallBatch::append(void **argv)
+{
+    QMutexLocker locker(&mutex);
+    if (pending.count == pending.capacity)
+        grow();
+    for (int n = 0; n < types.size(); ++n)
+        QMetaType::construct(types.at(n), argument(pending, pending.count, n), argv[n + 1]);
+    ++pending.count;
+
+    if (eventPosted)
+        return false;
+    eventPosted = true;
+    return true;
 }
 
+/*
+    Takes the pending emissions out of the batch; the next emission will post
+    a new event.
+*/
+QMetaCallBatch::Buffer QMetaCallBatch::take()
+{
+    QMutexLocker locker(&mutex);
+    Buffer buffer = pending;
+    pending = spare;
+    spare = Buffer{nullptr, 0, 0};
+    eventPosted = false;
+    return buffer;
+}
+
+/*
+    Destroys the arguments in \a buffer, and keeps its memory for reuse.
+*/
+void QMetaCallBatch::recycle(Buffer buffer)
+{
+    destroyArguments(buffer);
+    buffer.count = 0;
+
+    QMutexLocker locker(&mutex);
+    if (!spare.capacity)
+        qSwap(spare, buffer);
+    locker.unlock();
+    free(buffer.data);
+}
+
+class QBatchedMetaCallEvent : public QMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(ushort method_offset, ushort method_relative,
+                          QObjectPrivate::StaticMetaCallFunction callFunction,
+                          const QObject *sender, int signalId, QMetaCallBatch *batch)
+        : QMetaCallEvent(method_offset, method_relative, callFunction, sender, signalId),
+          batch(batch), delivered(false)
+    { batch->ref(); }
+    QBatchedMetaCallEvent(QtPrivate::QSlotObjectBase *slotObj, const QObject *sender,
+                          int signalId, QMetaCallBatch *batch)
+        : QMetaCallEvent(slotObj, sender, signalId), batch(batch), delivered(false)
+    { batch->ref(); }
+
+    ~QBatchedMetaCallEvent()
+    {
+        // drop the emissions if we were removed before being delivered
+        if (!delivered)
+            batch->recycle(batch->take());
+        batch->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        delivered = true;
+        QMetaCallBatch::Buffer buffer = batch->take();
+
+        QVarLengthArray<void *, 8> args(batch->argumentCount() + 1);
+        args[0] = nullptr;
+        QPointer<QObject> guard(object);
+        for (int i = 0; i < buffer.count && guard; ++i) {
+            for (int n = 0; n < batch->argumentCount(); ++n)
+                args[n + 1] = batch->argument(buffer, i, n);
+            invokeSlot(object, args.data());
+        }
+
+        batch->recycle(buffer);
+    }
+
+private:
+    QMetaCallBatch *batch;
+    bool delivered;
+};
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1043,6 +1270,8 @@ QObjectPrivate::Connection::~Connection()
     }
     if (isSlotObject)
         slotObj->destroyIfLastRef();
+    if (batch)
+        batch->deref();
 }
 
 
@@ -1506,6 +1735,10 @@ void QObject::moveToThread(QThread *targetThread)
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // forward the events that were posted without locking; postEvent() takes
+    // care of the ones pushed onto currentData's inbox after this point
+    currentData->drainPostEventInbox();
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2764,7 +2997,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::QueuedBatchedConnection)
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(0);
     }
@@ -2845,7 +3078,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || type == Qt::QueuedBatchedConnection)
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(0);
 
@@ -3570,8 +3803,11 @@ void QMetaObject::connectSlotsByName(QObject *o)
 
     \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
 */
-static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv,
-                            QMutexLocker &locker)
+/*
+    Returns the 0-terminated list of the argument types of the connection \a c,
+    or \nullptr if they cannot be queued.
+*/
+static const int *queuedArgumentTypes(QObject *sender, int signal, QObjectPrivate::Connection *c)
 {
     const int *argumentTypes = c->argumentTypes.load();
     if (!argumentTypes) {
@@ -3585,7 +3821,16 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             argumentTypes = c->argumentTypes.load();
         }
     }
-    if (argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
+    if (argumentTypes == &DIRECT_CONNECTION_ONLY)
+        return nullptr;
+    return argumentTypes;
+}
+
+static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv,
+                            QMutexLocker &locker)
+{
+    const int *argumentTypes = queuedArgumentTypes(sender, signal, c);
+    if (!argumentTypes) // cannot activate
         return;
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
@@ -3624,6 +3869,39 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     QCoreApplication::postEvent(c->receiver, ev);
 }
 
+static void queued_batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                                    void **argv, QMutexLocker &locker)
+{
+    const int *argumentTypes = queuedArgumentTypes(sender, signal, c);
+    if (!argumentTypes) // cannot activate
+        return;
+
+    if (!c->batch)
+        c->batch = new QMetaCallBatch(argumentTypes);
+    QMetaCallBatch *batch = c->batch;
+    batch->ref();
+
+    locker.unlock();
+    const bool needsEvent = batch->append(argv);
+    locker.relock();
+
+    if (needsEvent) {
+        if (c->receiver) {
+            QMetaCallEvent *ev = c->isSlotObject ?
+                new QBatchedMetaCallEvent(c->slotObj, sender, signal, batch) :
+                new QBatchedMetaCallEvent(c->method_offset, c->method_relative, c->callFunction, sender, signal, batch);
+            QCoreApplication::postEvent(c->receiver, ev);
+        } else {
+            // we have been disconnected while the mutex was unlocked
+            locker.unlock();
+            batch->recycle(batch->take());
+            locker.relock();
+        }
+    }
+
+    batch->deref();
+}
+
 /*!
     \internal
  */
@@ -3722,6 +4000,9 @@ void QMetaObject::activate(QObject *sender, int signalOffset, int local_signal_i
                 || (c->connectionType == Qt::QueuedConnection)) {
                 queued_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
                 continue;
+            } else if (c->connectionType == Qt::QueuedBatchedConnection) {
+                queued_batched_activate(sender, signal_index, c, argv ? argv : empty_argv, locker);
+                continue;
 #ifndef QT_NO_THREAD
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
                 if (receiverInSameThread) {
@@ -244,7 +244,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::QueuedBatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal),
@@ -284,7 +285,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::QueuedBatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, nullptr,
@@ -323,7 +325,8 @@ public:
                           "No Q_OBJECT in the class with the signal");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection
+                || type == Qt::QueuedBatchedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, nullptr,
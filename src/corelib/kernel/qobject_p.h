@@ -67,6 +67,7 @@ QT_BEGIN_NAMESPACE
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallBatch;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -138,14 +139,15 @@ public:
         Connection *next;
         Connection **prev;
         QAtomicPointer<const int> argumentTypes;
+        QMetaCallBatch *batch; // pending emissions of a Qt::QueuedBatchedConnection
         QAtomicInt ref_;
         ushort method_offset;
         ushort method_relative;
         uint signal_index : 27; // In signal range (see QObjectPrivate::signalIndex())
-        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
+        ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 3 == blocking, 4 == batched
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : nextConnectionList(nullptr), ref_(2), ownArgumentTypes(true) {
+        Connection() : nextConnectionList(nullptr), batch(nullptr), ref_(2), ownArgumentTypes(true) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -392,6 +394,9 @@ public:
 
     virtual void placeMetaCall(QObject *object);
 
+protected:
+    void invokeSlot(QObject *object, void **args);
+
 private:
     QtPrivate::QSlotObjectBase *slotObj_;
     const QObject *sender_;
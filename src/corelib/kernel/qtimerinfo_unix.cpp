@@ -53,6 +53,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -62,30 +64,6 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
  * timerBitVec array is used for keeping track of timer identifiers.
  */
 
-QTimerInfoList::QTimerInfoList()
-{
-#if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC) && !defined(Q_OS_NACL)
-    if (!QElapsedTimer::isMonotonic()) {
-        // not using monotonic timers, initialize the timeChanged() machinery
-        previousTime = qt_gettime();
-
-        tms unused;
-        previousTicks = times(&unused);
-
-        ticksPerSecond = sysconf(_SC_CLK_TCK);
-        msPerTick = 1000/ticksPerSecond;
-    } else {
-        // detected monotonic timers
-        previousTime.tv_sec = previousTime.tv_nsec = 0;
-        previousTicks = 0;
-        ticksPerSecond = 0;
-        msPerTick = 0;
-    }
-#endif
-
-    firstTimerInfo = 0;
-}
-
 timespec QTimerInfoList::updateCurrentTime()
 {
     return (currentTime = qt_gettime());
@@ -145,49 +123,8 @@ bool QTimerInfoList::timeChanged(timespec *delta)
     return elapsedTimeTicks < ((qAbsTimespec(*delta) - tickGranularity) * 10);
 }
 
-/*
-  repair broken timer
-*/
-void QTimerInfoList::timerRepair(const timespec &diff)
-{
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
-        t->timeout = t->timeout + diff;
-    }
-}
-
-void QTimerInfoList::repairTimersIfNeeded()
-{
-    if (QElapsedTimer::isMonotonic())
-        return;
-    timespec delta;
-    if (timeChanged(&delta))
-        timerRepair(delta);
-}
-
-#else // !(_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(QT_BOOTSTRAPPED)
-
-void QTimerInfoList::repairTimersIfNeeded()
-{
-}
-
 #endif
 
-/*
-  insert timer info into list
-*/
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
-{
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
-    }
-    insert(index+1, ti);
-}
-
 inline timespec &operator+=(timespec &t1, int ms)
 {
     t1.tv_sec += ms / 1000;
@@ -379,26 +316,401 @@ static void calculateNextTimeout(QTimerInfo *t, timespec currentTime)
 #endif
 }
 
+static void calculateFirstTimeout(QTimerInfo *t, timespec currentTime)
+{
+    const int interval = t->interval;
+    timespec expected = currentTime + interval;
+
+    switch (t->timerType) {
+    case Qt::PreciseTimer:
+        // high precision timer is based on millisecond precision
+        // so no adjustment is necessary
+        t->timeout = expected;
+        break;
+
+    case Qt::CoarseTimer:
+        // this timer has up to 5% coarseness
+        // so our boundaries are 20 ms and 20 s
+        // below 20 ms, 5% inaccuracy is below 1 ms, so we convert to high precision
+        // above 20 s, 5% inaccuracy is above 1 s, so we convert to VeryCoarseTimer
+        if (interval >= 20000) {
+            t->timerType = Qt::VeryCoarseTimer;
+        } else {
+            t->timeout = expected;
+            if (interval <= 20) {
+                t->timerType = Qt::PreciseTimer;
+                // no adjustment is necessary
+            } else if (interval <= 20000) {
+                calculateCoarseTimerTimeout(t, currentTime);
+            }
+            break;
+        }
+        Q_FALLTHROUGH();
+    case Qt::VeryCoarseTimer:
+        // the very coarse timer is based on full second precision,
+        // so we keep the interval in seconds (round to closest second)
+        t->interval /= 500;
+        t->interval += 1;
+        t->interval >>= 1;
+        t->timeout.tv_sec = currentTime.tv_sec + t->interval;
+        t->timeout.tv_nsec = 0;
+
+        // if we're past the half-second mark, increase the timeout again
+        if (currentTime.tv_nsec > 500*1000*1000)
+            ++t->timeout.tv_sec;
+    }
+}
+
 /*
-  Returns the time to wait for the next timer, or null if no timers
-  are waiting.
+    Timers are kept in a hierarchical timing wheel: the first level has one
+    slot per millisecond for the next 256 ms, every further level has 64 slots
+    that each cover a whole revolution of the level below. A timer is linked
+    into the slot for its timeout, which makes registering and unregistering
+    it constant time. Whenever the first level completes a revolution, the
+    next slot of the level above is cascaded, i.e. its timers are moved down
+    to the slots that now cover them.
+
+    Timers that have expired are moved from the wheel into the sorted list of
+    due timers, which activateTimers() processes in order.
 */
-bool QTimerInfoList::timerWait(timespec &tm)
+
+static inline qint64 toTick(const timespec &t)
 {
-    timespec currentTime = updateCurrentTime();
-    repairTimersIfNeeded();
+    return qint64(t.tv_sec) * 1000 + t.tv_nsec / (1000 * 1000);
+}
+
+static inline bool timerLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    return t1->sequence < t2->sequence;
+}
+
+QTimerInfoList::QTimerInfoList()
+{
+#if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC) && !defined(Q_OS_NACL)
+    if (!QElapsedTimer::isMonotonic()) {
+        // not using monotonic timers, initialize the timeChanged() machinery
+        previousTime = qt_gettime();
+
+        tms unused;
+        previousTicks = times(&unused);
+
+        ticksPerSecond = sysconf(_SC_CLK_TCK);
+        msPerTick = 1000/ticksPerSecond;
+    } else {
+        // detected monotonic timers
+        previousTime.tv_sec = previousTime.tv_nsec = 0;
+        previousTicks = 0;
+        ticksPerSecond = 0;
+        msPerTick = 0;
+    }
+#endif
+
+    firstTimerInfo = 0;
+    wheelTick = toTick(updateCurrentTime());
+    nextSequence = 0;
+    firstLinked = 0;
+    firstLinkedValid = true;
+    memset(buckets, 0, sizeof(buckets));
+    memset(occupied, 0, sizeof(occupied));
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
+}
 
-    // Find first waiting timer not already active
-    QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
+int QTimerInfoList::slotFor(qint64 tick) const
+{
+    if (tick < wheelTick)
+        tick = wheelTick;
+
+    const qint64 delta = tick - wheelTick;
+    if (delta < FirstLevelSize)
+        return int(tick & (FirstLevelSize - 1));
+
+    int level = 1;
+    for ( ; level < LevelCount - 1; ++level) {
+        if (delta < (qint64(1) << (levelShift(level) + LevelBits)))
             break;
+    }
+
+    // beyond the range of the wheel: park the timer in the farthest slot of
+    // the last level, it gets sorted in properly when that slot is cascaded
+    const qint64 range = qint64(1) << (levelShift(level) + LevelBits);
+    if (delta >= range)
+        tick = wheelTick + range - 1;
+
+    return levelBase(level) + int((tick >> levelShift(level)) & (LevelSize - 1));
+}
+
+/*
+    Returns the first occupied slot of \a level, searching from the slot
+    index \a start onwards and wrapping around, or -1 if the level is empty.
+*/
+int QTimerInfoList::nextOccupiedSlot(int level, int start) const
+{
+    const int base = levelBase(level);
+    const int size = levelSize(level);
+
+    for (int i = 0; i < size; ) {
+        const int slot = (start + i) & (size - 1);
+        const int bit = base + slot;
+        const int span = qMin(64 - bit % 64, size - slot);
+        quint64 word = occupied[bit / 64] >> (bit % 64);
+        if (span < 64)
+            word &= (Q_UINT64_C(1) << span) - 1;
+        if (word)
+            return slot + int(qCountTrailingZeroBits(word));
+        i += span;
+    }
+
+    return -1;
+}
+
+void QTimerInfoList::link(QTimerInfo *t)
+{
+    const int slot = slotFor(toTick(t->timeout));
+    t->slot = slot;
+    t->next = buckets[slot];
+    if (t->next)
+        t->next->pprev = &t->next;
+    t->pprev = &buckets[slot];
+    buckets[slot] = t;
+    occupied[slot / 64] |= Q_UINT64_C(1) << (slot % 64);
+
+    if (firstLinkedValid && (!firstLinked || timerLessThan(t, firstLinked)))
+        firstLinked = t;
+}
+
+void QTimerInfoList::unlink(QTimerInfo *t)
+{
+    Q_ASSERT(t->slot >= 0);
+    if (t == firstLinked) {
+        firstLinked = nullptr;
+        firstLinkedValid = false;
+    }
+    *t->pprev = t->next;
+    if (t->next)
+        t->next->pprev = t->pprev;
+    if (!buckets[t->slot])
+        occupied[t->slot / 64] &= ~(Q_UINT64_C(1) << (t->slot % 64));
+    t->slot = -1;
+    t->next = nullptr;
+    t->pprev = nullptr;
+}
+
+void QTimerInfoList::insert(QTimerInfo *t)
+{
+    t->sequence = nextSequence++;
+    link(t);
+}
+
+void QTimerInfoList::insertDue(QTimerInfo *t)
+{
+    int index = due.size();
+    while (index--) {
+        if (!timerLessThan(t, due.at(index)))
+            break;
+    }
+    due.insert(index + 1, t);
+}
+
+/*
+    Called whenever the wheel has been advanced to the start of a first level
+    revolution: moves the timers of the current slot of the next level down,
+    and so on for every level whose revolution completed as well.
+*/
+void QTimerInfoList::cascade()
+{
+    for (int level = 1; level < LevelCount; ++level) {
+        const int index = int((wheelTick >> levelShift(level)) & (LevelSize - 1));
+        const int slot = levelBase(level) + index;
+
+        QTimerInfo *t = buckets[slot];
+        buckets[slot] = nullptr;
+        occupied[slot / 64] &= ~(Q_UINT64_C(1) << (slot % 64));
+        while (t) {
+            QTimerInfo *next = t->next;
+            link(t);
+            t = next;
+        }
+
+        if (index != 0)
+            break;
+    }
+}
+
+/*
+    Advances the wheel to \a now, moving all timers that have expired by
+    then to the due list.
+*/
+void QTimerInfoList::advance(const timespec &now)
+{
+    const qint64 nowTick = toTick(now);
+
+    forever {
+        const int slot = int(wheelTick & (FirstLevelSize - 1));
+        QTimerInfo *t = buckets[slot];
+        while (t) {
+            QTimerInfo *next = t->next;
+            if (!(now < t->timeout)) {
+                unlink(t);
+                insertDue(t);
+            }
+            t = next;
+        }
+
+        if (wheelTick >= nowTick)
+            break;
+
+        // skip ahead to the next occupied slot of this revolution, if any
+        const qint64 boundary = (wheelTick | (FirstLevelSize - 1)) + 1;
+        if (slot < FirstLevelSize - 1) {
+            const int next = nextOccupiedSlot(0, slot + 1);
+            if (next > slot) {
+                wheelTick = qMin(nowTick, wheelTick + (next - slot));
+                continue;
+            }
+        }
+
+        if (boundary > nowTick) {
+            wheelTick = nowTick;
+        } else {
+            wheelTick = boundary;
+            cascade();
+        }
+    }
+}
+
+/*
+    Returns the timer linked into the wheel that expires first, skipping the
+    ones being activated if \a skipActivated is true, or null if there is
+    none. Only the first occupied slot of each level needs to be looked at,
+    and the levels above can be skipped as soon as a timer was found that
+    expires before they start.
+*/
+const QTimerInfo *QTimerInfoList::findFirstLinkedTimer(bool skipActivated) const
+{
+    const QTimerInfo *first = nullptr;
+    for (int level = 0; level < LevelCount; ++level) {
+        if (level && first) {
+            const qint64 levelStart = ((wheelTick >> levelShift(level)) + 1) << levelShift(level);
+            if (toTick(first->timeout) < levelStart)
+                break;
+        }
+
+        // the first level starts at the current millisecond, the others
+        // at the slot after the one that was cascaded last
+        int start = int(wheelTick >> levelShift(level));
+        if (level)
+            ++start;
+        start &= levelSize(level) - 1;
+
+        for (int i = 0; i < levelSize(level); ) {
+            const int slot = nextOccupiedSlot(level, (start + i) & (levelSize(level) - 1));
+            if (slot == -1)
+                break;
+
+            const QTimerInfo *earliest = nullptr;
+            for (const QTimerInfo *t = buckets[levelBase(level) + slot]; t; t = t->next) {
+                if (skipActivated && t->activateRef)
+                    continue;
+                if (!earliest || timerLessThan(t, earliest))
+                    earliest = t;
+            }
+
+            if (earliest) {
+                if (!first || timerLessThan(earliest, first))
+                    first = earliest;
+                break;
+            }
+
+            // only timers being activated in this slot, look further
+            i = ((slot - start) & (levelSize(level) - 1)) + 1;
+        }
+    }
+
+    return first;
+}
+
+/*
+    Returns the timer that expires first and is not being activated, or
+    null if there is none.
+*/
+const QTimerInfo *QTimerInfoList::firstWaitingTimer() const
+{
+    for (const QTimerInfo *t : due) {
+        if (!t->activateRef)
+            return t;
+    }
+
+    if (!firstLinkedValid) {
+        firstLinked = findFirstLinkedTimer(false);
+        firstLinkedValid = true;
+    }
+    if (!firstLinked || !firstLinked->activateRef)
+        return firstLinked;
+
+    // the earliest timer is being activated, i.e. we are in a nested event loop
+    return findFirstLinkedTimer(true);
+}
+
+#if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC) && !defined(Q_OS_INTEGRITY)) || defined(QT_BOOTSTRAPPED)
+
+/*
+  repair broken timers, by moving every timer and sorting them in again
+*/
+void QTimerInfoList::timerRepair(const timespec &diff)
+{
+    due.clear();
+    memset(buckets, 0, sizeof(buckets));
+    memset(occupied, 0, sizeof(occupied));
+    wheelTick = toTick(currentTime);
+    firstLinked = nullptr;
+    firstLinkedValid = true;
+
+    for (QTimerInfo *t : qAsConst(timers)) {
+        t->timeout = t->timeout + diff;
+        if (!(currentTime < t->timeout)) {
+            t->slot = -1;
+            t->next = nullptr;
+            t->pprev = nullptr;
+            insertDue(t);
+        } else {
+            link(t);
         }
     }
+}
+
+void QTimerInfoList::repairTimersIfNeeded()
+{
+    if (QElapsedTimer::isMonotonic())
+        return;
+    timespec delta;
+    if (timeChanged(&delta))
+        timerRepair(delta);
+}
+
+#else // !(_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(QT_BOOTSTRAPPED)
 
+void QTimerInfoList::repairTimersIfNeeded()
+{
+}
+
+#endif
+
+bool QTimerInfoList::timerWait(timespec &tm)
+{
+    timespec currentTime = updateCurrentTime();
+    repairTimersIfNeeded();
+
+    const QTimerInfo *t = firstWaitingTimer();
     if (!t)
-      return false;
+        return false;
 
     if (currentTime < t->timeout) {
         // time to wait
@@ -412,28 +724,18 @@ bool QTimerInfoList::timerWait(timespec &tm)
     return true;
 }
 
-/*
-  Returns the timer's remaining time in milliseconds with the given timerId, or
-  null if there is nothing left. If the timer id is not found in the list, the
-  returned value will be -1. If the timer is overdue, the returned value will be 0.
-*/
 int QTimerInfoList::timerRemainingTime(int timerId)
 {
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
-    timespec tm = {0, 0};
-
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            timespec tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
         }
+        return 0;
     }
 
 #ifndef QT_NO_DEBUG
@@ -452,50 +754,20 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     t->obj = object;
     t->activateRef = 0;
 
-    timespec expected = updateCurrentTime() + interval;
-
-    switch (timerType) {
-    case Qt::PreciseTimer:
-        // high precision timer is based on millisecond precision
-        // so no adjustment is necessary
-        t->timeout = expected;
-        break;
-
-    case Qt::CoarseTimer:
-        // this timer has up to 5% coarseness
-        // so our boundaries are 20 ms and 20 s
-        // below 20 ms, 5% inaccuracy is below 1 ms, so we convert to high precision
-        // above 20 s, 5% inaccuracy is above 1 s, so we convert to VeryCoarseTimer
-        if (interval >= 20000) {
-            t->timerType = Qt::VeryCoarseTimer;
-        } else {
-            t->timeout = expected;
-            if (interval <= 20) {
-                t->timerType = Qt::PreciseTimer;
-                // no adjustment is necessary
-            } else if (interval <= 20000) {
-                calculateCoarseTimerTimeout(t, currentTime);
-            }
-            break;
-        }
-        Q_FALLTHROUGH();
-    case Qt::VeryCoarseTimer:
-        // the very coarse timer is based on full second precision,
-        // so we keep the interval in seconds (round to closest second)
-        t->interval /= 500;
-        t->interval += 1;
-        t->interval >>= 1;
-        t->timeout.tv_sec = currentTime.tv_sec + t->interval;
-        t->timeout.tv_nsec = 0;
+    timespec currentTime = updateCurrentTime();
+    calculateFirstTimeout(t, currentTime);
 
-        // if we're past the half-second mark, increase the timeout again
-        if (currentTime.tv_nsec > 500*1000*1000)
-            ++t->timeout.tv_sec;
-    }
+    // the wheel is not advanced while there are no timers, catch up now
+    // instead of cascading through all the time that passed meanwhile
+    if (timers.isEmpty())
+        wheelTick = toTick(currentTime);
+    insert(t);
 
-    timerInsert(t);
+    timers.insert(timerId, t);
+    objectTimers.insert(object, t);
 
 #ifdef QTIMERINFO_DEBUG
+    timespec expected = currentTime + interval;
     t->expected = expected;
     t->cumulativeError = 0;
     t->count = 0;
@@ -505,59 +777,57 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 #endif
 }
 
+void QTimerInfoList::removeTimer(QTimerInfo *t)
+{
+    if (t->slot >= 0)
+        unlink(t);
+    else
+        due.removeOne(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+}
+
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
-    // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timers.take(timerId);
+    if (!t)
+        return false;
+
+    objectTimers.remove(t->obj, t);
+    removeTimer(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+
+    const QList<QTimerInfo *> list = objectTimers.values(object);
+    objectTimers.remove(object);
+    for (QTimerInfo *t : list) {
+        timers.remove(t->id);
+        removeTimer(t);
     }
     return true;
 }
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    QList<QTimerInfo *> objectList = objectTimers.values(object);
+    std::sort(objectList.begin(), objectList.end(), timerLessThan);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    list.reserve(objectList.size());
+    for (const QTimerInfo *t : qAsConst(objectList)) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -574,23 +844,17 @@ int QTimerInfoList::activateTimers()
     firstTimerInfo = 0;
 
     timespec currentTime = updateCurrentTime();
-    // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
 
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    advance(currentTime);
+    maxCount = due.size();
 
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
+        if (due.isEmpty())
             break;
 
-        QTimerInfo *currentTimerInfo = constFirst();
+        QTimerInfo *currentTimerInfo = due.constFirst();
         if (currentTime < currentTimerInfo->timeout)
             break; // no timer has expired
 
@@ -604,8 +868,8 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // remove from list
-        removeFirst();
+        // remove from the due list
+        due.removeFirst();
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -631,7 +895,7 @@ int QTimerInfoList::activateTimers()
         calculateNextTimeout(currentTimerInfo, currentTime);
 
         // reinsert timer
-        timerInsert(currentTimerInfo);
+        insert(currentTimerInfo);
         if (currentTimerInfo->interval > 0)
             n_act++;
 
@@ -648,7 +912,6 @@ int QTimerInfoList::activateTimers()
     }
 
     firstTimerInfo = 0;
-    // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
 
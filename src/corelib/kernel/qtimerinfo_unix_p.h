@@ -56,6 +56,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +70,10 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    QTimerInfo *next;   // - next timer in the same wheel slot
+    QTimerInfo **pprev; // - link pointing to this timer
+    quint64 sequence;   // - insertion order, for timers with equal timeouts
+    int slot;           // - wheel slot, or -1 if the timer is due
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,8 +82,40 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+/*
+    Hierarchical timing wheel, with constant time registration and
+    cancellation of timers.
+*/
+class Q_CORE_EXPORT QTimerInfoList
 {
+    enum {
+        LevelCount = 5,
+        FirstLevelBits = 8,
+        LevelBits = 6,
+        FirstLevelSize = 1 << FirstLevelBits,
+        LevelSize = 1 << LevelBits,
+        SlotCount = FirstLevelSize + (LevelCount - 1) * LevelSize
+    };
+
+    static int levelBase(int level)
+    { return level ? FirstLevelSize + (level - 1) * LevelSize : 0; }
+    static int levelSize(int level)
+    { return level ? int(LevelSize) : int(FirstLevelSize); }
+    static int levelShift(int level)
+    { return level ? FirstLevelBits + (level - 1) * LevelBits : 0; }
+
+    int slotFor(qint64 tick) const;
+    int nextOccupiedSlot(int level, int start) const;
+    void link(QTimerInfo *t);
+    void unlink(QTimerInfo *t);
+    void insert(QTimerInfo *t);
+    void insertDue(QTimerInfo *t);
+    void cascade();
+    void advance(const timespec &now);
+    const QTimerInfo *findFirstLinkedTimer(bool skipActivated) const;
+    const QTimerInfo *firstWaitingTimer() const;
+    void removeTimer(QTimerInfo *t);
+
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
     clock_t previousTicks;
@@ -89,20 +126,36 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
+    QTimerInfo *buckets[SlotCount];
+    quint64 occupied[SlotCount / 64];
+    qint64 wheelTick;         // the millisecond the wheel has been advanced to
+    quint64 nextSequence;
+
+    // earliest timer linked into the wheel, recomputed on demand
+    mutable const QTimerInfo *firstLinked;
+    mutable bool firstLinkedValid;
+
+    QList<QTimerInfo *> due; // expired timers, sorted by timeout
+    QHash<int, QTimerInfo *> timers;
+    QMultiHash<QObject *, QTimerInfo *> objectTimers;
+
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     timespec currentTime;
     timespec updateCurrentTime();
 
+    bool isEmpty() const { return timers.isEmpty(); }
+    int size() const { return timers.size(); }
+
     // must call updateCurrentTime() first!
     void repairTimersIfNeeded();
 
     bool timerWait(timespec &);
-    void timerInsert(QTimerInfo *);
 
     int timerRemainingTime(int timerId);
 
@@ -112,6 +165,9 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+private:
+    Q_DISABLE_COPY(QTimerInfoList)
 };
 
 QT_END_NAMESPACE
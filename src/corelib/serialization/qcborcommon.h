@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QCBORCOMMON_H
+#define QCBORCOMMON_H
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QString;
+
+enum class QCborSimpleType : quint8 {
+    False = 20,
+    True = 21,
+    Null = 22,
+    Undefined = 23
+};
+
+enum class QCborTag : quint64 {};
+
+enum class QCborKnownTags {
+    DateTimeString          = 0,
+    UnixTime_t              = 1,
+    PositiveBignum          = 2,
+    NegativeBignum          = 3,
+    Decimal                 = 4,
+    Bigfloat                = 5,
+    ExpectedBase64url       = 21,
+    ExpectedBase64          = 22,
+    ExpectedBase16          = 23,
+    EncodedCbor             = 24,
+    Url                     = 32,
+    Base64url               = 33,
+    Base64                  = 34,
+    RegularExpression       = 35,
+    MimeMessage             = 36,
+    Uuid                    = 37,
+    Signature               = 55799
+};
+
+inline bool operator==(QCborTag t, QCborKnownTags kt)   { return quint64(t) == quint64(kt); }
+inline bool operator==(QCborKnownTags kt, QCborTag t)   { return quint64(t) == quint64(kt); }
+inline bool operator!=(QCborTag t, QCborKnownTags kt)   { return quint64(t) != quint64(kt); }
+inline bool operator!=(QCborKnownTags kt, QCborTag t)   { return quint64(t) != quint64(kt); }
+
+struct Q_CORE_EXPORT QCborError
+{
+    enum Code : int {
+        UnknownError = 1,
+        AdvancePastEnd = 3,
+        InputOutputError = 4,
+        GarbageAtEnd = 256,
+        EndOfFile,
+        UnexpectedBreak,
+        UnknownType,
+        IllegalType,
+        IllegalNumber,
+        IllegalSimpleType,
+
+        InvalidUtf8String = 516,
+
+        DataTooLarge = 1024,
+        NestingTooDeep,
+        UnsupportedType,
+
+        NoError = 0
+    };
+
+    Code c;
+    operator Code() const { return c; }
+    QString toString() const;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCBORCOMMON_H
@@ -0,0 +1,1897 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qcborstream.h"
+
+#include "qjsonarray.h"
+#include "qjsondocument.h"
+#include "qjsonobject.h"
+#include "qjsonvalue.h"
+
+#include <qdatetime.h>
+#include <qendian.h>
+#include <qiodevice.h>
+#include <qlocale.h>
+#include <qurl.h>
+#include <quuid.h>
+#include <qvariant.h>
+#include <qvarlengtharray.h>
+#include <private/qutfcodec_p.h>
+
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+enum : quint8 {
+    // major types, already shifted into the initial byte
+    UnsignedIntegerType = 0x00,
+    NegativeIntegerType = 0x20,
+    ByteStringType = 0x40,
+    TextStringType = 0x60,
+    ArrayType = 0x80,
+    MapType = 0xa0,
+    TagType = 0xc0,
+    SimpleTypesType = 0xe0,
+
+    // additional information
+    Value8Bit = 24,
+    Value16Bit = 25,
+    Value32Bit = 26,
+    Value64Bit = 27,
+    IndefiniteLength = 31,
+
+    MajorTypeMask = 0xe0,
+    SmallValueMask = 0x1f,
+
+    HalfPrecisionFloat = SimpleTypesType | Value16Bit,
+    SinglePrecisionFloat = SimpleTypesType | Value32Bit,
+    DoublePrecisionFloat = SimpleTypesType | Value64Bit,
+    Break = SimpleTypesType | IndefiniteLength
+};
+
+// leave room for the QByteArray and QString headers
+const quint64 MaxStringSize = quint64((std::numeric_limits<int>::max)()) - 64;
+// longer strings and chunks are returned in pieces, so that the reader does
+// not have to buffer them in full
+const qsizetype MaxStringPieceSize = 64 * 1024;
+const int MaxConversionDepth = 1024;
+}
+
+/*!
+    \enum QCborSimpleType
+    \relates <QtCborCommon>
+    \since 5.12
+
+    This enum contains the simple types defined by RFC 7049 that have a
+    meaning of their own.
+
+    \value False    The boolean value false.
+    \value True     The boolean value true.
+    \value Null     The null value.
+    \value Undefined The undefined value.
+*/
+
+/*!
+    \enum QCborTag
+    \relates <QtCborCommon>
+    \since 5.12
+
+    This is a strongly-typed integer type that holds a CBOR tag number.
+    See QCborKnownTags for the tags whose meaning is defined by RFC 7049.
+*/
+
+/*!
+    \enum QCborKnownTags
+    \relates <QtCborCommon>
+    \since 5.12
+
+    This enum contains the tag numbers defined by RFC 7049 and a few
+    registered with IANA.
+
+    \value DateTimeString   A date and time as an RFC 3339 text string.
+    \value UnixTime_t       A date and time as the number of seconds since the epoch.
+    \value PositiveBignum   A positive integer encoded as a byte string.
+    \value NegativeBignum   A negative integer encoded as a byte string.
+    \value Decimal          A decimal fraction (exponent and mantissa).
+    \value Bigfloat         A binary fraction (exponent and mantissa).
+    \value ExpectedBase64url  The byte string should be converted to Base64url.
+    \value ExpectedBase64   The byte string should be converted to Base64.
+    \value ExpectedBase16   The byte string should be converted to Base16.
+    \value EncodedCbor      The byte string contains a CBOR stream.
+    \value Url              The text string contains a URL.
+    \value Base64url        The text string is encoded in Base64url.
+    \value Base64           The text string is encoded in Base64.
+    \value RegularExpression  The text string contains a regular expression.
+    \value MimeMessage      The text string contains a MIME message.
+    \value Uuid             The byte string contains a UUID.
+    \value Signature        Self-describing CBOR marker, usually at the start of a file.
+*/
+
+/*!
+    \class QCborError
+    \inmodule QtCore
+    \since 5.12
+
+    \brief The QCborError class holds the error condition found while
+    parsing a CBOR stream.
+
+    \sa QCborStreamReader
+
+    \value UnknownError         An unknown error occurred.
+    \value AdvancePastEnd       QCborStreamReader::next() was called at the end of a container.
+    \value InputOutputError     An error occurred reading from the QIODevice.
+    \value GarbageAtEnd         Data was found after the end of the stream.
+    \value EndOfFile            The end of the data was reached before the current
+                                element was complete. More data may be added with
+                                QCborStreamReader::addData().
+    \value UnexpectedBreak      A break byte was found outside an indefinite-length container.
+    \value UnknownType          The stream contains an unknown major type.
+    \value IllegalType          A string chunk has a different type than its string.
+    \value IllegalNumber        An integer with a reserved length encoding was found.
+    \value IllegalSimpleType    A simple type with a value below 32 was encoded in two bytes.
+    \value InvalidUtf8String    A text string is not valid UTF-8.
+    \value DataTooLarge         A string is too large to be held in memory.
+    \value NestingTooDeep       Containers are nested too deeply.
+    \value UnsupportedType      The stream contains a type this implementation does not support.
+    \value NoError              No error occurred.
+*/
+
+/*!
+    Returns a text string describing the error condition.
+*/
+QString QCborError::toString() const
+{
+    switch (c) {
+    case NoError:
+        return QStringLiteral("No error");
+    case UnknownError:
+        break;
+    case AdvancePastEnd:
+        return QStringLiteral("Attempted to advance past the end of a container");
+    case InputOutputError:
+        return QStringLiteral("Input/output error");
+    case GarbageAtEnd:
+        return QStringLiteral("Garbage after the end of the data");
+    case EndOfFile:
+        return QStringLiteral("Unexpected end of data");
+    case UnexpectedBreak:
+        return QStringLiteral("Unexpected break");
+    case UnknownType:
+        return QStringLiteral("Unknown major type");
+    case IllegalType:
+        return QStringLiteral("Illegal chunk type in indefinite-length string");
+    case IllegalNumber:
+        return QStringLiteral("Illegal number encoding");
+    case IllegalSimpleType:
+        return QStringLiteral("Illegal simple type encoding");
+    case InvalidUtf8String:
+        return QStringLiteral("Invalid UTF-8 in text string");
+    case DataTooLarge:
+        return QStringLiteral("Data too large");
+    case NestingTooDeep:
+        return QStringLiteral("Containers nested too deeply");
+    case UnsupportedType:
+        return QStringLiteral("Unsupported type");
+    }
+    return QStringLiteral("Unknown error");
+}
+
+class QCborStreamWriterPrivate
+{
+public:
+    QCborStreamWriterPrivate(QIODevice *device, QByteArray *data)
+        : device(device), data(data)
+    {}
+
+    void write(const char *ptr, qsizetype len)
+    {
+        if (data)
+            data->append(ptr, int(len));
+        else if (device)
+            device->write(ptr, len);
+    }
+
+    void writeHead(quint8 majorType, quint64 value)
+    {
+        char buf[1 + sizeof(quint64)];
+        qsizetype len = 1;
+        if (value < Value8Bit) {
+            buf[0] = char(majorType | value);
+        } else if (value <= 0xff) {
+            buf[0] = char(majorType | Value8Bit);
+            buf[1] = char(value);
+            len = 2;
+        } else if (value <= 0xffff) {
+            buf[0] = char(majorType | Value16Bit);
+            qToBigEndian(quint16(value), buf + 1);
+            len = 3;
+        } else if (value <= 0xffffffffU) {
+            buf[0] = char(majorType | Value32Bit);
+            qToBigEndian(quint32(value), buf + 1);
+            len = 5;
+        } else {
+            buf[0] = char(majorType | Value64Bit);
+            qToBigEndian(value, buf + 1);
+            len = 9;
+        }
+        write(buf, len);
+    }
+
+    // Counts a complete item against the enclosing definite-length container.
+    void itemWritten()
+    {
+        if (!containers.isEmpty() && containers.last() > 0)
+            --containers.last();
+    }
+
+    void startContainer(quint8 majorType, quint64 count, bool indefinite)
+    {
+        if (indefinite) {
+            const char c = char(majorType | IndefiniteLength);
+            write(&c, 1);
+        } else {
+            writeHead(majorType, count);
+        }
+        itemWritten();
+
+        qint64 items = -1;
+        if (!indefinite) {
+            if (majorType == MapType)
+                count *= 2;
+            items = count > quint64((std::numeric_limits<qint64>::max)())
+                    ? (std::numeric_limits<qint64>::max)() : qint64(count);
+        }
+        containers.append(items);
+    }
+
+    bool endContainer()
+    {
+        if (containers.isEmpty())
+            return false;
+        const qint64 remaining = containers.last();
+        containers.removeLast();
+        if (remaining < 0) {
+            const char c = char(Break);
+            write(&c, 1);
+            return true;
+        }
+        return remaining == 0;
+    }
+
+    QIODevice *device;
+    QByteArray *data;
+    // items left in each open container, -1 for indefinite length
+    QVarLengthArray<qint64, 16> containers;
+};
+
+/*!
+    \class QCborStreamWriter
+    \inmodule QtCore
+    \reentrant
+    \since 5.12
+
+    \brief The QCborStreamWriter class is a simple CBOR encoder operating
+    on a one-way stream.
+
+    \ingroup json
+
+    QCborStreamWriter writes Concise Binary Object Representation (CBOR,
+    RFC 7049) data either to a QIODevice or by appending to a QByteArray.
+    CBOR is a binary format modelled on JSON that is usually smaller and
+    faster to produce and parse than JSON text or the binary format of
+    QJsonDocument, and is understood by many other implementations.
+
+    The writer pushes one value at a time, in the same style as
+    QXmlStreamWriter. Arrays and maps are written by calling startArray()
+    or startMap(), then appending the elements (for maps, alternating keys
+    and values), and finally calling endArray() or endMap(). If the number
+    of elements is known in advance, pass it to startArray() or startMap()
+    to produce a more compact encoding.
+
+    \snippet code/src_corelib_serialization_qcborstream.cpp 0
+
+    appendJsonValue() and appendVariant() write a whole QJsonValue or
+    QVariant, including any nested arrays and objects.
+
+    QCborStreamWriter performs no validation of the structure it writes:
+    it is the caller's responsibility to append the number of elements
+    announced for each container and to use valid UTF-8 in
+    appendTextString().
+
+    \sa QCborStreamReader, QXmlStreamWriter
+*/
+
+/*!
+    Creates a QCborStreamWriter that writes to \a device. The device must
+    already be open for writing.
+*/
+QCborStreamWriter::QCborStreamWriter(QIODevice *device)
+    : d_ptr(new QCborStreamWriterPrivate(device, nullptr))
+{
+}
+
+/*!
+    Creates a QCborStreamWriter that appends the data it writes to \a data.
+    This is faster than writing to a QBuffer.
+*/
+QCborStreamWriter::QCborStreamWriter(QByteArray *data)
+    : d_ptr(new QCborStreamWriterPrivate(nullptr, data))
+{
+}
+
+/*!
+    Destroys this writer. Containers that are still open are not closed.
+*/
+QCborStreamWriter::~QCborStreamWriter()
+{
+}
+
+/*!
+    Replaces the device or byte array this writer writes to with \a device.
+    The state of open containers is kept.
+*/
+void QCborStreamWriter::setDevice(QIODevice *device)
+{
+    Q_D(QCborStreamWriter);
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device this writer writes to, or \nullptr if it appends to
+    a QByteArray.
+*/
+QIODevice *QCborStreamWriter::device() const
+{
+    Q_D(const QCborStreamWriter);
+    return d->device;
+}
+
+/*!
+    Appends the unsigned integer \a u.
+*/
+void QCborStreamWriter::append(quint64 u)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(UnsignedIntegerType, u);
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the signed integer \a i, using the unsigned or the negative
+    integer type depending on its sign.
+*/
+void QCborStreamWriter::append(qint64 i)
+{
+    Q_D(QCborStreamWriter);
+    if (i >= 0)
+        d->writeHead(UnsignedIntegerType, quint64(i));
+    else
+        d->writeHead(NegativeIntegerType, ~quint64(i));   // -1 - i
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the negative integer \a n, whose absolute value is stored in
+    the enumeration. This allows encoding the full negative range of CBOR,
+    down to -2\sup{64}. A value of zero represents -2\sup{64}.
+*/
+void QCborStreamWriter::append(QCborNegativeInteger n)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(NegativeIntegerType, quint64(n) - 1);
+    d->itemWritten();
+}
+
+/*!
+    \fn void QCborStreamWriter::append(const QByteArray &ba)
+    \overload
+
+    Appends \a ba as a byte string.
+*/
+
+/*!
+    \overload
+
+    Appends the Latin-1 string \a str as a text string, converting it to
+    UTF-8 if it contains characters outside the US-ASCII range.
+*/
+void QCborStreamWriter::append(QLatin1String str)
+{
+    const char *ptr = str.data();
+    const char *end = ptr + str.size();
+    for ( ; ptr != end; ++ptr) {
+        if (uchar(*ptr) >= 0x80)
+            break;
+    }
+    if (ptr == end) {
+        appendTextString(str.data(), str.size());
+    } else {
+        const QByteArray utf8 = QString(str).toUtf8();
+        appendTextString(utf8.constData(), utf8.size());
+    }
+}
+
+/*!
+    \overload
+
+    Appends \a str as a text string, converting it to UTF-8.
+*/
+void QCborStreamWriter::append(QStringView str)
+{
+    const QByteArray utf8 = str.toUtf8();
+    appendTextString(utf8.constData(), utf8.size());
+}
+
+/*!
+    \overload
+
+    Appends the tag \a tag. The next item appended is the value the tag
+    applies to; together, they count as a single element of the enclosing
+    container.
+*/
+void QCborStreamWriter::append(QCborTag tag)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(TagType, quint64(tag));
+}
+
+/*!
+    \fn void QCborStreamWriter::append(QCborKnownTags tag)
+    \overload
+
+    Appends the tag \a tag.
+*/
+
+/*!
+    \overload
+
+    Appends the simple type \a st.
+*/
+void QCborStreamWriter::append(QCborSimpleType st)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(SimpleTypesType, quint8(st));
+    d->itemWritten();
+}
+
+/*!
+    \fn void QCborStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends a null value.
+*/
+
+/*!
+    \overload
+
+    Appends the half-precision floating point number \a f.
+*/
+void QCborStreamWriter::append(qfloat16 f)
+{
+    Q_D(QCborStreamWriter);
+    quint16 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    char buf[1 + sizeof(bits)];
+    buf[0] = char(HalfPrecisionFloat);
+    qToBigEndian(bits, buf + 1);
+    d->write(buf, sizeof(buf));
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the single-precision floating point number \a f.
+*/
+void QCborStreamWriter::append(float f)
+{
+    Q_D(QCborStreamWriter);
+    quint32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    char buf[1 + sizeof(bits)];
+    buf[0] = char(SinglePrecisionFloat);
+    qToBigEndian(bits, buf + 1);
+    d->write(buf, sizeof(buf));
+    d->itemWritten();
+}
+
+/*!
+    \overload
+
+    Appends the double-precision floating point number \a d.
+*/
+void QCborStreamWriter::append(double d)
+{
+    quint64 bits;
+    memcpy(&bits, &d, sizeof(bits));
+    char buf[1 + sizeof(bits)];
+    buf[0] = char(DoublePrecisionFloat);
+    qToBigEndian(bits, buf + 1);
+    d_func()->write(buf, sizeof(buf));
+    d_func()->itemWritten();
+}
+
+/*!
+    Appends \a len bytes starting at \a data as a byte string.
+*/
+void QCborStreamWriter::appendByteString(const char *data, qsizetype len)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(ByteStringType, quint64(len));
+    d->write(data, len);
+    d->itemWritten();
+}
+
+/*!
+    Appends \a len bytes starting at \a utf8 as a text string. The data
+    must be valid UTF-8; this is not checked.
+*/
+void QCborStreamWriter::appendTextString(const char *utf8, qsizetype len)
+{
+    Q_D(QCborStreamWriter);
+    d->writeHead(TextStringType, quint64(len));
+    d->write(utf8, len);
+    d->itemWritten();
+}
+
+/*!
+    \fn void QCborStreamWriter::append(bool b)
+    \overload
+
+    Appends the boolean \a b.
+*/
+
+/*!
+    \fn void QCborStreamWriter::appendNull()
+
+    Appends a null value.
+*/
+
+/*!
+    \fn void QCborStreamWriter::appendUndefined()
+
+    Appends an undefined value.
+*/
+
+/*!
+    \fn void QCborStreamWriter::append(const char *str, qsizetype size)
+    \overload
+
+    Appends \a size bytes of the UTF-8 string \a str as a text string. If
+    \a size is -1, \a str must be null-terminated.
+*/
+
+/*!
+    Appends \a value, including the contents of arrays and objects.
+
+    Numbers that are integral and can be represented exactly are written as
+    integers; all other numbers are written as double-precision floating
+    point numbers. QCborStreamReader::readJsonValue() converts both back to
+    double.
+
+    \sa appendVariant(), QCborStreamReader::readJsonValue()
+*/
+void QCborStreamWriter::appendJsonValue(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+        appendNull();
+        return;
+    case QJsonValue::Bool:
+        append(value.toBool());
+        return;
+    case QJsonValue::Double: {
+        const double d = value.toDouble();
+        // 2^53: the largest range in which every integer is exact
+        const double maxExactInteger = 9007199254740992.;
+        if (d > -maxExactInteger && d < maxExactInteger && d == std::floor(d)
+                && !(d == 0 && std::signbit(d)))
+            append(qint64(d));
+        else
+            append(d);
+        return;
+    }
+    case QJsonValue::String:
+        append(value.toString());
+        return;
+    case QJsonValue::Array: {
+        const QJsonArray array = value.toArray();
+        startArray(quint64(array.size()));
+        for (const QJsonValue &element : array)
+            appendJsonValue(element);
+        endArray();
+        return;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        startMap(quint64(object.size()));
+        for (auto it = object.constBegin(), end = object.constEnd(); it != end; ++it) {
+            append(it.key());
+            appendJsonValue(it.value());
+        }
+        endMap();
+        return;
+    }
+    case QJsonValue::Undefined:
+        break;
+    }
+    appendUndefined();
+}
+
+/*!
+    Appends \a value, including the contents of lists and maps.
+
+    Integers, floating point numbers, booleans, strings and byte arrays are
+    written as the corresponding CBOR types. QVariantList and QStringList
+    become arrays, QVariantMap and QVariantHash become maps with text string
+    keys. QDateTime, QUrl and QUuid are written with the tags defined for
+    them (QCborKnownTags::DateTimeString, QCborKnownTags::Url and
+    QCborKnownTags::Uuid). JSON types are written as by appendJsonValue(). A
+    null QVariant is written as undefined and a \c std::nullptr_t as null;
+    other types are written as text strings if QVariant can convert them to
+    QString, or as undefined otherwise.
+
+    \sa appendJsonValue(), QCborStreamReader::readVariant()
+*/
+void QCborStreamWriter::appendVariant(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::UnknownType:
+        appendUndefined();
+        return;
+    case QMetaType::Nullptr:
+        appendNull();
+        return;
+    case QMetaType::Bool:
+        append(value.toBool());
+        return;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        append(value.toLongLong());
+        return;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        append(value.toULongLong());
+        return;
+    case QMetaType::Float:
+        append(value.toFloat());
+        return;
+    case QMetaType::Double:
+        append(value.toDouble());
+        return;
+    case QMetaType::QString:
+        append(value.toString());
+        return;
+    case QMetaType::QByteArray:
+        append(value.toByteArray());
+        return;
+    case QMetaType::QStringList: {
+        const QStringList list = value.toStringList();
+        startArray(quint64(list.size()));
+        for (const QString &s : list)
+            append(s);
+        endArray();
+        return;
+    }
+    case QMetaType::QVariantList: {
+        const QVariantList list = value.toList();
+        startArray(quint64(list.size()));
+        for (const QVariant &v : list)
+            appendVariant(v);
+        endArray();
+        return;
+    }
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        startMap(quint64(map.size()));
+        for (auto it = map.constBegin(), end = map.constEnd(); it != end; ++it) {
+            append(it.key());
+            appendVariant(it.value());
+        }
+        endMap();
+        return;
+    }
+    case QMetaType::QVariantHash: {
+        const QVariantHash hash = value.toHash();
+        startMap(quint64(hash.size()));
+        for (auto it = hash.constBegin(), end = hash.constEnd(); it != end; ++it) {
+            append(it.key());
+            appendVariant(it.value());
+        }
+        endMap();
+        return;
+    }
+    case QMetaType::QDateTime:
+        append(QCborKnownTags::DateTimeString);
+        append(value.toDateTime().toString(Qt::ISODateWithMs));
+        return;
+    case QMetaType::QUrl:
+        append(QCborKnownTags::Url);
+        append(value.toUrl().toString(QUrl::FullyEncoded));
+        return;
+    case QMetaType::QUuid:
+        append(QCborKnownTags::Uuid);
+        append(value.toUuid().toRfc4122());
+        return;
+    case QMetaType::QJsonValue:
+        appendJsonValue(value.toJsonValue());
+        return;
+    case QMetaType::QJsonObject:
+        appendJsonValue(value.toJsonObject());
+        return;
+    case QMetaType::QJsonArray:
+        appendJsonValue(value.toJsonArray());
+        return;
+    case QMetaType::QJsonDocument: {
+        const QJsonDocument doc = value.toJsonDocument();
+        if (doc.isArray())
+            appendJsonValue(doc.array());
+        else if (doc.isObject())
+            appendJsonValue(doc.object());
+        else
+            appendNull();
+        return;
+    }
+    }
+
+    if (value.canConvert<QString>())
+        append(value.toString());
+    else
+        appendUndefined();
+}
+
+/*!
+    Starts an array of unknown length. The elements must be appended next,
+    followed by a call to endArray().
+
+    \sa startMap(), endArray()
+*/
+void QCborStreamWriter::startArray()
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(ArrayType, 0, true);
+}
+
+/*!
+    \overload
+
+    Starts an array of \a count elements, which produces a shorter encoding
+    than an array of unknown length.
+*/
+void QCborStreamWriter::startArray(quint64 count)
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(ArrayType, count, false);
+}
+
+/*!
+    Ends the array started by the last call to startArray() that has not
+    been ended yet. Returns \c true if the array had the announced number
+    of elements, \c false otherwise or if no array was open.
+*/
+bool QCborStreamWriter::endArray()
+{
+    Q_D(QCborStreamWriter);
+    return d->endContainer();
+}
+
+/*!
+    Starts a map of unknown length. Keys and values must be appended next,
+    alternately, followed by a call to endMap().
+
+    \sa startArray(), endMap()
+*/
+void QCborStreamWriter::startMap()
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MapType, 0, true);
+}
+
+/*!
+    \overload
+
+    Starts a map of \a count key-value pairs, which produces a shorter
+    encoding than a map of unknown length.
+*/
+void QCborStreamWriter::startMap(quint64 count)
+{
+    Q_D(QCborStreamWriter);
+    d->startContainer(MapType, count, false);
+}
+
+/*!
+    Ends the map started by the last call to startMap() that has not been
+    ended yet. Returns \c true if the map had the announced number of
+    pairs, \c false otherwise or if no map was open.
+*/
+bool QCborStreamWriter::endMap()
+{
+    Q_D(QCborStreamWriter);
+    return d->endContainer();
+}
+
+class QCborStreamReaderPrivate
+{
+public:
+    enum StringState {
+        NotReadingString,
+        ReadingDefiniteString,      // inside a definite-length string
+        DefiniteStringRead,         // the whole string was returned
+        ReadingChunks               // inside an indefinite-length string
+    };
+
+    struct Container {
+        QCborStreamReader::Type type;
+        qint64 remaining;           // -1 for indefinite length
+    };
+
+    QCborStreamReaderPrivate(QCborStreamReader *q)
+        : q_ptr(q)
+    {}
+
+    bool ensureBytes(qsizetype count);
+    void handleError(QCborError::Code code)
+    {
+        lastError = { code };
+        q_ptr->type_ = QCborStreamReader::Invalid;
+    }
+    void preparse();
+    void itemRead()
+    {
+        if (!containers.isEmpty() && containers.last().remaining > 0)
+            --containers.last().remaining;
+    }
+    void advance(qsizetype count, bool completesItem)
+    {
+        bufferPos += count;
+        if (completesItem)
+            itemRead();
+        preparse();
+    }
+    bool decodeHead(qsizetype offset, quint8 *initialByte, quint64 *value, int *headerSize);
+    QCborStreamReader::StringResultCode readStringChunk(const char **data, qsizetype *len);
+    bool skip(int maxRecursion);
+
+    QString readAllString();
+    QByteArray readAllByteArray();
+    QJsonValue readJsonValue(int depth);
+    QVariant readVariant(int depth);
+
+    QCborStreamReader *q_ptr;
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype bufferPos = 0;        // start of the current element in buffer
+    qint64 bufferOffset = 0;        // stream offset of the start of buffer
+    QVarLengthArray<Container, 16> containers;
+    QCborError lastError = { QCborError::NoError };
+    int headerSize = 0;
+    bool indefinite = false;
+    bool atContainerEnd = false;
+    StringState stringState = NotReadingString;
+    qint64 stringRemaining = 0;     // bytes of the string or chunk not returned yet
+};
+
+/*!
+    \internal
+
+    Makes sure that \a count bytes starting at the current element are in
+    the buffer, reading them from the device if necessary.
+*/
+bool QCborStreamReaderPrivate::ensureBytes(qsizetype count)
+{
+    if (buffer.size() - bufferPos >= count)
+        return true;
+    if (!device)
+        return false;
+
+    // drop what was already consumed
+    if (bufferPos) {
+        buffer.remove(0, int(bufferPos));
+        bufferOffset += bufferPos;
+        bufferPos = 0;
+    }
+    while (buffer.size() < count) {
+        const QByteArray chunk = device->read(qMax<qint64>(count - buffer.size(), 16384));
+        if (chunk.isEmpty())
+            return false;
+        buffer += chunk;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Decodes the initial byte and argument of the data item at \a offset
+    bytes past the current element. Returns \c false without setting an
+    error if there is not enough data.
+*/
+bool QCborStreamReaderPrivate::decodeHead(qsizetype offset, quint8 *initialByte,
+                                          quint64 *value, int *size)
+{
+    if (!ensureBytes(offset + 1))
+        return false;
+    const uchar *ptr = reinterpret_cast<const uchar *>(buffer.constData()) + bufferPos + offset;
+    const quint8 info = *ptr & SmallValueMask;
+    *initialByte = *ptr;
+    if (info < Value8Bit || info > Value64Bit) {
+        *value = info;
+        *size = 1;
+        return true;
+    }
+
+    const int n = 1 << (info - Value8Bit);
+    if (!ensureBytes(offset + 1 + n))
+        return false;
+    ptr = reinterpret_cast<const uchar *>(buffer.constData()) + bufferPos + offset + 1;
+    switch (n) {
+    case 1:
+        *value = *ptr;
+        break;
+    case 2:
+        *value = qFromBigEndian<quint16>(ptr);
+        break;
+    case 4:
+        *value = qFromBigEndian<quint32>(ptr);
+        break;
+    default:
+        *value = qFromBigEndian<quint64>(ptr);
+        break;
+    }
+    *size = 1 + n;
+    return true;
+}
+
+/*!
+    \internal
+
+    Decodes the element at the current position, updating the reader's
+    type and value.
+*/
+void QCborStreamReaderPrivate::preparse()
+{
+    QCborStreamReader *q = q_ptr;
+    q->type_ = QCborStreamReader::Invalid;
+    q->value64 = 0;
+    headerSize = 0;
+    indefinite = false;
+    atContainerEnd = false;
+    stringState = NotReadingString;
+    if (lastError != QCborError::NoError && lastError != QCborError::EndOfFile)
+        return;
+    lastError = { QCborError::NoError };
+
+    if (!containers.isEmpty() && containers.last().remaining == 0) {
+        atContainerEnd = true;
+        return;
+    }
+
+    quint8 initialByte;
+    quint64 value;
+    int size;
+    if (!decodeHead(0, &initialByte, &value, &size)) {
+        lastError = { QCborError::EndOfFile };
+        return;
+    }
+
+    const quint8 majorType = initialByte & MajorTypeMask;
+    const quint8 info = initialByte & SmallValueMask;
+    if (initialByte == Break) {
+        if (!containers.isEmpty() && containers.last().remaining < 0)
+            atContainerEnd = true;
+        else
+            handleError(QCborError::UnexpectedBreak);
+        return;
+    }
+    if (info > Value64Bit) {
+        if (info != IndefiniteLength || majorType < ByteStringType || majorType > MapType) {
+            handleError(QCborError::IllegalNumber);
+            return;
+        }
+        indefinite = true;
+        value = 0;
+    }
+
+    QCborStreamReader::Type type = QCborStreamReader::Type(majorType);
+    if (majorType == SimpleTypesType) {
+        if (info == Value8Bit) {
+            if (value < 32) {
+                handleError(QCborError::IllegalSimpleType);
+                return;
+            }
+        } else if (info > Value8Bit) {
+            type = QCborStreamReader::Type(initialByte);
+        }
+    } else if ((majorType == ByteStringType || majorType == TextStringType)
+               && value > MaxStringSize) {
+        handleError(QCborError::DataTooLarge);
+        return;
+    }
+
+    headerSize = size;
+    q->value64 = value;
+    q->type_ = type;
+}
+
+/*!
+    \internal
+
+    Returns the length of the first \a size bytes of the UTF-8 text at \a data
+    without a trailing multi-byte sequence that is incomplete, so that a text
+    string can be returned in pieces that are valid on their own.
+*/
+static qsizetype completeUtf8Length(const char *data, qsizetype size)
+{
+    for (qsizetype i = size - 1; i >= 0 && i >= size - 4; --i) {
+        const uchar c = uchar(data[i]);
+        if (c < 0x80)
+            return size;
+        if (c >= 0xc0) {
+            const qsizetype sequenceLength = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+            return size - i >= sequenceLength ? size : i;
+        }
+    }
+    // not UTF-8 at all, let the validation report it
+    return size;
+}
+
+/*!
+    \internal
+
+    Returns the next piece of the current string in \a data and \a len. This
+    is a whole chunk, unless the chunk is longer than MaxStringPieceSize.
+
+    The position only moves past the string's and the chunk's headers
+    together with the data that is returned, so after an EndOfFile error,
+    reparse() either decodes the string again or continues with the piece
+    that could not be returned.
+*/
+QCborStreamReader::StringResultCode
+QCborStreamReaderPrivate::readStringChunk(const char **data, qsizetype *len)
+{
+    QCborStreamReader *q = q_ptr;
+    qsizetype offset = 0;           // headers in front of the data
+    switch (stringState) {
+    case NotReadingString:
+        offset = headerSize;
+        if (!indefinite) {
+            stringRemaining = qint64(q->value64);
+            break;
+        }
+        stringRemaining = 0;
+        Q_FALLTHROUGH();
+
+    case ReadingChunks:
+        if (stringRemaining == 0) {
+            quint8 initialByte;
+            quint64 value;
+            int size;
+            if (!decodeHead(offset, &initialByte, &value, &size)) {
+                lastError = { QCborError::EndOfFile };
+                return QCborStreamReader::Error;
+            }
+            if (initialByte == Break) {
+                advance(offset + 1, true);
+                return QCborStreamReader::EndOfString;
+            }
+            if ((initialByte & MajorTypeMask) != quint8(q->type_)
+                    || (initialByte & SmallValueMask) > Value64Bit) {
+                handleError(QCborError::IllegalType);
+                return QCborStreamReader::Error;
+            }
+            if (value > MaxStringSize) {
+                handleError(QCborError::DataTooLarge);
+                return QCborStreamReader::Error;
+            }
+            offset += size;
+            stringRemaining = qint64(value);
+        }
+        break;
+
+    case ReadingDefiniteString:
+        break;
+
+    case DefiniteStringRead:
+        advance(0, true);
+        return QCborStreamReader::EndOfString;
+    }
+
+    qsizetype pieceSize = qsizetype(qMin<qint64>(stringRemaining, MaxStringPieceSize));
+    if (!ensureBytes(offset + pieceSize)) {
+        if (stringState == ReadingChunks && offset)
+            stringRemaining = 0;    // decode the chunk's header again
+        lastError = { QCborError::EndOfFile };
+        return QCborStreamReader::Error;
+    }
+    *data = buffer.constData() + bufferPos + offset;
+    if (pieceSize < stringRemaining && q->type_ == QCborStreamReader::TextString)
+        pieceSize = completeUtf8Length(*data, pieceSize);
+    *len = pieceSize;
+    bufferPos += offset + pieceSize;
+    stringRemaining -= pieceSize;
+    if (indefinite)
+        stringState = ReadingChunks;
+    else
+        stringState = stringRemaining ? ReadingDefiniteString : DefiniteStringRead;
+    return QCborStreamReader::Ok;
+}
+
+/*!
+    \internal
+
+    Skips the current element, including the contents of containers and
+    all chunks of strings.
+*/
+bool QCborStreamReaderPrivate::skip(int maxRecursion)
+{
+    QCborStreamReader *q = q_ptr;
+    switch (q->type()) {
+    case QCborStreamReader::Invalid:
+        if (atContainerEnd)
+            lastError = { QCborError::AdvancePastEnd };
+        return false;
+
+    case QCborStreamReader::Array:
+    case QCborStreamReader::Map:
+        if (maxRecursion < 0) {
+            handleError(QCborError::NestingTooDeep);
+            return false;
+        }
+        q->enterContainer();
+        while (lastError == QCborError::NoError && q->hasNext()) {
+            if (!skip(maxRecursion - 1))
+                return false;
+        }
+        return lastError == QCborError::NoError && q->leaveContainer();
+
+    case QCborStreamReader::ByteString:
+    case QCborStreamReader::TextString: {
+        const char *data;
+        qsizetype len;
+        QCborStreamReader::StringResultCode r;
+        while ((r = readStringChunk(&data, &len)) == QCborStreamReader::Ok)
+            ;
+        return r == QCborStreamReader::EndOfString;
+    }
+
+    case QCborStreamReader::Tag:
+        // the tag and the tagged item are a single element of the container
+        if (maxRecursion < 0) {
+            handleError(QCborError::NestingTooDeep);
+            return false;
+        }
+        advance(headerSize, false);
+        return skip(maxRecursion - 1);
+
+    default:
+        advance(headerSize, true);
+        return true;
+    }
+}
+
+QString QCborStreamReaderPrivate::readAllString()
+{
+    QString result;
+    auto r = q_ptr->readString();
+    while (r.status == QCborStreamReader::Ok) {
+        result += r.data;
+        r = q_ptr->readString();
+    }
+    return result;
+}
+
+QByteArray QCborStreamReaderPrivate::readAllByteArray()
+{
+    QByteArray result;
+    auto r = q_ptr->readByteArray();
+    while (r.status == QCborStreamReader::Ok) {
+        result += r.data;
+        r = q_ptr->readByteArray();
+    }
+    return result;
+}
+
+static QString jsonKey(const QJsonValue &key)
+{
+    switch (key.type()) {
+    case QJsonValue::String:
+        return key.toString();
+    case QJsonValue::Double:
+        return QString::number(key.toDouble(), 'g', QLocale::FloatingPointShortest);
+    case QJsonValue::Bool:
+        return key.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QJsonValue::Array:
+        return QString::fromUtf8(QJsonDocument(key.toArray()).toJson(QJsonDocument::Compact));
+    case QJsonValue::Object:
+        return QString::fromUtf8(QJsonDocument(key.toObject()).toJson(QJsonDocument::Compact));
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        break;
+    }
+    return QStringLiteral("null");
+}
+
+QJsonValue QCborStreamReaderPrivate::readJsonValue(int depth)
+{
+    QCborStreamReader *q = q_ptr;
+    if (depth > MaxConversionDepth) {
+        handleError(QCborError::NestingTooDeep);
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    QJsonValue result;
+    switch (q->type()) {
+    case QCborStreamReader::UnsignedInteger:
+        result = double(q->value64);
+        break;
+    case QCborStreamReader::NegativeInteger:
+        result = -1. - double(q->value64);
+        break;
+    case QCborStreamReader::ByteString:
+        return QString::fromLatin1(readAllByteArray().toBase64(QByteArray::Base64UrlEncoding
+                                                               | QByteArray::OmitTrailingEquals));
+    case QCborStreamReader::TextString:
+        return readAllString();
+    case QCborStreamReader::Array: {
+        QJsonArray array;
+        q->enterContainer();
+        while (lastError == QCborError::NoError && q->hasNext())
+            array.append(readJsonValue(depth + 1));
+        if (lastError == QCborError::NoError)
+            q->leaveContainer();
+        return array;
+    }
+    case QCborStreamReader::Map: {
+        QJsonObject object;
+        q->enterContainer();
+        while (lastError == QCborError::NoError && q->hasNext()) {
+            const QString key = q->isString() ? readAllString() : jsonKey(readJsonValue(depth + 1));
+            const QJsonValue value = readJsonValue(depth + 1);
+            if (lastError == QCborError::NoError)
+                object.insert(key, value);
+        }
+        if (lastError == QCborError::NoError)
+            q->leaveContainer();
+        return object;
+    }
+    case QCborStreamReader::Tag:
+        // JSON has no tags: convert the tagged item itself
+        advance(headerSize, false);
+        return readJsonValue(depth + 1);
+    case QCborStreamReader::SimpleType:
+        if (q->isBool())
+            result = q->toBool();
+        break;
+    case QCborStreamReader::Float16:
+        result = double(q->toFloat16());
+        break;
+    case QCborStreamReader::Float:
+        result = double(q->toFloat());
+        break;
+    case QCborStreamReader::Double:
+        result = q->toDouble();
+        break;
+    case QCborStreamReader::Invalid:
+        if (atContainerEnd)
+            lastError = { QCborError::AdvancePastEnd };
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    advance(headerSize, true);
+    return result;
+}
+
+QVariant QCborStreamReaderPrivate::readVariant(int depth)
+{
+    QCborStreamReader *q = q_ptr;
+    if (depth > MaxConversionDepth) {
+        handleError(QCborError::NestingTooDeep);
+        return QVariant();
+    }
+
+    QVariant result;
+    switch (q->type()) {
+    case QCborStreamReader::UnsignedInteger:
+        if (q->value64 <= quint64((std::numeric_limits<qint64>::max)()))
+            result = qint64(q->value64);
+        else
+            result = q->value64;
+        break;
+    case QCborStreamReader::NegativeInteger:
+        if (q->value64 <= quint64((std::numeric_limits<qint64>::max)()))
+            result = -1 - qint64(q->value64);
+        else
+            result = -1. - double(q->value64);
+        break;
+    case QCborStreamReader::ByteString:
+        return readAllByteArray();
+    case QCborStreamReader::TextString:
+        return readAllString();
+    case QCborStreamReader::Array: {
+        QVariantList list;
+        q->enterContainer();
+        while (lastError == QCborError::NoError && q->hasNext())
+            list.append(readVariant(depth + 1));
+        if (lastError == QCborError::NoError)
+            q->leaveContainer();
+        return list;
+    }
+    case QCborStreamReader::Map: {
+        QVariantMap map;
+        q->enterContainer();
+        while (lastError == QCborError::NoError && q->hasNext()) {
+            const QString key = q->isString() ? readAllString() : readVariant(depth + 1).toString();
+            const QVariant value = readVariant(depth + 1);
+            if (lastError == QCborError::NoError)
+                map.insert(key, value);
+        }
+        if (lastError == QCborError::NoError)
+            q->leaveContainer();
+        return map;
+    }
+    case QCborStreamReader::Tag: {
+        const QCborTag tag = q->toTag();
+        advance(headerSize, false);
+        const QVariant tagged = readVariant(depth + 1);
+        // running out of data after the tagged item is not an error
+        if (lastError != QCborError::NoError && lastError != QCborError::EndOfFile)
+            return tagged;
+        if (tag == QCborKnownTags::DateTimeString && tagged.userType() == QMetaType::QString)
+            return QDateTime::fromString(tagged.toString(), Qt::ISODateWithMs);
+        if (tag == QCborKnownTags::UnixTime_t && tagged.canConvert<double>())
+            return QDateTime::fromMSecsSinceEpoch(qint64(tagged.toDouble() * 1000), Qt::UTC);
+        if (tag == QCborKnownTags::Url && tagged.userType() == QMetaType::QString)
+            return QUrl(tagged.toString());
+        if (tag == QCborKnownTags::Uuid && tagged.userType() == QMetaType::QByteArray
+                && tagged.toByteArray().size() == 16)
+            return QUuid::fromRfc4122(tagged.toByteArray());
+        return tagged;
+    }
+    case QCborStreamReader::SimpleType:
+        if (q->isBool())
+            result = q->toBool();
+        else if (q->isNull())
+            result = QVariant::fromValue(nullptr);
+        break;
+    case QCborStreamReader::Float16:
+        result = float(q->toFloat16());
+        break;
+    case QCborStreamReader::Float:
+        result = q->toFloat();
+        break;
+    case QCborStreamReader::Double:
+        result = q->toDouble();
+        break;
+    case QCborStreamReader::Invalid:
+        if (atContainerEnd)
+            lastError = { QCborError::AdvancePastEnd };
+        return QVariant();
+    }
+
+    advance(headerSize, true);
+    return result;
+}
+
+/*!
+    \class QCborStreamReader
+    \inmodule QtCore
+    \reentrant
+    \since 5.12
+
+    \brief The QCborStreamReader class is a simple CBOR stream decoder,
+    operating on either a QByteArray or QIODevice.
+
+    \ingroup json
+
+    QCborStreamReader decodes Concise Binary Object Representation (CBOR,
+    RFC 7049) data one element at a time, in the same pull style as
+    QXmlStreamReader. The application inspects the current element with
+    type() and the \c{is} and \c{to} functions, then calls next() to
+    advance to the following one. Arrays and maps are entered with
+    enterContainer(); their elements are read while hasNext() returns
+    \c true, and leaveContainer() continues with the element after the
+    container. Strings are read in chunks with readString() and
+    readByteArray(), which advance past the string once they return
+    EndOfString.
+
+    \snippet code/src_corelib_serialization_qcborstream.cpp 1
+
+    readJsonValue() and readVariant() read a whole element, including the
+    contents of arrays and maps, and convert it.
+
+    Data can be supplied incrementally. If the reader reaches the end of
+    the available data before an element is complete, lastError() returns
+    QCborError::EndOfFile; after more data has been supplied with addData(),
+    call reparse() to continue. When reading from a QIODevice, the reader
+    reads from the device as needed. Strings and chunks longer than 64 KiB
+    are returned in several pieces, so that they need not be buffered in
+    full; text strings are only split between characters.
+
+    When constructed from a QByteArray, the reader shares the array's data
+    instead of copying it, and strings read with readByteArray() are copied
+    straight out of it.
+
+    \sa QCborStreamWriter, QXmlStreamReader
+*/
+
+/*!
+    \enum QCborStreamReader::Type
+
+    This enum describes the type of the current element.
+
+    \value UnsignedInteger  An unsigned integer; see toUnsignedInteger().
+    \value NegativeInteger  A negative integer; see toNegativeInteger().
+    \value ByteString       A byte string; see readByteArray().
+    \value ByteArray        Same as ByteString.
+    \value TextString       A UTF-8 text string; see readString().
+    \value String           Same as TextString.
+    \value Array            An array; see enterContainer().
+    \value Map              A map of key-value pairs; see enterContainer().
+    \value Tag              A tag applying to the next element; see toTag().
+    \value SimpleType       A simple type, including booleans and null; see toSimpleType().
+    \value HalfFloat        A half-precision floating point number; see toFloat16().
+    \value Float16          Same as HalfFloat.
+    \value Float            A single-precision floating point number; see toFloat().
+    \value Double           A double-precision floating point number; see toDouble().
+    \value Invalid          No element could be decoded, because of an error,
+                            the end of the data or the end of a container.
+*/
+
+/*!
+    \enum QCborStreamReader::StringResultCode
+
+    This enum is the status of a chunk returned by readString() and
+    readByteArray().
+
+    \value EndOfString  There are no more chunks; the reader advanced past the string.
+    \value Ok           The chunk was read successfully.
+    \value Error        An error occurred or more data is needed; see lastError().
+*/
+
+/*!
+    \class QCborStreamReader::StringResult
+    \inmodule QtCore
+
+    This class holds a chunk of a string in \c data and the status of the
+    read in \c status.
+*/
+
+/*!
+    Creates a reader without data. Use addData() or setDevice() to supply
+    data.
+*/
+QCborStreamReader::QCborStreamReader()
+    : value64(0), d_ptr(new QCborStreamReaderPrivate(this)), type_(Invalid)
+{
+    d_ptr->preparse();
+}
+
+/*!
+    Creates a reader for the \a len bytes starting at \a data. The data is
+    copied.
+*/
+QCborStreamReader::QCborStreamReader(const char *data, qsizetype len)
+    : QCborStreamReader(QByteArray(data, int(len)))
+{
+}
+
+/*!
+    \overload
+*/
+QCborStreamReader::QCborStreamReader(const quint8 *data, qsizetype len)
+    : QCborStreamReader(QByteArray(reinterpret_cast<const char *>(data), int(len)))
+{
+}
+
+/*!
+    \overload
+
+    Creates a reader for \a data, which is shared rather than copied.
+*/
+QCborStreamReader::QCborStreamReader(const QByteArray &data)
+    : value64(0), d_ptr(new QCborStreamReaderPrivate(this)), type_(Invalid)
+{
+    d_ptr->buffer = data;
+    d_ptr->preparse();
+}
+
+/*!
+    Creates a reader that reads from \a device, which must already be open
+    for reading.
+*/
+QCborStreamReader::QCborStreamReader(QIODevice *device)
+    : value64(0), d_ptr(new QCborStreamReaderPrivate(this)), type_(Invalid)
+{
+    setDevice(device);
+}
+
+/*!
+    Destroys this reader.
+*/
+QCborStreamReader::~QCborStreamReader()
+{
+}
+
+/*!
+    Makes the reader read from \a device, discarding any data and state
+    it had.
+
+    \sa device(), clear()
+*/
+void QCborStreamReader::setDevice(QIODevice *device)
+{
+    Q_D(QCborStreamReader);
+    d->buffer.clear();
+    d->bufferPos = 0;
+    d->bufferOffset = device ? device->pos() : 0;
+    d->device = device;
+    d->containers.clear();
+    d->lastError = { QCborError::NoError };
+    d->preparse();
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if it reads from
+    a byte array.
+*/
+QIODevice *QCborStreamReader::device() const
+{
+    Q_D(const QCborStreamReader);
+    return d->device;
+}
+
+/*!
+    Appends \a data to the data to be decoded. If the reader previously
+    stopped at the end of the data, call reparse() afterwards.
+
+    This function must not be used when reading from a device.
+*/
+void QCborStreamReader::addData(const QByteArray &data)
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT_X(!d->device, "QCborStreamReader::addData", "Cannot add data to a reader with a device");
+    d->buffer += data;
+}
+
+/*!
+    \overload
+
+    Appends the \a len bytes starting at \a data.
+*/
+void QCborStreamReader::addData(const char *data, qsizetype len)
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT_X(!d->device, "QCborStreamReader::addData", "Cannot add data to a reader with a device");
+    d->buffer.append(data, int(len));
+}
+
+/*!
+    \fn void QCborStreamReader::addData(const quint8 *data, qsizetype len)
+    \overload
+*/
+
+/*!
+    Decodes the current element again after more data has become
+    available, clearing a QCborError::EndOfFile error. In the middle of a
+    string, only the error is cleared, so that reading can continue with
+    readString() or readByteArray().
+*/
+void QCborStreamReader::reparse()
+{
+    Q_D(QCborStreamReader);
+    if (d->lastError != QCborError::EndOfFile)
+        return;
+    if (d->stringState == QCborStreamReaderPrivate::NotReadingString)
+        d->preparse();
+    else
+        d->lastError = { QCborError::NoError };
+}
+
+/*!
+    Discards all data and state and unsets the device.
+
+    \sa setDevice()
+*/
+void QCborStreamReader::clear()
+{
+    setDevice(nullptr);
+}
+
+/*!
+    Returns to the beginning of the data, resetting all state. When reading
+    from a device, the device is reset too.
+*/
+void QCborStreamReader::reset()
+{
+    Q_D(QCborStreamReader);
+    if (d->device) {
+        d->device->reset();
+        setDevice(d->device);
+        return;
+    }
+    d->bufferPos = 0;
+    d->containers.clear();
+    d->lastError = { QCborError::NoError };
+    d->preparse();
+}
+
+/*!
+    Returns the last error, or QCborError::NoError.
+*/
+QCborError QCborStreamReader::lastError()
+{
+    Q_D(const QCborStreamReader);
+    return d->lastError;
+}
+
+/*!
+    Returns the offset in the stream of the current element.
+*/
+qint64 QCborStreamReader::currentOffset() const
+{
+    Q_D(const QCborStreamReader);
+    return d->bufferOffset + d->bufferPos;
+}
+
+/*!
+    Returns the number of containers that have been entered and not left.
+*/
+int QCborStreamReader::containerDepth() const
+{
+    Q_D(const QCborStreamReader);
+    return d->containers.size();
+}
+
+/*!
+    Returns the type of the innermost container that has been entered, or
+    Invalid at the top level.
+*/
+QCborStreamReader::Type QCborStreamReader::parentContainerType() const
+{
+    Q_D(const QCborStreamReader);
+    return d->containers.isEmpty() ? Invalid : d->containers.last().type;
+}
+
+/*!
+    Returns \c true if the current container has more elements. At the top
+    level, returns \c true if an element could be decoded or more data is
+    needed to decode it.
+*/
+bool QCborStreamReader::hasNext() const Q_DECL_NOTHROW
+{
+    Q_D(const QCborStreamReader);
+    if (d->lastError != QCborError::NoError && d->lastError != QCborError::EndOfFile)
+        return false;
+    if (d->containers.isEmpty())
+        return type_ != Invalid || d->bufferPos < d->buffer.size();
+    return !d->atContainerEnd;
+}
+
+/*!
+    Advances past the current element, including all elements of a
+    container and all chunks of a string, and returns \c true on success.
+    Containers nested deeper than \a maxRecursion are reported as
+    QCborError::NestingTooDeep.
+
+    A tag is skipped together with the element it tags; the tag counts
+    towards \a maxRecursion like a container.
+*/
+bool QCborStreamReader::next(int maxRecursion)
+{
+    Q_D(QCborStreamReader);
+    return d->skip(maxRecursion);
+}
+
+/*!
+    Returns \c true if the length of the current string, array or map is
+    encoded in the stream, \c false for indefinite-length elements.
+
+    \sa length()
+*/
+bool QCborStreamReader::isLengthKnown() const Q_DECL_NOTHROW
+{
+    Q_D(const QCborStreamReader);
+    return !d->indefinite;
+}
+
+/*!
+    Returns the length of the current string in bytes, or the number of
+    elements of the current array or pairs of the current map. Must only
+    be called if isLengthKnown() returns \c true.
+*/
+quint64 QCborStreamReader::length() const
+{
+    Q_ASSERT(isLengthKnown());
+    return value64;
+}
+
+/*!
+    Enters the current array or map, making its first element current.
+    Returns \c true on success.
+
+    \sa leaveContainer(), hasNext()
+*/
+bool QCborStreamReader::enterContainer()
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT(isContainer());
+    if (!isContainer())
+        return false;
+
+    qint64 remaining = -1;
+    if (!d->indefinite) {
+        quint64 items = value64;
+        if (isMap())
+            items *= 2;
+        if (items > quint64((std::numeric_limits<qint64>::max)())
+                || (isMap() && value64 > items)) {
+            d->handleError(QCborError::DataTooLarge);
+            return false;
+        }
+        remaining = qint64(items);
+    }
+    d->containers.append({ type(), remaining });
+    d->bufferPos += d->headerSize;
+    d->preparse();
+    return true;
+}
+
+/*!
+    Leaves the current container after its last element has been read and
+    makes the element after the container current. Returns \c true on
+    success.
+
+    \sa enterContainer(), hasNext()
+*/
+bool QCborStreamReader::leaveContainer()
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT(!d->containers.isEmpty());
+    if (d->containers.isEmpty() || !d->atContainerEnd)
+        return false;
+
+    // skip the break byte of indefinite-length containers
+    const qsizetype count = d->containers.last().remaining < 0 ? 1 : 0;
+    d->containers.removeLast();
+    d->advance(count, true);
+    return true;
+}
+
+/*!
+    Reads the next chunk of the current text string. The result's status is
+    Ok if a chunk was read; EndOfString if the string is complete, in which
+    case the reader has advanced to the next element; or Error.
+
+    \sa readByteArray()
+*/
+QCborStreamReader::StringResult<QString> QCborStreamReader::readString()
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT(isString());
+    StringResult<QString> result;
+    const char *data;
+    qsizetype len;
+    result.status = d->readStringChunk(&data, &len);
+    if (result.status == Ok) {
+        const QUtf8::ValidUtf8Result validation = QUtf8::isValidUtf8(data, len);
+        if (!validation.isValidUtf8) {
+            d->handleError(QCborError::InvalidUtf8String);
+            result.status = Error;
+        } else if (validation.isValidAscii) {
+            result.data = QString::fromLatin1(data, int(len));
+        } else {
+            result.data = QString::fromUtf8(data, int(len));
+        }
+    }
+    return result;
+}
+
+/*!
+    Reads the next chunk of the current byte string. The result's status is
+    Ok if a chunk was read; EndOfString if the string is complete, in which
+    case the reader has advanced to the next element; or Error.
+
+    \sa readString()
+*/
+QCborStreamReader::StringResult<QByteArray> QCborStreamReader::readByteArray()
+{
+    Q_D(QCborStreamReader);
+    Q_ASSERT(isByteArray());
+    StringResult<QByteArray> result;
+    const char *data;
+    qsizetype len;
+    result.status = d->readStringChunk(&data, &len);
+    if (result.status == Ok)
+        result.data = QByteArray(data, int(len));
+    return result;
+}
+
+/*!
+    Reads the current element, including the contents of arrays and maps,
+    converts it to QJsonValue and advances past it.
+
+    Integers and floating point numbers become doubles, byte strings become
+    Base64url-encoded strings, and tags are ignored. Map keys that are not
+    text strings are converted to strings. Undefined and other simple types
+    become null. If an error occurs, lastError() is set and the result is
+    incomplete.
+
+    \sa readVariant(), QCborStreamWriter::appendJsonValue()
+*/
+QJsonValue QCborStreamReader::readJsonValue()
+{
+    Q_D(QCborStreamReader);
+    return d->readJsonValue(0);
+}
+
+/*!
+    Reads the current element, including the contents of arrays and maps,
+    converts it to QVariant and advances past it.
+
+    Integers become \c qint64 (or \c quint64 or \c double if they are out
+    of range), strings become QString or QByteArray, arrays become
+    QVariantList and maps become QVariantMap. The tags that
+    QCborStreamWriter::appendVariant() writes for QDateTime, QUrl and QUuid
+    are converted back to those types. Null becomes a \c std::nullptr_t
+    variant and undefined a null QVariant. If an error occurs, lastError()
+    is set and the result is incomplete.
+
+    \sa readJsonValue(), QCborStreamWriter::appendVariant()
+*/
+QVariant QCborStreamReader::readVariant()
+{
+    Q_D(QCborStreamReader);
+    return d->readVariant(0);
+}
+
+QT_END_NAMESPACE
@@ -45,6 +45,7 @@
 #include "qjsonparser_p.h"
 #include "qjson_p.h"
 #include "private/qutfcodec_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -256,8 +257,37 @@ void Parser::eatBOM()
         json += 3;
 }
 
+#ifdef __SSE2__
+static inline const char *simdSkipWhitespace(const char *json, const char *end)
+{
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i carriageReturn = _mm_set1_epi8(Return);
+
+    // do sixteen characters at a time
+    for ( ; end - json >= 16; json += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space), _mm_cmpeq_epi8(data, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed), _mm_cmpeq_epi8(data, carriageReturn)));
+
+        // n has a bit set for every character that is not whitespace
+        uint n = ~uint(_mm_movemask_epi8(ws)) & 0xffff;
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+    return json;
+}
+#endif
+
 bool Parser::eatSpace()
 {
+#ifdef __SSE2__
+    // compact documents have no whitespace between tokens at all, so only
+    // go wide once we know we are looking at some (usually indentation)
+    if (end - json >= 16 && uchar(*json) <= Space)
+        json = simdSkipWhitespace(json, end);
+#endif
     while (json < end) {
         if (*json > Space)
             break;
@@ -912,6 +942,183 @@ static inline bool scanUtf8Char(const char *&json, const char *end, uint *result
     return true;
 }
 
+/*
+    Returns the number of characters starting at \a json that can be copied
+    verbatim into a string: printable US-ASCII other than the quotation mark
+    and the backslash. Anything else needs to go through scanEscapeSequence()
+    or scanUtf8Char().
+*/
+static inline int scanPlainAscii(const char *json, const char *end)
+{
+    const char *src = json;
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i firstPrintable = _mm_set1_epi8(0x20);
+
+    // do sixteen characters at a time
+    for ( ; end - src >= 16; src += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // the comparison is signed, so it catches both control characters
+        // and the bytes with the high bit set (non-ASCII)
+        __m128i special = _mm_or_si128(_mm_cmplt_epi8(data, firstPrintable),
+                                       _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                                    _mm_cmpeq_epi8(data, backslash)));
+        uint n = _mm_movemask_epi8(special);
+        if (n)
+            return int(src - json) + qCountTrailingZeroBits(n);
+    }
+#endif
+    for ( ; src < end; ++src) {
+        uchar c = *src;
+        if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\')
+            break;
+    }
+    return int(src - json);
+}
+
+/*
+    Returns \a len, shortened by the multi-byte sequence at the end of the
+    valid UTF-8 in \a str, if that sequence is not complete.
+*/
+static inline int completeUtf8Length(const char *str, int len)
+{
+    for (int i = 1; i <= qMin(3, len); ++i) {
+        const uchar c = str[len - i];
+        if (c < 0x80)
+            break;
+        if (c >= 0xc0) {
+            const int needed = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : 2;
+            return needed > i ? len - i : len;
+        }
+    }
+    return len;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+/*
+    Validates UTF-8 sixteen bytes at a time, using the three nibble lookup
+    tables from Keiser and Lemire, "Validating UTF-8 In Less Than One
+    Instruction Per Byte". Each table maps a nibble to the set of errors it
+    may take part in; a pair of bytes is invalid when the high and low nibble
+    of the first byte and the high nibble of the second one agree on an error.
+*/
+QT_FUNCTION_TARGET(SSSE3)
+static int scanValidUtf8Ssse3(const char *json, const char *end)
+{
+    enum : uchar {
+        TooShort = 1 << 0,      // 11______ 0_______ or 11______ 11______
+        TooLong = 1 << 1,       // 0_______ 10______
+        Overlong3 = 1 << 2,     // 11100000 100_____
+        TooLarge = 1 << 3,      // 11110100 1001____ and above
+        Surrogate = 1 << 4,     // 11101101 101_____
+        Overlong2 = 1 << 5,     // 1100000_ 10______
+        TooLarge1000 = 1 << 6,  // 11110101 1000____ and above
+        Overlong4 = 1 << 6,     // 11110000 1000____
+        TwoConts = 1 << 7,      // 10______ 10______
+        Carry = TooShort | TooLong | TwoConts
+    };
+
+    const __m128i firstByteHigh = _mm_setr_epi8(
+                TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+                TwoConts, TwoConts, TwoConts, TwoConts,
+                TooShort | Overlong2,
+                TooShort,
+                TooShort | Overlong3 | Surrogate,
+                char(TooShort | TooLarge | TooLarge1000 | Overlong4));
+    const __m128i firstByteLow = _mm_setr_epi8(
+                char(Carry | Overlong3 | Overlong2 | Overlong4),
+                char(Carry | Overlong2),
+                char(Carry),
+                char(Carry),
+                char(Carry | TooLarge),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000 | Surrogate),
+                char(Carry | TooLarge | TooLarge1000),
+                char(Carry | TooLarge | TooLarge1000));
+    const __m128i secondByteHigh = _mm_setr_epi8(
+                TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+                char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4),
+                char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge),
+                char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+                char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+                TooShort, TooShort, TooShort, TooShort);
+
+    const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControl = _mm_set1_epi8(0x1f);
+    const __m128i thirdByte = _mm_set1_epi8(char(0xe0 - 0x80));
+    const __m128i fourthByte = _mm_set1_epi8(char(0xf0 - 0x80));
+    const __m128i highBit = _mm_set1_epi8(char(0x80));
+
+    // the byte before json was either ASCII or the end of a complete sequence
+    __m128i previous = _mm_setzero_si128();
+    const char *src = json;
+    for ( ; end - src >= 16; src += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // leave quotes, escapes and control characters to the caller
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(data, lastControl), data),
+                                       _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                                    _mm_cmpeq_epi8(data, backslash)));
+        if (_mm_movemask_epi8(special))
+            break;
+
+        const __m128i prev1 = _mm_alignr_epi8(data, previous, 15);
+        __m128i error = _mm_shuffle_epi8(firstByteHigh, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask));
+        error = _mm_and_si128(error, _mm_shuffle_epi8(firstByteLow, _mm_and_si128(prev1, nibbleMask)));
+        error = _mm_and_si128(error, _mm_shuffle_epi8(secondByteHigh, _mm_and_si128(_mm_srli_epi16(data, 4), nibbleMask)));
+
+        // the third and fourth byte of a sequence must be continuation bytes
+        // (which the tables flag as TwoConts), and nothing else may be
+        const __m128i prev2 = _mm_alignr_epi8(data, previous, 14);
+        const __m128i prev3 = _mm_alignr_epi8(data, previous, 13);
+        __m128i mustContinue = _mm_or_si128(_mm_subs_epu8(prev2, thirdByte),
+                                            _mm_subs_epu8(prev3, fourthByte));
+        error = _mm_xor_si128(error, _mm_and_si128(mustContinue, highBit));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+            break;
+
+        previous = data;
+    }
+
+    // let scanUtf8Char() report the exact error, or finish a sequence that
+    // continues in the block we did not accept
+    return completeUtf8Length(json, int(src - json));
+}
+#endif
+
+/*
+    Returns the number of bytes starting at \a json that are valid UTF-8 and
+    contain neither quotation marks, backslashes nor control characters, so
+    that they can be decoded without further checks. Only whole blocks of
+    sixteen bytes are considered; the caller falls back to scanUtf8Char() for
+    the remainder, and when the CPU cannot validate in SIMD.
+*/
+static inline int scanValidUtf8(const char *json, const char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return scanValidUtf8Ssse3(json, end);
+#endif
+    Q_UNUSED(json);
+    Q_UNUSED(end);
+    return 0;
+}
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+void qt_from_latin1(ushort *dst, const char *str, size_t size) Q_DECL_NOTHROW;
+#endif
+
 bool Parser::parseString(bool *latin1)
 {
     *latin1 = true;
@@ -927,6 +1134,19 @@ bool Parser::parseString(bool *latin1)
 
     BEGIN << "parse string stringPos=" << stringPos << json;
     while (json < end) {
+        // copy runs of characters that need neither unescaping nor UTF-8
+        // decoding in one go, as long as the string still fits a latin1string
+        int run = qMin(scanPlainAscii(json, end), int(0x7fff - (json - start)));
+        if (run > 0) {
+            int pos = reserveSpace(run);
+            if (pos < 0)
+                return false;
+            memcpy(data + pos, json, run);
+            json += run;
+            if (json >= end)
+                break;
+        }
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -979,6 +1199,48 @@ bool Parser::parseString(bool *latin1)
     current = outStart + sizeof(int);
 
     while (json < end) {
+        int run = scanPlainAscii(json, end);
+        if (run > 0) {
+            int pos = reserveSpace(2 * run);
+            if (pos < 0)
+                return false;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            qt_from_latin1(reinterpret_cast<ushort *>(data + pos), json, run);
+#else
+            QJsonPrivate::qle_ushort *dst = reinterpret_cast<QJsonPrivate::qle_ushort *>(data + pos);
+            for (int i = 0; i < run; ++i)
+                dst[i] = uchar(json[i]);
+#endif
+            json += run;
+            if (json >= end)
+                break;
+        }
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        // decode runs of multi-byte characters that were validated in SIMD
+        // in one go; the string can no longer be written as latin1 anyway
+        run = uchar(*json) >= 0x80 ? scanValidUtf8(json, end) : 0;
+        if (run > 0) {
+            int pos = reserveSpace(2 * run);
+            if (pos < 0)
+                return false;
+            QChar *dst = reinterpret_cast<QChar *>(data + pos);
+            QChar *out = dst;
+            const char *runEnd = json + run;
+            // QUtf8::convertToUnicode() drops a leading BOM, but a U+FEFF
+            // inside a string is content
+            while (runEnd - json >= 3 && uchar(json[0]) == 0xef
+                   && uchar(json[1]) == 0xbb && uchar(json[2]) == 0xbf) {
+                *out++ = QChar(QChar::ByteOrderMark);
+                json += 3;
+            }
+            out = QUtf8::convertToUnicode(out, json, int(runEnd - json));
+            current = pos + 2 * int(out - dst);
+            json = runEnd;
+            continue;
+        }
+#endif
+
         uint ch = 0;
         if (*json == '"')
             break;
@@ -0,0 +1,1064 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader.h"
+
+#include "qjsonarray.h"
+#include "qjsonobject.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qlocale_tools_p.h>
+#include <private/qutfcodec_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// how much to read from the device at least when more data is needed
+const qint64 ReadChunkSize = 16384;
+// consumed data is dropped from the buffer once there is this much of it
+const int CompactThreshold = 4096;
+}
+
+class QJsonStreamReaderPrivate
+{
+    Q_DECLARE_TR_FUNCTIONS(QJsonStreamReader)
+public:
+    enum State {
+        BeforeDocument,         // StartDocument comes next
+        ExpectValue,            // the top-level value, or the value after ':' or ','
+        ExpectValueOrEnd,       // after '['
+        ExpectNameOrEnd,        // after '{'
+        ExpectName,             // after ',' in an object
+        ExpectColon,            // after a member name
+        ExpectCommaOrEnd,       // after a value in an array or object
+        AfterTopLevelValue,     // EndDocument comes next
+        AfterDocument
+    };
+
+    enum ParseResult {
+        TokenRead,
+        NeedMoreData,
+        ParseError
+    };
+
+    struct Container {
+        char bracket;           // '{' or '['
+        QString name;           // the member name of the container in its parent
+    };
+
+    QJsonStreamReaderPrivate(QJsonStreamReader *q)
+        : q_ptr(q)
+    {}
+
+    void init()
+    {
+        buffer.clear();
+        pos = 0;
+        offset = 0;
+        containers.clear();
+        state = BeforeDocument;
+        type = QJsonStreamReader::NoToken;
+        error = QJsonStreamReader::NoError;
+        errorString.clear();
+        text.clear();
+        currentName.clear();
+        dataComplete = false;
+    }
+
+    bool inputFinished() const
+    {
+        // data passed to the constructor is the whole input, addData() may
+        // be followed by more
+        return device ? device->atEnd() : dataComplete;
+    }
+    bool fetchMore();
+    void compact();
+
+    ParseResult parseError(const QString &message)
+    {
+        errorString = message;
+        return ParseError;
+    }
+    ParseResult parseNext();
+    ParseResult parseValue();
+    ParseResult parseName();
+    ParseResult parseString(QString *out);
+    ParseResult parseNumber();
+    ParseResult parseLiteral(const char *literal, int length);
+    ParseResult endContainer(char bracket);
+    void valueDone()
+    {
+        state = containers.isEmpty() ? AfterTopLevelValue : ExpectCommaOrEnd;
+    }
+    bool skipWhitespace()
+    {
+        const char *data = buffer.constData();
+        const int size = buffer.size();
+        while (pos < size) {
+            switch (data[pos]) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                ++pos;
+                continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    QJsonStreamReader *q_ptr;
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    bool dataComplete = false;      // buffer holds all input, no device
+    int pos = 0;                    // first unconsumed byte in buffer
+    qint64 offset = 0;              // stream offset of the start of buffer
+    QVarLengthArray<Container, 16> containers;
+    State state = BeforeDocument;
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QString errorString;
+    QString text;                   // Name and String tokens, or the literal of a Number
+    QString currentName;
+    double number = 0;
+    bool boolean = false;
+};
+
+/*!
+    \internal
+
+    Reads more data from the device into the buffer. Returns \c false if
+    no more data is available at the moment.
+*/
+bool QJsonStreamReaderPrivate::fetchMore()
+{
+    if (!device)
+        return false;
+    // grow geometrically, so that a token spanning many reads is not
+    // rescanned once per chunk
+    const qint64 wanted = qMax(ReadChunkSize, qint64(buffer.size() - pos));
+    const int oldSize = buffer.size();
+    buffer.resize(oldSize + int(wanted));
+    const qint64 readBytes = device->read(buffer.data() + oldSize, wanted);
+    buffer.resize(oldSize + int(qMax(readBytes, Q_INT64_C(0))));
+    return readBytes > 0;
+}
+
+/*!
+    \internal
+
+    Drops the consumed part of the buffer, so that memory use depends on
+    the size of the largest token rather than the size of the document.
+*/
+void QJsonStreamReaderPrivate::compact()
+{
+    if (pos < CompactThreshold || pos < buffer.size() / 2)
+        return;
+    if (pos == buffer.size())
+        buffer.clear();
+    else
+        buffer.remove(0, pos);
+    offset += pos;
+    pos = 0;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::parseNext()
+{
+    switch (state) {
+    case BeforeDocument:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        type = QJsonStreamReader::StartDocument;
+        state = ExpectValue;
+        return TokenRead;
+
+    case AfterTopLevelValue:
+        type = QJsonStreamReader::EndDocument;
+        state = AfterDocument;
+        return TokenRead;
+
+    case AfterDocument:
+        // another document may follow, as in JSON Lines
+        if (!skipWhitespace())
+            return NeedMoreData;
+        type = QJsonStreamReader::StartDocument;
+        state = ExpectValue;
+        return TokenRead;
+
+    case ExpectValue:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        return parseValue();
+
+    case ExpectValueOrEnd:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        if (buffer.at(pos) == ']')
+            return endContainer(']');
+        return parseValue();
+
+    case ExpectNameOrEnd:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        if (buffer.at(pos) == '}')
+            return endContainer('}');
+        return parseName();
+
+    case ExpectName:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        return parseName();
+
+    case ExpectColon:
+        if (!skipWhitespace())
+            return NeedMoreData;
+        if (buffer.at(pos) != ':')
+            return parseError(tr("missing name separator"));
+        ++pos;
+        if (!skipWhitespace())
+            return NeedMoreData;
+        return parseValue();
+
+    case ExpectCommaOrEnd: {
+        if (!skipWhitespace())
+            return NeedMoreData;
+        const char c = buffer.at(pos);
+        const char bracket = containers.last().bracket;
+        if (c == ',') {
+            ++pos;
+            if (!skipWhitespace())
+                return NeedMoreData;
+            return bracket == '{' ? parseName() : parseValue();
+        }
+        if (c == ']' || c == '}')
+            return endContainer(c);
+        return parseError(bracket == '{' ? tr("unterminated object")
+                                         : tr("unterminated array"));
+    }
+    }
+    Q_UNREACHABLE();
+    return ParseError;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::endContainer(char bracket)
+{
+    const char open = bracket == '}' ? '{' : '[';
+    if (containers.last().bracket != open)
+        return parseError(open == '{' ? tr("unterminated array") : tr("unterminated object"));
+    ++pos;
+    type = open == '{' ? QJsonStreamReader::EndObject : QJsonStreamReader::EndArray;
+    currentName = containers.last().name;
+    containers.removeLast();
+    valueDone();
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::parseName()
+{
+    if (buffer.at(pos) != '"')
+        return parseError(tr("illegal value"));
+    const ParseResult result = parseString(&text);
+    if (result != TokenRead)
+        return result;
+    type = QJsonStreamReader::Name;
+    currentName = text;
+    state = ExpectColon;
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::parseValue()
+{
+    ParseResult result;
+    switch (buffer.at(pos)) {
+    case '{':
+    case '[': {
+        const char bracket = buffer.at(pos);
+        ++pos;
+        const bool inObject = !containers.isEmpty() && containers.last().bracket == '{';
+        containers.append({ bracket, inObject ? currentName : QString() });
+        currentName.clear();
+        if (bracket == '{') {
+            type = QJsonStreamReader::StartObject;
+            state = ExpectNameOrEnd;
+        } else {
+            type = QJsonStreamReader::StartArray;
+            state = ExpectValueOrEnd;
+        }
+        return TokenRead;
+    }
+    case '"':
+        result = parseString(&text);
+        type = QJsonStreamReader::String;
+        break;
+    case 't':
+        result = parseLiteral("true", 4);
+        type = QJsonStreamReader::Bool;
+        boolean = true;
+        break;
+    case 'f':
+        result = parseLiteral("false", 5);
+        type = QJsonStreamReader::Bool;
+        boolean = false;
+        break;
+    case 'n':
+        result = parseLiteral("null", 4);
+        type = QJsonStreamReader::Null;
+        break;
+    case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        result = parseNumber();
+        type = QJsonStreamReader::Number;
+        break;
+    default:
+        return parseError(tr("illegal value"));
+    }
+
+    if (result == TokenRead) {
+        if (containers.isEmpty() || containers.last().bracket != '{')
+            currentName.clear();
+        valueDone();
+    }
+    return result;
+}
+
+QJsonStreamReaderPrivate::ParseResult
+QJsonStreamReaderPrivate::parseLiteral(const char *literal, int length)
+{
+    const int available = qMin(length, buffer.size() - pos);
+    if (memcmp(buffer.constData() + pos, literal, available) != 0)
+        return parseError(tr("illegal value"));
+    if (available < length)
+        return NeedMoreData;
+    pos += length;
+    return TokenRead;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::parseNumber()
+{
+    const char *start = buffer.constData() + pos;
+    const char *end = buffer.constData() + buffer.size();
+    const char *json = start;
+
+    // minus
+    if (json < end && *json == '-')
+        ++json;
+
+    // int = zero / ( digit1-9 *DIGIT )
+    const char *digits = json;
+    if (json < end && *json == '0') {
+        ++json;
+    } else {
+        while (json < end && *json >= '0' && *json <= '9')
+            ++json;
+    }
+    bool valid = json > digits;
+
+    // frac = decimal-point 1*DIGIT
+    if (json < end && *json == '.') {
+        ++json;
+        digits = json;
+        while (json < end && *json >= '0' && *json <= '9')
+            ++json;
+        valid = valid && json > digits;
+    }
+
+    // exp = e [ minus / plus ] 1*DIGIT
+    if (json < end && (*json == 'e' || *json == 'E')) {
+        ++json;
+        if (json < end && (*json == '-' || *json == '+'))
+            ++json;
+        digits = json;
+        while (json < end && *json >= '0' && *json <= '9')
+            ++json;
+        valid = valid && json > digits;
+    }
+
+    // the number might continue in data that has not arrived yet
+    if (json == end && !inputFinished())
+        return NeedMoreData;
+    if (!valid)
+        return parseError(tr("illegal number"));
+
+    bool ok;
+    int processed;
+    number = asciiToDouble(start, int(json - start), ok, processed);
+    if (!ok)
+        return parseError(tr("illegal number"));
+    text = QString::fromLatin1(start, int(json - start));
+    pos += int(json - start);
+    return TokenRead;
+}
+
+static inline int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+QJsonStreamReaderPrivate::ParseResult QJsonStreamReaderPrivate::parseString(QString *out)
+{
+    const char *data = buffer.constData();
+    const int size = buffer.size();
+
+    // find the end of the string before decoding anything
+    int end = pos + 1;
+    bool hasEscapes = false;
+    for (;;) {
+        if (end >= size)
+            return NeedMoreData;
+        const char c = data[end];
+        if (c == '"')
+            break;
+        if (c == '\\') {
+            hasEscapes = true;
+            end += 2;
+            continue;
+        }
+        if (uchar(c) < 0x20)
+            return parseError(tr("illegal value"));
+        ++end;
+    }
+
+    out->clear();
+    int runStart = pos + 1;
+    auto appendRun = [&](int runEnd) {
+        const QUtf8::ValidUtf8Result validation = QUtf8::isValidUtf8(data + runStart, runEnd - runStart);
+        if (!validation.isValidUtf8)
+            return false;
+        if (validation.isValidAscii)
+            out->append(QLatin1String(data + runStart, runEnd - runStart));
+        else
+            out->append(QString::fromUtf8(data + runStart, runEnd - runStart));
+        return true;
+    };
+
+    if (hasEscapes) {
+        int i = runStart;
+        while (i < end) {
+            if (data[i] != '\\') {
+                ++i;
+                continue;
+            }
+            if (!appendRun(i))
+                return parseError(tr("invalid UTF8 string"));
+            const char escaped = data[i + 1];
+            i += 2;
+            switch (escaped) {
+            case '"':
+            case '\\':
+            case '/':
+                out->append(QLatin1Char(escaped));
+                break;
+            case 'b':
+                out->append(QLatin1Char('\b'));
+                break;
+            case 'f':
+                out->append(QLatin1Char('\f'));
+                break;
+            case 'n':
+                out->append(QLatin1Char('\n'));
+                break;
+            case 'r':
+                out->append(QLatin1Char('\r'));
+                break;
+            case 't':
+                out->append(QLatin1Char('\t'));
+                break;
+            case 'u': {
+                if (i + 4 > end)
+                    return parseError(tr("illegal escape sequence"));
+                ushort ch = 0;
+                for (int j = 0; j < 4; ++j) {
+                    const int digit = hexDigit(data[i + j]);
+                    if (digit < 0)
+                        return parseError(tr("illegal escape sequence"));
+                    ch = ushort((ch << 4) | digit);
+                }
+                out->append(QChar(ch));
+                i += 4;
+                break;
+            }
+            default:
+                return parseError(tr("illegal escape sequence"));
+            }
+            runStart = i;
+        }
+    }
+    if (!appendRun(end))
+        return parseError(tr("invalid UTF8 string"));
+
+    pos = end + 1;
+    return TokenRead;
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \reentrant
+    \since 5.12
+
+    \brief The QJsonStreamReader class provides a fast parser for reading
+    JSON via a simple streaming API.
+
+    \ingroup json
+
+    QJsonStreamReader reports a JSON document as a stream of tokens,
+    without building a QJsonDocument. Like QXmlStreamReader, the
+    application drives the loop and pulls tokens from the reader by
+    calling readNext(), then inspects tokenType() and the token's data:
+    the name() of an object member, the text() of a string, the
+    toDouble() of a number or the toBool() of a boolean.
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 0
+
+    The reader reads from a QIODevice (see setDevice()) or from data
+    supplied with addData(), and only keeps the part of the input that has
+    not been consumed yet. Its memory use therefore depends on the size of
+    the largest string or number and the nesting depth, not on the size of
+    the document. readValue() reads the current value as a QJsonValue for
+    the parts of a document that the application wants as a whole, and
+    skipCurrentValue() skips values the application is not interested in.
+
+    \section1 Incremental Parsing
+
+    If the reader reaches the end of the available data in the middle of
+    the document, readNext() returns Invalid and error() returns
+    PrematureEndOfDocumentError. After more data has arrived, either on the
+    device or through addData(), calling readNext() again continues with
+    the token that was incomplete. This makes it possible to parse data
+    from a network connection as it arrives.
+
+    A number at the top level of a document has no closing delimiter, so it
+    is only complete when whitespace follows it or when the input ends: at
+    the end of the data passed to the constructor, or when the device
+    reports atEnd(). Data added with addData() can always be continued by
+    further calls.
+
+    \section1 Multiple Documents
+
+    After the EndDocument token, atEnd() returns \c true. Calling readNext()
+    again starts a new document if there is more data, which makes it
+    possible to read a series of documents, such as lines of a JSON Lines
+    log file, with a single reader. If there is no more data, readNext()
+    returns NoToken.
+
+    \sa QJsonDocument, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken The reader has not read anything yet, or there is no
+    more data after the end of a document.
+    \value Invalid An error has occurred, reported in error() and
+    errorString().
+    \value StartDocument The reader is at the start of a document.
+    \value EndDocument The reader has read the complete document.
+    \value StartObject The start of an object. Its members follow, each as
+    a Name token followed by the member's value.
+    \value EndObject The end of an object.
+    \value StartArray The start of an array. Its elements follow.
+    \value EndArray The end of an array.
+    \value Name The name of an object member, available in name() and text().
+    \value String A string value, available in text().
+    \value Number A number, available in toDouble(). text() holds the number
+    as written in the document.
+    \value Bool A boolean value, available in toBool().
+    \value Null The null value.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError No error has occurred.
+    \value CustomError A custom error has been raised with raiseError().
+    \value NotWellFormedError The document is not valid JSON.
+    \value PrematureEndOfDocumentError The input ended before the document
+    was complete. If more data arrives, readNext() can continue.
+*/
+
+/*!
+    Constructs a stream reader without input.
+
+    \sa setDevice(), addData()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d_ptr(new QJsonStreamReaderPrivate(this))
+{
+}
+
+/*!
+    Creates a new stream reader that reads from \a device.
+
+    \sa setDevice(), clear()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d_ptr(new QJsonStreamReaderPrivate(this))
+{
+    setDevice(device);
+}
+
+/*!
+    Creates a new stream reader that reads from \a data.
+
+    \sa addData(), clear(), setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d_ptr(new QJsonStreamReaderPrivate(this))
+{
+    Q_D(QJsonStreamReader);
+    d->buffer = data;
+    d->dataComplete = true;
+}
+
+/*!
+    Destructs the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device and resets the reader to its
+    initial state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamReader);
+    d->init();
+    d->device = device;
+}
+
+/*!
+    Returns the current device associated with the QJsonStreamReader,
+    or \nullptr if no device has been assigned.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->device;
+}
+
+/*!
+    Adds more \a data for the reader to read. This function does nothing
+    if the reader has a device().
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    Q_D(QJsonStreamReader);
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->buffer += data;
+    d->dataComplete = false;
+}
+
+/*!
+    \overload
+
+    Adds the null-terminated \a data for the reader to read.
+*/
+void QJsonStreamReader::addData(const char *data)
+{
+    addData(QByteArray(data));
+}
+
+/*!
+    Removes any device() or data from the reader and resets its internal
+    state to the initial state.
+
+    \sa addData()
+*/
+void QJsonStreamReader::clear()
+{
+    setDevice(nullptr);
+}
+
+/*!
+    Returns \c true if the reader has read until the end of the document,
+    or if an error other than PrematureEndOfDocumentError has occurred.
+
+    \sa hasError(), readNext()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->error != NoError)
+        return d->error != PrematureEndOfDocumentError;
+    return d->state == QJsonStreamReaderPrivate::AfterDocument;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    If an error other than PrematureEndOfDocumentError has occurred,
+    reading stops and Invalid is returned. After a
+    PrematureEndOfDocumentError, the reader continues with the incomplete
+    token once more data is available.
+
+    \sa tokenType(), tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    Q_D(QJsonStreamReader);
+    if (d->error != NoError) {
+        if (d->error != PrematureEndOfDocumentError)
+            return Invalid;
+        d->error = NoError;
+        d->errorString.clear();
+    }
+
+    d->compact();
+    const int start = d->pos;
+    for (;;) {
+        switch (d->parseNext()) {
+        case QJsonStreamReaderPrivate::TokenRead:
+            return d->type;
+        case QJsonStreamReaderPrivate::ParseError:
+            d->type = Invalid;
+            d->error = NotWellFormedError;
+            return Invalid;
+        case QJsonStreamReaderPrivate::NeedMoreData:
+            break;
+        }
+
+        // nothing is consumed until a token is complete
+        d->pos = start;
+        if (d->fetchMore())
+            continue;
+        if (d->state == QJsonStreamReaderPrivate::AfterDocument) {
+            d->type = NoToken;
+            return NoToken;
+        }
+        d->type = Invalid;
+        d->error = PrematureEndOfDocumentError;
+        d->errorString = QJsonStreamReaderPrivate::tr("unterminated document");
+        return Invalid;
+    }
+}
+
+/*!
+    Reads until the end of the current value. If the current token is
+    StartObject or StartArray, this skips to the matching EndObject or
+    EndArray token. If the current token is a Name, this skips the member's
+    value. For other tokens, it does nothing.
+
+    If the input ends before the value does, the reader stops with a
+    PrematureEndOfDocumentError; reading resumes inside the value.
+*/
+void QJsonStreamReader::skipCurrentValue()
+{
+    Q_D(QJsonStreamReader);
+    TokenType token = tokenType();
+    if (token == Name)
+        token = readNext();
+    if (token != StartObject && token != StartArray)
+        return;
+
+    const int depth = d->containers.size();
+    while (!hasError()) {
+        token = readNext();
+        if ((token == EndObject || token == EndArray) && d->containers.size() < depth)
+            return;
+    }
+}
+
+/*!
+    Reads the current value, including all members of objects and elements
+    of arrays, and returns it. If the current token is a Name, the member's
+    value is read. After this function returns, the reader is at the last
+    token of the value.
+
+    This function builds a QJsonValue for the value, so it should only be
+    used for values that fit in memory. If an error occurs, Undefined is
+    returned.
+
+    \sa skipCurrentValue(), value()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    TokenType token = tokenType();
+    if (token == Name)
+        token = readNext();
+
+    switch (token) {
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString key = text();
+            readNext();
+            const QJsonValue member = readValue();
+            if (hasError())
+                break;
+            object.insert(key, member);
+        }
+        if (hasError())
+            break;
+        return object;
+    }
+    case StartArray: {
+        QJsonArray array;
+        for (;;) {
+            token = readNext();
+            if (token == EndArray || hasError())
+                break;
+            array.append(readValue());
+        }
+        if (hasError())
+            break;
+        return array;
+    }
+    case String:
+    case Number:
+    case Bool:
+    case Null:
+        return value();
+    default:
+        break;
+    }
+    return QJsonValue(QJsonValue::Undefined);
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type;
+}
+
+/*!
+    Returns the reader's current token as string.
+
+    \sa tokenType()
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    static const char *const names[] = {
+        "NoToken", "Invalid", "StartDocument", "EndDocument", "StartObject", "EndObject",
+        "StartArray", "EndArray", "Name", "String", "Number", "Bool", "Null"
+    };
+    return QLatin1String(names[tokenType()]);
+}
+
+/*!
+    Returns the nesting depth of the current token: the number of objects
+    and arrays that have been started and not ended, including the one
+    just started by a StartObject or StartArray token.
+*/
+int QJsonStreamReader::depth() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->containers.size();
+}
+
+/*!
+    Returns the offset of the end of the current token in the input, in
+    bytes.
+*/
+qint64 QJsonStreamReader::characterOffset() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->offset + d->pos;
+}
+
+/*!
+    Returns the name of the current object member. This is the text of a
+    Name token, and stays available while the member's value is read: for
+    a value token directly inside an object, and for the StartObject,
+    StartArray, EndObject and EndArray tokens of an object or array that is
+    the value of a member. Otherwise, returns an empty string.
+
+    \sa text()
+*/
+QString QJsonStreamReader::name() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case StartObject:
+    case StartArray:
+        return d->containers.last().name;
+    case Name:
+    case String:
+    case Number:
+    case Bool:
+    case Null:
+    case EndObject:
+    case EndArray:
+        return d->currentName;
+    default:
+        break;
+    }
+    return QString();
+}
+
+/*!
+    Returns the text of a Name or String token, or the number as written in
+    the document for a Number token. Otherwise, returns an empty string.
+
+    \sa name(), toDouble()
+*/
+QString QJsonStreamReader::text() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case Name:
+    case String:
+    case Number:
+        return d->text;
+    default:
+        break;
+    }
+    return QString();
+}
+
+/*!
+    Returns the value of a Number token, or 0 for other tokens.
+*/
+double QJsonStreamReader::toDouble() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Number ? d->number : 0;
+}
+
+/*!
+    Returns the value of a Bool token, or \c false for other tokens.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Returns the value of a String, Number, Bool or Null token as a
+    QJsonValue, or Undefined for other tokens.
+
+    \sa readValue()
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case String:
+        return d->text;
+    case Number:
+        return d->number;
+    case Bool:
+        return d->boolean;
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    default:
+        break;
+    }
+    return QJsonValue(QJsonValue::Undefined);
+}
+
+/*!
+    Raises a custom error with an optional error \a message.
+
+    \sa error(), errorString()
+*/
+void QJsonStreamReader::raiseError(const QString &message)
+{
+    Q_D(QJsonStreamReader);
+    d->type = Invalid;
+    d->error = CustomError;
+    d->errorString = message;
+}
+
+/*!
+    Returns the error message that was set with raiseError(), or a
+    description of the JSON error.
+
+    \sa error(), hasError()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->error == NoError)
+        return QString();
+    return d->errorString;
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error occurred.
+
+    \sa errorString(), raiseError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->error;
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error has occurred, otherwise \c false.
+
+    \sa errorString(), error()
+*/
+
+QT_END_NAMESPACE
@@ -1,6 +1,8 @@
 # Qt data formats core module
 
 HEADERS += \
+    serialization/qcborcommon.h \
+    serialization/qcborstream.h \
     serialization/qdatastream.h \
     serialization/qdatastream_p.h \
     serialization/qjson_p.h \
@@ -8,6 +10,7 @@ HEADERS += \
     serialization/qjsonobject.h \
     serialization/qjsonvalue.h \
     serialization/qjsonarray.h \
+    serialization/qjsonstreamreader.h \
     serialization/qjsonwriter_p.h \
     serialization/qjsonparser_p.h \
     serialization/qtextstream.h \
@@ -17,6 +20,7 @@ HEADERS += \
     serialization/qxmlutils_p.h
 
 SOURCES += \
+    serialization/qcborstream.cpp \
     serialization/qdatastream.cpp \
     serialization/qjson.cpp \
     serialization/qjsondocument.cpp \
@@ -25,6 +29,7 @@ SOURCES += \
     serialization/qjsonvalue.cpp \
     serialization/qjsonwriter.cpp \
     serialization/qjsonparser.cpp \
+    serialization/qjsonstreamreader.cpp \
     serialization/qtextstream.cpp \
     serialization/qxmlstream.cpp \
     serialization/qxmlutils.cpp
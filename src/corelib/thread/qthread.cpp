@@ -89,6 +89,7 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    drainPostEventInbox();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -101,6 +102,40 @@ QThreadData::~QThreadData()
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
+/*
+    Moves the events that QCoreApplication::postEvent() pushed onto the
+    lock-free inbox into postEventList, keeping the priority order. Must be
+    called with postEventList.mutex held, before looking at the list.
+
+    An event whose receiver was moved to another thread while it was being
+    posted is forwarded to the inbox of the receiver's new thread.
+*/
+void QThreadData::drainPostEventInbox()
+{
+    QPostEventInbox::Node *node = postEventList.inbox.takeAll();
+    while (node) {
+        QPostEventInbox::Node *next = node->next;
+        QObject *receiver = node->event.receiver;
+        QThreadData *data = receiver->d_func()->threadData;
+        if (data == this) {
+            postEventList.addEvent(node->event);
+            ++receiver->d_func()->postedEvents;
+            canWait = false;
+            delete node;
+        } else if (data) {
+            data->postEventList.inbox.push(node);
+            if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+        } else {
+            // the receiver is being destroyed
+            node->event.event->posted = false;
+            delete node->event.event;
+            delete node;
+        }
+        node = next;
+    }
+}
+
 void QThreadData::ref()
 {
 #ifndef QT_NO_THREAD
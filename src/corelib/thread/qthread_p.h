@@ -100,6 +100,52 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// This class holds the events posted without taking the QPostEventList mutex.
+// Any number of threads may push(); the nodes are taken out all at once by
+// takeAll(), which is only called with the mutex held, so there is no ABA
+// problem despite the list being a plain Treiber stack.
+class QPostEventInbox
+{
+public:
+    struct Node
+    {
+        explicit Node(const QPostEvent &ev) : event(ev), next(nullptr) { }
+        QPostEvent event;
+        Node *next;
+    };
+
+    inline QPostEventInbox() : head(nullptr) { }
+
+    bool isEmpty() const
+    { return !head.loadAcquire(); }
+
+    void push(Node *node)
+    {
+        Node *current = head.loadAcquire();
+        do {
+            node->next = current;
+        } while (!head.testAndSetOrdered(current, node, current));
+    }
+
+    // returns the nodes in the order they were pushed
+    Node *takeAll()
+    {
+        Node *node = head.fetchAndStoreOrdered(nullptr);
+        Node *reversed = nullptr;
+        while (node) {
+            Node *next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        return reversed;
+    }
+
+private:
+    Q_DISABLE_COPY(QPostEventInbox)
+    QAtomicPointer<Node> head;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class QPostEventList : public QVector<QPostEvent>
@@ -115,6 +161,9 @@ public:
 
     QMutex mutex;
 
+    // events posted without locking the mutex, see QThreadData::drainPostEventInbox()
+    QPostEventInbox inbox;
+
     inline QPostEventList()
         : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
     { }
@@ -252,9 +301,11 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && postEventList.inbox.isEmpty();
     }
 
+    void drainPostEventInbox();
+
     // This class provides per-thread (by way of being a QThreadData
     // member) storage for qFlagLocation()
     class FlaggedDebugSignatures
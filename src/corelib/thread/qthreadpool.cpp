@@ -40,6 +40,7 @@
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
 #include "qelapsedtimer.h"
+#include "qmutexpool_p.h"
 
 #include <algorithm>
 
@@ -59,11 +60,22 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    QRunnable *takeLocalTask();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // work stealing mode: runnables started from within this thread; the
+    // owner takes from the back, other workers steal from the front
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
+#ifdef Q_COMPILER_THREAD_LOCAL
+static thread_local QThreadPoolThread *currentThreadPoolThread = nullptr;
+#endif
+
 /*
     QThreadPool private class.
 */
@@ -83,6 +95,10 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+#ifdef Q_COMPILER_THREAD_LOCAL
+    currentThreadPoolThread = this;
+#endif
+
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -90,27 +106,39 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                const bool autoDelete = r->autoDelete();
-
+                bool autoDelete;
 
                 // run the task
                 locker.unlock();
+                forever {
+                    autoDelete = r->autoDelete();
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
+                    if (!manager->workStealing.loadAcquire())
+                        break;
+
+                    // keep going with the runnables this thread queued
+                    // itself, without touching the pool's mutex
+                    if (autoDelete && manager->derefRunnable(r))
+                        delete r;
+                    r = takeLocalTask();
+                    if (!r)
+                        break;
+                }
                 locker.relock();
 
-                if (autoDelete && !--r->ref)
+                if (r && autoDelete && manager->derefRunnable(r))
                     delete r;
             }
 
@@ -119,8 +147,10 @@ void QThreadPoolThread::run()
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
-                break;
+                r = manager->workStealing.loadAcquire() ? manager->stealTask(this) : nullptr;
+                if (!r)
+                    break;
+                continue;
             }
 
             QueuePage *page = manager->queue.first();
@@ -162,6 +192,12 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeLast();
+}
+
 
 /*
     \internal
@@ -196,8 +232,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
 
         ++activeThreads;
 
-        if (task->autoDelete())
-            ++task->ref;
+        refRunnable(task);
         thread->runnable = task;
         thread->start();
         return true;
@@ -216,8 +251,7 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
-    if (runnable->autoDelete())
-        ++runnable->ref;
+    refRunnable(runnable);
 
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
@@ -272,8 +306,7 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     allThreads.append(thread.data());
     ++activeThreads;
 
-    if (runnable->autoDelete())
-        ++runnable->ref;
+    refRunnable(runnable);
     thread->runnable = runnable;
     thread.take()->start();
 }
@@ -332,12 +365,120 @@ void QThreadPoolPrivate::clear()
     for (QueuePage *page : qAsConst(queue)) {
         while (!page->isFinished()) {
             QRunnable *r = page->pop();
-            if (r && r->autoDelete() && !--r->ref)
+            if (r && r->autoDelete() && derefRunnable(r))
                 delete r;
         }
     }
     qDeleteAll(queue);
     queue.clear();
+
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        for (QRunnable *r : qAsConst(thread->localQueue)) {
+            if (r->autoDelete() && derefRunnable(r))
+                delete r;
+        }
+        thread->localQueue.clear();
+    }
+}
+
+/*!
+    \internal
+    In work stealing mode, QRunnable::ref is also modified without holding
+    the pool's mutex, so it is protected by a mutex from the global
+    QMutexPool instead.
+*/
+void QThreadPoolPrivate::refRunnable(QRunnable *runnable)
+{
+    if (!runnable->autoDelete())
+        return;
+
+    if (workStealing.loadAcquire()) {
+        QMutexLocker locker(QMutexPool::globalInstanceGet(runnable));
+        ++runnable->ref;
+    } else {
+        ++runnable->ref;
+    }
+}
+
+/*!
+    \internal
+    Returns \c true if \a runnable needs to be deleted by the caller.
+*/
+bool QThreadPoolPrivate::derefRunnable(QRunnable *runnable)
+{
+    if (workStealing.loadAcquire()) {
+        QMutexLocker locker(QMutexPool::globalInstanceGet(runnable));
+        return !--runnable->ref;
+    }
+    return !--runnable->ref;
+}
+
+/*!
+    \internal
+    Returns the worker thread of this pool the caller is running on, or
+    \c nullptr if it is called from any other thread.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentPoolThread() const
+{
+#ifdef Q_COMPILER_THREAD_LOCAL
+    QThreadPoolThread *thread = currentThreadPoolThread;
+    if (thread && thread->manager == this)
+        return thread;
+#endif
+    return nullptr;
+}
+
+/*!
+    \internal
+    Queues \a runnable on the local queue of \a thread, the current thread.
+    Only the first runnable that goes into an empty local queue takes the
+    pool's mutex, to hand it to an idle or new worker if there is one, or
+    else to wake a waiting worker to steal it. Idle workers look at the
+    local queues under the pool's mutex before they go to sleep, so the
+    runnables appended to a non-empty local queue are never overlooked.
+*/
+void QThreadPoolPrivate::enqueueLocalTask(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (!thread->localQueue.isEmpty()) {
+            refRunnable(runnable);
+            thread->localQueue.append(runnable);
+            return;
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    if (tryStart(runnable))
+        return;
+
+    refRunnable(runnable);
+    {
+        QMutexLocker localLocker(&thread->localMutex);
+        thread->localQueue.append(runnable);
+    }
+
+    if (!waitingThreads.isEmpty())
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+}
+
+/*!
+    \internal
+    Takes the oldest runnable from the local queue of another worker thread.
+    Must be called with the pool's mutex locked.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    const int count = allThreads.count();
+    const int start = allThreads.indexOf(thief);
+    for (int i = 1; i < count; ++i) {
+        QThreadPoolThread *victim = allThreads.at((start + i) % count);
+        QMutexLocker localLocker(&victim->localMutex);
+        if (!victim->localQueue.isEmpty())
+            return victim->localQueue.takeFirst();
+    }
+    return nullptr;
 }
 
 /*!
@@ -360,22 +501,42 @@ void QThreadPoolPrivate::clear()
 bool QThreadPool::tryTake(QRunnable *runnable)
 {
     Q_D(QThreadPool);
+    bool deleteRunnable;
+    return d->tryTake(runnable, &deleteRunnable);
+}
 
+/*!
+    \internal
+    Removes \a runnable from the queues like QThreadPool::tryTake() does.
+    \a deleteRunnable is set to \c true if the pool held the last reference
+    to an auto-deleting \a runnable, so that the caller has to delete it.
+*/
+bool QThreadPoolPrivate::tryTake(QRunnable *runnable, bool *deleteRunnable)
+{
+    *deleteRunnable = false;
     if (runnable == nullptr)
         return false;
-    {
-        QMutexLocker locker(&d->mutex);
 
-        for (QueuePage *page : qAsConst(d->queue)) {
-            if (page->tryTake(runnable)) {
-                if (page->isFinished()) {
-                    d->queue.removeOne(page);
-                    delete page;
-                }
-                if (runnable->autoDelete())
-                    --runnable->ref; // undo ++ref in start()
-                return true;
+    QMutexLocker locker(&mutex);
+
+    for (QueuePage *page : qAsConst(queue)) {
+        if (page->tryTake(runnable)) {
+            if (page->isFinished()) {
+                queue.removeOne(page);
+                delete page;
             }
+            if (runnable->autoDelete())
+                *deleteRunnable = derefRunnable(runnable); // undo ++ref in start()
+            return true;
+        }
+    }
+
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->localQueue.removeOne(runnable)) {
+            if (runnable->autoDelete())
+                *deleteRunnable = derefRunnable(runnable); // undo ++ref in start()
+            return true;
         }
     }
 
@@ -390,10 +551,9 @@ bool QThreadPool::tryTake(QRunnable *runnable)
      */
 void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
 {
-    Q_Q(QThreadPool);
-    if (!q->tryTake(runnable))
+    bool del;
+    if (!tryTake(runnable, &del))
         return;
-    const bool del = runnable->autoDelete() && !runnable->ref; // tryTake already deref'ed
 
     runnable->run();
 
@@ -500,6 +660,13 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->workStealing.loadAcquire() && priority == 0) {
+        if (QThreadPoolThread *thread = d->currentPoolThread()) {
+            d->enqueueLocalTask(thread, runnable);
+            return;
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
         d->enqueueTask(runnable, priority);
@@ -659,6 +826,55 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+
+    This property holds whether runnables started from within the thread
+    pool's own worker threads are queued per worker thread.
+
+    By default, all runnables that cannot be started right away go to one
+    queue shared by all worker threads, which is protected by a single mutex.
+    When work stealing is enabled, a runnable that a worker thread starts
+    with the default priority is queued on that worker thread instead. The
+    worker thread runs those runnables itself, most recently queued first,
+    once its current runnable has finished; idle worker threads take the
+    oldest ones from busy worker threads before going to sleep. This reduces
+    contention on the shared queue for workloads that split their work into
+    many small runnables from within the pool.
+
+    Runnables started from other threads, or with a non-default priority,
+    still go through the shared queue. A worker thread empties its own queue
+    before it takes the next runnable from the shared queue, and it only
+    steals from other worker threads once the shared queue is empty, too.
+
+    Set this property before starting any runnables; changing it while
+    runnables are queued or running results in undefined behavior.
+
+    Work stealing needs a compiler that supports \c thread_local. Without
+    it, enabling the property prints a warning and leaves it \c false.
+
+    The default value is \c false.
+
+    \since 5.12
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+#ifndef Q_COMPILER_THREAD_LOCAL
+    if (enabled) {
+        qWarning("QThreadPool::setWorkStealingEnabled: Work stealing is not supported by this compiler");
+        return;
+    }
+#endif
+    QMutexLocker locker(&d->mutex);
+    d->workStealing.storeRelease(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadAcquire();
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -722,7 +938,9 @@ void QThreadPool::clear()
 */
 void QThreadPool::cancel(QRunnable *runnable)
 {
-    if (tryTake(runnable) && runnable->autoDelete() && !runnable->ref) // tryTake already deref'ed
+    Q_D(QThreadPool);
+    bool deleteRunnable;
+    if (d->tryTake(runnable, &deleteRunnable) && deleteRunnable)
         delete runnable;
 }
 #endif
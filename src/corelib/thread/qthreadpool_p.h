@@ -57,6 +57,7 @@
 #include "QtCore/qwaitcondition.h"
 #include "QtCore/qset.h"
 #include "QtCore/qqueue.h"
+#include "QtCore/qatomic.h"
 #include "private/qobject_p.h"
 
 #ifndef QT_NO_THREAD
@@ -164,9 +165,17 @@ public:
     void reset();
     bool waitForDone(int msecs);
     void clear();
+    bool tryTake(QRunnable *runnable, bool *deleteRunnable);
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    void refRunnable(QRunnable *runnable);
+    bool derefRunnable(QRunnable *runnable);
+
+    QThreadPoolThread *currentPoolThread() const;
+    void enqueueLocalTask(QThreadPoolThread *thread, QRunnable *runnable);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+
     mutable QMutex mutex;
     QList<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -180,6 +189,7 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     bool isExiting = false;
+    QAtomicInt workStealing;
 };
 
 QT_END_NAMESPACE
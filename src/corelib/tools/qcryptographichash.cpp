@@ -40,6 +40,7 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#include <private/qsimd_p.h>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -164,6 +165,672 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+/*
+    SHA-1 and SHA-224/256 consume their input in 64-byte blocks. The block
+    functions below take a run of whole blocks, so that the SHA extensions
+    of x86 CPUs (SHA-NI) can be used when available. They fall back to the
+    portable implementations.
+*/
+typedef void (*QHashBlockFunction)(quint32 *state, const uchar *data, size_t blocks);
+
+static void sha1ProcessBlocks(quint32 *state, const uchar *data, size_t blocks)
+{
+    Sha1State context;
+    context.h0 = state[0];
+    context.h1 = state[1];
+    context.h2 = state[2];
+    context.h3 = state[3];
+    context.h4 = state[4];
+    for ( ; blocks; --blocks, data += 64)
+        sha1ProcessChunk(&context, data);
+    state[0] = context.h0;
+    state[1] = context.h1;
+    state[2] = context.h2;
+    state[3] = context.h3;
+    state[4] = context.h4;
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static void sha256ProcessBlocks(quint32 *state, const uchar *data, size_t blocks)
+{
+    SHA256Context context;
+    memcpy(context.Intermediate_Hash, state, sizeof context.Intermediate_Hash);
+    for ( ; blocks; --blocks, data += 64) {
+        memcpy(context.Message_Block, data, SHA256_Message_Block_Size);
+        SHA224_256ProcessMessageBlock(&context);
+    }
+    memcpy(state, context.Intermediate_Hash, sizeof context.Intermediate_Hash);
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(SHA) || QT_COMPILER_SUPPORTS_HERE(AVX2)
+static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
+#if QT_COMPILER_SUPPORTS_HERE(SHA)
+// Each step runs four rounds; the message schedule for the following steps
+// is computed alongside, so that msg[] only ever holds four vectors.
+#define SHA1_NI_STEP(i, f) \
+    do { \
+        if ((i) < 4) \
+            msg[(i)] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * (i))), byteSwap); \
+        const __m128i e = (i) == 0 ? _mm_add_epi32(e0, msg[0]) : _mm_sha1nexte_epu32(previous, msg[(i) & 3]); \
+        previous = abcd; \
+        abcd = _mm_sha1rnds4_epu32(abcd, e, (f)); \
+        if ((i) >= 3 && (i) <= 18) \
+            msg[((i) + 1) & 3] = _mm_sha1msg2_epu32(msg[((i) + 1) & 3], msg[(i) & 3]); \
+        if ((i) >= 1 && (i) <= 16) \
+            msg[((i) - 1) & 3] = _mm_sha1msg1_epu32(msg[((i) - 1) & 3], msg[(i) & 3]); \
+        if ((i) >= 2 && (i) <= 17) \
+            msg[((i) + 2) & 3] = _mm_xor_si128(msg[((i) + 2) & 3], msg[(i) & 3]); \
+    } while (false)
+
+QT_FUNCTION_TARGET(SHA)
+static void sha1ProcessBlocksShaNi(quint32 *state, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0001020304050607), Q_INT64_C(0x08090a0b0c0d0e0f));
+    __m128i abcd = _mm_set_epi32(state[0], state[1], state[2], state[3]);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i savedAbcd = abcd;
+        const __m128i savedE0 = e0;
+        __m128i msg[4];
+        __m128i previous;
+
+        SHA1_NI_STEP(0, 0); SHA1_NI_STEP(1, 0); SHA1_NI_STEP(2, 0); SHA1_NI_STEP(3, 0);
+        SHA1_NI_STEP(4, 0); SHA1_NI_STEP(5, 1); SHA1_NI_STEP(6, 1); SHA1_NI_STEP(7, 1);
+        SHA1_NI_STEP(8, 1); SHA1_NI_STEP(9, 1); SHA1_NI_STEP(10, 2); SHA1_NI_STEP(11, 2);
+        SHA1_NI_STEP(12, 2); SHA1_NI_STEP(13, 2); SHA1_NI_STEP(14, 2); SHA1_NI_STEP(15, 3);
+        SHA1_NI_STEP(16, 3); SHA1_NI_STEP(17, 3); SHA1_NI_STEP(18, 3); SHA1_NI_STEP(19, 3);
+
+        e0 = _mm_sha1nexte_epu32(previous, savedE0);
+        abcd = _mm_add_epi32(abcd, savedAbcd);
+    }
+
+    state[0] = _mm_extract_epi32(abcd, 3);
+    state[1] = _mm_extract_epi32(abcd, 2);
+    state[2] = _mm_extract_epi32(abcd, 1);
+    state[3] = _mm_extract_epi32(abcd, 0);
+    state[4] = _mm_extract_epi32(e0, 3);
+}
+#undef SHA1_NI_STEP
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+#define SHA256_NI_STEP(i) \
+    do { \
+        if ((i) < 4) \
+            msg[(i)] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * (i))), byteSwap); \
+        __m128i wk = _mm_add_epi32(msg[(i) & 3], \
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants + 4 * (i)))); \
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk); \
+        if ((i) >= 3 && (i) <= 14) { \
+            msg[((i) + 1) & 3] = _mm_add_epi32(msg[((i) + 1) & 3], _mm_alignr_epi8(msg[(i) & 3], msg[((i) - 1) & 3], 4)); \
+            msg[((i) + 1) & 3] = _mm_sha256msg2_epu32(msg[((i) + 1) & 3], msg[(i) & 3]); \
+        } \
+        wk = _mm_shuffle_epi32(wk, 0x0e); \
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, wk); \
+        if ((i) >= 1 && (i) <= 12) \
+            msg[((i) - 1) & 3] = _mm_sha256msg1_epu32(msg[((i) - 1) & 3], msg[(i) & 3]); \
+    } while (false)
+
+QT_FUNCTION_TARGET(SHA)
+static void sha256ProcessBlocksShaNi(quint32 *state, const uchar *data, size_t blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(Q_INT64_C(0x0c0d0e0f08090a0b), Q_INT64_C(0x0405060700010203));
+    __m128i abef = _mm_set_epi32(state[0], state[1], state[4], state[5]);
+    __m128i cdgh = _mm_set_epi32(state[2], state[3], state[6], state[7]);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const __m128i savedAbef = abef;
+        const __m128i savedCdgh = cdgh;
+        __m128i msg[4];
+
+        SHA256_NI_STEP(0); SHA256_NI_STEP(1); SHA256_NI_STEP(2); SHA256_NI_STEP(3);
+        SHA256_NI_STEP(4); SHA256_NI_STEP(5); SHA256_NI_STEP(6); SHA256_NI_STEP(7);
+        SHA256_NI_STEP(8); SHA256_NI_STEP(9); SHA256_NI_STEP(10); SHA256_NI_STEP(11);
+        SHA256_NI_STEP(12); SHA256_NI_STEP(13); SHA256_NI_STEP(14); SHA256_NI_STEP(15);
+
+        abef = _mm_add_epi32(abef, savedAbef);
+        cdgh = _mm_add_epi32(cdgh, savedCdgh);
+    }
+
+    state[0] = _mm_extract_epi32(abef, 3);
+    state[1] = _mm_extract_epi32(abef, 2);
+    state[2] = _mm_extract_epi32(cdgh, 3);
+    state[3] = _mm_extract_epi32(cdgh, 2);
+    state[4] = _mm_extract_epi32(abef, 1);
+    state[5] = _mm_extract_epi32(abef, 0);
+    state[6] = _mm_extract_epi32(cdgh, 1);
+    state[7] = _mm_extract_epi32(cdgh, 0);
+}
+#undef SHA256_NI_STEP
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
+static inline bool hasSha1Extensions()
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+static inline bool hasSha2Extensions()
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+#else
+static inline bool hasSha1Extensions()
+{
+    return false;
+}
+static inline bool hasSha2Extensions()
+{
+    return false;
+}
+#endif
+
+static QHashBlockFunction sha1BlockFunction()
+{
+#if QT_COMPILER_SUPPORTS_HERE(SHA)
+    if (hasSha1Extensions())
+        return sha1ProcessBlocksShaNi;
+#endif
+    return sha1ProcessBlocks;
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static QHashBlockFunction sha256BlockFunction()
+{
+#if QT_COMPILER_SUPPORTS_HERE(SHA)
+    if (hasSha2Extensions())
+        return sha256ProcessBlocksShaNi;
+#endif
+    return sha256ProcessBlocks;
+}
+#endif
+
+/*
+    Appends \a length bytes of \a data to a hash whose partial block is kept in
+    the 64-byte \a buffer, currently holding \a used bytes. Whole blocks are
+    handed to \a processBlocks straight from \a data. Returns the number of
+    bytes left in \a buffer.
+*/
+static uint hashBlocks(quint32 *state, uchar *buffer, uint used, const uchar *data, size_t length,
+                       QHashBlockFunction processBlocks)
+{
+    if (!length)
+        return used;
+
+    if (used) {
+        const size_t n = qMin(size_t(64 - used), length);
+        memcpy(buffer + used, data, n);
+        used += uint(n);
+        data += n;
+        length -= n;
+        if (used < 64)
+            return used;
+        processBlocks(state, buffer, 1);
+    }
+
+    const size_t blocks = length / 64;
+    if (blocks) {
+        processBlocks(state, data, blocks);
+        data += blocks * 64;
+        length -= blocks * 64;
+    }
+    if (length)
+        memcpy(buffer, data, length);
+    return uint(length);
+}
+
+static void sha1AddData(Sha1State *context, const uchar *data, size_t length)
+{
+    quint32 state[5] = { context->h0, context->h1, context->h2, context->h3, context->h4 };
+    hashBlocks(state, context->buffer, uint(context->messageSize & 63), data, length,
+               sha1BlockFunction());
+    context->messageSize += length;
+    context->h0 = state[0];
+    context->h1 = state[1];
+    context->h2 = state[2];
+    context->h3 = state[3];
+    context->h4 = state[4];
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+// Replaces SHA224Input() and SHA256Input(), which process a byte at a time.
+static void sha256AddData(SHA256Context *context, const uchar *data, size_t length)
+{
+    const quint64 bitCount = ((quint64(context->Length_High) << 32) | context->Length_Low)
+            + (quint64(length) << 3);
+    context->Length_High = quint32(bitCount >> 32);
+    context->Length_Low = quint32(bitCount);
+    context->Message_Block_Index = qint16(hashBlocks(context->Intermediate_Hash,
+                                                     context->Message_Block,
+                                                     uint(context->Message_Block_Index),
+                                                     data, length, sha256BlockFunction()));
+}
+
+/*
+    CRC-32C (Castagnoli), as used by iSCSI, SCTP, ext4 and others. The SSE 4.2
+    instruction set calculates it directly.
+*/
+static const quint32 crc32cTable[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c,
+    0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c,
+    0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc,
+    0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512,
+    0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad,
+    0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf,
+    0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f,
+    0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f,
+    0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e,
+    0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e,
+    0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de,
+    0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4,
+    0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b,
+    0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5,
+    0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975,
+    0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905,
+    0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8,
+    0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8,
+    0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78,
+    0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6,
+    0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69,
+    0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+};
+
+#if QT_COMPILER_SUPPORTS_HERE(SSE4_2)
+static inline bool hasFastCrc32c()
+{
+    return qCpuHasFeature(SSE4_2);
+}
+
+QT_FUNCTION_TARGET(SSE4_2)
+static quint32 crc32cHardware(quint32 crc, const uchar *p, size_t len)
+{
+    const uchar *const e = p + len;
+#  ifdef Q_PROCESSOR_X86_64
+    // see qhash.cpp for why this is a 64-bit variable
+    quint64 crc64 = crc;
+    for ( ; e - p >= 8; p += 8)
+        crc64 = _mm_crc32_u64(crc64, qFromUnaligned<quint64>(p));
+    crc = quint32(crc64);
+#  endif
+    for ( ; e - p >= 4; p += 4)
+        crc = _mm_crc32_u32(crc, qFromUnaligned<quint32>(p));
+    for ( ; p != e; ++p)
+        crc = _mm_crc32_u8(crc, *p);
+    return crc;
+}
+#else
+static inline bool hasFastCrc32c()
+{
+    return false;
+}
+
+static quint32 crc32cHardware(quint32 crc, const uchar *, size_t)
+{
+    Q_UNREACHABLE();
+    return crc;
+}
+#endif
+
+static quint32 crc32cUpdate(quint32 crc, const uchar *p, size_t len)
+{
+    if (hasFastCrc32c())
+        return crc32cHardware(crc, p, len);
+
+    for (size_t i = 0; i < len; ++i)
+        crc = crc32cTable[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
+/*
+    Multi-buffer hashing: eight independent messages are hashed side by side,
+    one per 32-bit lane of the AVX2 registers. Used by
+    QCryptographicHash::hashMany() on CPUs without the SHA extensions.
+*/
+enum { HashLanes = 8 };
+
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i rotateRight(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Loads block word 0..15 of each lane into w[0..15].
+QT_FUNCTION_TARGET(AVX2)
+static inline void loadLaneWords(__m256i *w, const uchar *const *blocks)
+{
+    const __m256i byteSwap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                             12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    for (int half = 0; half < 2; ++half) {
+        __m256i r[HashLanes];
+        for (int lane = 0; lane < HashLanes; ++lane)
+            r[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blocks[lane] + 32 * half));
+
+        // transpose the 8x8 matrix of words
+        const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+        const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+        const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+        const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+        const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+        const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+        const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+        const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+        const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+        const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+        const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+        const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+        const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+        const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+        const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+        __m256i *out = w + 8 * half;
+        out[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), byteSwap);
+        out[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), byteSwap);
+        out[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), byteSwap);
+        out[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), byteSwap);
+        out[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), byteSwap);
+        out[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), byteSwap);
+        out[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), byteSwap);
+        out[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), byteSwap);
+    }
+}
+
+// state[word * HashLanes + lane]
+QT_FUNCTION_TARGET(AVX2)
+static void sha256ProcessLanesAvx2(quint32 *state, const uchar *const *blocks)
+{
+    __m256i w[16];
+    loadLaneWords(w, blocks);
+
+    __m256i v[8];
+    for (int i = 0; i < 8; ++i)
+        v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + i * HashLanes));
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            const __m256i w15 = w[(t - 15) & 15];
+            const __m256i w2 = w[(t - 2) & 15];
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotateRight(w15, 7), rotateRight(w15, 18)),
+                                                _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotateRight(w2, 17), rotateRight(w2, 19)),
+                                                _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                         _mm256_add_epi32(w[(t - 7) & 15], s1));
+        }
+        const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotateRight(e, 6), rotateRight(e, 11)),
+                                                rotateRight(e, 25));
+        const __m256i choose = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+        const __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+                                               _mm256_add_epi32(_mm256_add_epi32(choose, w[t & 15]),
+                                                                _mm256_set1_epi32(sha256RoundConstants[t])));
+        const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotateRight(a, 2), rotateRight(a, 13)),
+                                                rotateRight(a, 22));
+        const __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(temp1, _mm256_add_epi32(sigma0, majority));
+    }
+
+    const __m256i result[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; ++i)
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(state + i * HashLanes), _mm256_add_epi32(v[i], result[i]));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i sha1LaneWord(__m256i *w, int t)
+{
+    if (t < 16)
+        return w[t];
+    const __m256i x = _mm256_xor_si256(_mm256_xor_si256(w[(t - 3) & 15], w[(t - 8) & 15]),
+                                       _mm256_xor_si256(w[(t - 14) & 15], w[t & 15]));
+    return w[t & 15] = _mm256_or_si256(_mm256_slli_epi32(x, 1), _mm256_srli_epi32(x, 31));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline void sha1LaneRound(__m256i &a, __m256i &b, __m256i &c, __m256i &d, __m256i &e,
+                                 __m256i f, __m256i k, __m256i w)
+{
+    const __m256i temp = _mm256_add_epi32(_mm256_add_epi32(rotateRight(a, 27), f),
+                                          _mm256_add_epi32(_mm256_add_epi32(e, k), w));
+    e = d;
+    d = c;
+    c = rotateRight(b, 2);
+    b = a;
+    a = temp;
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static void sha1ProcessLanesAvx2(quint32 *state, const uchar *const *blocks)
+{
+    __m256i w[16];
+    loadLaneWords(w, blocks);
+
+    __m256i v[5];
+    for (int i = 0; i < 5; ++i)
+        v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + i * HashLanes));
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4];
+
+    __m256i k = _mm256_set1_epi32(0x5a827999);
+    for (int t = 0; t < 20; ++t) {
+        const __m256i f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+        sha1LaneRound(a, b, c, d, e, f, k, sha1LaneWord(w, t));
+    }
+    k = _mm256_set1_epi32(0x6ed9eba1);
+    for (int t = 20; t < 40; ++t) {
+        const __m256i f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+        sha1LaneRound(a, b, c, d, e, f, k, sha1LaneWord(w, t));
+    }
+    k = _mm256_set1_epi32(int(0x8f1bbcdc));
+    for (int t = 40; t < 60; ++t) {
+        const __m256i f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+        sha1LaneRound(a, b, c, d, e, f, k, sha1LaneWord(w, t));
+    }
+    k = _mm256_set1_epi32(int(0xca62c1d6));
+    for (int t = 60; t < 80; ++t) {
+        const __m256i f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+        sha1LaneRound(a, b, c, d, e, f, k, sha1LaneWord(w, t));
+    }
+
+    const __m256i result[5] = { a, b, c, d, e };
+    for (int i = 0; i < 5; ++i)
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(state + i * HashLanes), _mm256_add_epi32(v[i], result[i]));
+}
+
+struct QHashLaneJob
+{
+    const uchar *data;      // next whole block of the message
+    size_t blocks;          // whole blocks left, then the tail blocks
+    uint tailBlocks;
+    uint tailDone;
+    uchar tail[128];        // the last partial block, padded
+    int message;            // index of the message, -1 if the lane is idle
+};
+
+struct QHashLaneAlgorithm
+{
+    void (*processLanes)(quint32 *state, const uchar *const *blocks);
+    QHashBlockFunction processBlocks;
+    const quint32 *initialState;
+    int stateWords;
+    int digestSize;
+};
+
+static void startHashLaneJob(QHashLaneJob *job, const QByteArray &message, int index)
+{
+    const size_t length = size_t(message.size());
+    const size_t rest = length % 64;
+    job->data = reinterpret_cast<const uchar *>(message.constData());
+    job->blocks = length / 64;
+    job->tailBlocks = rest < 56 ? 1 : 2;
+    job->tailDone = 0;
+    job->message = index;
+
+    // same padding as sha1FinalizeState() and SHA224_256PadMessage()
+    memset(job->tail, 0, sizeof job->tail);
+    if (rest)
+        memcpy(job->tail, job->data + job->blocks * 64, rest);
+    job->tail[rest] = 0x80;
+    qToBigEndian(quint64(length) << 3, job->tail + 64 * job->tailBlocks - 8);
+}
+
+static QByteArray hashLaneDigest(const QHashLaneAlgorithm &algorithm, const quint32 *state, int lane)
+{
+    QByteArray digest(algorithm.digestSize, Qt::Uninitialized);
+    for (int i = 0; i < algorithm.digestSize / 4; ++i)
+        qToBigEndian(state[i * HashLanes + lane], digest.data() + 4 * i);
+    return digest;
+}
+
+static void hashManyLanes(const QHashLaneAlgorithm &algorithm, const QByteArrayList &messages,
+                          QByteArrayList *results)
+{
+    static const uchar idleBlock[64] = {};
+    quint32 state[8 * HashLanes];
+    QHashLaneJob jobs[HashLanes];
+    const int count = messages.size();
+    int next = 0;
+    int active = 0;
+
+    results->reserve(count);
+    for (int i = 0; i < count; ++i)
+        results->append(QByteArray());
+
+    const auto startLane = [&](int lane) {
+        if (next == count) {
+            jobs[lane].message = -1;
+            return;
+        }
+        startHashLaneJob(&jobs[lane], messages.at(next), next);
+        for (int i = 0; i < algorithm.stateWords; ++i)
+            state[i * HashLanes + lane] = algorithm.initialState[i];
+        ++next;
+        ++active;
+    };
+    for (int lane = 0; lane < HashLanes; ++lane)
+        startLane(lane);
+
+    // Once the queue is empty, a lone long message is finished faster by the
+    // single-buffer code than by running mostly idle lanes.
+    while (active > 2 || (active && next < count)) {
+        const uchar *blocks[HashLanes];
+        for (int lane = 0; lane < HashLanes; ++lane) {
+            const QHashLaneJob &job = jobs[lane];
+            if (job.message < 0)
+                blocks[lane] = idleBlock;
+            else if (job.blocks)
+                blocks[lane] = job.data;
+            else
+                blocks[lane] = job.tail + 64 * job.tailDone;
+        }
+        algorithm.processLanes(state, blocks);
+
+        for (int lane = 0; lane < HashLanes; ++lane) {
+            QHashLaneJob &job = jobs[lane];
+            if (job.message < 0)
+                continue;
+            if (job.blocks) {
+                job.data += 64;
+                --job.blocks;
+                continue;
+            }
+            if (++job.tailDone < job.tailBlocks)
+                continue;
+            (*results)[job.message] = hashLaneDigest(algorithm, state, lane);
+            --active;
+            startLane(lane);
+        }
+    }
+
+    for (int lane = 0; lane < HashLanes; ++lane) {
+        const QHashLaneJob &job = jobs[lane];
+        if (job.message < 0)
+            continue;
+        quint32 laneState[8];
+        for (int i = 0; i < algorithm.stateWords; ++i)
+            laneState[i] = state[i * HashLanes + lane];
+        algorithm.processBlocks(laneState, job.data, job.blocks);
+        algorithm.processBlocks(laneState, job.tail + 64 * job.tailDone, job.tailBlocks - job.tailDone);
+        for (int i = 0; i < algorithm.stateWords; ++i)
+            state[i * HashLanes + lane] = laneState[i];
+        (*results)[job.message] = hashLaneDigest(algorithm, state, lane);
+    }
+}
+
+static const quint32 sha1InitialState[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+static bool hashManyMultiBuffer(const QByteArrayList &messages, QCryptographicHash::Algorithm method,
+                                QByteArrayList *results)
+{
+    if (messages.size() < 4 || !qCpuHasFeature(AVX2))
+        return false;
+
+    QHashLaneAlgorithm algorithm;
+    switch (method) {
+    case QCryptographicHash::Sha1:
+        if (hasSha1Extensions())
+            return false;
+        algorithm = { sha1ProcessLanesAvx2, sha1ProcessBlocks, sha1InitialState, 5, 20 };
+        break;
+    case QCryptographicHash::Sha224:
+        if (hasSha2Extensions())
+            return false;
+        algorithm = { sha256ProcessLanesAvx2, sha256ProcessBlocks, SHA224_H0, 8, SHA224HashSize };
+        break;
+    case QCryptographicHash::Sha256:
+        if (hasSha2Extensions())
+            return false;
+        algorithm = { sha256ProcessLanesAvx2, sha256ProcessBlocks, SHA256_H0, 8, SHA256HashSize };
+        break;
+    default:
+        return false;
+    }
+
+    hashManyLanes(algorithm, messages, results);
+    return true;
+}
+#endif // AVX2
+
 class QCryptographicHashPrivate
 {
 public:
@@ -178,6 +845,7 @@ public:
         SHA384Context sha384Context;
         SHA512Context sha512Context;
         SHA3Context sha3Context;
+        quint32 crc32cContext;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -273,6 +941,9 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Keccak_256 Generate a Keccak-256 hash sum. Introduced in Qt 5.9.2
   \value Keccak_384 Generate a Keccak-384 hash sum. Introduced in Qt 5.9.2
   \value Keccak_512 Generate a Keccak-512 hash sum. Introduced in Qt 5.9.2
+  \value Crc32c Generate a CRC-32C (Castagnoli) checksum. This is not a
+         cryptographic hash; it detects accidental corruption of data only.
+         Introduced in Qt 5.12
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
@@ -346,6 +1017,9 @@ void QCryptographicHash::reset()
     case Keccak_512:
         sha3Init(&d->sha3Context, 512);
         break;
+    case Crc32c:
+        d->crc32cContext = 0xffffffff;
+        break;
 #endif
     }
     d->result.clear();
@@ -359,7 +1033,7 @@ void QCryptographicHash::addData(const char *data, int length)
 {
     switch (d->method) {
     case Sha1:
-        sha1Update(&d->sha1Context, (const unsigned char *)data, length);
+        sha1AddData(&d->sha1Context, reinterpret_cast<const uchar *>(data), length);
         break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
     default:
@@ -374,10 +1048,10 @@ void QCryptographicHash::addData(const char *data, int length)
         MD5Update(&d->md5Context, (const unsigned char *)data, length);
         break;
     case Sha224:
-        SHA224Input(&d->sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256AddData(&d->sha224Context, reinterpret_cast<const uchar *>(data), length);
         break;
     case Sha256:
-        SHA256Input(&d->sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+        sha256AddData(&d->sha256Context, reinterpret_cast<const uchar *>(data), length);
         break;
     case Sha384:
         SHA384Input(&d->sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -401,6 +1075,9 @@ void QCryptographicHash::addData(const char *data, int length)
     case Keccak_512:
         sha3Update(&d->sha3Context, reinterpret_cast<const BitSequence *>(data), length*8);
         break;
+    case Crc32c:
+        d->crc32cContext = crc32cUpdate(d->crc32cContext, reinterpret_cast<const uchar *>(data), length);
+        break;
 #endif
     }
     d->result.clear();
@@ -529,6 +1206,10 @@ QByteArray QCryptographicHash::result() const
         d->sha3Finish(512, QCryptographicHashPrivate::Sha3Variant::Keccak);
         break;
     }
+    case Crc32c:
+        d->result.resize(4);
+        qToBigEndian(~d->crc32cContext, d->result.data());
+        break;
 #endif
     }
     return d->result;
@@ -544,6 +1225,35 @@ QByteArray QCryptographicHash::hash(const QByteArray &data, Algorithm method)
     return hash.result();
 }
 
+/*!
+  \since 5.12
+
+  Returns the hashes of each of the \a messages using \a method, in the same
+  order as the messages.
+
+  This gives the same results as calling hash() on every message, but for
+  SHA-1, SHA-224 and SHA-256 the messages may be hashed side by side using
+  vector instructions, which is considerably faster than hashing them one
+  after another on processors without dedicated SHA instructions.
+*/
+QByteArrayList QCryptographicHash::hashMany(const QByteArrayList &messages, Algorithm method)
+{
+    QByteArrayList results;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
+    if (hashManyMultiBuffer(messages, method, &results))
+        return results;
+#endif
+
+    results.reserve(messages.size());
+    QCryptographicHash hash(method);
+    for (const QByteArray &message : messages) {
+        hash.reset();
+        hash.addData(message);
+        results.append(hash.result());
+    }
+    return results;
+}
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
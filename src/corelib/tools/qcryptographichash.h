@@ -42,6 +42,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qbytearraylist.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -78,13 +79,14 @@ public:
         Sha3_224 = RealSha3_224,
         Sha3_256 = RealSha3_256,
         Sha3_384 = RealSha3_384,
-        Sha3_512 = RealSha3_512
+        Sha3_512 = RealSha3_512,
 #  else
         Sha3_224 = Keccak_224,
         Sha3_256 = Keccak_256,
         Sha3_384 = Keccak_384,
-        Sha3_512 = Keccak_512
+        Sha3_512 = Keccak_512,
 #  endif
+        Crc32c = 15
 #endif
     };
     Q_ENUM(Algorithm)
@@ -101,6 +103,7 @@ public:
     QByteArray result() const;
 
     static QByteArray hash(const QByteArray &data, Algorithm method);
+    static QByteArrayList hashMany(const QByteArrayList &messages, Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
     QCryptographicHashPrivate *d;
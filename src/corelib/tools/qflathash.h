@@ -0,0 +1,766 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qcontainerfwd.h>
+#include <QtCore/qglobal.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qlist.h>
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+#include <iterator>
+
+#if defined(__SSE2__) || (defined(Q_CC_MSVC) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#  define QT_FLATHASH_SSE2
+#  include <emmintrin.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QFlatHashPrivate {
+
+// Every slot of the table has a control byte: the 7 low bits of the hash
+// for used slots, a negative value for free ones.
+const signed char Empty = -128;
+const signed char Deleted = -2;
+
+// A group of consecutive control bytes that are probed together. The
+// masks have one bit set (at position index << Shift) per matching byte.
+#ifdef QT_FLATHASH_SSE2
+struct Group
+{
+    enum { Width = 16, Shift = 0 };
+    typedef quint32 Mask;
+
+    explicit Group(const signed char *ctrl)
+        : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl)))
+    {}
+
+    Mask match(signed char h2) const
+    { return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes))); }
+    Mask matchEmpty() const
+    { return match(Empty); }
+    Mask matchFree() const
+    { return Mask(_mm_movemask_epi8(bytes)); }
+
+    __m128i bytes;
+};
+#else
+struct Group
+{
+    enum { Width = 8, Shift = 3 };
+    typedef quint64 Mask;
+
+    explicit Group(const signed char *ctrl)
+        : bytes(qFromLittleEndian<quint64>(ctrl))
+    {}
+
+    // may report bytes that don't match, callers check the control byte
+    Mask match(signed char h2) const
+    {
+        const quint64 x = bytes ^ (lsbs() * quint8(h2));
+        return (x - lsbs()) & ~x & msbs();
+    }
+    Mask matchEmpty() const
+    { return bytes & (~bytes << 6) & msbs(); }
+    Mask matchFree() const
+    { return bytes & msbs(); }
+
+    static Q_DECL_CONSTEXPR quint64 lsbs() { return Q_UINT64_C(0x0101010101010101); }
+    static Q_DECL_CONSTEXPR quint64 msbs() { return Q_UINT64_C(0x8080808080808080); }
+
+    quint64 bytes;
+};
+#endif
+
+inline int firstIndex(Group::Mask mask)
+{ return int(qCountTrailingZeroBits(mask) >> Group::Shift); }
+
+inline quint64 mixHash(uint h)
+{ return quint64(h) * Q_UINT64_C(0x9e3779b97f4a7c15); }
+
+inline signed char h2(quint64 mixed)
+{ return static_cast<signed char>((mixed >> 24) & 0x7f); }
+
+struct DummyValue {};
+
+template <typename Key, typename T>
+struct Node
+{
+    Node(const Key &k, const T &v) : key(k), value(v) {}
+    void setValue(const T &v) { value = v; }
+    Key key;
+    T value;
+};
+
+template <typename Key>
+struct Node<Key, DummyValue>
+{
+    Node(const Key &k, const DummyValue &) : key(k) {}
+    void setValue(const DummyValue &) {}
+    Key key;
+};
+
+} // namespace QFlatHashPrivate
+
+Q_DECLARE_TYPEINFO(QFlatHashPrivate::DummyValue, Q_PRIMITIVE_TYPE);
+
+template <class Key, class T>
+class QFlatHash
+{
+    typedef QFlatHashPrivate::Node<Key, T> Node;
+    typedef QFlatHashPrivate::Group Group;
+
+public:
+    inline QFlatHash() Q_DECL_NOTHROW
+        : ctrl(nullptr), nodes(nullptr), groupCount(0), groupBits(0), sz(0), growthLeft(0),
+          seed(uint(qGlobalQHashSeed()))
+    {}
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatHash(std::initializer_list<std::pair<Key, T> > list)
+        : QFlatHash()
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<std::pair<Key, T> >::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+#endif
+    QFlatHash(const QFlatHash &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    QFlatHash(QFlatHash &&other) Q_DECL_NOTHROW
+        : QFlatHash()
+    { swap(other); }
+    QFlatHash &operator=(QFlatHash &&other) Q_DECL_NOTHROW
+    { QFlatHash moved(std::move(other)); swap(moved); return *this; }
+#endif
+    QFlatHash &operator=(const QFlatHash &other)
+    {
+        if (this != &other) {
+            QFlatHash copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    ~QFlatHash() { freeData(); }
+
+    void swap(QFlatHash &other) Q_DECL_NOTHROW
+    {
+        qSwap(ctrl, other.ctrl);
+        qSwap(nodes, other.nodes);
+        qSwap(groupCount, other.groupCount);
+        qSwap(groupBits, other.groupBits);
+        qSwap(sz, other.sz);
+        qSwap(growthLeft, other.growthLeft);
+        qSwap(seed, other.seed);
+    }
+
+    bool operator==(const QFlatHash &other) const;
+    inline bool operator!=(const QFlatHash &other) const { return !(*this == other); }
+
+    inline int size() const { return sz; }
+    inline int count() const { return sz; }
+    inline bool isEmpty() const { return sz == 0; }
+    inline int capacity() const { return groupCount * Group::Width; }
+    void reserve(int size);
+    void squeeze() { rehash(groupCountFor(sz)); }
+    void clear();
+
+    class iterator;
+    class const_iterator;
+
+    iterator insert(const Key &key, const T &value);
+    int remove(const Key &key);
+    T take(const Key &key);
+    bool contains(const Key &key) const { return findIndex(key) >= 0; }
+    int count(const Key &key) const { return contains(key) ? 1 : 0; }
+    const T value(const Key &key) const;
+    const T value(const Key &key, const T &defaultValue) const;
+    const Key key(const T &value) const;
+    const Key key(const T &value, const Key &defaultKey) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const { return value(key); }
+    QList<Key> keys() const;
+    QList<T> values() const;
+
+    class iterator
+    {
+        friend class QFlatHash;
+        friend class const_iterator;
+        QFlatHash *h;
+        int i;
+        iterator(QFlatHash *hash, int index) : h(hash), i(index) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        Q_DECL_CONSTEXPR iterator() : h(nullptr), i(0) {}
+
+        inline const Key &key() const { return h->nodes[i].key; }
+        inline T &value() const { return h->nodes[i].value; }
+        inline T &operator*() const { return value(); }
+        inline T *operator->() const { return &value(); }
+        inline bool operator==(const iterator &o) const { return i == o.i; }
+        inline bool operator!=(const iterator &o) const { return i != o.i; }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+
+        inline iterator &operator++() { i = h->nextIndex(i); return *this; }
+        inline iterator operator++(int) { iterator r = *this; ++*this; return r; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class QFlatHash;
+        friend class iterator;
+        const QFlatHash *h;
+        int i;
+        const_iterator(const QFlatHash *hash, int index) : h(hash), i(index) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        Q_DECL_CONSTEXPR const_iterator() : h(nullptr), i(0) {}
+        inline const_iterator(const iterator &o) : h(o.h), i(o.i) {}
+
+        inline const Key &key() const { return h->nodes[i].key; }
+        inline const T &value() const { return h->nodes[i].value; }
+        inline const T &operator*() const { return value(); }
+        inline const T *operator->() const { return &value(); }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+
+        inline const_iterator &operator++() { i = h->nextIndex(i); return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+    };
+    friend class const_iterator;
+
+    inline iterator begin() { return iterator(this, nextIndex(-1)); }
+    inline const_iterator begin() const { return const_iterator(this, nextIndex(-1)); }
+    inline const_iterator cbegin() const { return const_iterator(this, nextIndex(-1)); }
+    inline const_iterator constBegin() const { return const_iterator(this, nextIndex(-1)); }
+    inline iterator end() { return iterator(this, capacity()); }
+    inline const_iterator end() const { return const_iterator(this, capacity()); }
+    inline const_iterator cend() const { return const_iterator(this, capacity()); }
+    inline const_iterator constEnd() const { return const_iterator(this, capacity()); }
+
+    iterator erase(const_iterator it);
+    iterator find(const Key &key)
+    { const int i = findIndex(key); return i < 0 ? end() : iterator(this, i); }
+    const_iterator find(const Key &key) const
+    { return constFind(key); }
+    const_iterator constFind(const Key &key) const
+    { const int i = findIndex(key); return i < 0 ? constEnd() : const_iterator(this, i); }
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    int findIndex(const Key &key) const;
+    int findIndex(const Key &key, quint64 mixed) const;
+    int prepareInsert(quint64 mixed);
+    int findFree(quint64 mixed) const;
+    int nextIndex(int i) const;
+    void eraseAt(int i);
+    void rehash(int newGroupCount);
+    void freeData();
+
+    static int groupCountFor(int size)
+    {
+        // keep the load factor at or below 7/8
+        int groups = 1;
+        while (groups * Group::Width - groups * Group::Width / 8 < size)
+            groups *= 2;
+        return groups;
+    }
+    inline int maxLoad() const { return capacity() - capacity() / 8; }
+    inline int firstGroup(quint64 mixed) const
+    { return int((mixed >> 1) >> (63 - groupBits)); }
+
+    signed char *ctrl;
+    Node *nodes;
+    int groupCount;
+    int groupBits;
+    int sz;
+    int growthLeft;
+    uint seed;
+};
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatHash<Key, T>::QFlatHash(const QFlatHash &other)
+    : ctrl(nullptr), nodes(nullptr), groupCount(0), groupBits(0), sz(0), growthLeft(0),
+      seed(other.seed)
+{
+    if (!other.groupCount)
+        return;
+    const int cap = other.capacity();
+    ctrl = static_cast<signed char *>(::malloc(cap));
+    Q_CHECK_PTR(ctrl);
+    nodes = static_cast<Node *>(::malloc(cap * sizeof(Node)));
+    Q_CHECK_PTR(nodes);
+    memcpy(ctrl, other.ctrl, cap);
+    groupCount = other.groupCount;
+    groupBits = other.groupBits;
+    growthLeft = other.growthLeft;
+    for (int i = 0; i < cap; ++i) {
+        if (ctrl[i] >= 0) {
+            new (nodes + i) Node(other.nodes[i]);
+            ++sz;
+        }
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::freeData()
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        for (int i = 0, cap = capacity(); i < cap; ++i) {
+            if (ctrl[i] >= 0)
+                nodes[i].~Node();
+        }
+    }
+    ::free(ctrl);
+    ::free(nodes);
+    ctrl = nullptr;
+    nodes = nullptr;
+    groupCount = 0;
+    groupBits = 0;
+    sz = 0;
+    growthLeft = 0;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::clear()
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        for (int i = 0, cap = capacity(); i < cap; ++i) {
+            if (ctrl[i] >= 0)
+                nodes[i].~Node();
+        }
+    }
+    if (ctrl)
+        memset(ctrl, QFlatHashPrivate::Empty, capacity());
+    sz = 0;
+    growthLeft = maxLoad();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::reserve(int size)
+{
+    if (size > maxLoad())
+        rehash(groupCountFor(size));
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::rehash(int newGroupCount)
+{
+    Q_ASSERT(newGroupCount > 0);
+    Q_ASSERT(newGroupCount * Group::Width - newGroupCount * Group::Width / 8 >= sz);
+    signed char *oldCtrl = ctrl;
+    Node *oldNodes = nodes;
+    const int oldCapacity = capacity();
+
+    const int cap = newGroupCount * Group::Width;
+    ctrl = static_cast<signed char *>(::malloc(cap));
+    Q_CHECK_PTR(ctrl);
+    nodes = static_cast<Node *>(::malloc(cap * sizeof(Node)));
+    Q_CHECK_PTR(nodes);
+    memset(ctrl, QFlatHashPrivate::Empty, cap);
+    groupCount = newGroupCount;
+    groupBits = 0;
+    while ((1 << groupBits) < newGroupCount)
+        ++groupBits;
+    growthLeft = maxLoad() - sz;
+
+    for (int i = 0; i < oldCapacity; ++i) {
+        if (oldCtrl[i] < 0)
+            continue;
+        const quint64 mixed = QFlatHashPrivate::mixHash(qHash(oldNodes[i].key, seed));
+        const int j = findFree(mixed);
+        ctrl[j] = QFlatHashPrivate::h2(mixed);
+        if (QTypeInfo<Key>::isStatic || QTypeInfo<T>::isStatic) {
+            new (nodes + j) Node(std::move(oldNodes[i]));
+            oldNodes[i].~Node();
+        } else {
+            memcpy(static_cast<void *>(nodes + j), static_cast<const void *>(oldNodes + i), sizeof(Node));
+        }
+    }
+    ::free(oldCtrl);
+    ::free(oldNodes);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findFree(quint64 mixed) const
+{
+    const int groupMask = groupCount - 1;
+    int g = firstGroup(mixed);
+    for (int step = 1; ; ++step) {
+        const Group group(ctrl + g * Group::Width);
+        const Group::Mask free = group.matchFree();
+        if (free)
+            return g * Group::Width + QFlatHashPrivate::firstIndex(free);
+        g = (g + step) & groupMask;
+    }
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findIndex(const Key &key, quint64 mixed) const
+{
+    if (!groupCount)
+        return -1;
+    const signed char tag = QFlatHashPrivate::h2(mixed);
+    const int groupMask = groupCount - 1;
+    int g = firstGroup(mixed);
+    // triangular probing visits every group once the table is full
+    for (int step = 1; step <= groupCount; ++step) {
+        const signed char *groupCtrl = ctrl + g * Group::Width;
+        const Group group(groupCtrl);
+        for (Group::Mask m = group.match(tag); m; m &= m - 1) {
+            const int i = QFlatHashPrivate::firstIndex(m);
+            if (groupCtrl[i] == tag && nodes[g * Group::Width + i].key == key)
+                return g * Group::Width + i;
+        }
+        if (group.matchEmpty())
+            return -1;
+        g = (g + step) & groupMask;
+    }
+    return -1;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findIndex(const Key &key) const
+{
+    return groupCount ? findIndex(key, QFlatHashPrivate::mixHash(qHash(key, seed))) : -1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::prepareInsert(quint64 mixed)
+{
+    if (growthLeft == 0) {
+        // Reuse the slots of erased entries if they make up a large part
+        // of the table, otherwise grow.
+        if (groupCount && sz <= capacity() / 32 * 25)
+            rehash(groupCount);
+        else
+            rehash(groupCount ? groupCount * 2 : 1);
+    }
+    const int i = findFree(mixed);
+    if (ctrl[i] == QFlatHashPrivate::Empty)
+        --growthLeft;
+    ctrl[i] = QFlatHashPrivate::h2(mixed);
+    ++sz;
+    return i;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::nextIndex(int i) const
+{
+    const int cap = capacity();
+    while (++i < cap) {
+        if (ctrl[i] >= 0)
+            break;
+    }
+    return i;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::eraseAt(int i)
+{
+    nodes[i].~Node();
+    --sz;
+    // A group with an empty slot was never full, so no probe sequence
+    // continues past it and the slot can become empty again.
+    const int g = i / Group::Width;
+    if (Group(ctrl + g * Group::Width).matchEmpty()) {
+        ctrl[i] = QFlatHashPrivate::Empty;
+        ++growthLeft;
+    } else {
+        ctrl[i] = QFlatHashPrivate::Deleted;
+    }
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::insert(const Key &key, const T &value)
+{
+    const quint64 mixed = QFlatHashPrivate::mixHash(qHash(key, seed));
+    int i = findIndex(key, mixed);
+    if (i >= 0) {
+        nodes[i].setValue(value);
+        return iterator(this, i);
+    }
+    i = prepareInsert(mixed);
+    new (nodes + i) Node(key, value);
+    return iterator(this, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatHash<Key, T>::operator[](const Key &key)
+{
+    const quint64 mixed = QFlatHashPrivate::mixHash(qHash(key, seed));
+    int i = findIndex(key, mixed);
+    if (i < 0) {
+        i = prepareInsert(mixed);
+        new (nodes + i) Node(key, T());
+    }
+    return nodes[i].value;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::remove(const Key &key)
+{
+    const int i = findIndex(key);
+    if (i < 0)
+        return 0;
+    eraseAt(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatHash<Key, T>::take(const Key &key)
+{
+    const int i = findIndex(key);
+    if (i < 0)
+        return T();
+    T t = std::move(nodes[i].value);
+    eraseAt(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(const_iterator it)
+{
+    Q_ASSERT_X(it.h == this, "QFlatHash::erase", "The specified iterator argument 'it' is invalid");
+    Q_ASSERT(it.i >= 0 && it.i < capacity() && ctrl[it.i] >= 0);
+    eraseAt(it.i);
+    return iterator(this, nextIndex(it.i));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &key) const
+{
+    const int i = findIndex(key);
+    return i < 0 ? T() : nodes[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &key, const T &defaultValue) const
+{
+    const int i = findIndex(key);
+    return i < 0 ? defaultValue : nodes[i].value;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &value) const
+{
+    return key(value, Key());
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &value, const Key &defaultKey) const
+{
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it.value() == value)
+            return it.key();
+    }
+    return defaultKey;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    res.reserve(sz);
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.key());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    res.reserve(sz);
+    for (const_iterator it = begin(); it != end(); ++it)
+        res.append(it.value());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QFlatHash<Key, T>::operator==(const QFlatHash &other) const
+{
+    if (sz != other.sz)
+        return false;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        const int i = other.findIndex(it.key());
+        if (i < 0 || !(other.nodes[i].value == it.value()))
+            return false;
+    }
+    return true;
+}
+
+template <class T>
+class QFlatSet
+{
+    typedef QFlatHash<T, QFlatHashPrivate::DummyValue> Hash;
+
+public:
+    inline QFlatSet() Q_DECL_NOTHROW {}
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    inline QFlatSet(std::initializer_list<T> list)
+    {
+        reserve(int(list.size()));
+        for (typename std::initializer_list<T>::const_iterator it = list.begin(); it != list.end(); ++it)
+            insert(*it);
+    }
+#endif
+    // compiler-generated copy/move ctor/assignment operators are fine!
+    // compiler-generated destructor is fine!
+
+    inline void swap(QFlatSet &other) Q_DECL_NOTHROW { q_hash.swap(other.q_hash); }
+
+    bool operator==(const QFlatSet &other) const
+    {
+        if (size() != other.size())
+            return false;
+        for (const_iterator it = begin(); it != end(); ++it) {
+            if (!other.contains(*it))
+                return false;
+        }
+        return true;
+    }
+    inline bool operator!=(const QFlatSet &other) const { return !(*this == other); }
+
+    inline int size() const { return q_hash.size(); }
+    inline int count() const { return q_hash.size(); }
+    inline bool isEmpty() const { return q_hash.isEmpty(); }
+    inline int capacity() const { return q_hash.capacity(); }
+    inline void reserve(int size) { q_hash.reserve(size); }
+    inline void squeeze() { q_hash.squeeze(); }
+    inline void clear() { q_hash.clear(); }
+
+    inline bool remove(const T &value) { return q_hash.remove(value) != 0; }
+    inline bool contains(const T &value) const { return q_hash.contains(value); }
+
+    class const_iterator
+    {
+        friend class QFlatSet;
+        typename Hash::const_iterator i;
+        const_iterator(typename Hash::const_iterator it) : i(it) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() {}
+        inline const T &operator*() const { return i.key(); }
+        inline const T *operator->() const { return &i.key(); }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+        inline const_iterator &operator++() { ++i; return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++i; return r; }
+    };
+    typedef const_iterator iterator;
+
+    inline const_iterator insert(const T &value)
+    { return const_iterator(q_hash.insert(value, QFlatHashPrivate::DummyValue())); }
+    inline const_iterator erase(const_iterator it)
+    { return const_iterator(q_hash.erase(it.i)); }
+    inline const_iterator find(const T &value) const { return const_iterator(q_hash.find(value)); }
+    inline const_iterator constFind(const T &value) const { return find(value); }
+
+    inline const_iterator begin() const { return const_iterator(q_hash.begin()); }
+    inline const_iterator cbegin() const { return begin(); }
+    inline const_iterator constBegin() const { return begin(); }
+    inline const_iterator end() const { return const_iterator(q_hash.end()); }
+    inline const_iterator cend() const { return end(); }
+    inline const_iterator constEnd() const { return end(); }
+
+    QList<T> values() const { return q_hash.keys(); }
+
+    // STL compatibility
+    typedef T key_type;
+    typedef T value_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    Hash q_hash;
+};
+
+template <class Key, class T>
+inline void swap(QFlatHash<Key, T> &value1, QFlatHash<Key, T> &value2) Q_DECL_NOTHROW
+{ value1.swap(value2); }
+
+template <class T>
+inline void swap(QFlatSet<T> &value1, QFlatSet<T> &value2) Q_DECL_NOTHROW
+{ value1.swap(value2); }
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_H
@@ -0,0 +1,392 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+#include <initializer_list>
+#endif
+#include <iterator>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+
+template <class Key, class T>
+class QFlatMap
+{
+    struct KeyLessThan
+    {
+        bool operator()(const Key &key1, const Key &key2) const
+        { return qMapLessThanKey(key1, key2); }
+    };
+
+public:
+    inline QFlatMap() Q_DECL_NOTHROW {}
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatMap(std::initializer_list<std::pair<Key, T> > list);
+#endif
+    QFlatMap(const QVector<Key> &keys, const QVector<T> &values);
+    explicit QFlatMap(const QMap<Key, T> &map);
+    // compiler-generated copy/move ctor/assignment operators are fine!
+    // compiler-generated destructor is fine!
+
+    inline void swap(QFlatMap &other) Q_DECL_NOTHROW
+    { k.swap(other.k); v.swap(other.v); }
+
+    bool operator==(const QFlatMap &other) const
+    { return k == other.k && v == other.v; }
+    inline bool operator!=(const QFlatMap &other) const { return !(*this == other); }
+
+    inline int size() const { return k.size(); }
+    inline int count() const { return k.size(); }
+    inline bool isEmpty() const { return k.isEmpty(); }
+    inline int capacity() const { return k.capacity(); }
+    inline void reserve(int size) { k.reserve(size); v.reserve(size); }
+    inline void squeeze() { k.squeeze(); v.squeeze(); }
+    inline void clear() { *this = QFlatMap(); }
+
+    class iterator;
+    class const_iterator;
+
+    iterator insert(const Key &key, const T &value);
+    int remove(const Key &key);
+    T take(const Key &key);
+    inline bool contains(const Key &key) const { return indexOf(key) >= 0; }
+    inline int count(const Key &key) const { return contains(key) ? 1 : 0; }
+    const T value(const Key &key, const T &defaultValue = T()) const;
+    const Key key(const T &value, const Key &defaultKey = Key()) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const { return value(key); }
+    QList<Key> keys() const { return k.toList(); }
+    QList<T> values() const { return v.toList(); }
+
+    inline const Key &firstKey() const { Q_ASSERT(!isEmpty()); return k.first(); }
+    inline const Key &lastKey() const { Q_ASSERT(!isEmpty()); return k.last(); }
+    inline T &first() { Q_ASSERT(!isEmpty()); return v.first(); }
+    inline const T &first() const { Q_ASSERT(!isEmpty()); return v.first(); }
+    inline T &last() { Q_ASSERT(!isEmpty()); return v.last(); }
+    inline const T &last() const { Q_ASSERT(!isEmpty()); return v.last(); }
+
+    class iterator
+    {
+        friend class QFlatMap;
+        friend class const_iterator;
+        QFlatMap *m;
+        int i;
+        iterator(QFlatMap *map, int index) : m(map), i(index) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        Q_DECL_CONSTEXPR iterator() : m(nullptr), i(0) {}
+
+        inline const Key &key() const { return m->k.at(i); }
+        inline T &value() const { return m->v[i]; }
+        inline T &operator*() const { return value(); }
+        inline T *operator->() const { return &value(); }
+        inline bool operator==(const iterator &o) const { return i == o.i; }
+        inline bool operator!=(const iterator &o) const { return i != o.i; }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+
+        inline iterator &operator++() { ++i; return *this; }
+        inline iterator operator++(int) { iterator r = *this; ++i; return r; }
+        inline iterator &operator--() { --i; return *this; }
+        inline iterator operator--(int) { iterator r = *this; --i; return r; }
+        inline iterator operator+(int j) const { return iterator(m, i + j); }
+        inline iterator operator-(int j) const { return iterator(m, i - j); }
+        inline iterator &operator+=(int j) { i += j; return *this; }
+        inline iterator &operator-=(int j) { i -= j; return *this; }
+        inline int operator-(const iterator &o) const { return i - o.i; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class QFlatMap;
+        friend class iterator;
+        const QFlatMap *m;
+        int i;
+        const_iterator(const QFlatMap *map, int index) : m(map), i(index) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        Q_DECL_CONSTEXPR const_iterator() : m(nullptr), i(0) {}
+        inline const_iterator(const iterator &o) : m(o.m), i(o.i) {}
+
+        inline const Key &key() const { return m->k.at(i); }
+        inline const T &value() const { return m->v.at(i); }
+        inline const T &operator*() const { return value(); }
+        inline const T *operator->() const { return &value(); }
+        inline bool operator==(const const_iterator &o) const { return i == o.i; }
+        inline bool operator!=(const const_iterator &o) const { return i != o.i; }
+
+        inline const_iterator &operator++() { ++i; return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++i; return r; }
+        inline const_iterator &operator--() { --i; return *this; }
+        inline const_iterator operator--(int) { const_iterator r = *this; --i; return r; }
+        inline const_iterator operator+(int j) const { return const_iterator(m, i + j); }
+        inline const_iterator operator-(int j) const { return const_iterator(m, i - j); }
+        inline const_iterator &operator+=(int j) { i += j; return *this; }
+        inline const_iterator &operator-=(int j) { i -= j; return *this; }
+        inline int operator-(const const_iterator &o) const { return i - o.i; }
+    };
+    friend class const_iterator;
+
+    typedef typename QVector<Key>::const_iterator key_iterator;
+
+    inline iterator begin() { return iterator(this, 0); }
+    inline const_iterator begin() const { return const_iterator(this, 0); }
+    inline const_iterator cbegin() const { return const_iterator(this, 0); }
+    inline const_iterator constBegin() const { return const_iterator(this, 0); }
+    inline iterator end() { return iterator(this, size()); }
+    inline const_iterator end() const { return const_iterator(this, size()); }
+    inline const_iterator cend() const { return const_iterator(this, size()); }
+    inline const_iterator constEnd() const { return const_iterator(this, size()); }
+    inline key_iterator keyBegin() const { return k.constBegin(); }
+    inline key_iterator keyEnd() const { return k.constEnd(); }
+
+    iterator erase(iterator it);
+    iterator find(const Key &key)
+    { const int i = indexOf(key); return i < 0 ? end() : iterator(this, i); }
+    const_iterator find(const Key &key) const
+    { return constFind(key); }
+    const_iterator constFind(const Key &key) const
+    { const int i = indexOf(key); return i < 0 ? constEnd() : const_iterator(this, i); }
+    iterator lowerBound(const Key &key)
+    { return iterator(this, lowerIndex(key)); }
+    const_iterator lowerBound(const Key &key) const
+    { return const_iterator(this, lowerIndex(key)); }
+    iterator upperBound(const Key &key)
+    { return iterator(this, upperIndex(key)); }
+    const_iterator upperBound(const Key &key) const
+    { return const_iterator(this, upperIndex(key)); }
+
+    // STL compatibility
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef qptrdiff difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    int lowerIndex(const Key &key) const
+    {
+        // Branch-free binary search: the compiler turns the selection into
+        // a conditional move, which avoids a mispredicted branch at almost
+        // every step once the keys don't fit the branch predictor anymore.
+        int len = k.size();
+        if (!len)
+            return 0;
+        const Key *first = k.constData();
+        const Key *base = first;
+        while (len > 1) {
+            const int half = len / 2;
+            base = qMapLessThanKey(base[half], key) ? base + half : base;
+            len -= half;
+        }
+        return int(base - first) + (qMapLessThanKey(*base, key) ? 1 : 0);
+    }
+    int upperIndex(const Key &key) const
+    { return int(std::upper_bound(k.constBegin(), k.constEnd(), key, KeyLessThan()) - k.constBegin()); }
+    int indexOf(const Key &key) const
+    {
+        const int i = lowerIndex(key);
+        return (i < k.size() && !qMapLessThanKey(key, k.at(i))) ? i : -1;
+    }
+
+    QVector<Key> k;
+    QVector<T> v;
+};
+
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(std::initializer_list<std::pair<Key, T> > list)
+{
+    QVector<Key> keys;
+    QVector<T> values;
+    keys.reserve(int(list.size()));
+    values.reserve(int(list.size()));
+    for (typename std::initializer_list<std::pair<Key, T> >::const_iterator it = list.begin(); it != list.end(); ++it) {
+        keys.append(it->first);
+        values.append(it->second);
+    }
+    QFlatMap(keys, values).swap(*this);
+}
+#endif
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(const QVector<Key> &keys, const QVector<T> &values)
+{
+    Q_ASSERT_X(keys.size() == values.size(), "QFlatMap::QFlatMap", "keys and values differ in size");
+
+    // Sort the positions rather than the items, so that neither keys nor
+    // values are copied more than once. The sort is stable, so for
+    // duplicate keys the last value wins, as if the items were inserted
+    // one after the other.
+    const int n = keys.size();
+    QVector<int> order(n);
+    for (int i = 0; i < n; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return qMapLessThanKey(keys.at(a), keys.at(b));
+    });
+
+    k.reserve(n);
+    v.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const int j = order.at(i);
+        if (i + 1 < n && !qMapLessThanKey(keys.at(j), keys.at(order.at(i + 1))))
+            continue;
+        k.append(keys.at(j));
+        v.append(values.at(j));
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QFlatMap<Key, T>::QFlatMap(const QMap<Key, T> &map)
+{
+    k.reserve(map.size());
+    v.reserve(map.size());
+    for (typename QMap<Key, T>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        // a QMap may hold several values per key, keep the most recent one
+        if (!k.isEmpty() && !qMapLessThanKey(k.last(), it.key()))
+            continue;
+        k.append(it.key());
+        v.append(it.value());
+    }
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::insert(const Key &key, const T &value)
+{
+    const int i = lowerIndex(key);
+    if (i < k.size() && !qMapLessThanKey(key, k.at(i))) {
+        v[i] = value;
+    } else {
+        k.insert(i, key);
+        v.insert(i, value);
+    }
+    return iterator(this, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatMap<Key, T>::operator[](const Key &key)
+{
+    const int i = lowerIndex(key);
+    if (i == k.size() || qMapLessThanKey(key, k.at(i))) {
+        k.insert(i, key);
+        v.insert(i, T());
+    }
+    return v[i];
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatMap<Key, T>::remove(const Key &key)
+{
+    const int i = indexOf(key);
+    if (i < 0)
+        return 0;
+    k.remove(i);
+    v.remove(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatMap<Key, T>::take(const Key &key)
+{
+    const int i = indexOf(key);
+    if (i < 0)
+        return T();
+    T t = v.at(i);
+    k.remove(i);
+    v.remove(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatMap<Key, T>::iterator QFlatMap<Key, T>::erase(iterator it)
+{
+    Q_ASSERT_X(it.m == this, "QFlatMap::erase", "The specified iterator argument 'it' is invalid");
+    Q_ASSERT(it.i >= 0 && it.i < size());
+    k.remove(it.i);
+    v.remove(it.i);
+    return it;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T>::value(const Key &key, const T &defaultValue) const
+{
+    const int i = indexOf(key);
+    return i < 0 ? defaultValue : v.at(i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatMap<Key, T>::key(const T &value, const Key &defaultKey) const
+{
+    const int i = v.indexOf(value);
+    return i < 0 ? defaultKey : k.at(i);
+}
+
+template <class Key, class T>
+inline void swap(QFlatMap<Key, T> &value1, QFlatMap<Key, T> &value2) Q_DECL_NOTHROW
+{ value1.swap(value2); }
+
+QT_END_NAMESPACE
+
+#endif // QFLATMAP_H
@@ -111,6 +111,9 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
         return 72;
+    case QCryptographicHash::Crc32c:
+        // not a hash function; HMAC is not defined for it
+        break;
     }
     return 0;
 }
@@ -129,12 +132,13 @@ public:
     QCryptographicHash::Algorithm method;
     bool messageHashInited;
 
+    bool isSupported() const { return method != QCryptographicHash::Crc32c; }
     void initMessageHash();
 };
 
 void QMessageAuthenticationCodePrivate::initMessageHash()
 {
-    if (messageHashInited)
+    if (messageHashInited || !isSupported())
         return;
     messageHashInited = true;
 
@@ -175,7 +179,8 @@ void QMessageAuthenticationCodePrivate::initMessageHash()
     \reentrant
 
     QMessageAuthenticationCode supports all cryptographic hashes which are supported by
-    QCryptographicHash.
+    QCryptographicHash. QCryptographicHash::Crc32c is a checksum, not a cryptographic
+    hash, and is rejected: the result is an empty QByteArray.
 
     To generate message authentication code, pass hash algorithm QCryptographicHash::Algorithm
     to constructor, then set key and message by setKey() and addData() functions. Result
@@ -269,6 +274,11 @@ QByteArray QMessageAuthenticationCode::result() const
     if (!d->result.isEmpty())
         return d->result;
 
+    if (!d->isSupported()) {
+        qWarning("QMessageAuthenticationCode: QCryptographicHash::Crc32c is not supported");
+        return QByteArray();
+    }
+
     d->initMessageHash();
 
     const int blockSize = qt_hash_block_size(d->method);
@@ -0,0 +1,563 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmultistringmatcher.h"
+#include "qflathash.h"
+#include "qvector.h"
+
+#include <private/qsimd_p.h>
+
+#include <algorithm>
+#include <limits.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The matcher is a variant of the Teddy algorithm: the patterns are
+    spread over eight buckets, and for each of the first (up to) three
+    positions of a pattern a table records which buckets have a pattern
+    with a given byte at that position. A position in the input is a
+    candidate if some bucket has a pattern matching all of those bytes.
+
+    The SIMD versions split each byte into its two nibbles and look both
+    up in 16-byte tables with PSHUFB, checking 16 (SSSE3) or 32 (AVX2)
+    positions at a time. That overestimates slightly, which is fine: every
+    candidate is verified by looking up the first units of the input in a
+    hash of the pattern prefixes and comparing the patterns found there.
+
+    UTF-16 input is narrowed to bytes with unsigned saturation (PACKUSWB)
+    for the filter. foldUnit() applies the same conversion to the
+    patterns and in the scalar code, so all versions find the same
+    candidates.
+*/
+
+enum {
+    BucketCount = 8,
+    MaxMaskLength = 3
+};
+
+struct QMultiStringMatcherTable
+{
+    int minLength;
+    int maskLength;
+    int keyLength;
+    int firstEmpty;
+    // patterns sharing a prefix key, linked in increasing index order
+    QFlatHash<quint64, int> heads;
+    QVector<int> next;
+    uchar exact[MaxMaskLength][256];
+    uchar lo[MaxMaskLength][16];
+    uchar hi[MaxMaskLength][16];
+};
+
+class QMultiStringMatcherPrivate
+{
+public:
+    void rebuild();
+
+    QVector<QByteArray> bytePatterns;
+    QVector<QString> stringPatterns;
+    QMultiStringMatcherTable byteTable;
+    QMultiStringMatcherTable stringTable;
+};
+
+static inline uchar foldUnit(uchar c)
+{
+    return c;
+}
+
+static inline uchar foldUnit(ushort c)
+{
+    // same as PACKUSWB, which treats its input as signed
+    return c >= 0x8000 ? 0 : c > 0xff ? 0xff : uchar(c);
+}
+
+static inline const uchar *unitData(const QByteArray &pattern)
+{
+    return reinterpret_cast<const uchar *>(pattern.constData());
+}
+
+static inline const ushort *unitData(const QString &pattern)
+{
+    return pattern.utf16();
+}
+
+template <typename Char>
+static inline quint64 prefixKey(const Char *p, int keyLength)
+{
+    quint64 key = 0;
+    for (int k = 0; k < keyLength; ++k)
+        key |= quint64(p[k]) << (k * 8 * sizeof(Char));
+    return key;
+}
+
+template <typename Char, typename Pattern>
+static void buildTable(QMultiStringMatcherTable &t, const QVector<Pattern> &patterns)
+{
+    t.minLength = INT_MAX;
+    t.firstEmpty = -1;
+    t.heads.clear();
+    t.next.fill(-1, patterns.size());
+    memset(t.exact, 0, sizeof(t.exact));
+    memset(t.lo, 0, sizeof(t.lo));
+    memset(t.hi, 0, sizeof(t.hi));
+
+    QVector<int> order;
+    order.reserve(patterns.size());
+    for (int i = 0; i < patterns.size(); ++i) {
+        const int len = patterns.at(i).size();
+        if (len == 0) {
+            if (t.firstEmpty < 0)
+                t.firstEmpty = i;
+            continue;
+        }
+        order.append(i);
+        t.minLength = qMin(t.minLength, len);
+    }
+    if (order.isEmpty()) {
+        t.minLength = t.maskLength = t.keyLength = 0;
+        return;
+    }
+    t.maskLength = qMin(t.minLength, int(MaxMaskLength));
+    t.keyLength = qMin(t.minLength, int(sizeof(quint64) / sizeof(Char)));
+
+    // Patterns with similar prefixes share a bucket, which keeps the
+    // filter selective.
+    const int maskLength = t.maskLength;
+    std::sort(order.begin(), order.end(), [&patterns, maskLength](int a, int b) {
+        const Char *pa = unitData(patterns.at(a));
+        const Char *pb = unitData(patterns.at(b));
+        for (int j = 0; j < maskLength; ++j) {
+            if (foldUnit(pa[j]) != foldUnit(pb[j]))
+                return foldUnit(pa[j]) < foldUnit(pb[j]);
+        }
+        return a < b;
+    });
+    for (int r = 0; r < order.size(); ++r) {
+        const Char *p = unitData(patterns.at(order.at(r)));
+        const uchar bit = uchar(1U << (qint64(r) * BucketCount / order.size()));
+        for (int j = 0; j < maskLength; ++j) {
+            const uchar c = foldUnit(p[j]);
+            t.exact[j][c] |= bit;
+            t.lo[j][c & 0xf] |= bit;
+            t.hi[j][c >> 4] |= bit;
+        }
+    }
+
+    t.heads.reserve(order.size());
+    for (int i = patterns.size() - 1; i >= 0; --i) {
+        if (patterns.at(i).isEmpty())
+            continue;
+        const quint64 key = prefixKey(unitData(patterns.at(i)), t.keyLength);
+        QFlatHash<quint64, int>::iterator it = t.heads.find(key);
+        if (it == t.heads.end()) {
+            t.heads.insert(key, i);
+        } else {
+            t.next[i] = *it;
+            *it = i;
+        }
+    }
+}
+
+// Returns the lowest index of the patterns that occur at \a pos, or -1.
+template <typename Char, typename Pattern>
+static inline int matchAt(const QMultiStringMatcherTable &t, const QVector<Pattern> &patterns,
+                          const Char *d, int n, int pos)
+{
+    QFlatHash<quint64, int>::const_iterator it = t.heads.constFind(prefixKey(d + pos, t.keyLength));
+    if (it == t.heads.constEnd())
+        return -1;
+    for (int p = *it; p >= 0; p = t.next.at(p)) {
+        const Pattern &pattern = patterns.at(p);
+        if (pattern.size() <= n - pos
+                && memcmp(unitData(pattern), d + pos, pattern.size() * sizeof(Char)) == 0) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+template <typename Char, typename Pattern>
+static int scanScalar(const QMultiStringMatcherTable &t, const QVector<Pattern> &patterns,
+                      const Char *d, int n, int end, int i, int *which)
+{
+    for ( ; i < end; ++i) {
+        uint buckets = t.exact[0][foldUnit(d[i])];
+        for (int j = 1; buckets && j < t.maskLength; ++j)
+            buckets &= t.exact[j][foldUnit(d[i + j])];
+        if (!buckets)
+            continue;
+        const int p = matchAt(t, patterns, d, n, i);
+        if (p >= 0) {
+            if (which)
+                *which = p;
+            return i;
+        }
+    }
+    return -1;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+QT_FUNCTION_TARGET(SSSE3)
+static inline __m128i loadBytes(const uchar *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static inline __m128i loadBytes(const ushort *p)
+{
+    return _mm_packus_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8)));
+}
+
+// Scans blocks of 16 positions starting at \a i. Returns the position of
+// the first match, or -1 with \a i set to where the scalar code has to
+// continue.
+template <typename Char, typename Pattern>
+QT_FUNCTION_TARGET(SSSE3)
+static int scanSsse3(const QMultiStringMatcherTable &t, const QVector<Pattern> &patterns,
+                     const Char *d, int n, int end, int &i, int *which)
+{
+    const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+    __m128i lo[MaxMaskLength];
+    __m128i hi[MaxMaskLength];
+    for (int j = 0; j < t.maskLength; ++j) {
+        lo[j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t.lo[j]));
+        hi[j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t.hi[j]));
+    }
+
+    for ( ; i < end && i + 16 + t.maskLength - 1 <= n; i += 16) {
+        __m128i buckets = _mm_set1_epi8(-1);
+        for (int j = 0; j < t.maskLength; ++j) {
+            const __m128i bytes = loadBytes(d + i + j);
+            const __m128i l = _mm_shuffle_epi8(lo[j], _mm_and_si128(bytes, nibbleMask));
+            const __m128i h = _mm_shuffle_epi8(hi[j], _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+            buckets = _mm_and_si128(buckets, _mm_and_si128(l, h));
+        }
+        uint candidates = uint(_mm_movemask_epi8(_mm_cmpeq_epi8(buckets, _mm_setzero_si128()))) ^ 0xffffU;
+        for ( ; candidates; candidates &= candidates - 1) {
+            const int pos = i + int(qCountTrailingZeroBits(candidates));
+            if (pos >= end) {
+                i = end;
+                return -1;
+            }
+            const int p = matchAt(t, patterns, d, n, pos);
+            if (p >= 0) {
+                if (which)
+                    *which = p;
+                return pos;
+            }
+        }
+    }
+    return -1;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i loadBytes256(const uchar *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i loadBytes256(const ushort *p)
+{
+    // PACKUSWB works per 128-bit lane, put the quadwords back in order
+    const __m256i packed = _mm256_packus_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)),
+                                               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 16)));
+    return _mm256_permute4x64_epi64(packed, 0xd8);
+}
+
+// Same as scanSsse3(), 32 positions at a time.
+template <typename Char, typename Pattern>
+QT_FUNCTION_TARGET(AVX2)
+static int scanAvx2(const QMultiStringMatcherTable &t, const QVector<Pattern> &patterns,
+                    const Char *d, int n, int end, int &i, int *which)
+{
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+    __m256i lo[MaxMaskLength];
+    __m256i hi[MaxMaskLength];
+    for (int j = 0; j < t.maskLength; ++j) {
+        lo[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(t.lo[j])));
+        hi[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(t.hi[j])));
+    }
+
+    for ( ; i < end && i + 32 + t.maskLength - 1 <= n; i += 32) {
+        __m256i buckets = _mm256_set1_epi8(-1);
+        for (int j = 0; j < t.maskLength; ++j) {
+            const __m256i bytes = loadBytes256(d + i + j);
+            const __m256i l = _mm256_shuffle_epi8(lo[j], _mm256_and_si256(bytes, nibbleMask));
+            const __m256i h = _mm256_shuffle_epi8(hi[j], _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask));
+            buckets = _mm256_and_si256(buckets, _mm256_and_si256(l, h));
+        }
+        uint candidates = ~uint(_mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets, _mm256_setzero_si256())));
+        for ( ; candidates; candidates &= candidates - 1) {
+            const int pos = i + int(qCountTrailingZeroBits(candidates));
+            if (pos >= end) {
+                i = end;
+                return -1;
+            }
+            const int p = matchAt(t, patterns, d, n, pos);
+            if (p >= 0) {
+                if (which)
+                    *which = p;
+                return pos;
+            }
+        }
+    }
+    return -1;
+}
+#endif
+
+template <typename Char, typename Pattern>
+static int findIn(const QMultiStringMatcherTable &t, const QVector<Pattern> &patterns,
+                  const Char *d, int n, int from, int *which)
+{
+    if (from < 0)
+        from = 0;
+    if (t.firstEmpty >= 0) {
+        // the empty pattern matches right away, unless a pattern with a
+        // lower index matches at the same position
+        if (from > n)
+            return -1;
+        const int p = t.maskLength && from + t.minLength <= n ? matchAt(t, patterns, d, n, from) : -1;
+        if (which)
+            *which = (p >= 0 && p < t.firstEmpty) ? p : t.firstEmpty;
+        return from;
+    }
+    if (!t.maskLength)
+        return -1;
+
+    const int end = n - t.minLength + 1;
+    int i = from;
+    int pos = -1;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        pos = scanAvx2(t, patterns, d, n, end, i, which);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (pos < 0 && qCpuHasFeature(SSSE3))
+        pos = scanSsse3(t, patterns, d, n, end, i, which);
+#endif
+    if (pos < 0)
+        pos = scanScalar(t, patterns, d, n, end, i, which);
+    return pos;
+}
+
+void QMultiStringMatcherPrivate::rebuild()
+{
+    buildTable<uchar>(byteTable, bytePatterns);
+    buildTable<ushort>(stringTable, stringPatterns);
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 5.12
+    \brief The QMultiStringMatcher class finds the first occurrence of any of a set of patterns.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Searching a text for many different keywords by calling
+    QByteArray::indexOf() or QString::indexOf() for each of them reads
+    the text once per keyword. QMultiStringMatcher prepares the set of
+    patterns once and then finds the first occurrence of any of them
+    in a single pass over the text.
+
+    The patterns can be searched for both in byte arrays, where they
+    are encoded as UTF-8, and in UTF-16 strings. indexIn() returns the
+    position of the leftmost match. If several patterns start at that
+    position, the one that comes first in the list of patterns is
+    reported.
+
+    \snippet code/src_corelib_tools_qmultistringmatcher.cpp 0
+
+    On x86 processors with SSSE3 or AVX2, QMultiStringMatcher checks 16
+    or 32 positions of the text at a time against the first bytes of
+    all patterns, and only compares whole patterns where these match.
+    The comparison is case sensitive.
+
+    \sa QByteArrayMatcher, QStringMatcher
+*/
+
+/*!
+    Constructs an empty matcher that won't match anything.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate)
+{
+    d->rebuild();
+}
+
+/*!
+    Constructs a matcher that searches for any of the \a patterns.
+    When searching in a QString or QStringView, the patterns are
+    decoded from UTF-8.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QList<QByteArray> &patterns)
+    : d(new QMultiStringMatcherPrivate)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Constructs a matcher that searches for any of the \a patterns.
+    When searching in a QByteArray, the patterns are encoded as UTF-8.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns)
+    : d(new QMultiStringMatcherPrivate)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Copies the \a other matcher to this matcher.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other)
+    : d(new QMultiStringMatcherPrivate(*other.d))
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher()
+{
+    delete d;
+}
+
+/*!
+    Assigns the \a other matcher to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other)
+{
+    if (this != &other)
+        *d = *other.d;
+    return *this;
+}
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    \sa patterns()
+*/
+void QMultiStringMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    d->bytePatterns = patterns.toVector();
+    d->stringPatterns.clear();
+    d->stringPatterns.reserve(patterns.size());
+    for (const QByteArray &pattern : patterns)
+        d->stringPatterns.append(QString::fromUtf8(pattern));
+    d->rebuild();
+}
+
+/*!
+    \overload
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d->stringPatterns = patterns.toVector();
+    d->bytePatterns.clear();
+    d->bytePatterns.reserve(patterns.size());
+    for (const QString &pattern : patterns)
+        d->bytePatterns.append(pattern.toUtf8());
+    d->rebuild();
+}
+
+/*!
+    Returns the patterns this matcher searches for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->stringPatterns.toList();
+}
+
+/*!
+    Returns the number of patterns.
+*/
+int QMultiStringMatcher::patternCount() const
+{
+    return d->stringPatterns.size();
+}
+
+/*!
+    Searches the byte array \a ba, from byte position \a from (default
+    0, i.e. from the first byte), for the first occurrence of any of
+    the patterns. Returns the position of the match, or -1 if none of
+    the patterns occurs.
+
+    If \a pattern is not null, the index of the pattern that matched
+    is stored in the variable it points to.
+*/
+int QMultiStringMatcher::indexIn(const QByteArray &ba, int from, int *pattern) const
+{
+    return findIn(d->byteTable, d->bytePatterns, reinterpret_cast<const uchar *>(ba.constData()),
+                  ba.size(), from, pattern);
+}
+
+/*!
+    \overload
+
+    Searches the char string \a str, which has length \a len.
+*/
+int QMultiStringMatcher::indexIn(const char *str, int len, int from, int *pattern) const
+{
+    return findIn(d->byteTable, d->bytePatterns, reinterpret_cast<const uchar *>(str),
+                  len, from, pattern);
+}
+
+/*!
+    \overload
+
+    Searches the string \a str, from character position \a from.
+*/
+int QMultiStringMatcher::indexIn(QStringView str, int from, int *pattern) const
+{
+    return findIn(d->stringTable, d->stringPatterns, reinterpret_cast<const ushort *>(str.utf16()),
+                  int(str.size()), from, pattern);
+}
+
+QT_END_NAMESPACE
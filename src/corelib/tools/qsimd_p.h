@@ -257,7 +257,7 @@
 #define QT_FUNCTION_TARGET_STRING_BMI           "bmi"
 #define QT_FUNCTION_TARGET_STRING_BMI2          "bmi2"
 #define QT_FUNCTION_TARGET_STRING_RDSEED        "rdseed"
-#define QT_FUNCTION_TARGET_STRING_SHA           "sha"
+#define QT_FUNCTION_TARGET_STRING_SHA           "sha,sse4.1"
 
 #endif  /* Q_PROCESSOR_X86 */
 
@@ -3511,6 +3511,13 @@ int qFindString(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle0[0], from, cs);
 
+#ifdef __SSE2__
+    QStringFirstLastFilter filter;
+    if (qt_init_first_last_filter(&filter, reinterpret_cast<const ushort *>(needle0), sl, cs))
+        return qt_first_last_find(reinterpret_cast<const ushort *>(haystack0), l, from,
+                                  reinterpret_cast<const ushort *>(needle0), sl, filter, cs);
+#endif
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
@@ -11473,6 +11480,28 @@ bool QtPrivate::endsWith(QLatin1String haystack, QLatin1String needle, Qt::CaseS
     return qt_ends_with_impl(haystack, needle, cs);
 }
 
+/*!
+    \fn qsizetype QtPrivate::findString(QStringView haystack, qsizetype from, QStringView needle, Qt::CaseSensitivity cs)
+    \since 5.12
+    \internal
+    \relates QStringView
+
+    Returns the index position of the first occurrence of \a needle in
+    \a haystack, searching forward from index position \a from.
+    Returns -1 if \a needle is not found.
+
+    If \a cs is Qt::CaseSensitive (the default), the search is case-sensitive;
+    otherwise the search is case-insensitive.
+
+    \sa QString::indexOf(), QStringView::indexOf()
+*/
+
+qsizetype QtPrivate::findString(QStringView haystack, qsizetype from, QStringView needle, Qt::CaseSensitivity cs) Q_DECL_NOTHROW
+{
+    return qFindString(haystack.data(), int(haystack.size()), int(from),
+                       needle.data(), int(needle.size()), cs);
+}
+
 /*!
     \since 4.8
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qstringmatcher.h"
+#include "qsimd_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -120,6 +121,162 @@ static inline int bm_find(const ushort *uc, uint l, int index, const ushort *puc
     return -1; // not found
 }
 
+#ifdef __SSE2__
+/*
+    The first/last character filter compares the first and the last
+    character of the needle against a whole block of haystack positions at
+    once and only verifies the positions where both of them match. For the
+    short needles typically searched for, this beats the skip table by far.
+
+    In case-insensitive mode we need to know every character that folds to
+    the same character as the needle's first and last one. We only do that
+    for Latin-1 characters whose case partners are in Latin-1, too; all
+    others fall back to the skip table.
+*/
+struct QStringFirstLastFilter
+{
+    ushort first[2];
+    ushort last[2];
+};
+
+static inline bool qt_latin1_case_variants(ushort c, ushort *variants)
+{
+    // characters with case partners outside of Latin-1
+    switch (c) {
+    case 'K': case 'k':     // KELVIN SIGN
+    case 'S': case 's':     // LATIN SMALL LETTER LONG S
+    case 0xb5:              // MICRO SIGN folds to GREEK SMALL LETTER MU
+    case 0xc5: case 0xe5:   // ANGSTROM SIGN
+    case 0xdf:              // LATIN CAPITAL LETTER SHARP S
+    case 0xff:              // LATIN CAPITAL LETTER Y WITH DIAERESIS
+        return false;
+    default:
+        break;
+    }
+    if (c > 0xff)
+        return false;
+    variants[0] = QChar::toLower(c);
+    variants[1] = QChar::toUpper(c);
+    return true;
+}
+
+static inline bool qt_init_first_last_filter(QStringFirstLastFilter *filter, const ushort *needle,
+                                             int needleLen, Qt::CaseSensitivity cs)
+{
+    if (needleLen < 2)
+        return false;
+    const ushort first = needle[0];
+    const ushort last = needle[needleLen - 1];
+    if (cs == Qt::CaseSensitive) {
+        filter->first[0] = filter->first[1] = first;
+        filter->last[0] = filter->last[1] = last;
+        return true;
+    }
+    return qt_latin1_case_variants(first, filter->first)
+            && qt_latin1_case_variants(last, filter->last);
+}
+
+static inline bool qt_first_last_verify(const ushort *candidate, const ushort *needle,
+                                        int needleLen, Qt::CaseSensitivity cs)
+{
+    // the first and the last characters are known to match already
+    if (cs == Qt::CaseSensitive)
+        return memcmp(candidate + 1, needle + 1, (needleLen - 2) * sizeof(ushort)) == 0;
+    return QtPrivate::compareStrings(QStringView(candidate, needleLen),
+                                     QStringView(needle, needleLen), cs) == 0;
+}
+
+// Processes the positions [*index, end) in blocks of 8 and leaves the
+// remainder to the caller.
+static int qt_first_last_find_sse2(const ushort *haystack, int *index, int end,
+                                   const ushort *needle, int needleLen,
+                                   const QStringFirstLastFilter &filter, Qt::CaseSensitivity cs)
+{
+    const __m128i first0 = _mm_set1_epi16(filter.first[0]);
+    const __m128i first1 = _mm_set1_epi16(filter.first[1]);
+    const __m128i last0 = _mm_set1_epi16(filter.last[0]);
+    const __m128i last1 = _mm_set1_epi16(filter.last[1]);
+    int i = *index;
+    for ( ; i + 8 <= end; i += 8) {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + needleLen - 1));
+        const __m128i eqFirst = _mm_or_si128(_mm_cmpeq_epi16(f, first0), _mm_cmpeq_epi16(f, first1));
+        const __m128i eqLast = _mm_or_si128(_mm_cmpeq_epi16(l, last0), _mm_cmpeq_epi16(l, last1));
+        uint mask = _mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast));
+        while (mask) {
+            // two bits per character
+            const int candidate = i + qCountTrailingZeroBits(mask) / 2;
+            if (qt_first_last_verify(haystack + candidate, needle, needleLen, cs))
+                return candidate;
+            mask &= mask - 1;
+            mask &= mask - 1;
+        }
+    }
+    *index = i;
+    return -1;
+}
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static int qt_first_last_find_avx2(const ushort *haystack, int *index, int end,
+                                   const ushort *needle, int needleLen,
+                                   const QStringFirstLastFilter &filter, Qt::CaseSensitivity cs)
+{
+    const __m256i first0 = _mm256_set1_epi16(filter.first[0]);
+    const __m256i first1 = _mm256_set1_epi16(filter.first[1]);
+    const __m256i last0 = _mm256_set1_epi16(filter.last[0]);
+    const __m256i last1 = _mm256_set1_epi16(filter.last[1]);
+    int i = *index;
+    for ( ; i + 16 <= end; i += 16) {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + needleLen - 1));
+        const __m256i eqFirst = _mm256_or_si256(_mm256_cmpeq_epi16(f, first0), _mm256_cmpeq_epi16(f, first1));
+        const __m256i eqLast = _mm256_or_si256(_mm256_cmpeq_epi16(l, last0), _mm256_cmpeq_epi16(l, last1));
+        uint mask = _mm256_movemask_epi8(_mm256_and_si256(eqFirst, eqLast));
+        while (mask) {
+            const int candidate = i + qCountTrailingZeroBits(mask) / 2;
+            if (qt_first_last_verify(haystack + candidate, needle, needleLen, cs))
+                return candidate;
+            mask &= mask - 1;
+            mask &= mask - 1;
+        }
+    }
+    *index = i;
+    return -1;
+}
+#endif
+
+static int qt_first_last_find(const ushort *haystack, int haystackLen, int from,
+                              const ushort *needle, int needleLen,
+                              const QStringFirstLastFilter &filter, Qt::CaseSensitivity cs)
+{
+    // one past the last position where the needle fits
+    const int end = haystackLen - needleLen + 1;
+    if (from >= end)
+        return -1;
+    int i = from;
+    int result;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        result = qt_first_last_find_avx2(haystack, &i, end, needle, needleLen, filter, cs);
+        if (result >= 0)
+            return result;
+    }
+#endif
+    result = qt_first_last_find_sse2(haystack, &i, end, needle, needleLen, filter, cs);
+    if (result >= 0)
+        return result;
+    const ushort *last = haystack + needleLen - 1;
+    for ( ; i < end; ++i) {
+        if ((haystack[i] == filter.first[0] || haystack[i] == filter.first[1])
+                && (last[i] == filter.last[0] || last[i] == filter.last[1])
+                && qt_first_last_verify(haystack + i, needle, needleLen, cs))
+            return i;
+    }
+    return -1;
+}
+#endif // __SSE2__
+
 /*!
     \class QStringMatcher
     \inmodule QtCore
@@ -267,11 +424,7 @@ void QStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
 */
 int QStringMatcher::indexIn(const QString &str, int from) const
 {
-    if (from < 0)
-        from = 0;
-    return bm_find((const ushort *)str.unicode(), str.size(), from,
-                   (const ushort *)p.uc, p.len,
-                   p.q_skiptable, q_cs);
+    return int(indexIn(QStringView(str.unicode(), str.size()), from));
 }
 
 /*!
@@ -287,12 +440,33 @@ int QStringMatcher::indexIn(const QString &str, int from) const
     \sa setPattern(), setCaseSensitivity()
 */
 int QStringMatcher::indexIn(const QChar *str, int length, int from) const
+{
+    return int(indexIn(QStringView(str, length), from));
+}
+
+/*!
+    \since 5.12
+
+    Searches the string \a str from character position \a from
+    (default 0, i.e. from the first character), for the string
+    pattern() that was set in the constructor or in the most recent
+    call to setPattern(). Returns the position where the pattern()
+    matched in \a str, or -1 if no match was found.
+
+    \sa setPattern(), setCaseSensitivity()
+*/
+qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
 {
     if (from < 0)
         from = 0;
-    return bm_find((const ushort *)str, length, from,
-                   (const ushort *)p.uc, p.len,
-                   p.q_skiptable, q_cs);
+    const ushort *haystack = reinterpret_cast<const ushort *>(str.data());
+    const ushort *needle = reinterpret_cast<const ushort *>(p.uc);
+#ifdef __SSE2__
+    QStringFirstLastFilter filter;
+    if (qt_init_first_last_filter(&filter, needle, p.len, q_cs))
+        return qt_first_last_find(haystack, int(str.size()), int(from), needle, p.len, filter, q_cs);
+#endif
+    return bm_find(haystack, uint(str.size()), int(from), needle, p.len, p.q_skiptable, q_cs);
 }
 
 /*!
@@ -65,6 +65,7 @@ public:
 
     int indexIn(const QString &str, int from = 0) const;
     int indexIn(const QChar *str, int length, int from = 0) const;
+    qsizetype indexIn(QStringView str, qsizetype from = 0) const;
     QString pattern() const;
     inline Qt::CaseSensitivity caseSensitivity() const { return q_cs; }
 
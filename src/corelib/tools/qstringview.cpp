@@ -712,6 +712,36 @@ QT_BEGIN_NAMESPACE
     \sa startsWith()
 */
 
+/*!
+    \fn qsizetype QStringView::indexOf(QStringView str, qsizetype from, Qt::CaseSensitivity cs) const
+    \since 5.12
+
+    Returns the index position of the first occurrence of the string-view
+    \a str in this string-view, searching forward from index position
+    \a from. Returns -1 if \a str is not found.
+
+    If \a cs is Qt::CaseSensitive (the default), the search is case-sensitive;
+    otherwise the search is case-insensitive.
+
+    If \a from is -1, the search starts at the last character; if it is
+    -2, at the next to last character and so on.
+
+    \sa contains(), QString::indexOf()
+*/
+
+/*!
+    \fn bool QStringView::contains(QStringView str, Qt::CaseSensitivity cs) const
+    \since 5.12
+
+    Returns \c true if this string-view contains an occurrence of the
+    string-view \a str; otherwise returns \c false.
+
+    If \a cs is Qt::CaseSensitive (the default), the search is case-sensitive;
+    otherwise the search is case-insensitive.
+
+    \sa indexOf()
+*/
+
 /*!
     \fn QByteArray QStringView::toLatin1() const
 
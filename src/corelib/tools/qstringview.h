@@ -266,6 +266,11 @@ public:
     Q_REQUIRED_RESULT bool endsWith(QChar c, Qt::CaseSensitivity cs) const Q_DECL_NOTHROW
     { return QtPrivate::endsWith(*this, QStringView(&c, 1), cs); }
 
+    Q_REQUIRED_RESULT qsizetype indexOf(QStringView s, qsizetype from = 0, Qt::CaseSensitivity cs = Qt::CaseSensitive) const Q_DECL_NOTHROW
+    { return QtPrivate::findString(*this, from, s, cs); }
+    Q_REQUIRED_RESULT bool contains(QStringView s, Qt::CaseSensitivity cs = Qt::CaseSensitive) const Q_DECL_NOTHROW
+    { return indexOf(s, 0, cs) != qsizetype(-1); }
+
     Q_REQUIRED_RESULT bool isRightToLeft() const Q_DECL_NOTHROW
     { return QtPrivate::isRightToLeft(*this); }
 
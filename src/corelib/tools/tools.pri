@@ -27,6 +27,8 @@ HEADERS +=  \
         tools/qhash.h \
         tools/qhashfunctions.h \
         tools/qiterator.h \
+        tools/qflathash.h \
+        tools/qflatmap.h \
         tools/qline.h \
         tools/qlinkedlist.h \
         tools/qlist.h \
@@ -37,6 +39,7 @@ HEADERS +=  \
         tools/qmap.h \
         tools/qmargins.h \
         tools/qmessageauthenticationcode.h \
+        tools/qmultistringmatcher.h \
         tools/qcontiguouscache.h \
         tools/qpair.h \
         tools/qpoint.h \
@@ -95,6 +98,7 @@ SOURCES += \
         tools/qmap.cpp \
         tools/qmargins.cpp \
         tools/qmessageauthenticationcode.cpp \
+        tools/qmultistringmatcher.cpp \
         tools/qcontiguouscache.cpp \
         tools/qrect.cpp \
         tools/qregexp.cpp \
@@ -25,7 +25,9 @@ HEADERS += \
     access/qnetworkfile_p.h \
     access/qhsts_p.h \
     access/qhstspolicy.h \
-    access/qhstsstore_p.h
+    access/qhstsstore_p.h \
+    access/qhttpconnectionpool.h \
+    access/qhttpconnectionpool_p.h
 
 SOURCES += \
     access/qnetworkaccessauthenticationmanager.cpp \
@@ -46,7 +48,8 @@ SOURCES += \
     access/qnetworkfile.cpp \
     access/qhsts.cpp \
     access/qhstspolicy.cpp \
-    access/qhstsstore.cpp
+    access/qhstsstore.cpp \
+    access/qhttpconnectionpool.cpp
 
 qtConfig(ftp) {
     HEADERS += \
@@ -76,6 +79,7 @@ qtConfig(http) {
     SOURCES += \
         access/qabstractprotocolhandler.cpp \
         access/qhttp2protocolhandler.cpp \
+        access/qhttp2serverconnection.cpp \
         access/qhttpmultipart.cpp \
         access/qhttpnetworkconnection.cpp \
         access/qhttpnetworkconnectionchannel.cpp \
@@ -83,12 +87,15 @@ qtConfig(http) {
         access/qhttpnetworkreply.cpp \
         access/qhttpnetworkrequest.cpp \
         access/qhttpprotocolhandler.cpp \
+        access/qhttpserverconnection.cpp \
+        access/qhttpserverengine.cpp \
         access/qhttpthreaddelegate.cpp \
         access/qnetworkreplyhttpimpl.cpp
 
     HEADERS += \
         access/qabstractprotocolhandler_p.h \
         access/qhttp2protocolhandler_p.h \
+        access/qhttp2serverconnection_p.h \
         access/qhttpmultipart.h \
         access/qhttpmultipart_p.h \
         access/qhttpnetworkconnection_p.h \
@@ -97,6 +104,8 @@ qtConfig(http) {
         access/qhttpnetworkreply_p.h \
         access/qhttpnetworkrequest_p.h \
         access/qhttpprotocolhandler_p.h \
+        access/qhttpserverconnection_p.h \
+        access/qhttpserverengine_p.h \
         access/qhttpthreaddelegate_p.h \
         access/qnetworkreplyhttpimpl_p.h
 
@@ -113,14 +113,27 @@ void BitOStream::write(const QByteArray &src, bool compressed)
 
     write(byteLen);
 
+    // Strings always start at an octet boundary, after their length.
+    Q_ASSERT(!(bitsSet % 8));
     if (compressed) {
-        huffman_encode_string(src, *this);
+        const auto oldSize = buffer.size();
+        buffer.resize(oldSize + byteLen);
+        if (byteLen)
+            huffman_encode_string(src, &buffer[oldSize]);
+        bitsSet += quint64(byteLen) * 8;
     } else {
         bitsSet += quint64(src.size()) * 8;
         buffer.insert(buffer.end(), src.begin(), src.end());
     }
 }
 
+void BitOStream::writeOctets(const uchar *first, const uchar *last)
+{
+    Q_ASSERT(!(bitsSet % 8));
+    buffer.insert(buffer.end(), first, last);
+    bitsSet += quint64(last - first) * 8;
+}
+
 quint64 BitOStream::bitLength() const
 {
     return bitsSet;
@@ -275,6 +288,31 @@ bool BitIStream::read(QByteArray *dstPtr)
 {
     Q_ASSERT(dstPtr);
     QByteArray &dst = *dstPtr;
+
+    const quint64 oldOffset = offset;
+    const uchar *octets = nullptr;
+    quint32 len = 0;
+    bool compressed = false;
+    if (!readStringLiteral(&octets, &len, &compressed))
+        return false;
+
+    if (!compressed) {
+        dst = QByteArray(reinterpret_cast<const char *>(octets), len);
+        return true;
+    }
+
+    dst.clear();
+    if (huffman_decode_string(octets, octets + len, &dst))
+        return true;
+
+    setError(Error::CompressionError);
+    offset = oldOffset;
+    return false;
+}
+
+bool BitIStream::readStringLiteral(const uchar **octets, quint32 *length, bool *compressed)
+{
+    Q_ASSERT(octets && length && compressed);
     //5.2 String Literal Representation
     //
     // Header field names and header field values can be represented as string literals.
@@ -284,8 +322,8 @@ bool BitIStream::read(QByteArray *dstPtr)
     // We update the offset _only_ if the read was successful.
 
     const quint64 oldOffset = offset;
-    uchar compressed = 0;
-    if (peekBits(offset, 1, &compressed) != 1 || !skipBits(1)) {
+    uchar huffmanBit = 0;
+    if (peekBits(offset, 1, &huffmanBit) != 1 || !skipBits(1)) {
         setError(Error::NotEnoughData);
         return false;
     }
@@ -294,27 +332,18 @@ bool BitIStream::read(QByteArray *dstPtr)
 
     quint32 len = 0;
     if (read(&len)) {
+        // Now good news, integer always ends on a byte boundary.
+        // We can take 'len' bytes without any bit magic.
         Q_ASSERT(!(offset % 8));
         if (len <= (bitLength() - offset) / 8) { // We have enough data to read a string ...
-            if (!compressed) {
-                // Now good news, integer always ends on a byte boundary.
-                // We can read 'len' bytes without any bit magic.
-                const char *src = reinterpret_cast<const char *>(first + offset / 8);
-                dst = QByteArray(src, len);
-                offset += quint64(len) * 8;
-                return true;
-            }
-
-            BitIStream slice(first + offset / 8, first + offset / 8 + len);
-            if (huffman_decode_string(slice, &dst)) {
-                offset += quint64(len) * 8;
-                return true;
-            }
-
-            setError(Error::CompressionError);
-        } else {
-            setError(Error::NotEnoughData);
+            *octets = first + offset / 8;
+            *length = len;
+            *compressed = huffmanBit;
+            offset += quint64(len) * 8;
+            return true;
         }
+
+        setError(Error::NotEnoughData);
     } // else the exact reason was set by read(quint32).
 
     offset = oldOffset;
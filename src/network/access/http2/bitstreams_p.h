@@ -80,6 +80,9 @@ public:
     // * strings
     void write(quint32 src);
     void write(const QByteArray &src, bool compressed);
+    // Appends octets that were encoded before, for example, by another
+    // BitOStream; the stream must be at an octet boundary.
+    void writeOctets(const uchar *first, const uchar *last);
 
     quint64 bitLength() const;
     quint64 byteLength() const;
@@ -166,6 +169,10 @@ public:
 
     bool read(quint32 *dstPtr);
     bool read(QByteArray *dstPtr);
+    // Reads a string literal without copying or decoding it:
+    // 'octets' points into the stream, Huffman-coded if
+    // 'compressed' is set.
+    bool readStringLiteral(const uchar **octets, quint32 *length, bool *compressed);
 
     Error error() const;
 
@@ -39,6 +39,7 @@
 
 #include "bitstreams_p.h"
 #include "hpack_p.h"
+#include "huffman_p.h"
 
 #include <QtCore/qbytearray.h>
 #include <QtCore/qdebug.h>
@@ -201,6 +202,32 @@ bool Encoder::encodeSizeUpdate(BitOStream &outputStream, quint32 newSize)
     return true;
 }
 
+bool Encoder::encodeHeaderFieldsWithoutIndexing(BitOStream &outputStream,
+                                                const HttpHeader &header)
+{
+    const quint32 nStatic = lookupTable.numberOfStaticEntries();
+    for (const auto &field : header) {
+        // indexOf() looks in the static part first:
+        const quint32 index = lookupTable.indexOf(field.name, field.value);
+        if (index && index <= nStatic) {
+            if (!encodeIndexedField(outputStream, index))
+                return false;
+            continue;
+        }
+
+        const quint32 nameIndex = lookupTable.indexOf(field.name);
+        const bool encoded = nameIndex && nameIndex <= nStatic
+            ? encodeLiteralField(outputStream, LiteralNoIndexing, nameIndex,
+                                 field.value, compressStrings)
+            : encodeLiteralField(outputStream, LiteralNoIndexing, field.name,
+                                 field.value, compressStrings);
+        if (!encoded)
+            return false;
+    }
+
+    return true;
+}
+
 void Encoder::setMaxDynamicTableSize(quint32 size)
 {
     // Up to a caller (HTTP2 protocol handler)
@@ -406,20 +433,39 @@ Decoder::Decoder(quint32 size)
 }
 
 bool Decoder::decodeHeaderFields(BitIStream &inputStream)
+{
+    return decodeFields(inputStream, false);
+}
+
+bool Decoder::decodeHeaderFieldViews(BitIStream &inputStream)
+{
+    // Huffman-decoded strings cannot be longer than this,
+    // so 'scratch' will not reallocate:
+    const quint32 maxLength = huffman_max_decoded_length(quint32(inputStream.bitLength() / 8));
+    if (quint32(scratch.size()) < maxLength)
+        scratch.resize(int(maxLength));
+    scratchUsed = 0;
+    pinnedStrings.clear();
+
+    return decodeFields(inputStream, true);
+}
+
+bool Decoder::decodeFields(BitIStream &inputStream, bool views)
 {
     header.clear();
+    headerView.clear();
     while (true) {
         if (read_bit_pattern(Indexed, inputStream)) {
-            if (!decodeIndexedField(inputStream))
+            if (!decodeIndexedField(inputStream, views))
                 return false;
         } else if (read_bit_pattern(LiteralIncrementalIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralIncrementalIndexing, inputStream))
+            if (!decodeLiteralField(LiteralIncrementalIndexing, inputStream, views))
                 return false;
         } else if (read_bit_pattern(LiteralNoIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralNoIndexing, inputStream))
+            if (!decodeLiteralField(LiteralNoIndexing, inputStream, views))
                 return false;
         } else if (read_bit_pattern(LiteralNeverIndexing, inputStream)) {
-            if (!decodeLiteralField(LiteralNeverIndexing, inputStream))
+            if (!decodeLiteralField(LiteralNeverIndexing, inputStream, views))
                 return false;
         } else if (read_bit_pattern(SizeUpdate, inputStream)) {
             if (!decodeSizeUpdate(inputStream))
@@ -444,7 +490,7 @@ void Decoder::setMaxDynamicTableSize(quint32 size)
     lookupTable.setMaxDynamicTableSize(size);
 }
 
-bool Decoder::decodeIndexedField(BitIStream &inputStream)
+bool Decoder::decodeIndexedField(BitIStream &inputStream, bool views)
 {
     quint32 index = 0;
     if (inputStream.read(&index)) {
@@ -458,7 +504,7 @@ bool Decoder::decodeIndexedField(BitIStream &inputStream)
 
         QByteArray name, value;
         if (lookupTable.field(index, &name, &value))
-            return processDecodedField(Indexed, name, value);
+            return processDecodedField(Indexed, name, value, views);
     } else {
         handleStreamError(inputStream);
     }
@@ -481,29 +527,43 @@ bool Decoder::decodeSizeUpdate(BitIStream &inputStream)
     return false;
 }
 
-bool Decoder::decodeLiteralField(const BitPattern &fieldType, BitIStream &inputStream)
+bool Decoder::decodeLiteralField(const BitPattern &fieldType, BitIStream &inputStream,
+                                 bool views)
 {
     // https://http2.github.io/http2-spec/compression.html
     // 6.2.1, 6.2.2, 6.2.3
     // Format for all 'literal' is similar,
     // the difference - is how we update/not our lookup table.
+
+    // Fields we add to the table must own their data anyway:
+    const bool asView = views && !(fieldType == LiteralIncrementalIndexing);
+
     quint32 index = 0;
     if (inputStream.read(&index)) {
         QByteArray name;
+        QLatin1String nameView;
         if (!index) {
             // Read a string.
-            if (!inputStream.read(&name)) {
+            if (!readString(inputStream, asView, &name, &nameView)) {
                 handleStreamError(inputStream);
                 return false;
             }
         } else {
             if (!lookupTable.fieldName(index, &name))
                 return false;
+            if (asView)
+                nameView = pin(name);
         }
 
         QByteArray value;
-        if (inputStream.read(&value))
-            return processDecodedField(fieldType, name, value);
+        QLatin1String valueView;
+        if (readString(inputStream, asView, &value, &valueView)) {
+            if (!asView)
+                return processDecodedField(fieldType, name, value, views);
+
+            headerView.push_back({nameView, valueView});
+            return true;
+        }
     }
 
     handleStreamError(inputStream);
@@ -511,19 +571,57 @@ bool Decoder::decodeLiteralField(const BitPattern &fieldType, BitIStream &inputS
     return false;
 }
 
+bool Decoder::readString(BitIStream &inputStream, bool view,
+                         QByteArray *string, QLatin1String *stringView)
+{
+    if (!view)
+        return inputStream.read(string);
+
+    const uchar *octets = nullptr;
+    quint32 length = 0;
+    bool compressed = false;
+    if (!inputStream.readStringLiteral(&octets, &length, &compressed))
+        return false;
+
+    if (!compressed) {
+        *stringView = QLatin1String(reinterpret_cast<const char *>(octets), int(length));
+        return true;
+    }
+
+    char *dst = scratch.data() + scratchUsed;
+    Q_ASSERT(scratchUsed + huffman_max_decoded_length(length) <= quint32(scratch.size()));
+    const int decodedLength = huffman_decode(octets, octets + length, dst);
+    if (decodedLength < 0)
+        return false;
+
+    scratchUsed += decodedLength;
+    *stringView = QLatin1String(dst, decodedLength);
+    return true;
+}
+
 bool Decoder::processDecodedField(const BitPattern &fieldType,
                                  const QByteArray &name,
-                                 const QByteArray &value)
+                                 const QByteArray &value,
+                                 bool views)
 {
     if (fieldType == LiteralIncrementalIndexing) {
         if (!lookupTable.prependField(name, value))
             return false;
     }
 
-    header.push_back(HeaderField(name, value));
+    if (views)
+        headerView.push_back({pin(name), pin(value)});
+    else
+        header.push_back(HeaderField(name, value));
     return true;
 }
 
+QLatin1String Decoder::pin(const QByteArray &string)
+{
+    pinnedStrings.push_back(string);
+    return QLatin1String(string.constData(), string.size());
+}
+
 void Decoder::handleStreamError(BitIStream &inputStream)
 {
     const auto errorCode(inputStream.error());
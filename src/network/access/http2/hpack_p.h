@@ -54,6 +54,7 @@
 #include "hpacktable_p.h"
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qstring.h>
 
 #include <vector>
 
@@ -67,6 +68,16 @@ namespace HPack
 using HttpHeader = std::vector<HeaderField>;
 HeaderSize header_size(const HttpHeader &header);
 
+// A header field decoded by Decoder::decodeHeaderFieldViews(). The octets
+// are not copied: they belong to the HPACK block or to the decoder.
+struct HeaderFieldView
+{
+    QLatin1String name;
+    QLatin1String value;
+};
+
+using HttpHeaderView = std::vector<HeaderFieldView>;
+
 class Q_AUTOTEST_EXPORT Encoder
 {
 public:
@@ -82,6 +93,12 @@ public:
     bool encodeSizeUpdate(BitOStream &outputStream,
                           quint32 newSize);
 
+    // Refers to the static table only and leaves the dynamic tables on
+    // both sides untouched (literals are sent 'without indexing'), so the
+    // result can be encoded once and appended to any header block.
+    bool encodeHeaderFieldsWithoutIndexing(BitOStream &outputStream,
+                                           const HttpHeader &header);
+
     void setMaxDynamicTableSize(quint32 size);
 
 private:
@@ -126,24 +143,50 @@ public:
         return header;
     }
 
+    // Same as decodeHeaderFields(), but names and values are not copied
+    // unless they have to be added to the dynamic table: they point into
+    // the input block, into the lookup table or into a scratch buffer of
+    // the decoder. The views are valid until the next call to a decode
+    // function and as long as the input block exists.
+    bool decodeHeaderFieldViews(BitIStream &inputStream);
+
+    const HttpHeaderView &decodedHeaderView() const
+    {
+        return headerView;
+    }
+
     quint32 dynamicTableSize() const;
 
     void setMaxDynamicTableSize(quint32 size);
 
 private:
 
-    bool decodeIndexedField(BitIStream &inputStream);
+    bool decodeFields(BitIStream &inputStream, bool views);
+    bool decodeIndexedField(BitIStream &inputStream, bool views);
     bool decodeSizeUpdate(BitIStream &inputStream);
     bool decodeLiteralField(const BitPattern &fieldType,
-                            BitIStream &inputStream);
+                            BitIStream &inputStream, bool views);
+    bool readString(BitIStream &inputStream, bool view,
+                    QByteArray *string, QLatin1String *stringView);
 
     bool processDecodedField(const BitPattern &fieldType,
                              const QByteArray &name,
-                             const QByteArray &value);
+                             const QByteArray &value,
+                             bool views);
+    QLatin1String pin(const QByteArray &string);
 
     void handleStreamError(BitIStream &inputStream);
 
     HttpHeader header;
+    HttpHeaderView headerView;
+    // Strings shared with the lookup table, so that
+    // 'headerView' survives evictions:
+    std::vector<QByteArray> pinnedStrings;
+    // Huffman-decoded strings of 'headerView'. Sized for
+    // the whole block up front, it never reallocates
+    // while a block is being decoded.
+    QByteArray scratch;
+    int scratchUsed = 0;
     FieldLookupTable lookupTable;
 };
 
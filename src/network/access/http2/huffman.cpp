@@ -37,12 +37,11 @@
 **
 ****************************************************************************/
 
-#include "bitstreams_p.h"
 #include "huffman_p.h"
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qvarlengtharray.h>
 
-#include <algorithm>
 #include <limits>
 
 QT_BEGIN_NAMESPACE
@@ -60,32 +59,23 @@ namespace HPack
     code length. All codes were left-aligned - for implementation
     convenience.
 
-    Using binary trees to implement decoding would be prohibitively
-    expensive (both memory and time-wise). Instead we use a table-based
-    approach and any given code itself works as an index into such table(s).
-    We have 256 possible byte values and code lengths in
-    a range [5, 26]. This would require a huge table (and most of entries
-    would be 'wasted', since we only have to encode 256 elements).
-    Instead we use multi-level tables. The first level table
-    is using 9-bit length index; some entries in this table are 'terminal',
-    some reference the next level table(s).
+    Decoding walks the code tree, but not bit by bit: the tree's
+    internal nodes (256 of them, since we have 257 symbols) are the
+    states of a finite state machine, and a table indexed by a state and
+    the next four bits of input gives the state we end up in, and the
+    symbol we passed on the way if any. As the shortest code is 5 bits
+    long, four bits can complete one code at most. This is the same
+    approach as in nghttp2 and other HPACK implementations; it needs no
+    bit-level access to the input and no branching on code lengths.
 
     For example, bytes with values 48 and 49 (ASCII codes for '0' and '1')
-    both have code length 5, Huffman codes are: 00000 and 00001. They
-    both are placed in the 'root' table,
-    the 'root' table has index length == 9:
-    [00000 | 4 remaining bits]
-     ...
-    [00001 | 4 remaining bits]
-
-    All entires with indices between these two will 'point' to value 48
-    with bitLength == 5 so that bit stream (for example) 000001010 will be
-    decoded as: 48 + "put 1010 back into bitstream".
-
-    A good description can be found here:
-    http://commandlinefanatic.com/cgi-bin/showarticle.cgi?article=art007
-    or just google "Efficient Huffman Decoding".
-    Also see comments below about 'filling holes'.
+    both have code length 5, Huffman codes are: 00000 and 00001. From
+    the root, the nibble 0000 leads to the internal node '0000'; from
+    there, the nibble 0xxx completes the code 00000 (emitting 48) and
+    leaves us in the node 'xxx' below the root, 1xxx completes 00001.
+
+    A state 'accepts' the end of the input if the path to it consists of
+    at most seven 1-bits: that is valid EOS padding (HPACK, 5.2).
 */
 
 namespace
@@ -352,29 +342,7 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, const CodeEntry &code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
+const quint32 nSymbols = sizeof staticHuffmanCodeTable / sizeof staticHuffmanCodeTable[0];
 
 }
 
@@ -385,187 +353,148 @@ quint64 huffman_encoded_bit_length(const QByteArray &inputData)
 {
     quint64 bitLength = 0;
     for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+        bitLength += staticHuffmanCodeTable[uchar(inputData[i])].bitLength;
 
     return bitLength;
 }
 
-void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream)
+void huffman_encode_string(const QByteArray &inputData, uchar *outputBuffer)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        write_huffman_code(outputStream, staticHuffmanCodeTable[int(inputData[i])]);
-
-    // Pad bits ...
-    if (outputStream.bitLength() % 8)
-        outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
-}
-
-bool padding_is_valid(quint32 chunk, quint32 nBits)
-{
-    Q_ASSERT(nBits);
+    // Codes are at most 30 bits long, so 'bits' never holds more
+    // than 37 bits we have yet to write.
+    quint64 bits = 0;
+    quint32 nBits = 0;
+    for (int i = 0, e = inputData.size(); i < e; ++i) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(inputData[i])];
+        bits = (bits << code.bitLength) | (code.huffmanCode >> (32 - code.bitLength));
+        nBits += code.bitLength;
+        while (nBits >= 8) {
+            nBits -= 8;
+            *outputBuffer++ = uchar(bits >> nBits);
+        }
+    }
 
-    // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be
-    // treated as a decoding error."
-    if (nBits > 7)
-        return false;
-    // HPACK, 5.2:
-    // "A padding not corresponding to the most significant bits
-    // of the code for the EOS symbol MUST be treated as a decoding error."
-    return (chunk >> (32 - nBits)) == quint32((1 << nBits) - 1);
+    // Pad bits with the most significant bits of EOS (all 1s) ...
+    if (nBits)
+        *outputBuffer = uchar((bits << (8 - nBits)) | (0xff >> nBits));
 }
 
 HuffmanDecoder::HuffmanDecoder()
-    : minCodeLength()
 {
-    const auto nCodes = sizeof staticHuffmanCodeTable / sizeof staticHuffmanCodeTable[0];
-
-    std::vector<CodeEntry> symbols(staticHuffmanCodeTable, staticHuffmanCodeTable + nCodes);
-    // Now we sort: by bit length first (in the descending order) and by the symbol
-    // value (descending). Descending order: to make sure we do not create prefix tables with
-    // short 'indexLength' first and having longer codes that do not fit into such tables later.
-    std::sort(symbols.begin(), symbols.end(), [](const CodeEntry &code1, const CodeEntry &code2) {
-        if (code1.bitLength == code2.bitLength)
-            return code1.byteValue > code2.byteValue;
-        return code1.bitLength > code2.bitLength;
-    });
-
-    minCodeLength = symbols.back().bitLength; // The shortest one, currently it's 5.
-
-    // TODO: add a verification - Huffman codes
-    // within a given bit length range also
-    // should be in descending order.
-
-    // Initialize 'prefixTables' and 'tableData'.
-    addTable(0, quint32(BitConstants::rootPrefix)); // 'root' table.
-
-    for (const auto &s : symbols) {
-        quint32 tableIndex = 0;
-        while (true) {
-            Q_ASSERT(tableIndex < prefixTables.size());
-            // Note, by value - since prefixTables will be updated in between.
-            const auto table = prefixTables[tableIndex];
-            // We skip prefixed bits (if any) and use indexed bits only:
-            const auto entryIndex = s.huffmanCode << table.prefixLength >> (32 - table.indexLength);
-            // Again, by value.
-            PrefixTableEntry entry = tableEntry(table, entryIndex);
-            // How many bits were coded by previous tables and this table:
-            const auto codedLength = table.prefixLength + table.indexLength;
-            if (codedLength < s.bitLength) {
-                // We have to add a new prefix table ... (if it's not done yet).
-                if (!entry.bitLength) {
-                    entry.nextTable = addTable(codedLength, std::min<quint32>(quint32(BitConstants::childPrefix),
-                                                                              s.bitLength - codedLength));
-                    entry.bitLength = s.bitLength;
-                    entry.byteValue = s.byteValue;
-                    setTableEntry(table, entryIndex, entry);
-                }
-                tableIndex = entry.nextTable;
-            } else {
-                // We found the slot for our code (terminal entry):
-                entry.byteValue = s.byteValue;
-                entry.bitLength = s.bitLength;
-                // Refer to our own table as 'nextTable':
-                entry.nextTable = tableIndex;
-                setTableEntry(table, entryIndex, entry);
+    // Build the code tree first. Children are either internal
+    // nodes (>= 0) or leaves, as -(symbol + 1).
+    struct Node
+    {
+        int child[2];
+        bool accepted;
+    };
+    std::vector<Node> nodes(1, Node{{0, 0}, true});
+
+    for (quint32 i = 0; i < nSymbols; ++i) {
+        const CodeEntry &code = staticHuffmanCodeTable[i];
+        int node = 0;
+        for (quint32 depth = 0; depth < code.bitLength; ++depth) {
+            const int bit = (code.huffmanCode >> (31 - depth)) & 1;
+            if (depth + 1 == code.bitLength) {
+                nodes[node].child[bit] = -int(code.byteValue) - 1;
                 break;
             }
-        }
-    }
-
-    // Now, we have a table(s) and have to fill 'holes' to
-    // 'fix' terminal entries.
-    for (const auto &table : prefixTables) {
-        const quint32 codedLength = table.prefixLength + table.indexLength;
-        for (quint32 j = 0; j < table.size();) {
-            const PrefixTableEntry &entry = tableEntry(table, j);
-            if (entry.bitLength && entry.bitLength < codedLength) {
-                const quint32 range = 1 << (codedLength - entry.bitLength);
-                for (quint32 k = 1; k < range; ++k)
-                    setTableEntry(table, j + k, entry);
-                j += range;
-            } else {
-                ++j;
+            if (!nodes[node].child[bit]) {
+                // Only a prefix of 1s not longer than 7 bits is a valid padding:
+                const bool accepted = nodes[node].accepted && bit && depth < 7;
+                nodes.push_back(Node{{0, 0}, accepted});
+                nodes[node].child[bit] = int(nodes.size() - 1);
             }
+            node = nodes[node].child[bit];
         }
     }
-}
-
-bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
-{
-    while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
-
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
 
-        quint32 tableIndex = 0;
-        const PrefixTable *table = &prefixTables[tableIndex];
-        quint32 entryIndex = chunk >> (32 - table->indexLength);
-        PrefixTableEntry entry = tableEntry(*table, entryIndex);
-
-        while (true) {
-            if (entry.nextTable == tableIndex)
-                break;
+    // The code is complete, so the tree has exactly nSymbols - 1 internal nodes:
+    Q_ASSERT(nodes.size() == nSymbols - 1);
+    Q_ASSERT(nodes.size() <= 256); // they must fit into 'nextState'
+
+    stateTable.resize(nodes.size() * 16);
+    for (quint32 state = 0; state < nodes.size(); ++state) {
+        for (quint32 nibble = 0; nibble < 16; ++nibble) {
+            DecodeTableEntry &entry = stateTable[state * 16 + nibble];
+            entry = DecodeTableEntry();
+            int node = int(state);
+            for (int shift = 3; shift >= 0; --shift) {
+                const int next = nodes[node].child[(nibble >> shift) & 1];
+                if (next > 0) {
+                    node = next;
+                    continue;
+                }
 
-            tableIndex = entry.nextTable;
-            table = &prefixTables[tableIndex];
-            entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
-            entry = tableEntry(*table, entryIndex);
-        }
+                Q_ASSERT(next < 0);
+                const quint32 symbol = quint32(-next - 1);
+                if (symbol == 256) {
+                    // EOS (256) == compression error (HPACK).
+                    entry.flags = DecodeTableEntry::Failure;
+                    break;
+                }
 
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
+                Q_ASSERT(!(entry.flags & DecodeTableEntry::Symbol));
+                entry.flags |= DecodeTableEntry::Symbol;
+                entry.symbol = quint8(symbol);
+                node = 0;
+            }
 
-        if (!entry.bitLength || entry.byteValue == 256) {
-            //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+            entry.nextState = quint8(node);
+            if (nodes[node].accepted)
+                entry.flags |= DecodeTableEntry::Accepted;
         }
-
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
     }
-
-    return false;
 }
 
-quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
+int HuffmanDecoder::decode(const uchar *first, const uchar *last, char *outputBuffer) const
 {
-    PrefixTable newTable{prefix, index};
-    newTable.offset = quint32(tableData.size());
-    prefixTables.push_back(newTable);
-    // Add entries for this table:
-    tableData.resize(tableData.size() + newTable.size());
+    const DecodeTableEntry *table = stateTable.data();
+    char *dst = outputBuffer;
+    quint32 state = 0;
+    // The empty string is valid:
+    quint8 flags = DecodeTableEntry::Accepted;
+
+    for (; first != last; ++first) {
+        for (const quint32 nibble : {quint32(*first >> 4), quint32(*first & 0xf)}) {
+            const DecodeTableEntry &entry = table[state * 16 + nibble];
+            flags = entry.flags;
+            if (flags & DecodeTableEntry::Failure)
+                return -1;
+            if (flags & DecodeTableEntry::Symbol)
+                *dst++ = char(entry.symbol);
+            state = entry.nextState;
+        }
+    }
 
-    return quint32(prefixTables.size() - 1);
-}
+    if (!(flags & DecodeTableEntry::Accepted))
+        return -1;
 
-PrefixTableEntry HuffmanDecoder::tableEntry(const PrefixTable &table, quint32 index)
-{
-    Q_ASSERT(index < table.size());
-    return tableData[table.offset + index];
+    return int(dst - outputBuffer);
 }
 
-void HuffmanDecoder::setTableEntry(const PrefixTable &table, quint32 index,
-                                   const PrefixTableEntry &entry)
+int huffman_decode(const uchar *first, const uchar *last, char *outputBuffer)
 {
-    Q_ASSERT(index < table.size());
-    tableData[table.offset + index] = entry;
+    static const HuffmanDecoder decoder;
+    return decoder.decode(first, last, outputBuffer);
 }
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer)
+bool huffman_decode_string(const uchar *first, const uchar *last, QByteArray *outputBuffer)
 {
     Q_ASSERT(outputBuffer);
 
-    static HuffmanDecoder decoder;
-    return decoder.decodeStream(inputStream, *outputBuffer);
+    // Decode into a buffer on the stack when possible and allocate
+    // the result once, with its exact size.
+    QVarLengthArray<char, 1024> buffer(int(huffman_max_decoded_length(quint32(last - first))));
+    const int length = huffman_decode(first, last, buffer.data());
+    if (length < 0)
+        return false;
+
+    if (outputBuffer->isEmpty())
+        *outputBuffer = QByteArray(buffer.constData(), length);
+    else
+        outputBuffer->append(buffer.constData(), length);
+    return true;
 }
 
 }
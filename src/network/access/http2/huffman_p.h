@@ -53,6 +53,8 @@
 
 #include <QtCore/qglobal.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class QByteArray;
@@ -67,99 +69,51 @@ struct CodeEntry
     quint32 bitLength;
 };
 
-class BitOStream;
-
 quint64 huffman_encoded_bit_length(const QByteArray &inputData);
-void huffman_encode_string(const QByteArray &inputData, BitOStream &outputStream);
-
-// PrefixTable:
-// Huffman codes with a small bit length
-// fit into a table (these are 'terminal' symbols),
-// codes with longer codes require additional
-// tables, so several symbols will have the same index
-// in a table - pointing into the next table.
-// Every table has an 'indexLength' - that's
-// how many bits can fit in table's indices +
-// 'prefixLength' - how many bits were addressed
-// by its 'parent' table(s).
-// All PrefixTables are kept in 'prefixTables' array.
-// PrefixTable itself does not have any entries,
-// it just holds table's prefix/index + 'offset' -
-// there table's data starts in an array of all
-// possible entries ('tableData').
-
-struct PrefixTable
-{
-    PrefixTable()
-        : prefixLength(),
-          indexLength(),
-          offset()
-    {
-    }
-
-    PrefixTable(quint32 prefix, quint32 index)
-        : prefixLength(prefix),
-          indexLength(index),
-          offset()
-    {
-    }
-
-    quint32 size()const
-    {
-        // Number of entries table contains:
-        return 1 << indexLength;
-    }
-
-    quint32 prefixLength;
-    quint32 indexLength;
-    quint32 offset;
-};
-
-// Table entry is either a terminal entry (thus probably the code found)
-// or points into another table ('nextTable' - index into
-// 'prefixTables' array). If it's a terminal, 'nextTable' index
-// refers to the same table.
-
-struct PrefixTableEntry
+// Writes exactly (huffman_encoded_bit_length(inputData) + 7) / 8 octets,
+// including the EOS padding, to 'outputBuffer'.
+void huffman_encode_string(const QByteArray &inputData, uchar *outputBuffer);
+
+// The code is read as a finite state machine: every state is an internal
+// node of the code tree, and a table lookup consumes four bits at once.
+// Since the shortest code is five bits long, one lookup emits a symbol
+// at most.
+struct DecodeTableEntry
 {
-    PrefixTableEntry()
-        : bitLength(),
-          nextTable(),
-          byteValue()
+    enum Flag : quint8
     {
-    }
+        Accepted = 0x1, // the state is a valid end of the string (EOS padding)
+        Symbol = 0x2,   // 'symbol' was decoded on the way
+        Failure = 0x4   // EOS found in the string
+    };
 
-    quint32 bitLength;
-    quint32 nextTable;
-    quint32 byteValue;
+    quint8 nextState;
+    quint8 flags;
+    quint8 symbol;
 };
 
-class BitIStream;
-
 class HuffmanDecoder
 {
 public:
-    enum class BitConstants
-    {
-        rootPrefix = 9,
-        childPrefix = 6
-    };
-
     HuffmanDecoder();
 
-    bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
+    // Returns the number of octets written to 'outputBuffer',
+    // which must have room for huffman_max_decoded_length()
+    // octets, or -1 if the input is not a valid string.
+    int decode(const uchar *first, const uchar *last, char *outputBuffer) const;
 
 private:
-    quint32 addTable(quint32 prefixLength, quint32 indexLength);
-    PrefixTableEntry tableEntry(const PrefixTable &table, quint32 index);
-    void setTableEntry(const PrefixTable &table, quint32 index, const PrefixTableEntry &entry);
-
-    std::vector<PrefixTable> prefixTables;
-    std::vector<PrefixTableEntry> tableData;
-    quint32 minCodeLength;
+    std::vector<DecodeTableEntry> stateTable;
 };
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
+inline quint32 huffman_max_decoded_length(quint32 encodedLength)
+{
+    // 5 bits is the shortest code.
+    return encodedLength * 8 / 5;
+}
+
+int huffman_decode(const uchar *first, const uchar *last, char *outputBuffer);
+bool huffman_decode_string(const uchar *first, const uchar *last, QByteArray *outputBuffer);
 
 } // namespace HPack
 
@@ -196,7 +196,7 @@ QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *chan
         }
     }
 
-    if (!channel->ssl) {
+    if (!channel->ssl && m_connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
         // We upgraded from HTTP/1.1 to HTTP/2. channel->request was already sent
         // as HTTP/1.1 request. The response with status code 101 triggered
         // protocol switch and now we are waiting for the real response, sent
@@ -448,18 +448,87 @@ bool QHttp2ProtocolHandler::sendHEADERS(Stream &stream)
 #ifndef QT_NO_NETWORKPROXY
     useProxy = m_connection->d_func()->networkProxy.type() != QNetworkProxy::NoProxy;
 #endif
-    const auto headers = build_headers(stream.request(), maxHeaderListSize, useProxy);
+    auto headers = build_headers(stream.request(), maxHeaderListSize, useProxy);
     if (!headers.size()) // nothing fits into maxHeaderListSize
         return false;
 
+    std::vector<bool> sendStatic(staticHeaders.size(), true);
+    if (staticHeaders.size()) {
+        std::vector<bool> inRequest(staticHeaders.size(), false);
+        const auto sentStatically = [this, &sendStatic, &inRequest](const HeaderField &field) {
+            for (std::size_t i = 0; i < staticHeaders.size(); ++i) {
+                if (staticHeaders[i].field.name == field.name) {
+                    if (staticHeaders[i].field.value == field.value) {
+                        inRequest[i] = true;
+                        return true;
+                    }
+                    sendStatic[i] = false;
+                    return false;
+                }
+            }
+            return false;
+        };
+        headers.erase(std::remove_if(headers.begin(), headers.end(), sentStatically),
+                      headers.end());
+
+        // The static fields the request also has were counted by build_headers(),
+        // the others are sent on top of the request's fields and must fit into
+        // maxHeaderListSize as well. Like build_headers(), leave out what does not.
+        HeaderSize size = header_size(headers);
+        for (std::size_t i = 0; i < staticHeaders.size(); ++i) {
+            if (sendStatic[i] && inRequest[i])
+                size.second += entry_size(staticHeaders[i].field).second;
+        }
+        for (std::size_t i = 0; i < staticHeaders.size(); ++i) {
+            if (!sendStatic[i] || inRequest[i])
+                continue;
+            const HeaderSize delta = entry_size(staticHeaders[i].field);
+            if (!delta.first || std::numeric_limits<quint32>::max() - delta.second < size.second
+                || size.second + delta.second > maxHeaderListSize) {
+                sendStatic[i] = false;
+                continue;
+            }
+            size.second += delta.second;
+        }
+    }
+
     // Compress in-place:
     BitOStream outputStream(frameWriter.outboundFrame().buffer);
     if (!encoder.encodeRequest(outputStream, headers))
         return false;
 
+    for (std::size_t i = 0; i < staticHeaders.size(); ++i) {
+        if (sendStatic[i]) {
+            const std::vector<uchar> &encoded = staticHeaders[i].encoded;
+            outputStream.writeOctets(encoded.data(), encoded.data() + encoded.size());
+        }
+    }
+
     return frameWriter.writeHEADERS(*m_socket, maxFrameSize);
 }
 
+void QHttp2ProtocolHandler::setStaticHeaders(const HPack::HttpHeader &header)
+{
+    using namespace HPack;
+
+    staticHeaders.clear();
+    for (const HeaderField &field : header) {
+        // 8.1.2 - names are lowercase; pseudo-header fields
+        // must come first and are never static anyway.
+        StaticHeaderField staticField;
+        staticField.field = HeaderField(field.name.toLower(), field.value);
+        if (staticField.field.name.startsWith(':')) {
+            qCWarning(QT_HTTP2, "pseudo-header field %s cannot be static",
+                      staticField.field.name.constData());
+            continue;
+        }
+
+        BitOStream outputStream(staticField.encoded);
+        if (encoder.encodeHeaderFieldsWithoutIndexing(outputStream, {staticField.field}))
+            staticHeaders.push_back(std::move(staticField));
+    }
+}
+
 bool QHttp2ProtocolHandler::sendDATA(Stream &stream)
 {
     Q_ASSERT(maxFrameSize > frameHeaderSize);
@@ -940,8 +1009,17 @@ void QHttp2ProtocolHandler::handleContinuedHEADERS()
         // has yet to see the reset.
     }
 
-    std::vector<uchar> hpackBlock(assemble_hpack_block(continuedFrames));
-    if (!hpackBlock.size()) {
+    // A header block in a single frame (the common case) is decoded in place.
+    const uchar *hpackBlockBegin = continuedFrames[0].hpackBlockBegin();
+    quint32 hpackBlockSize = continuedFrames[0].hpackBlockSize();
+    std::vector<uchar> hpackBlock;
+    if (continuedFrames.size() > 1) {
+        hpackBlock = assemble_hpack_block(continuedFrames);
+        hpackBlockBegin = hpackBlock.data();
+        hpackBlockSize = quint32(hpackBlock.size());
+    }
+
+    if (!hpackBlockSize) {
         // It could be a PRIORITY sent in HEADERS - already handled by this
         // point in handleHEADERS. If it was PUSH_PROMISE (HTTP/2 8.2.1):
         // "The header fields in PUSH_PROMISE and any subsequent CONTINUATION
@@ -956,7 +1034,7 @@ void QHttp2ProtocolHandler::handleContinuedHEADERS()
         return;
     }
 
-    HPack::BitIStream inputStream{&hpackBlock[0], &hpackBlock[0] + hpackBlock.size()};
+    HPack::BitIStream inputStream{hpackBlockBegin, hpackBlockBegin + hpackBlockSize};
     if (!decoder.decodeHeaderFields(inputStream))
         return connectionError(COMPRESSION_ERROR, "HPACK decompression failed");
 
@@ -90,6 +90,12 @@ public:
     QHttp2ProtocolHandler &operator = (const QHttp2ProtocolHandler &rhs) = delete;
     QHttp2ProtocolHandler &operator = (QHttp2ProtocolHandler &&rhs) = delete;
 
+    // Header fields sent with every request on this connection. They are
+    // HPACK-encoded once, referring to the static table only, and the
+    // encoded octets are appended to each HEADERS frame. A request's own
+    // field with the same name and a different value replaces them.
+    void setStaticHeaders(const HPack::HttpHeader &header);
+
 private slots:
     void _q_uploadDataReadyRead();
     void _q_replyDestroyed(QObject* reply);
@@ -156,6 +162,13 @@ private:
     HPack::Decoder decoder;
     HPack::Encoder encoder;
 
+    struct StaticHeaderField
+    {
+        HPack::HeaderField field;
+        std::vector<uchar> encoded;
+    };
+    std::vector<StaticHeaderField> staticHeaders;
+
     QHash<quint32, Stream> activeStreams;
     std::deque<quint32> suspendedStreams[3]; // 3 for priorities: High, Normal, Low.
     static const std::deque<quint32>::size_type maxRecycledStreams;
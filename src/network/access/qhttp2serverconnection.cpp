@@ -0,0 +1,934 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttp2serverconnection_p.h"
+#include "qhttpserverengine_p.h"
+
+#include "http2/bitstreams_p.h"
+
+#include <QtNetwork/qabstractsocket.h>
+
+#include <QtCore/qendian.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qdebug.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+
+std::vector<uchar> assemble_hpack_block(const std::vector<Http2::Frame> &frames)
+{
+    std::vector<uchar> hpackBlock;
+
+    quint32 total = 0;
+    for (const auto &frame : frames)
+        total += frame.hpackBlockSize();
+
+    if (!total)
+        return hpackBlock;
+
+    hpackBlock.resize(total);
+    auto dst = hpackBlock.begin();
+    for (const auto &frame : frames) {
+        if (const auto hpackBlockSize = frame.hpackBlockSize()) {
+            const uchar *src = frame.hpackBlockBegin();
+            std::copy(src, src + hpackBlockSize, dst);
+            dst += hpackBlockSize;
+        }
+    }
+
+    return hpackBlock;
+}
+
+bool sum_will_overflow(qint32 windowSize, qint32 delta)
+{
+    if (windowSize > 0)
+        return std::numeric_limits<qint32>::max() - windowSize < delta;
+    return std::numeric_limits<qint32>::min() - windowSize > delta;
+}
+
+bool is_connection_specific(const QByteArray &name)
+{
+    // HTTP/2 8.1.2.2 - these are not allowed in HTTP/2 messages:
+    return name == "connection" || name == "keep-alive" || name == "proxy-connection"
+           || name == "transfer-encoding" || name == "upgrade";
+}
+
+}
+
+using namespace Http2;
+
+QHttp2ServerConnection::QHttp2ServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine)
+    : QHttpServerConnection(socket, engine)
+{
+    // Flow control limits what we buffer for request bodies; the
+    // socket must not stop reading frames (WINDOW_UPDATE for example):
+    m_socket->setReadBufferSize(0);
+    streamRecvWindowSize = qint32(engine->requestBufferSize());
+
+    connect(m_socket, &QIODevice::readyRead, this, &QHttp2ServerConnection::_q_readyRead);
+    connect(m_socket, &QAbstractSocket::disconnected, this, &QHttp2ServerConnection::_q_disconnected);
+
+    sendServerSettings();
+
+    if (m_socket->state() != QAbstractSocket::ConnectedState)
+        QMetaObject::invokeMethod(this, "_q_disconnected", Qt::QueuedConnection);
+    else if (m_socket->bytesAvailable())
+        QMetaObject::invokeMethod(this, "_q_readyRead", Qt::QueuedConnection);
+}
+
+bool QHttp2ServerConnection::startUpgraded(QHttpServerRequest *request,
+                                           const QByteArray &http2Settings)
+{
+    Q_ASSERT(request);
+
+    // HTTP/2 3.2.1: the payload of HTTP2-Settings is applied as if it was
+    // a SETTINGS frame, the 101 response acknowledges it implicitly.
+    Q_ASSERT(http2Settings.size() % 6 == 0);
+    auto src = reinterpret_cast<const uchar *>(http2Settings.constData());
+    for (const uchar *end = src + http2Settings.size(); src != end; src += 6) {
+        const Settings identifier = Settings(qFromBigEndian<quint16>(src));
+        const quint32 intVal = qFromBigEndian<quint32>(src + 2);
+        if (!acceptSetting(identifier, intVal)) {
+            delete request;
+            return false;
+        }
+    }
+
+    // The request that carried the upgrade becomes stream 1, half-closed
+    // (remote), the response is sent with HTTP/2.
+    request->setParent(this);
+    QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    requestPrivate->connection = this;
+    requestPrivate->streamID = 1;
+    lastStreamID = 1;
+
+    Stream &stream = createStream(1, request);
+    stream.remoteClosed = true;
+    QHttpServerResponse *response = stream.response;
+    startExchange(request, response);
+
+    return true;
+}
+
+void QHttp2ServerConnection::requestBodyRead(QHttpServerRequest *request, qint64 bytes)
+{
+    const auto it = activeStreams.find(request->d_func()->streamID);
+    if (it == activeStreams.end() || it->request != request || it->remoteClosed)
+        return;
+
+    // We give our peer its credit back once the application consumed half
+    // of the stream's window, this way no more than requestBufferSize()
+    // bytes of a request body are ever buffered:
+    it->consumed += qint32(bytes);
+    if (it->consumed >= streamRecvWindowSize / 2) {
+        sendWINDOW_UPDATE(it->streamID, quint32(it->consumed));
+        it->recvWindow += it->consumed;
+        it->consumed = 0;
+    }
+}
+
+void QHttp2ServerConnection::writeResponseData(QHttpServerResponse *response,
+                                               const char *data, qint64 size)
+{
+    const auto it = activeStreams.find(response->d_func()->streamID);
+    if (it == activeStreams.end() || it->response != response || it->localClosed)
+        return;
+
+    Stream &stream = it.value();
+    if (!stream.headersSent && !sendHEADERS(stream, false))
+        return;
+
+    if (!stream.responseHasBody || !size)
+        return;
+
+    stream.pending.append(QByteArray(data, int(size)));
+    sendDATA(stream);
+}
+
+void QHttp2ServerConnection::finishResponse(QHttpServerResponse *response)
+{
+    const quint32 streamID = response->d_func()->streamID;
+    const auto it = activeStreams.find(streamID);
+    if (it == activeStreams.end() || it->response != response || it->localClosed)
+        return;
+
+    Stream &stream = it.value();
+    stream.responseFinished = true;
+    if (!stream.headersSent)
+        sendHEADERS(stream, true);
+    else
+        sendDATA(stream);
+
+    closeStreamIfDone(streamID);
+}
+
+qint64 QHttp2ServerConnection::responseBytesToWrite(const QHttpServerResponse *response) const
+{
+    const auto it = activeStreams.find(response->d_func()->streamID);
+    if (it == activeStreams.end() || it->response != response)
+        return 0;
+    return it->pending.byteAmount();
+}
+
+void QHttp2ServerConnection::_q_readyRead()
+{
+    if (waitingForPreface && !readClientPreface())
+        return;
+
+    while (m_socket->state() == QAbstractSocket::ConnectedState) {
+        const auto result = frameReader.read(*m_socket);
+        switch (result) {
+        case FrameStatus::incompleteFrame:
+            return;
+        case FrameStatus::protocolError:
+            return connectionError(PROTOCOL_ERROR, "invalid frame");
+        case FrameStatus::sizeError:
+            return connectionError(FRAME_SIZE_ERROR, "invalid frame size");
+        default:
+            break;
+        }
+
+        Q_ASSERT(result == FrameStatus::goodFrame);
+
+        inboundFrame = std::move(frameReader.inboundFrame());
+
+        const auto frameType = inboundFrame.type();
+        if (waitingForSettings) {
+            // HTTP/2 3.5: the client preface ends with a SETTINGS frame.
+            if (frameType != FrameType::SETTINGS)
+                return connectionError(PROTOCOL_ERROR, "SETTINGS expected");
+            waitingForSettings = false;
+        }
+
+        if (continuationExpected && frameType != FrameType::CONTINUATION)
+            return connectionError(PROTOCOL_ERROR, "CONTINUATION expected");
+
+        switch (frameType) {
+        case FrameType::DATA:
+            handleDATA();
+            break;
+        case FrameType::HEADERS:
+            handleHEADERS();
+            break;
+        case FrameType::PRIORITY:
+            handlePRIORITY();
+            break;
+        case FrameType::RST_STREAM:
+            handleRST_STREAM();
+            break;
+        case FrameType::SETTINGS:
+            handleSETTINGS();
+            break;
+        case FrameType::PUSH_PROMISE:
+            handlePUSH_PROMISE();
+            break;
+        case FrameType::PING:
+            handlePING();
+            break;
+        case FrameType::GOAWAY:
+            handleGOAWAY();
+            break;
+        case FrameType::WINDOW_UPDATE:
+            handleWINDOW_UPDATE();
+            break;
+        case FrameType::CONTINUATION:
+            handleCONTINUATION();
+            break;
+        case FrameType::LAST_FRAME_TYPE:
+            // 5.1 - ignore unknown frames.
+            break;
+        }
+    }
+}
+
+void QHttp2ServerConnection::_q_disconnected()
+{
+    goingAway = true;
+    const auto streams = activeStreams;
+    activeStreams.clear();
+    for (const auto &stream : streams)
+        abortExchange(stream.request, stream.response);
+    deleteLater();
+}
+
+bool QHttp2ServerConnection::readClientPreface()
+{
+    // 3.5 HTTP/2 Connection Preface
+    if (m_socket->bytesAvailable() < clientPrefaceLength)
+        return false;
+
+    char preface[clientPrefaceLength] = {};
+    m_socket->read(preface, clientPrefaceLength);
+    if (std::memcmp(preface, Http2clientPreface, clientPrefaceLength)) {
+        qCDebug(QT_HTTP2) << "invalid client connection preface";
+        goingAway = true;
+        m_socket->abort();
+        return false;
+    }
+
+    waitingForPreface = false;
+    return true;
+}
+
+void QHttp2ServerConnection::sendServerSettings()
+{
+    // 6.5 SETTINGS, our part of the connection preface (3.5).
+    frameWriter.start(FrameType::SETTINGS, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(Settings::MAX_CONCURRENT_STREAMS_ID);
+    frameWriter.append(m_engine->maxConcurrentStreams());
+    frameWriter.append(Settings::INITIAL_WINDOW_SIZE_ID);
+    frameWriter.append(quint32(streamRecvWindowSize));
+    frameWriter.append(Settings::MAX_HEADER_LIST_SIZE_ID);
+    frameWriter.append(quint32(MaxHeaderSize));
+    frameWriter.write(*m_socket);
+
+    // The session window only protects us from a client flooding us with
+    // DATA; stream windows already bound what we buffer. So we open it
+    // wide:
+    sessionRecvWindow = maxSessionReceiveWindowSize;
+    sendWINDOW_UPDATE(connectionStreamID, maxSessionReceiveWindowSize - defaultSessionWindowSize);
+}
+
+bool QHttp2ServerConnection::sendHEADERS(Stream &stream, bool endStream)
+{
+    Q_ASSERT(stream.response);
+
+    QHttpServerResponsePrivate *responsePrivate = stream.response->d_func();
+    const int statusCode = responsePrivate->statusCode;
+    if (statusCode < 200 || statusCode == 204 || statusCode == 304)
+        stream.responseHasBody = false;
+
+    frameWriter.start(FrameType::HEADERS, FrameFlag::END_HEADERS, stream.streamID);
+    if (endStream)
+        frameWriter.addFlag(FrameFlag::END_STREAM);
+
+    HPack::HttpHeader header;
+    header.push_back(HPack::HeaderField(":status", QByteArray::number(statusCode)));
+    for (const auto &field : qAsConst(responsePrivate->header.fields)) {
+        // 8.1.2 - header field names MUST be converted to lowercase.
+        const QByteArray name(field.first.toLower());
+        if (!is_connection_specific(name))
+            header.push_back(HPack::HeaderField(name, field.second));
+    }
+
+    HPack::BitOStream outputStream(frameWriter.outboundFrame().buffer);
+    if (!encoder.encodeResponse(outputStream, header)) {
+        connectionError(INTERNAL_ERROR, "HPACK compression failed");
+        return false;
+    }
+
+    stream.headersSent = true;
+    responsePrivate->headersSent = true;
+    if (endStream)
+        stream.localClosed = true;
+
+    return frameWriter.writeHEADERS(*m_socket, maxFrameSize);
+}
+
+void QHttp2ServerConnection::sendDATA(Stream &stream)
+{
+    qint64 written = 0;
+    while (!stream.pending.isEmpty() && stream.sendWindow > 0 && sessionSendWindow > 0) {
+        const qint32 slot = std::min({stream.sendWindow, sessionSendWindow, qint32(maxFrameSize)});
+        const QByteArray chunk(stream.pending.read(slot));
+
+        frameWriter.start(FrameType::DATA, FrameFlag::EMPTY, stream.streamID);
+        if (stream.pending.isEmpty() && stream.responseFinished) {
+            frameWriter.addFlag(FrameFlag::END_STREAM);
+            stream.localClosed = true;
+        }
+        frameWriter.writeDATA(*m_socket, maxFrameSize,
+                              reinterpret_cast<const uchar *>(chunk.constData()), chunk.size());
+
+        stream.sendWindow -= chunk.size();
+        sessionSendWindow -= chunk.size();
+        written += chunk.size();
+    }
+
+    if (stream.pending.isEmpty() && stream.responseFinished && !stream.localClosed) {
+        frameWriter.start(FrameType::DATA, FrameFlag::END_STREAM, stream.streamID);
+        frameWriter.write(*m_socket);
+        stream.localClosed = true;
+    }
+
+    // Queued: we are possibly handling a frame or are called from
+    // QHttpServerResponse::write().
+    if (written && stream.response) {
+        QMetaObject::invokeMethod(stream.response, "bytesWritten", Qt::QueuedConnection,
+                                  Q_ARG(qint64, written));
+    }
+}
+
+bool QHttp2ServerConnection::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
+{
+    frameWriter.start(FrameType::WINDOW_UPDATE, FrameFlag::EMPTY, streamID);
+    frameWriter.append(delta);
+    return frameWriter.write(*m_socket);
+}
+
+bool QHttp2ServerConnection::sendRST_STREAM(quint32 streamID, quint32 errorCode)
+{
+    frameWriter.start(FrameType::RST_STREAM, FrameFlag::EMPTY, streamID);
+    frameWriter.append(errorCode);
+    return frameWriter.write(*m_socket);
+}
+
+bool QHttp2ServerConnection::sendGOAWAY(quint32 errorCode)
+{
+    frameWriter.start(FrameType::GOAWAY, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(lastStreamID);
+    frameWriter.append(errorCode);
+    return frameWriter.write(*m_socket);
+}
+
+void QHttp2ServerConnection::handleDATA()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::DATA);
+
+    const auto streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "DATA on stream 0x0");
+
+    // 6.9.1: padding counts against flow control windows too.
+    const qint32 frameSize = qint32(inboundFrame.payloadSize());
+    if (sessionRecvWindow < frameSize)
+        return connectionError(FLOW_CONTROL_ERROR, "Flow control error");
+
+    sessionRecvWindow -= frameSize;
+    if (sessionRecvWindow < maxSessionReceiveWindowSize / 2) {
+        sendWINDOW_UPDATE(connectionStreamID, maxSessionReceiveWindowSize - sessionRecvWindow);
+        sessionRecvWindow = maxSessionReceiveWindowSize;
+    }
+
+    const auto it = activeStreams.find(streamID);
+    if (it == activeStreams.end() || it->remoteClosed) {
+        if (streamID > lastStreamID)
+            return connectionError(PROTOCOL_ERROR, "DATA on idle stream");
+        sendRST_STREAM(streamID, STREAM_CLOSED);
+        return;
+    }
+
+    Stream &stream = it.value();
+    if (stream.recvWindow < frameSize)
+        return resetStream(streamID, FLOW_CONTROL_ERROR);
+
+    stream.recvWindow -= frameSize;
+    const bool endStream = inboundFrame.flags().testFlag(FrameFlag::END_STREAM);
+    if (endStream)
+        stream.remoteClosed = true;
+
+    const QPointer<QHttpServerRequest> request = stream.request;
+    const qint32 dataSize = qint32(inboundFrame.dataSize());
+    if (stream.responseFinished) {
+        // Nobody will read the rest of this body, but our peer can still
+        // be sending it (8.1):
+        if (!endStream)
+            sendWINDOW_UPDATE(streamID, quint32(frameSize));
+        stream.recvWindow += frameSize;
+    } else {
+        // Padding is never read by the application, count it as consumed:
+        stream.consumed += frameSize - dataSize;
+        if (request && dataSize) {
+            request->d_func()->appendBody(QByteArray(reinterpret_cast<const char *>(inboundFrame.dataBegin()),
+                                                     dataSize));
+        }
+    }
+
+    if (endStream) {
+        if (request)
+            request->d_func()->finishBody();
+        closeStreamIfDone(streamID);
+    }
+}
+
+void QHttp2ServerConnection::handleHEADERS()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::HEADERS);
+
+    const auto streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "HEADERS on 0x0 stream");
+
+    // 5.1.1 - streams initiated by a client use odd-numbered identifiers.
+    if (!(streamID & 0x1))
+        return connectionError(PROTOCOL_ERROR, "HEADERS on invalid stream");
+
+    quint32 dependency = 0;
+    if (inboundFrame.priority(&dependency) && dependency == streamID)
+        return resetStream(streamID, PROTOCOL_ERROR);
+
+    const bool endHeaders = inboundFrame.flags().testFlag(FrameFlag::END_HEADERS);
+    continuedFrames.clear();
+    continuedSize = inboundFrame.hpackBlockSize();
+    continuedFrames.push_back(std::move(inboundFrame));
+    if (!endHeaders) {
+        continuationExpected = true;
+        return;
+    }
+
+    handleContinuedHEADERS();
+}
+
+void QHttp2ServerConnection::handlePRIORITY()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::PRIORITY);
+
+    const auto streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "PRIORITY on 0x0 stream");
+
+    // We do not prioritize responses, but still have to validate the frame:
+    quint32 dependency = 0;
+    if (inboundFrame.priority(&dependency) && dependency == streamID)
+        resetStream(streamID, PROTOCOL_ERROR);
+}
+
+void QHttp2ServerConnection::handleRST_STREAM()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::RST_STREAM);
+
+    const auto streamID = inboundFrame.streamID();
+    if (streamID == connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "RST_STREAM on 0x0");
+
+    if (streamID > lastStreamID)
+        return connectionError(PROTOCOL_ERROR, "RST_STREAM on idle stream");
+
+    const auto it = activeStreams.find(streamID);
+    if (it == activeStreams.end())
+        return;
+
+    const Stream stream = it.value();
+    activeStreams.erase(it);
+    abortExchange(stream.request, stream.response);
+    if (stream.request)
+        stream.request->deleteLater();
+    if (stream.response)
+        stream.response->deleteLater();
+}
+
+void QHttp2ServerConnection::handleSETTINGS()
+{
+    // 6.5 SETTINGS.
+    Q_ASSERT(inboundFrame.type() == FrameType::SETTINGS);
+
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "SETTINGS on invalid stream");
+
+    if (inboundFrame.flags().testFlag(FrameFlag::ACK))
+        return;
+
+    if (inboundFrame.dataSize()) {
+        auto src = inboundFrame.dataBegin();
+        for (const uchar *end = src + inboundFrame.dataSize(); src != end; src += 6) {
+            const Settings identifier = Settings(qFromBigEndian<quint16>(src));
+            const quint32 intVal = qFromBigEndian<quint32>(src + 2);
+            if (!acceptSetting(identifier, intVal)) {
+                // If not accepted - we finish with connectionError.
+                return;
+            }
+        }
+    }
+
+    frameWriter.start(FrameType::SETTINGS, FrameFlag::ACK, connectionStreamID);
+    frameWriter.write(*m_socket);
+
+    resumeStreams();
+}
+
+void QHttp2ServerConnection::handlePUSH_PROMISE()
+{
+    // 8.2 - a client cannot push.
+    connectionError(PROTOCOL_ERROR, "PUSH_PROMISE from a client");
+}
+
+void QHttp2ServerConnection::handlePING()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::PING);
+
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "PING on invalid stream");
+
+    // We never send PING, so there is nothing to do with an ACK.
+    if (inboundFrame.flags() & FrameFlag::ACK)
+        return;
+
+    Q_ASSERT(inboundFrame.dataSize() == 8);
+
+    frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
+    frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
+    frameWriter.write(*m_socket);
+}
+
+void QHttp2ServerConnection::handleGOAWAY()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::GOAWAY);
+
+    if (inboundFrame.streamID() != connectionStreamID)
+        return connectionError(PROTOCOL_ERROR, "GOAWAY on invalid stream");
+
+    // We never initiate streams, so there is nothing the client could have
+    // refused; we finish the streams we have and close the connection.
+    goingAway = true;
+    if (activeStreams.isEmpty())
+        m_socket->disconnectFromHost();
+}
+
+void QHttp2ServerConnection::handleWINDOW_UPDATE()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::WINDOW_UPDATE);
+
+    const quint32 delta = qFromBigEndian<quint32>(inboundFrame.dataBegin()) & 0x7fffffff;
+    const bool valid = delta != 0;
+    const auto streamID = inboundFrame.streamID();
+
+    if (streamID == connectionStreamID) {
+        if (!valid || sum_will_overflow(sessionSendWindow, delta))
+            return connectionError(PROTOCOL_ERROR, "WINDOW_UPDATE invalid delta");
+        sessionSendWindow += delta;
+        resumeStreams();
+    } else {
+        const auto it = activeStreams.find(streamID);
+        if (it == activeStreams.end()) {
+            // WINDOW_UPDATE on closed streams can be ignored.
+            return;
+        }
+        if (!valid || sum_will_overflow(it->sendWindow, delta))
+            return resetStream(streamID, PROTOCOL_ERROR);
+        it->sendWindow += delta;
+        sendDATA(it.value());
+        closeStreamIfDone(streamID);
+    }
+}
+
+void QHttp2ServerConnection::handleCONTINUATION()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::CONTINUATION);
+
+    if (!continuationExpected)
+        return connectionError(PROTOCOL_ERROR, "unexpected CONTINUATION frame");
+
+    Q_ASSERT(continuedFrames.size());
+    if (inboundFrame.streamID() != continuedFrames.front().streamID())
+        return connectionError(PROTOCOL_ERROR, "CONTINUATION on invalid stream");
+
+    // A header block we would refuse anyway must not make us buffer an
+    // unbounded number of CONTINUATION frames:
+    continuedSize += inboundFrame.payloadSize();
+    if (continuedSize > quint32(MaxHeaderSize))
+        return connectionError(ENHANCE_YOUR_CALM, "header block too large");
+
+    const bool endHeaders = inboundFrame.flags().testFlag(FrameFlag::END_HEADERS);
+    continuedFrames.push_back(std::move(inboundFrame));
+
+    if (!endHeaders)
+        return;
+
+    continuationExpected = false;
+    handleContinuedHEADERS();
+}
+
+void QHttp2ServerConnection::handleContinuedHEADERS()
+{
+    Q_ASSERT(continuedFrames.size());
+    Q_ASSERT(continuedFrames[0].type() == FrameType::HEADERS);
+
+    const auto streamID = continuedFrames[0].streamID();
+    const bool endStream = continuedFrames[0].flags().testFlag(FrameFlag::END_STREAM);
+
+    // Even if we end up refusing the stream, the header block
+    // changes the HPACK context and must be decoded:
+    // A header block in a single frame (the common case) is decoded in place.
+    const uchar *hpackBlockBegin = continuedFrames[0].hpackBlockBegin();
+    quint32 hpackBlockSize = continuedFrames[0].hpackBlockSize();
+    std::vector<uchar> hpackBlock;
+    if (continuedFrames.size() > 1) {
+        hpackBlock = assemble_hpack_block(continuedFrames);
+        hpackBlockBegin = hpackBlock.data();
+        hpackBlockSize = quint32(hpackBlock.size());
+    }
+
+    HPack::HttpHeader header;
+    bool decoded = true;
+    if (hpackBlockSize) {
+        HPack::BitIStream inputStream{hpackBlockBegin, hpackBlockBegin + hpackBlockSize};
+        decoded = decoder.decodeHeaderFields(inputStream);
+        header = decoder.decodedHeader();
+    }
+    continuedFrames.clear();
+    if (!decoded)
+        return connectionError(COMPRESSION_ERROR, "HPACK decompression failed");
+
+    // 6.5.2 - we announced MaxHeaderSize as SETTINGS_MAX_HEADER_LIST_SIZE.
+    const HPack::HeaderSize headerSize = HPack::header_size(header);
+    const bool headerTooLarge = !headerSize.first || headerSize.second > quint32(MaxHeaderSize);
+
+    const auto it = activeStreams.find(streamID);
+    if (it != activeStreams.end()) {
+        // Trailing header fields; 8.1 - they must end the stream.
+        if (it->remoteClosed)
+            return resetStream(streamID, STREAM_CLOSED);
+        if (!endStream || headerTooLarge)
+            return resetStream(streamID, PROTOCOL_ERROR);
+
+        it->remoteClosed = true;
+        if (const QPointer<QHttpServerRequest> request = it->request)
+            request->d_func()->finishBody();
+        return closeStreamIfDone(streamID);
+    }
+
+    if (streamID <= lastStreamID)
+        return connectionError(STREAM_CLOSED, "HEADERS on closed stream");
+
+    lastStreamID = streamID;
+
+    if (goingAway || quint32(activeStreams.size()) >= m_engine->maxConcurrentStreams()) {
+        sendRST_STREAM(streamID, REFUSE_STREAM);
+        return;
+    }
+
+    QHttpServerRequest *request = headerTooLarge ? nullptr : createRequest(streamID, header);
+    if (!request) {
+        // 8.1.2.6 - malformed requests are a stream error, we treat
+        // requests with too large headers the same way.
+        sendRST_STREAM(streamID, PROTOCOL_ERROR);
+        return;
+    }
+
+    Stream &stream = createStream(streamID, request);
+    if (endStream) {
+        stream.remoteClosed = true;
+        request->d_func()->bodyFinished = true;
+    }
+
+    QHttpServerResponse *response = stream.response;
+    startExchange(request, response);
+}
+
+bool QHttp2ServerConnection::acceptSetting(Http2::Settings identifier, quint32 newValue)
+{
+    if (identifier == Settings::HEADER_TABLE_SIZE_ID) {
+        if (newValue > maxAcceptableTableSize) {
+            connectionError(PROTOCOL_ERROR, "SETTINGS invalid table size");
+            return false;
+        }
+        encoder.setMaxDynamicTableSize(newValue);
+    }
+
+    if (identifier == Settings::INITIAL_WINDOW_SIZE_ID) {
+        // For every active stream - adjust its window
+        // (and handle possible overflows as errors).
+        if (newValue > quint32(std::numeric_limits<qint32>::max())) {
+            connectionError(FLOW_CONTROL_ERROR, "SETTINGS invalid initial window size");
+            return false;
+        }
+
+        const qint32 delta = qint32(newValue) - streamInitialSendWindow;
+        streamInitialSendWindow = newValue;
+
+        for (auto &stream : activeStreams) {
+            if (sum_will_overflow(stream.sendWindow, delta)) {
+                connectionError(FLOW_CONTROL_ERROR, "SETTINGS window overflow");
+                return false;
+            }
+            stream.sendWindow += delta;
+        }
+    }
+
+    if (identifier == Settings::ENABLE_PUSH_ID) {
+        if (newValue > 1) {
+            connectionError(PROTOCOL_ERROR, "SETTINGS invalid ENABLE_PUSH value");
+            return false;
+        }
+        // We never push, so the value does not matter.
+    }
+
+    if (identifier == Settings::MAX_FRAME_SIZE_ID) {
+        if (newValue < Http2::maxFrameSize || newValue > Http2::maxPayloadSize) {
+            connectionError(PROTOCOL_ERROR, "SETTINGS max frame size is out of range");
+            return false;
+        }
+        maxFrameSize = newValue;
+    }
+
+    // MAX_CONCURRENT_STREAMS limits pushed streams, MAX_HEADER_LIST_SIZE is
+    // advisory - we ignore both.
+
+    return true;
+}
+
+QHttpServerRequest *QHttp2ServerConnection::createRequest(quint32 streamID,
+                                                          const HPack::HttpHeader &header)
+{
+    QScopedPointer<QHttpServerRequest> request(new QHttpServerRequest(this, streamID));
+    QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    requestPrivate->majorVersion = 2;
+    requestPrivate->minorVersion = 0;
+
+    QByteArray scheme;
+    QByteArray authority;
+    QByteArray path;
+    for (const auto &field : header) {
+        if (!field.name.startsWith(':')) {
+            if (is_connection_specific(field.name))
+                return nullptr;
+            requestPrivate->header.fields.append(qMakePair(field.name, field.value));
+            continue;
+        }
+
+        // 8.1.2.1 - pseudo-header fields precede regular ones:
+        if (!requestPrivate->header.fields.isEmpty())
+            return nullptr;
+
+        if (field.name == ":method")
+            requestPrivate->method = field.value;
+        else if (field.name == ":scheme")
+            scheme = field.value;
+        else if (field.name == ":authority")
+            authority = field.value;
+        else if (field.name == ":path")
+            path = field.value;
+        else
+            return nullptr;
+    }
+
+    // 8.1.2.3 - all requests except CONNECT have :method, :scheme and :path.
+    if (requestPrivate->method.isEmpty())
+        return nullptr;
+    if (requestPrivate->method != "CONNECT" && (scheme.isEmpty() || path.isEmpty()))
+        return nullptr;
+
+    if (authority.isEmpty())
+        authority = requestPrivate->header.headerField("host");
+    requestPrivate->header.url = QUrl::fromEncoded(scheme + "://" + authority + path);
+
+    return request.take();
+}
+
+QHttp2ServerConnection::Stream &QHttp2ServerConnection::createStream(quint32 streamID,
+                                                                    QHttpServerRequest *request)
+{
+    Stream stream;
+    stream.streamID = streamID;
+    stream.request = request;
+    stream.response = new QHttpServerResponse(this, streamID);
+    stream.sendWindow = streamInitialSendWindow;
+    stream.recvWindow = streamRecvWindowSize;
+    stream.responseHasBody = request->method() != "HEAD";
+
+    return activeStreams.insert(streamID, stream).value();
+}
+
+void QHttp2ServerConnection::resumeStreams()
+{
+    // sendDATA() does not add or remove streams, but closeStreamIfDone()
+    // does, so we iterate over a copy of the keys:
+    const auto streamIDs = activeStreams.keys();
+    for (quint32 streamID : streamIDs) {
+        const auto it = activeStreams.find(streamID);
+        if (it == activeStreams.end())
+            continue;
+        if (sessionSendWindow <= 0)
+            break;
+        sendDATA(it.value());
+        closeStreamIfDone(streamID);
+    }
+}
+
+void QHttp2ServerConnection::closeStreamIfDone(quint32 streamID)
+{
+    const auto it = activeStreams.find(streamID);
+    if (it == activeStreams.end() || !it->remoteClosed || !it->localClosed)
+        return;
+
+    if (it->request)
+        it->request->deleteLater();
+    if (it->response)
+        it->response->deleteLater();
+    activeStreams.erase(it);
+
+    if (goingAway && activeStreams.isEmpty())
+        m_socket->disconnectFromHost();
+}
+
+void QHttp2ServerConnection::resetStream(quint32 streamID, quint32 errorCode)
+{
+    sendRST_STREAM(streamID, errorCode);
+
+    const auto it = activeStreams.find(streamID);
+    if (it == activeStreams.end())
+        return;
+
+    const Stream stream = it.value();
+    activeStreams.erase(it);
+    abortExchange(stream.request, stream.response);
+    if (stream.request)
+        stream.request->deleteLater();
+    if (stream.response)
+        stream.response->deleteLater();
+}
+
+void QHttp2ServerConnection::connectionError(Http2::Http2Error errorCode, const char *message)
+{
+    Q_ASSERT(message);
+
+    if (m_socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    qCWarning(QT_HTTP2) << "connection error:" << message;
+
+    goingAway = true;
+    sendGOAWAY(errorCode);
+
+    const auto streams = activeStreams;
+    activeStreams.clear();
+    for (const auto &stream : streams)
+        abortExchange(stream.request, stream.response);
+
+    m_socket->disconnectFromHost();
+}
+
+QT_END_NAMESPACE
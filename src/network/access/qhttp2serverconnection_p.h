@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QHTTP2SERVERCONNECTION_P_H
+#define QHTTP2SERVERCONNECTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qhttpserverconnection_p.h>
+#include <private/qbytedata_p.h>
+
+#include <private/http2protocol_p.h>
+#include <private/http2frames_p.h>
+#include <private/hpack_p.h>
+
+#include <QtCore/qhash.h>
+
+#include <vector>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QHttp2ServerConnection : public QHttpServerConnection
+{
+    Q_OBJECT
+public:
+    QHttp2ServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine);
+
+    bool startUpgraded(QHttpServerRequest *request, const QByteArray &http2Settings);
+
+    void requestBodyRead(QHttpServerRequest *request, qint64 bytes) override;
+    void writeResponseData(QHttpServerResponse *response,
+                           const char *data, qint64 size) override;
+    void finishResponse(QHttpServerResponse *response) override;
+    qint64 responseBytesToWrite(const QHttpServerResponse *response) const override;
+
+private Q_SLOTS:
+    void _q_readyRead();
+    void _q_disconnected();
+
+private:
+    struct Stream
+    {
+        quint32 streamID = 0;
+        QPointer<QHttpServerRequest> request;
+        QPointer<QHttpServerResponse> response;
+        qint32 sendWindow = Http2::defaultSessionWindowSize;
+        qint32 recvWindow = Http2::defaultSessionWindowSize;
+        // DATA the application has consumed, but we have not yet
+        // returned to our peer with a WINDOW_UPDATE frame:
+        qint32 consumed = 0;
+        QByteDataBuffer pending;
+        bool responseHasBody = true;
+        bool remoteClosed = false;
+        bool responseFinished = false;
+        bool headersSent = false;
+        bool localClosed = false;
+    };
+
+    bool readClientPreface();
+    void sendServerSettings();
+
+    bool sendHEADERS(Stream &stream, bool endStream);
+    void sendDATA(Stream &stream);
+    bool sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    bool sendRST_STREAM(quint32 streamID, quint32 errorCode);
+    bool sendGOAWAY(quint32 errorCode);
+
+    void handleDATA();
+    void handleHEADERS();
+    void handlePRIORITY();
+    void handleRST_STREAM();
+    void handleSETTINGS();
+    void handlePUSH_PROMISE();
+    void handlePING();
+    void handleGOAWAY();
+    void handleWINDOW_UPDATE();
+    void handleCONTINUATION();
+    void handleContinuedHEADERS();
+
+    bool acceptSetting(Http2::Settings identifier, quint32 newValue);
+    QHttpServerRequest *createRequest(quint32 streamID, const HPack::HttpHeader &header);
+    Stream &createStream(quint32 streamID, QHttpServerRequest *request);
+    void resumeStreams();
+    void closeStreamIfDone(quint32 streamID);
+    void resetStream(quint32 streamID, quint32 errorCode);
+    void connectionError(Http2::Http2Error errorCode, const char *message);
+
+    Http2::FrameReader frameReader;
+    Http2::Frame inboundFrame;
+    Http2::FrameWriter frameWriter;
+
+    HPack::Decoder decoder{HPack::FieldLookupTable::DefaultSize};
+    HPack::Encoder encoder{HPack::FieldLookupTable::DefaultSize, true};
+
+    std::vector<Http2::Frame> continuedFrames;
+    quint32 continuedSize = 0;
+    bool continuationExpected = false;
+
+    QHash<quint32, Stream> activeStreams;
+    quint32 lastStreamID = 0;
+
+    bool waitingForPreface = true;
+    bool waitingForSettings = true;
+    bool goingAway = false;
+
+    qint32 sessionSendWindow = Http2::defaultSessionWindowSize;
+    qint32 sessionRecvWindow = Http2::defaultSessionWindowSize;
+    qint32 streamInitialSendWindow = Http2::defaultSessionWindowSize;
+    qint32 streamRecvWindowSize = Http2::defaultSessionWindowSize;
+    quint32 maxFrameSize = Http2::maxFrameSize;
+
+    static const quint32 maxAcceptableTableSize = 16 * HPack::FieldLookupTable::DefaultSize;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTP2SERVERCONNECTION_P_H
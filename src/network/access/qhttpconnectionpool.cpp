@@ -0,0 +1,397 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttpconnectionpool.h"
+#include "qhttpconnectionpool_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpConnectionPoolPolicy
+    \brief The QHttpConnectionPoolPolicy class controls how many HTTP/1.1
+           connections QNetworkAccessManager keeps to a host.
+    \since 5.12
+    \ingroup network
+    \inmodule QtNetwork
+
+    QNetworkAccessManager sends HTTP/1.1 requests to a host over a pool of
+    parallel connections. Requests that cannot be sent immediately are queued
+    until one of the connections becomes free. The policy decides the size of
+    that pool, how long it is kept open after the last request finished and
+    how many of its connections are opened before they are needed.
+
+    A policy takes effect when the pool for a host is created, that is for
+    the first request to the host or after the idle timeout of a previous pool
+    has expired. Calling QNetworkAccessManager::clearConnectionCache() drops
+    all existing pools.
+
+    \sa QNetworkAccessManager::setConnectionPoolPolicy(), QHttpConnectionPoolStatistics
+*/
+
+/*!
+    Returns \c true if \a lhs and \a rhs have the same maximum number of
+    connections, idle timeout and number of prewarmed connections.
+*/
+bool operator==(const QHttpConnectionPoolPolicy &lhs, const QHttpConnectionPoolPolicy &rhs)
+{
+    return *lhs.d == *rhs.d;
+}
+
+/*!
+    \fn bool operator!=(const QHttpConnectionPoolPolicy &lhs, const QHttpConnectionPoolPolicy &rhs)
+    \relates QHttpConnectionPoolPolicy
+
+    Returns \c true if \a lhs and \a rhs differ.
+*/
+
+/*!
+    Constructs the default policy: at most six connections per host, an idle
+    timeout of two minutes and no prewarmed connections.
+*/
+QHttpConnectionPoolPolicy::QHttpConnectionPoolPolicy()
+    : d(new QHttpConnectionPoolPolicyPrivate)
+{
+}
+
+/*!
+    Creates a copy of \a other.
+*/
+QHttpConnectionPoolPolicy::QHttpConnectionPoolPolicy(const QHttpConnectionPoolPolicy &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Copies \a other into this policy.
+*/
+QHttpConnectionPoolPolicy &QHttpConnectionPoolPolicy::operator=(const QHttpConnectionPoolPolicy &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QHttpConnectionPoolPolicy &QHttpConnectionPoolPolicy::operator=(QHttpConnectionPoolPolicy &&other)
+
+    Move-assigns \a other to this policy.
+*/
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolPolicy::~QHttpConnectionPoolPolicy()
+{
+}
+
+/*!
+    \fn void QHttpConnectionPoolPolicy::swap(QHttpConnectionPoolPolicy &other)
+
+    Swaps this policy with \a other. This operation is very fast and never fails.
+*/
+
+/*!
+    Sets the maximum number of parallel connections to a host to \a count.
+    Values outside the range 1 to 65535 are ignored.
+
+    HTTP/2 and SPDY multiplex all requests over one connection and are not
+    affected by this setting, except when the protocol negotiation falls
+    back to HTTP/1.1.
+
+    \sa maximumConnections()
+*/
+void QHttpConnectionPoolPolicy::setMaximumConnections(int count)
+{
+    if (count < 1 || count > 0xffff) {
+        qWarning("QHttpConnectionPoolPolicy::setMaximumConnections: invalid count %d", count);
+        return;
+    }
+    d->maximumConnections = count;
+}
+
+/*!
+    Returns the maximum number of parallel connections to a host.
+    The default is 6.
+
+    \sa setMaximumConnections()
+*/
+int QHttpConnectionPoolPolicy::maximumConnections() const
+{
+    return d->maximumConnections;
+}
+
+/*!
+    Sets the time, in milliseconds, the pool for a host is kept open after
+    the last request to it finished to \a msecs. Negative values are ignored.
+
+    \sa idleTimeout()
+*/
+void QHttpConnectionPoolPolicy::setIdleTimeout(int msecs)
+{
+    if (msecs < 0) {
+        qWarning("QHttpConnectionPoolPolicy::setIdleTimeout: invalid timeout %d", msecs);
+        return;
+    }
+    d->idleTimeout = msecs;
+}
+
+/*!
+    Returns the idle timeout in milliseconds. The default is 120000.
+
+    \sa setIdleTimeout()
+*/
+int QHttpConnectionPoolPolicy::idleTimeout() const
+{
+    return d->idleTimeout;
+}
+
+/*!
+    Sets the number of connections that are opened as soon as the pool for a
+    host is created to \a count, so that subsequent requests do not have to
+    wait for the TCP (and TLS) handshake. The number is bounded by
+    maximumConnections(). Negative values are ignored.
+
+    \sa prewarmedConnections(), QNetworkAccessManager::connectToHost()
+*/
+void QHttpConnectionPoolPolicy::setPrewarmedConnections(int count)
+{
+    if (count < 0) {
+        qWarning("QHttpConnectionPoolPolicy::setPrewarmedConnections: invalid count %d", count);
+        return;
+    }
+    d->prewarmedConnections = count;
+}
+
+/*!
+    Returns the number of prewarmed connections. The default is 0.
+
+    \sa setPrewarmedConnections()
+*/
+int QHttpConnectionPoolPolicy::prewarmedConnections() const
+{
+    return d->prewarmedConnections;
+}
+
+/*!
+    \class QHttpConnectionPoolStatistics
+    \brief The QHttpConnectionPoolStatistics class describes how the HTTP
+           connection pool for a host has been used.
+    \since 5.12
+    \ingroup network
+    \inmodule QtNetwork
+
+    The statistics are a snapshot taken by
+    QNetworkAccessManager::connectionPoolStatistics(). They accumulate over
+    the lifetime of the manager, across pools that expired and were created
+    again, and are meant to help choosing a QHttpConnectionPoolPolicy for
+    the host.
+
+    \sa QHttpConnectionPoolPolicy
+*/
+
+/*!
+    Constructs empty statistics.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics()
+    : d(new QHttpConnectionPoolStatisticsPrivate)
+{
+}
+
+/*!
+    Creates a copy of \a other.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(const QHttpConnectionPoolStatistics &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Copies \a other into this object.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(const QHttpConnectionPoolStatistics &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(QHttpConnectionPoolStatistics &&other)
+
+    Move-assigns \a other to this object.
+*/
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolStatistics::~QHttpConnectionPoolStatistics()
+{
+}
+
+/*!
+    \fn void QHttpConnectionPoolStatistics::swap(QHttpConnectionPoolStatistics &other)
+
+    Swaps this object with \a other. This operation is very fast and never fails.
+*/
+
+/*!
+    Returns the number of requests that were waiting for a free connection
+    when the snapshot was taken.
+
+    \sa peakQueueDepth()
+*/
+int QHttpConnectionPoolStatistics::queueDepth() const
+{
+    return d->queueDepth;
+}
+
+/*!
+    Returns the largest number of requests that were waiting for a free
+    connection at the same time.
+
+    \sa queueDepth()
+*/
+int QHttpConnectionPoolStatistics::peakQueueDepth() const
+{
+    return d->peakQueueDepth;
+}
+
+/*!
+    Returns the number of requests that were assigned to a connection.
+*/
+qint64 QHttpConnectionPoolStatistics::requestCount() const
+{
+    return d->requestCount;
+}
+
+/*!
+    Returns the number of requests that were sent over a connection that was
+    already open, either because it served an earlier request or because it
+    was prewarmed.
+
+    \sa reuseRate()
+*/
+qint64 QHttpConnectionPoolStatistics::reusedConnectionRequestCount() const
+{
+    return d->reusedCount;
+}
+
+/*!
+    Returns the fraction, between 0 and 1, of requests that did not have to
+    wait for a new connection to be established.
+
+    \sa reusedConnectionRequestCount(), requestCount()
+*/
+qreal QHttpConnectionPoolStatistics::reuseRate() const
+{
+    return d->requestCount ? qreal(d->reusedCount) / qreal(d->requestCount) : qreal(0);
+}
+
+/*!
+    Returns the number of connections that were established.
+*/
+qint64 QHttpConnectionPoolStatistics::connectionCount() const
+{
+    return d->connectionCount;
+}
+
+/*!
+    Returns the average time, in milliseconds, it took to establish a
+    connection, including the TLS handshake for encrypted connections.
+
+    \sa maximumConnectLatency()
+*/
+qint64 QHttpConnectionPoolStatistics::averageConnectLatency() const
+{
+    return d->connectionCount ? d->totalConnectLatency / d->connectionCount : 0;
+}
+
+/*!
+    Returns the longest time, in milliseconds, it took to establish a
+    connection.
+
+    \sa averageConnectLatency()
+*/
+qint64 QHttpConnectionPoolStatistics::maximumConnectLatency() const
+{
+    return d->maximumConnectLatency;
+}
+
+template <typename T>
+static void storeMaximum(QAtomicInteger<T> &maximum, T value)
+{
+    T current = maximum.load();
+    while (value > current && !maximum.testAndSetRelaxed(current, value, current))
+        ;
+}
+
+void QHttpConnectionPoolStatisticsCollector::recordQueueDepth(int depth)
+{
+    queueDepth.store(depth);
+    storeMaximum(peakQueueDepth, depth);
+}
+
+void QHttpConnectionPoolStatisticsCollector::recordRequest(bool reusedConnection)
+{
+    requestCount.ref();
+    if (reusedConnection)
+        reusedCount.ref();
+}
+
+void QHttpConnectionPoolStatisticsCollector::recordConnect(qint64 latency)
+{
+    connectionCount.ref();
+    totalConnectLatency.fetchAndAddRelaxed(latency);
+    storeMaximum(maximumConnectLatency, latency);
+}
+
+QHttpConnectionPoolStatistics QHttpConnectionPoolStatisticsCollector::snapshot() const
+{
+    QHttpConnectionPoolStatistics result;
+    QHttpConnectionPoolStatisticsPrivate *d = result.d.data();
+    d->queueDepth = queueDepth.load();
+    d->peakQueueDepth = peakQueueDepth.load();
+    d->requestCount = requestCount.load();
+    d->reusedCount = reusedCount.load();
+    d->connectionCount = connectionCount.load();
+    d->totalConnectLatency = totalConnectLatency.load();
+    d->maximumConnectLatency = maximumConnectLatency.load();
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QHTTPCONNECTIONPOOL_P_H
+#define QHTTPCONNECTIONPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "qhttpconnectionpool.h"
+
+#include <QtCore/qatomic.h>
+
+QT_BEGIN_NAMESPACE
+
+class QHttpConnectionPoolPolicyPrivate : public QSharedData
+{
+public:
+    int maximumConnections = 6;
+    int idleTimeout = 120000;
+    int prewarmedConnections = 0;
+
+    bool operator==(const QHttpConnectionPoolPolicyPrivate &other) const
+    {
+        return maximumConnections == other.maximumConnections
+               && idleTimeout == other.idleTimeout
+               && prewarmedConnections == other.prewarmedConnections;
+    }
+};
+
+class QHttpConnectionPoolStatisticsPrivate : public QSharedData
+{
+public:
+    int queueDepth = 0;
+    int peakQueueDepth = 0;
+    qint64 requestCount = 0;
+    qint64 reusedCount = 0;
+    qint64 connectionCount = 0;
+    qint64 totalConnectLatency = 0;
+    qint64 maximumConnectLatency = 0;
+};
+
+// Shared between the QNetworkAccessManager (which hands out snapshots) and the
+// QHttpNetworkConnection living in the HTTP thread (which records into it).
+class Q_AUTOTEST_EXPORT QHttpConnectionPoolStatisticsCollector
+{
+public:
+    void recordQueueDepth(int depth);
+    void recordRequest(bool reusedConnection);
+    void recordConnect(qint64 latency);
+
+    QHttpConnectionPoolStatistics snapshot() const;
+
+private:
+    QAtomicInt queueDepth;
+    QAtomicInt peakQueueDepth;
+    QAtomicInteger<qint64> requestCount;
+    QAtomicInteger<qint64> reusedCount;
+    QAtomicInteger<qint64> connectionCount;
+    QAtomicInteger<qint64> totalConnectLatency;
+    QAtomicInteger<qint64> maximumConnectLatency;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTPCONNECTIONPOOL_P_H
@@ -40,6 +40,7 @@
 #include "qhttpnetworkconnection_p.h"
 #include <private/qabstractsocket_p.h>
 #include "qhttpnetworkconnectionchannel_p.h"
+#include "qhttpconnectionpool_p.h"
 #include "private/qnoncontiguousbytedevice_p.h"
 #include <private/qnetworkrequest_p.h>
 #include <private/qobject_p.h>
@@ -105,7 +106,13 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                     || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+#ifndef QT_NO_SSL
+                     || type == QHttpNetworkConnection::ConnectionTypeSPDY
+#endif
+                     ? 1 : connectionCount),
+  channelCount(connectionCount)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
@@ -127,6 +134,14 @@ QHttpNetworkConnectionPrivate::~QHttpNetworkConnectionPrivate()
         }
     }
     delete []channels;
+
+    // nobody else owns the replies of prewarming requests that never finished
+    for (const QPointer<QHttpNetworkReply> &reply : qAsConst(prewarmReplies)) {
+        if (reply) {
+            reply->d_func()->connection = nullptr;
+            delete reply;
+        }
+    }
 }
 
 void QHttpNetworkConnectionPrivate::init()
@@ -637,6 +652,7 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
             lowPriorityQueue.prepend(pair);
             break;
         }
+        updateQueueStatistics();
     }
     else { // SPDY, HTTP/2 ('h2' mode)
         if (!pair.second->d_func()->requestIsPrepared)
@@ -705,6 +721,7 @@ void QHttpNetworkConnectionPrivate::requeueRequest(const HttpMessagePair &pair)
         lowPriorityQueue.prepend(pair);
         break;
     }
+    updateQueueStatistics();
 
     QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
 }
@@ -721,6 +738,7 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         updateChannel(i, messagePair);
+        updateQueueStatistics();
         return true;
     }
 
@@ -730,6 +748,7 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         updateChannel(i, messagePair);
+        updateQueueStatistics();
         return true;
     }
     return false;
@@ -737,6 +756,17 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
 
 void QHttpNetworkConnectionPrivate::updateChannel(int i, const HttpMessagePair &messagePair)
 {
+    if (poolStatistics && !messagePair.first.isPreConnect()) {
+        // a request on a socket that is already connected did not have
+        // to wait for a handshake, whether the socket served an earlier
+        // request or was opened by a prewarming request
+        const bool reused = channels[i].socket
+                && channels[i].socket->state() == QAbstractSocket::ConnectedState
+                && !channels[i].freshConnection;
+        poolStatistics->recordRequest(reused);
+    }
+    channels[i].freshConnection = false;
+
     channels[i].request = messagePair.first;
     channels[i].reply = messagePair.second;
     // Now that reply is assigned a channel, correct reply to channel association
@@ -866,6 +896,10 @@ bool QHttpNetworkConnectionPrivate::fillPipeline(QList<HttpMessagePair> &queue,
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         channel.pipelineInto(messagePair);
+        if (poolStatistics) {
+            poolStatistics->recordRequest(true);
+            updateQueueStatistics();
+        }
 
         // return false because we processed something and need to process again
         return false;
@@ -1000,6 +1034,7 @@ void QHttpNetworkConnectionPrivate::removeReply(QHttpNetworkReply *reply)
             HttpMessagePair messagePair = highPriorityQueue.at(j);
             if (messagePair.second == reply) {
                 highPriorityQueue.removeAt(j);
+                updateQueueStatistics();
                 QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
                 return;
             }
@@ -1011,6 +1046,7 @@ void QHttpNetworkConnectionPrivate::removeReply(QHttpNetworkReply *reply)
             HttpMessagePair messagePair = lowPriorityQueue.at(j);
             if (messagePair.second == reply) {
                 lowPriorityQueue.removeAt(j);
+                updateQueueStatistics();
                 QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
                 return;
             }
@@ -1136,6 +1172,39 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
 }
 
 
+// Opens up to count channels ahead of time by queueing preconnect requests,
+// the same way QNetworkAccessManager::connectToHost() does.
+void QHttpNetworkConnectionPrivate::prewarmConnections(int count)
+{
+    // SPDY and HTTP/2 multiplex everything over one connection, which the
+    // first request opens anyway
+    if (connectionType != QHttpNetworkConnection::ConnectionTypeHTTP)
+        return;
+
+    prewarmReplies.removeAll(QPointer<QHttpNetworkReply>());
+
+    QUrl url;
+    url.setScheme(encrypt ? QStringLiteral("preconnect-https") : QStringLiteral("preconnect-http"));
+    url.setHost(hostName);
+    url.setPort(port);
+
+    count = qMin(count, activeChannelCount);
+    for (int i = 0; i < count; ++i) {
+        QHttpNetworkRequest request(url);
+        request.setPreConnect(true);
+        QHttpNetworkReply *reply = queueRequest(request);
+        QObject::connect(reply, &QHttpNetworkReply::finished, reply, &QObject::deleteLater);
+        QObject::connect(reply, &QHttpNetworkReply::finishedWithError, reply, &QObject::deleteLater);
+        prewarmReplies.append(reply);
+    }
+}
+
+void QHttpNetworkConnectionPrivate::updateQueueStatistics()
+{
+    if (poolStatistics)
+        poolStatistics->recordQueueDepth(highPriorityQueue.count() + lowPriorityQueue.count());
+}
+
 void QHttpNetworkConnectionPrivate::readMoreLater(QHttpNetworkReply *reply)
 {
     for (int i = 0 ; i < activeChannelCount; ++i) {
@@ -1518,6 +1587,18 @@ void QHttpNetworkConnection::preConnectFinished()
     d_func()->preConnectRequests--;
 }
 
+void QHttpNetworkConnection::prewarmConnections(int count)
+{
+    Q_D(QHttpNetworkConnection);
+    d->prewarmConnections(count);
+}
+
+void QHttpNetworkConnection::setPoolStatistics(const QSharedPointer<QHttpConnectionPoolStatisticsCollector> &statistics)
+{
+    Q_D(QHttpNetworkConnection);
+    d->poolStatistics = statistics;
+}
+
 #ifndef QT_NO_NETWORKPROXY
 // only called from QHttpNetworkConnectionChannel::_q_proxyAuthenticationRequired, not
 // from QHttpNetworkConnectionChannel::handleAuthenticationChallenge
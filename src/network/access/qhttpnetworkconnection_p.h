@@ -80,6 +80,7 @@ class QHttpNetworkReply;
 class QHttpThreadDelegate;
 class QByteArray;
 class QHostInfo;
+class QHttpConnectionPoolStatisticsCollector;
 #ifndef QT_NO_SSL
 class QSslConfiguration;
 class QSslContext;
@@ -154,6 +155,9 @@ public:
 
     void preConnectFinished();
 
+    void prewarmConnections(int count);
+    void setPoolStatistics(const QSharedPointer<QHttpConnectionPoolStatisticsCollector> &statistics);
+
 private:
     Q_DECLARE_PRIVATE(QHttpNetworkConnection)
     Q_DISABLE_COPY(QHttpNetworkConnection)
@@ -245,6 +249,9 @@ public:
 
     void removeReply(QHttpNetworkReply *reply);
 
+    void prewarmConnections(int count);
+    void updateQueueStatistics();
+
     QString hostName;
     quint16 port;
     bool encrypt;
@@ -289,6 +296,10 @@ public:
 
     Http2::ProtocolParameters http2Parameters;
 
+    // shared with the QNetworkAccessManager that owns the connection pool
+    QSharedPointer<QHttpConnectionPoolStatisticsCollector> poolStatistics;
+    QList<QPointer<QHttpNetworkReply> > prewarmReplies;
+
     friend class QHttpNetworkConnectionChannel;
 };
 
@@ -40,6 +40,7 @@
 
 #include "qhttpnetworkconnectionchannel_p.h"
 #include "qhttpnetworkconnection_p.h"
+#include "qhttpconnectionpool_p.h"
 #include "private/qnoncontiguousbytedevice_p.h"
 
 #include <qpair.h>
@@ -319,6 +320,9 @@ bool QHttpNetworkConnectionChannel::ensureConnection()
         // connect to the host if not already connected.
         state = QHttpNetworkConnectionChannel::ConnectingState;
         pendingEncrypt = ssl;
+        // a request assigned before connecting has already been accounted for
+        freshConnection = !reply;
+        connectTimer.start();
 
         // reset state
         pipeliningSupported = PipeliningSupportUnknown;
@@ -839,6 +843,15 @@ void QHttpNetworkConnectionChannel::_q_disconnected()
 }
 
 
+void QHttpNetworkConnectionChannel::recordConnectLatency()
+{
+    if (!connectTimer.isValid())
+        return;
+    if (connection && connection->d_func()->poolStatistics)
+        connection->d_func()->poolStatistics->recordConnect(connectTimer.elapsed());
+    connectTimer.invalidate();
+}
+
 void QHttpNetworkConnectionChannel::_q_connected()
 {
     // For the Happy Eyeballs we need to check if this is the first channel to connect.
@@ -879,6 +892,9 @@ void QHttpNetworkConnectionChannel::_q_connected()
     // not sure yet if it helps, but it makes sense
     socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
 
+    if (!ssl && !pendingEncrypt)
+        recordConnectLatency();
+
     pipeliningSupported = QHttpNetworkConnectionChannel::PipeliningSupportUnknown;
 
     // ### FIXME: if the server closes the connection unexpectedly, we shouldn't send the same broken request again!
@@ -1135,6 +1151,8 @@ void QHttpNetworkConnectionChannel::_q_encrypted()
     QSslSocket *sslSocket = qobject_cast<QSslSocket *>(socket);
     Q_ASSERT(sslSocket);
 
+    recordConnectLatency();
+
     if (!protocolHandler && connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
         // ConnectionTypeHTTP2Direct does not rely on ALPN/NPN to negotiate HTTP/2,
         // after establishing a secure connection we immediately start sending
@@ -77,6 +77,7 @@
 #endif
 
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qelapsedtimer.h>
 
 QT_REQUIRE_CONFIG(http);
 
@@ -115,6 +116,8 @@ public:
     bool resendCurrent;
     int lastStatus; // last status received on this channel
     bool pendingEncrypt; // for https (send after encrypted)
+    bool freshConnection = false; // connecting or connected, no request assigned yet
+    QElapsedTimer connectTimer; // for the connection pool statistics
     int reconnectAttempts; // maximum 2 reconnection attempts
     QAuthenticatorPrivate::Method authMethod;
     QAuthenticatorPrivate::Method proxyAuthMethod;
@@ -172,6 +175,7 @@ public:
     void init();
     void close();
     void abort();
+    void recordConnectLatency();
 
     bool sendRequest();
 
@@ -0,0 +1,731 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttpserverconnection_p.h"
+#include "qhttpserverengine_p.h"
+#include "qhttp2serverconnection_p.h"
+
+#include <QtNetwork/qabstractsocket.h>
+#if QT_CONFIG(ssl)
+#include <QtNetwork/qsslsocket.h>
+#endif
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+namespace
+{
+
+// Limits protecting us from clients sending huge request heads:
+const int maxLineLength = 8 * 1024;
+const int maxHeaderCount = 100;
+
+const char *reasonPhrase(int statusCode)
+{
+    switch (statusCode) {
+    case 100: return "Continue";
+    case 101: return "Switching Protocols";
+    case 200: return "OK";
+    case 201: return "Created";
+    case 202: return "Accepted";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 308: return "Permanent Redirect";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 408: return "Request Timeout";
+    case 411: return "Length Required";
+    case 413: return "Payload Too Large";
+    case 414: return "URI Too Long";
+    case 415: return "Unsupported Media Type";
+    case 429: return "Too Many Requests";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 501: return "Not Implemented";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 505: return "HTTP Version Not Supported";
+    default: break;
+    }
+
+    return "";
+}
+
+QByteArray readHeaderLine(QAbstractSocket *socket)
+{
+    QByteArray line(socket->readLine());
+    while (line.endsWith('\n') || line.endsWith('\r'))
+        line.chop(1);
+    return line;
+}
+
+}
+
+QHttpServerConnection::QHttpServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine)
+    : QObject(engine),
+      m_socket(socket),
+      m_engine(engine)
+{
+    Q_ASSERT(socket);
+    Q_ASSERT(engine);
+
+    socket->setParent(this);
+}
+
+QHttpServerConnection::~QHttpServerConnection()
+{
+}
+
+void QHttpServerConnection::startExchange(QHttpServerRequest *request,
+                                          QHttpServerResponse *response)
+{
+    emit m_engine->newRequest(request, response);
+}
+
+void QHttpServerConnection::abortExchange(QHttpServerRequest *request,
+                                          QHttpServerResponse *response)
+{
+    if (request)
+        request->d_func()->abort();
+    if (response)
+        response->d_func()->abort();
+}
+
+QHttp1ServerConnection::QHttp1ServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine)
+    : QHttpServerConnection(socket, engine)
+{
+    // Stop reading from the kernel while the application does not consume
+    // a request body, or while pipelined requests wait for their turn:
+    m_socket->setReadBufferSize(engine->requestBufferSize());
+
+    connect(m_socket, &QIODevice::readyRead, this, &QHttp1ServerConnection::_q_readyRead);
+    connect(m_socket, &QIODevice::bytesWritten, this, &QHttp1ServerConnection::_q_bytesWritten);
+    connect(m_socket, &QAbstractSocket::disconnected, this, &QHttp1ServerConnection::_q_disconnected);
+
+    keepAliveTimer.setSingleShot(true);
+    connect(&keepAliveTimer, &QTimer::timeout, this, &QHttp1ServerConnection::_q_keepAliveTimeout);
+    if (engine->keepAliveTimeout() > 0)
+        keepAliveTimer.start(engine->keepAliveTimeout());
+    headerTimer.setSingleShot(true);
+    connect(&headerTimer, &QTimer::timeout, this, &QHttp1ServerConnection::_q_headerTimeout);
+
+    if (m_socket->state() != QAbstractSocket::ConnectedState)
+        QMetaObject::invokeMethod(this, "_q_disconnected", Qt::QueuedConnection);
+    else if (m_socket->bytesAvailable())
+        QMetaObject::invokeMethod(this, "_q_readyRead", Qt::QueuedConnection);
+}
+
+void QHttp1ServerConnection::requestBodyRead(QHttpServerRequest *target, qint64 bytes)
+{
+    Q_UNUSED(bytes);
+
+    if (target == request && bodyReadPaused) {
+        bodyReadPaused = false;
+        QMetaObject::invokeMethod(this, "_q_readyRead", Qt::QueuedConnection);
+    }
+}
+
+void QHttp1ServerConnection::writeResponseData(QHttpServerResponse *target,
+                                               const char *data, qint64 size)
+{
+    if (target != response || state == Closing)
+        return;
+
+    if (!response->d_func()->headersSent)
+        writeResponseHeaders(response, false);
+
+    if (!responseHasBody || !size)
+        return;
+
+    if (chunkedResponse) {
+        m_socket->write(QByteArray::number(size, 16) + "\r\n");
+        m_socket->write(data, size);
+        m_socket->write("\r\n", 2);
+    } else {
+        m_socket->write(data, size);
+    }
+}
+
+void QHttp1ServerConnection::finishResponse(QHttpServerResponse *target)
+{
+    if (target != response || state == Closing)
+        return;
+
+    if (!response->d_func()->headersSent)
+        writeResponseHeaders(response, true);
+    else if (chunkedResponse)
+        m_socket->write("0\r\n\r\n", 5);
+
+    if (!keepAlive) {
+        state = Closing;
+        m_socket->disconnectFromHost();
+        return;
+    }
+
+    // If the client is still sending the request body, we first have to
+    // skip it to find the next request; see deliverBody().
+    if (state == WaitingForResponse)
+        finishExchange();
+}
+
+qint64 QHttp1ServerConnection::responseBytesToWrite(const QHttpServerResponse *target) const
+{
+    return target == response ? m_socket->bytesToWrite() : 0;
+}
+
+void QHttp1ServerConnection::_q_readyRead()
+{
+    for (bool progress = true; progress;) {
+        switch (state) {
+        case ReadingRequestLine:
+            progress = readRequestLine();
+            break;
+        case ReadingHeaders:
+            progress = readHeaders();
+            break;
+        case ReadingBody:
+        case ReadingChunkData:
+            progress = readBody();
+            break;
+        case ReadingChunkSize:
+            progress = readChunkSize();
+            break;
+        case ReadingChunkEnd:
+            progress = readChunkEnd();
+            break;
+        case ReadingTrailer:
+            progress = readTrailer();
+            break;
+        case WaitingForResponse:
+        case Closing:
+            progress = false;
+            break;
+        }
+    }
+}
+
+void QHttp1ServerConnection::_q_bytesWritten(qint64 bytes)
+{
+    if (response)
+        emit response->bytesWritten(bytes);
+}
+
+void QHttp1ServerConnection::_q_disconnected()
+{
+    state = Closing;
+    keepAliveTimer.stop();
+    headerTimer.stop();
+    abortExchange(request, response);
+    deleteLater();
+}
+
+void QHttp1ServerConnection::_q_keepAliveTimeout()
+{
+    if (state == ReadingRequestLine)
+        m_socket->disconnectFromHost();
+}
+
+void QHttp1ServerConnection::_q_headerTimeout()
+{
+    if (state == ReadingRequestLine || state == ReadingHeaders)
+        sendError(408);
+}
+
+bool QHttp1ServerConnection::readRequestLine()
+{
+    if (!exchangeCount && detectHttp2Preface())
+        return false;
+
+    // Once a request has started to arrive, its head has to be complete
+    // within the timeout; see startRequest().
+    const int headerTimeout = m_engine->requestHeaderTimeout();
+    if (headerTimeout > 0 && !headerTimer.isActive() && m_socket->bytesAvailable())
+        headerTimer.start(headerTimeout);
+
+    if (!m_socket->canReadLine()) {
+        if (m_socket->bytesAvailable() > maxLineLength)
+            sendError(414);
+        return false;
+    }
+
+    const QByteArray line = readHeaderLine(m_socket);
+    if (line.size() > maxLineLength) {
+        sendError(414);
+        return false;
+    }
+
+    // RFC 7230, 3.5: ignore empty lines preceding a request line.
+    if (line.isEmpty())
+        return true;
+
+    keepAliveTimer.stop();
+
+    const int methodEnd = line.indexOf(' ');
+    const int targetEnd = line.lastIndexOf(' ');
+    if (methodEnd <= 0 || targetEnd == methodEnd) {
+        sendError(400);
+        return false;
+    }
+
+    const QByteArray version = line.mid(targetEnd + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+        sendError(version.startsWith("HTTP/") ? 505 : 400);
+        return false;
+    }
+
+    request = new QHttpServerRequest(this, ++exchangeCount);
+    QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    requestPrivate->method = line.left(methodEnd);
+    requestPrivate->minorVersion = version.at(7) - '0';
+    requestTarget = line.mid(methodEnd + 1, targetEnd - methodEnd - 1).trimmed();
+    headerCount = 0;
+    headerSize = line.size();
+    state = ReadingHeaders;
+
+    return true;
+}
+
+bool QHttp1ServerConnection::readHeaders()
+{
+    Q_ASSERT(request);
+
+    QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    while (m_socket->canReadLine()) {
+        const QByteArray line = readHeaderLine(m_socket);
+        if (line.isEmpty())
+            return startRequest();
+
+        const int colon = line.indexOf(':');
+        if (colon <= 0 || line.at(0) == ' ' || line.at(0) == '\t') {
+            // Obsolete line folding is not supported (RFC 7230, 3.2.4).
+            sendError(400);
+            return false;
+        }
+
+        headerSize += line.size();
+        if (line.size() > maxLineLength || ++headerCount > maxHeaderCount
+            || headerSize > MaxHeaderSize) {
+            sendError(431);
+            return false;
+        }
+
+        requestPrivate->header.fields.append(qMakePair(line.left(colon).trimmed(),
+                                                       line.mid(colon + 1).trimmed()));
+    }
+
+    if (m_socket->bytesAvailable() > maxLineLength)
+        sendError(431);
+
+    return false;
+}
+
+bool QHttp1ServerConnection::startRequest()
+{
+    Q_ASSERT(request);
+    headerTimer.stop();
+
+    QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    const QHttpNetworkHeaderPrivate &header = requestPrivate->header;
+
+    const QByteArray host = header.headerField("host");
+    if (requestPrivate->minorVersion == 1 && host.isEmpty()) {
+        sendError(400);
+        return false;
+    }
+
+    if (requestTarget.startsWith('/')) {
+        bool encrypted = false;
+#if QT_CONFIG(ssl)
+        if (auto sslSocket = qobject_cast<QSslSocket *>(m_socket))
+            encrypted = sslSocket->isEncrypted();
+#endif
+        requestPrivate->header.url = QUrl::fromEncoded((encrypted ? "https://" : "http://")
+                                                       + host + requestTarget);
+    } else {
+        // absolute-form, or asterisk-form for OPTIONS.
+        requestPrivate->header.url = QUrl::fromEncoded(requestTarget);
+    }
+
+    const QByteArray connectionField = header.headerField("connection").toLower();
+    if (requestPrivate->minorVersion == 1)
+        keepAlive = !connectionField.contains("close");
+    else
+        keepAlive = connectionField.contains("keep-alive");
+
+    // RFC 7230, 3.3.3: unless chunked is the final transfer coding, the
+    // length of the body cannot be determined, and guessing it differently
+    // from an intermediary would let a client smuggle requests past it.
+    // We implement no other coding (3.3.1).
+    bool chunked = false;
+    const QByteArray transferEncoding = header.headerField("transfer-encoding");
+    if (!transferEncoding.isEmpty()) {
+        QList<QByteArray> codings;
+        for (const QByteArray &coding : transferEncoding.split(',')) {
+            const QByteArray name = coding.trimmed().toLower();
+            if (!name.isEmpty())
+                codings.append(name);
+        }
+        if (codings.isEmpty() || codings.last() != "chunked" || codings.count("chunked") > 1) {
+            sendError(400);
+            return false;
+        }
+        if (codings.size() > 1) {
+            sendError(501);
+            return false;
+        }
+        chunked = true;
+    }
+
+    const qint64 length = header.contentLength();
+    if (!chunked && length < 0 && !header.headerField("content-length").isEmpty()) {
+        sendError(400);
+        return false;
+    }
+
+    // A clear text upgrade to HTTP/2 (RFC 7540, 3.2). We only accept it for
+    // requests without a body: the response to the request that carried the
+    // upgrade is sent on stream 1, and moving an unfinished HTTP/1.1 body
+    // into an HTTP/2 stream is not worth the trouble - a client will simply
+    // continue with HTTP/1.1.
+    if (!chunked && length <= 0 && isProtocolUpgrade()) {
+        const QByteArray settings = QByteArray::fromBase64(header.headerField("http2-settings"),
+                                                           QByteArray::Base64UrlEncoding);
+        if (settings.size() % 6 == 0) {
+            requestPrivate->bodyFinished = true;
+            switchToHttp2(settings);
+            return false;
+        }
+    }
+
+    response = new QHttpServerResponse(this, exchangeCount);
+    responseHasBody = requestPrivate->method != "HEAD";
+    chunkedResponse = false;
+    bodyReadPaused = false;
+
+    if (chunked) {
+        state = ReadingChunkSize;
+    } else if (length > 0) {
+        bodyRemaining = length;
+        state = ReadingBody;
+    } else {
+        requestPrivate->bodyFinished = true;
+        state = WaitingForResponse;
+    }
+
+    if (state != WaitingForResponse
+        && header.headerField("expect").toLower() == "100-continue") {
+        m_socket->write("HTTP/1.1 100 Continue\r\n\r\n");
+    }
+
+    startExchange(request, response);
+    return true;
+}
+
+bool QHttp1ServerConnection::readBody()
+{
+    if (isBodyBufferFull()) {
+        bodyReadPaused = true;
+        return false;
+    }
+
+    const qint64 available = qMin(bodyRemaining, m_socket->bytesAvailable());
+    if (available <= 0)
+        return false;
+
+    const QByteArray data = m_socket->read(available);
+    bodyRemaining -= data.size();
+    deliverBody(data);
+
+    if (!bodyRemaining) {
+        if (state == ReadingChunkData)
+            state = ReadingChunkEnd;
+        else if (state == ReadingBody)
+            finishRequestBody();
+    }
+
+    return true;
+}
+
+bool QHttp1ServerConnection::readChunkSize()
+{
+    if (!m_socket->canReadLine()) {
+        if (m_socket->bytesAvailable() > maxLineLength)
+            sendError(400);
+        return false;
+    }
+
+    QByteArray line = readHeaderLine(m_socket);
+    const int extension = line.indexOf(';');
+    if (extension >= 0)
+        line.truncate(extension);
+
+    bool ok = false;
+    const qint64 size = line.trimmed().toLongLong(&ok, 16);
+    if (!ok || size < 0) {
+        sendError(400);
+        return false;
+    }
+
+    if (size) {
+        bodyRemaining = size;
+        state = ReadingChunkData;
+    } else {
+        state = ReadingTrailer;
+    }
+
+    return true;
+}
+
+bool QHttp1ServerConnection::readChunkEnd()
+{
+    if (!m_socket->canReadLine())
+        return false;
+
+    if (!readHeaderLine(m_socket).isEmpty()) {
+        sendError(400);
+        return false;
+    }
+
+    state = ReadingChunkSize;
+    return true;
+}
+
+bool QHttp1ServerConnection::readTrailer()
+{
+    // We do not expose trailer fields, but still have to limit them:
+    while (m_socket->canReadLine()) {
+        const QByteArray line = readHeaderLine(m_socket);
+        if (line.isEmpty()) {
+            finishRequestBody();
+            return true;
+        }
+
+        headerSize += line.size();
+        if (line.size() > maxLineLength || ++headerCount > maxHeaderCount
+            || headerSize > MaxHeaderSize) {
+            sendError(431);
+            return false;
+        }
+    }
+
+    if (m_socket->bytesAvailable() > maxLineLength)
+        sendError(431);
+
+    return false;
+}
+
+bool QHttp1ServerConnection::detectHttp2Preface()
+{
+    // HTTP/2 with prior knowledge (RFC 7540, 3.4): the first bytes of the
+    // connection are the client connection preface instead of a request.
+    const QByteArray head = m_socket->peek(Http2::clientPrefaceLength);
+    if (head.isEmpty() || std::memcmp(head.constData(), Http2::Http2clientPreface, head.size()))
+        return false;
+
+    if (head.size() == Http2::clientPrefaceLength)
+        switchToHttp2(QByteArray());
+
+    return true;
+}
+
+bool QHttp1ServerConnection::isProtocolUpgrade() const
+{
+    Q_ASSERT(request);
+
+    const QHttpServerRequestPrivate *requestPrivate = request->d_func();
+    if (requestPrivate->minorVersion != 1 || exchangeCount != 1)
+        return false;
+
+    const QHttpNetworkHeaderPrivate &header = requestPrivate->header;
+    const QByteArray connectionField = header.headerField("connection").toLower();
+    return header.headerField("upgrade").toLower().contains("h2c")
+           && connectionField.contains("upgrade")
+           && connectionField.contains("http2-settings")
+           && header.headerFieldValues("http2-settings").size() == 1;
+}
+
+void QHttp1ServerConnection::switchToHttp2(const QByteArray &settings)
+{
+    keepAliveTimer.stop();
+    headerTimer.stop();
+    m_socket->disconnect(this);
+    state = Closing;
+
+    if (request) {
+        static const char switchingProtocols[] = "HTTP/1.1 101 Switching Protocols\r\n"
+                                                 "Connection: Upgrade\r\n"
+                                                 "Upgrade: h2c\r\n\r\n";
+        m_socket->write(switchingProtocols, sizeof switchingProtocols - 1);
+
+        auto connection = new QHttp2ServerConnection(m_socket, m_engine);
+        QHttpServerRequest *upgraded = request;
+        request = nullptr;
+        connection->startUpgraded(upgraded, settings);
+    } else {
+        new QHttp2ServerConnection(m_socket, m_engine);
+    }
+
+    deleteLater();
+}
+
+void QHttp1ServerConnection::deliverBody(const QByteArray &data)
+{
+    // Once the response is complete, nobody is interested in the rest of
+    // the request body; we read it only to get to the next request.
+    if (request && response && !response->isFinished())
+        request->d_func()->appendBody(data);
+}
+
+void QHttp1ServerConnection::finishRequestBody()
+{
+    state = WaitingForResponse;
+    if (request)
+        request->d_func()->finishBody();
+
+    // The response might have been finished before the body was complete
+    // (or while the application was handling readChannelFinished()):
+    if (state == WaitingForResponse && response && response->isFinished())
+        finishExchange();
+}
+
+void QHttp1ServerConnection::finishExchange()
+{
+    if (request)
+        request->deleteLater();
+    if (response)
+        response->deleteLater();
+    request = nullptr;
+    response = nullptr;
+
+    state = ReadingRequestLine;
+    if (m_engine->keepAliveTimeout() > 0)
+        keepAliveTimer.start(m_engine->keepAliveTimeout());
+
+    // Pipelined requests might already be waiting in the socket's buffer:
+    QMetaObject::invokeMethod(this, "_q_readyRead", Qt::QueuedConnection);
+}
+
+void QHttp1ServerConnection::writeResponseHeaders(QHttpServerResponse *target, bool finishing)
+{
+    Q_ASSERT(request);
+
+    QHttpServerResponsePrivate *responsePrivate = target->d_func();
+    responsePrivate->headersSent = true;
+
+    const int statusCode = responsePrivate->statusCode;
+    const bool bodyAllowed = statusCode >= 200 && statusCode != 204 && statusCode != 304;
+    if (!bodyAllowed)
+        responseHasBody = false;
+
+    QByteArray head;
+    head.reserve(256);
+    head += "HTTP/1.1 " + QByteArray::number(statusCode) + ' ' + reasonPhrase(statusCode) + "\r\n";
+
+    bool hasContentLength = false;
+    for (const auto &field : qAsConst(responsePrivate->header.fields)) {
+        // We are responsible for the framing of the message:
+        if (qstricmp(field.first.constData(), "connection") == 0
+            || qstricmp(field.first.constData(), "transfer-encoding") == 0) {
+            continue;
+        }
+        if (qstricmp(field.first.constData(), "content-length") == 0)
+            hasContentLength = true;
+        head += field.first + ": " + field.second + "\r\n";
+    }
+
+    chunkedResponse = false;
+    if (bodyAllowed && !hasContentLength) {
+        if (finishing) {
+            if (responseHasBody)
+                head += "Content-Length: 0\r\n";
+        } else if (request->minorVersion() == 1) {
+            chunkedResponse = responseHasBody;
+            if (chunkedResponse)
+                head += "Transfer-Encoding: chunked\r\n";
+        } else {
+            // HTTP/1.0 without Content-Length: the body ends with the connection.
+            keepAlive = false;
+        }
+    }
+
+    if (!keepAlive)
+        head += "Connection: close\r\n";
+    else if (request->minorVersion() == 0)
+        head += "Connection: keep-alive\r\n";
+    head += "\r\n";
+
+    m_socket->write(head);
+}
+
+void QHttp1ServerConnection::sendError(int statusCode)
+{
+    state = Closing;
+    headerTimer.stop();
+
+    if (response) {
+        // The application already owns this exchange; the response may be
+        // half-written, we cannot do anything but drop the connection.
+        abortExchange(request, response);
+    } else {
+        delete request.data();
+        m_socket->write("HTTP/1.1 " + QByteArray::number(statusCode) + ' '
+                        + reasonPhrase(statusCode)
+                        + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    }
+
+    m_socket->disconnectFromHost();
+}
+
+bool QHttp1ServerConnection::isBodyBufferFull() const
+{
+    return request && response && !response->isFinished()
+           && request->d_func()->body.byteAmount() >= m_engine->requestBufferSize();
+}
+
+QT_END_NAMESPACE
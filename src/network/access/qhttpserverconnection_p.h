@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QHTTPSERVERCONNECTION_P_H
+#define QHTTPSERVERCONNECTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractSocket;
+class QHttpServerEngine;
+class QHttpServerRequest;
+class QHttpServerResponse;
+
+// The protocol-specific half of QHttpServerEngine: a connection owns its
+// socket and the request/response pairs it creates for that socket.
+// QHttpServerRequest and QHttpServerResponse call back into it when the
+// application consumes request data or produces response data.
+class QHttpServerConnection : public QObject
+{
+    Q_OBJECT
+public:
+    QHttpServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine);
+    ~QHttpServerConnection();
+
+    QAbstractSocket *socket() const { return m_socket; }
+
+    virtual void requestBodyRead(QHttpServerRequest *request, qint64 bytes) = 0;
+    virtual void writeResponseData(QHttpServerResponse *response,
+                                   const char *data, qint64 size) = 0;
+    virtual void finishResponse(QHttpServerResponse *response) = 0;
+    virtual qint64 responseBytesToWrite(const QHttpServerResponse *response) const = 0;
+
+protected:
+    // The largest request head (HTTP/2: header block) we accept:
+    enum { MaxHeaderSize = 64 * 1024 };
+
+    void startExchange(QHttpServerRequest *request, QHttpServerResponse *response);
+    void abortExchange(QHttpServerRequest *request, QHttpServerResponse *response);
+
+    QAbstractSocket *m_socket;
+    QHttpServerEngine *m_engine;
+};
+
+class QHttp1ServerConnection : public QHttpServerConnection
+{
+    Q_OBJECT
+public:
+    QHttp1ServerConnection(QAbstractSocket *socket, QHttpServerEngine *engine);
+
+    void requestBodyRead(QHttpServerRequest *request, qint64 bytes) override;
+    void writeResponseData(QHttpServerResponse *response,
+                           const char *data, qint64 size) override;
+    void finishResponse(QHttpServerResponse *response) override;
+    qint64 responseBytesToWrite(const QHttpServerResponse *response) const override;
+
+private Q_SLOTS:
+    void _q_readyRead();
+    void _q_bytesWritten(qint64 bytes);
+    void _q_disconnected();
+    void _q_keepAliveTimeout();
+    void _q_headerTimeout();
+
+private:
+    enum State {
+        ReadingRequestLine,
+        ReadingHeaders,
+        ReadingBody,
+        ReadingChunkSize,
+        ReadingChunkData,
+        ReadingChunkEnd,
+        ReadingTrailer,
+        WaitingForResponse,
+        Closing
+    };
+
+    bool readRequestLine();
+    bool readHeaders();
+    bool readBody();
+    bool readChunkSize();
+    bool readChunkEnd();
+    bool readTrailer();
+
+    bool startRequest();
+    bool detectHttp2Preface();
+    bool isProtocolUpgrade() const;
+    void switchToHttp2(const QByteArray &settings);
+    void deliverBody(const QByteArray &data);
+    void finishRequestBody();
+    void finishExchange();
+    void writeResponseHeaders(QHttpServerResponse *response, bool finishing);
+    void sendError(int statusCode);
+    bool isBodyBufferFull() const;
+
+    State state = ReadingRequestLine;
+    QPointer<QHttpServerRequest> request;
+    QPointer<QHttpServerResponse> response;
+    QByteArray requestTarget;
+    quint32 exchangeCount = 0;
+    int headerCount = 0;
+    int headerSize = 0;
+    qint64 bodyRemaining = 0;
+    bool keepAlive = true;
+    bool chunkedResponse = false;
+    bool responseHasBody = true;
+    bool bodyReadPaused = false;
+    QTimer keepAliveTimer;
+    QTimer headerTimer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTPSERVERCONNECTION_P_H
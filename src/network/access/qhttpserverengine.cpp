@@ -0,0 +1,700 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qhttpserverengine_p.h"
+#include "qhttpserverconnection_p.h"
+#include "qhttp2serverconnection_p.h"
+
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#if QT_CONFIG(ssl)
+#include <QtNetwork/qsslsocket.h>
+#include <QtNetwork/qsslconfiguration.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpServerEngine
+    \internal
+    \since 5.12
+    \inmodule QtNetwork
+
+    \brief The QHttpServerEngine class implements the server side of
+    HTTP/1.1 and HTTP/2 on top of QTcpServer.
+
+    The engine accepts connections (or takes already connected sockets via
+    handleConnection()), parses requests and emits newRequest() once the
+    request headers are known. Request and response bodies are streamed:
+    QHttpServerRequest is a sequential QIODevice the application reads the
+    body from as it arrives, and QHttpServerResponse is a sequential
+    QIODevice the response body is written to.
+
+    HTTP/1.1 connections are kept alive between requests and pipelined
+    requests are answered in order. HTTP/2 is used when the client sends
+    the HTTP/2 connection preface (prior knowledge), asks for a clear text
+    protocol upgrade ("Upgrade: h2c") or negotiated "h2" via ALPN. An HTTP/2
+    connection multiplexes streams up to maxConcurrentStreams() and applies
+    flow control in both directions, reusing the frame and HPACK
+    implementation of the client side.
+
+    At most requestBufferSize() bytes of a request body are buffered before
+    the engine stops reading from the peer (HTTP/1.1) or stops extending
+    the stream's flow control window (HTTP/2).
+
+    Request heads are limited to 64 KiB, the HTTP/2 connection announces
+    this as its maximum header list size. An HTTP/1.1 request head also
+    has to arrive within requestHeaderTimeout().
+
+    The request and the response are deleted by the engine after the
+    response has been finished and the request body has been received, or
+    after the exchange was aborted.
+*/
+
+/*!
+    \fn void QHttpServerEngine::newRequest(QHttpServerRequest *request, QHttpServerResponse *response)
+
+    This signal is emitted when the headers of a new \a request have been
+    received. The application answers by setting the status code and
+    headers of \a response, writing the body and calling
+    QHttpServerResponse::finish().
+*/
+
+QHttpServerEnginePrivate::QHttpServerEnginePrivate()
+    : maxConcurrentStreams(Http2::maxConcurrentStreams)
+{
+}
+
+void QHttpServerEnginePrivate::createConnection(QAbstractSocket *socket)
+{
+    Q_Q(QHttpServerEngine);
+
+#if QT_CONFIG(ssl)
+    if (auto sslSocket = qobject_cast<QSslSocket *>(socket)) {
+        const auto protocol = sslSocket->sslConfiguration().nextNegotiatedProtocol();
+        if (protocol == QSslConfiguration::ALPNProtocolHTTP2) {
+            new QHttp2ServerConnection(socket, q);
+            return;
+        }
+    }
+#endif
+
+    new QHttp1ServerConnection(socket, q);
+}
+
+/*!
+    Constructs an HTTP server engine with the given \a parent.
+*/
+QHttpServerEngine::QHttpServerEngine(QObject *parent)
+    : QObject(*new QHttpServerEnginePrivate, parent)
+{
+}
+
+/*!
+    Destroys the engine, its listening socket and all open connections.
+*/
+QHttpServerEngine::~QHttpServerEngine()
+{
+}
+
+/*!
+    Starts accepting connections on \a address and \a port. Returns \c true
+    on success; see errorString() otherwise.
+*/
+bool QHttpServerEngine::listen(const QHostAddress &address, quint16 port)
+{
+    Q_D(QHttpServerEngine);
+
+    if (!d->server) {
+        d->server = new QTcpServer(this);
+        connect(d->server, &QTcpServer::newConnection, this, [this]() {
+            Q_D(QHttpServerEngine);
+            while (QTcpSocket *socket = d->server->nextPendingConnection())
+                d->createConnection(socket);
+        });
+    }
+
+    return d->server->listen(address, port);
+}
+
+/*!
+    Returns \c true if the engine is accepting connections.
+*/
+bool QHttpServerEngine::isListening() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->server && d->server->isListening();
+}
+
+/*!
+    Stops accepting new connections. Connections already established are
+    not affected.
+*/
+void QHttpServerEngine::close()
+{
+    Q_D(QHttpServerEngine);
+    if (d->server)
+        d->server->close();
+}
+
+/*!
+    Returns the port the engine is listening on, or 0.
+*/
+quint16 QHttpServerEngine::serverPort() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->server ? d->server->serverPort() : 0;
+}
+
+/*!
+    Returns a description of the last error that occurred in listen().
+*/
+QString QHttpServerEngine::errorString() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->server ? d->server->errorString() : QString();
+}
+
+/*!
+    Serves HTTP on the connected \a socket. The engine takes ownership of
+    the socket.
+
+    If \a socket is a QSslSocket, the engine waits for the handshake to
+    complete and speaks HTTP/2 if "h2" was negotiated via ALPN.
+*/
+void QHttpServerEngine::handleConnection(QAbstractSocket *socket)
+{
+    Q_D(QHttpServerEngine);
+    Q_ASSERT(socket);
+
+#if QT_CONFIG(ssl)
+    auto sslSocket = qobject_cast<QSslSocket *>(socket);
+    if (sslSocket && !sslSocket->isEncrypted()) {
+        sslSocket->setParent(this);
+        connect(sslSocket, &QSslSocket::encrypted, this, [this, sslSocket]() {
+            Q_D(QHttpServerEngine);
+            sslSocket->disconnect(this);
+            d->createConnection(sslSocket);
+        });
+        connect(sslSocket, &QAbstractSocket::disconnected,
+                sslSocket, &QObject::deleteLater);
+        return;
+    }
+#endif
+
+    d->createConnection(socket);
+}
+
+/*!
+    Sets the maximum number of concurrent HTTP/2 streams a client may open
+    on one connection to \a streams. The default is 100. The value is
+    announced in the SETTINGS frame of new connections.
+*/
+void QHttpServerEngine::setMaxConcurrentStreams(quint32 streams)
+{
+    Q_D(QHttpServerEngine);
+    d->maxConcurrentStreams = qBound(quint32(1), streams, quint32(Http2::maxPeerConcurrentStreams));
+}
+
+/*!
+    Returns the maximum number of concurrent HTTP/2 streams per connection.
+*/
+quint32 QHttpServerEngine::maxConcurrentStreams() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->maxConcurrentStreams;
+}
+
+/*!
+    Sets the time an idle HTTP/1.1 connection is kept open waiting for
+    the next request to \a msecs milliseconds. The default is 30 seconds.
+*/
+void QHttpServerEngine::setKeepAliveTimeout(int msecs)
+{
+    Q_D(QHttpServerEngine);
+    d->keepAliveTimeout = msecs;
+}
+
+/*!
+    Returns the keep-alive timeout of idle HTTP/1.1 connections.
+*/
+int QHttpServerEngine::keepAliveTimeout() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->keepAliveTimeout;
+}
+
+/*!
+    Sets the time a client has to send the complete head of an HTTP/1.1
+    request, from its first byte to the empty line ending the header
+    fields, to \a msecs milliseconds. The default is 10 seconds. Slower
+    clients get a 408 response and the connection is closed.
+*/
+void QHttpServerEngine::setRequestHeaderTimeout(int msecs)
+{
+    Q_D(QHttpServerEngine);
+    d->requestHeaderTimeout = msecs;
+}
+
+/*!
+    Returns the time a client has to send the head of an HTTP/1.1 request.
+*/
+int QHttpServerEngine::requestHeaderTimeout() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->requestHeaderTimeout;
+}
+
+/*!
+    Sets the number of request body bytes buffered per request before the
+    engine applies back-pressure to \a size. The default is 64 KiB. For
+    HTTP/2 this is the stream flow control window announced to clients.
+*/
+void QHttpServerEngine::setRequestBufferSize(qint64 size)
+{
+    Q_D(QHttpServerEngine);
+    d->requestBufferSize = qBound(qint64(Http2::defaultSessionWindowSize), size,
+                                  qint64(Http2::maxSessionReceiveWindowSize));
+}
+
+/*!
+    Returns the number of request body bytes buffered per request.
+*/
+qint64 QHttpServerEngine::requestBufferSize() const
+{
+    Q_D(const QHttpServerEngine);
+    return d->requestBufferSize;
+}
+
+/*!
+    \class QHttpServerRequest
+    \internal
+    \since 5.12
+    \inmodule QtNetwork
+
+    \brief The QHttpServerRequest class gives access to a request received
+    by QHttpServerEngine.
+
+    The request line and headers are available when
+    QHttpServerEngine::newRequest() is emitted; the body is read from the
+    device as it arrives. readyRead() is emitted for new body data and
+    readChannelFinished() once the body is complete. Requests without a
+    body are already finished when they are announced.
+*/
+
+/*!
+    \fn void QHttpServerRequest::aborted()
+
+    This signal is emitted when the client reset the stream or closed the
+    connection before the exchange was complete.
+*/
+
+QHttpServerRequestPrivate::QHttpServerRequestPrivate(QHttpServerConnection *connection,
+                                                     quint32 streamID)
+    : connection(connection),
+      streamID(streamID)
+{
+}
+
+void QHttpServerRequestPrivate::appendBody(const QByteArray &data)
+{
+    Q_Q(QHttpServerRequest);
+    if (data.isEmpty())
+        return;
+    body.append(data);
+    emit q->readyRead();
+}
+
+void QHttpServerRequestPrivate::finishBody()
+{
+    Q_Q(QHttpServerRequest);
+    if (bodyFinished)
+        return;
+    bodyFinished = true;
+    emit q->readChannelFinished();
+}
+
+void QHttpServerRequestPrivate::abort()
+{
+    Q_Q(QHttpServerRequest);
+    if (aborted || bodyFinished)
+        return;
+    aborted = true;
+    emit q->aborted();
+}
+
+QHttpServerRequest::QHttpServerRequest(QHttpServerConnection *connection, quint32 streamID)
+    : QIODevice(*new QHttpServerRequestPrivate(connection, streamID), connection)
+{
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+/*!
+    Destroys the request.
+*/
+QHttpServerRequest::~QHttpServerRequest()
+{
+}
+
+/*!
+    Returns the request method, for example "GET".
+*/
+QByteArray QHttpServerRequest::method() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->method;
+}
+
+/*!
+    Returns the request URL, built from the request target, the scheme and
+    the authority the client addressed.
+*/
+QUrl QHttpServerRequest::url() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->header.url;
+}
+
+/*!
+    Returns the major HTTP version of the request, 1 or 2.
+*/
+int QHttpServerRequest::majorVersion() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->majorVersion;
+}
+
+/*!
+    Returns the minor HTTP version of the request.
+*/
+int QHttpServerRequest::minorVersion() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->minorVersion;
+}
+
+/*!
+    Returns the request header fields in the order they were received.
+    HTTP/2 pseudo-header fields are not included.
+*/
+QList<QPair<QByteArray, QByteArray> > QHttpServerRequest::header() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->header.fields;
+}
+
+/*!
+    Returns the value of the header field \a name, compared
+    case-insensitively, or \a defaultValue if there is no such field.
+*/
+QByteArray QHttpServerRequest::headerField(const QByteArray &name,
+                                           const QByteArray &defaultValue) const
+{
+    Q_D(const QHttpServerRequest);
+    return d->header.headerField(name, defaultValue);
+}
+
+/*!
+    Returns the value of the Content-Length header, or -1.
+*/
+qint64 QHttpServerRequest::contentLength() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->header.contentLength();
+}
+
+/*!
+    Returns the address of the client.
+*/
+QHostAddress QHttpServerRequest::peerAddress() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->connection ? d->connection->socket()->peerAddress() : QHostAddress();
+}
+
+/*!
+    Returns the port of the client. Requests sharing a connection report
+    the same port.
+*/
+quint16 QHttpServerRequest::peerPort() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->connection ? d->connection->socket()->peerPort() : 0;
+}
+
+/*!
+    Returns \c true if the request body has been received completely.
+*/
+bool QHttpServerRequest::isFinished() const
+{
+    Q_D(const QHttpServerRequest);
+    return d->bodyFinished;
+}
+
+/*!
+    \reimp
+*/
+bool QHttpServerRequest::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerRequest::bytesAvailable() const
+{
+    Q_D(const QHttpServerRequest);
+    return QIODevice::bytesAvailable() + d->body.byteAmount();
+}
+
+/*!
+    \reimp
+*/
+bool QHttpServerRequest::atEnd() const
+{
+    Q_D(const QHttpServerRequest);
+    return (d->bodyFinished || d->aborted) && bytesAvailable() == 0;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerRequest::readData(char *data, qint64 maxSize)
+{
+    Q_D(QHttpServerRequest);
+
+    const qint64 bytesRead = d->body.read(data, maxSize);
+    if (bytesRead > 0) {
+        if (d->connection)
+            d->connection->requestBodyRead(this, bytesRead);
+        return bytesRead;
+    }
+
+    return d->bodyFinished || d->aborted ? -1 : 0;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerRequest::writeData(const char *, qint64)
+{
+    return -1;
+}
+
+/*!
+    \class QHttpServerResponse
+    \internal
+    \since 5.12
+    \inmodule QtNetwork
+
+    \brief The QHttpServerResponse class is the response to a
+    QHttpServerRequest.
+
+    Status code and header fields have to be set before the first body
+    data is written; they are sent together with it. For HTTP/1.1 the body
+    is sent with chunked transfer encoding unless a Content-Length header
+    was set. Data written is buffered until the transport can take it:
+    bytesToWrite() and bytesWritten() allow an application to stream large
+    bodies without holding them in memory. Call finish() to complete the
+    response.
+*/
+
+/*!
+    \fn void QHttpServerResponse::finished()
+
+    This signal is emitted when finish() has been called.
+*/
+
+/*!
+    \fn void QHttpServerResponse::aborted()
+
+    This signal is emitted when the client reset the stream or closed the
+    connection before the response was finished.
+*/
+
+QHttpServerResponsePrivate::QHttpServerResponsePrivate(QHttpServerConnection *connection,
+                                                       quint32 streamID)
+    : connection(connection),
+      streamID(streamID)
+{
+}
+
+void QHttpServerResponsePrivate::abort()
+{
+    Q_Q(QHttpServerResponse);
+    if (aborted || finished)
+        return;
+    aborted = true;
+    emit q->aborted();
+}
+
+QHttpServerResponse::QHttpServerResponse(QHttpServerConnection *connection, quint32 streamID)
+    : QIODevice(*new QHttpServerResponsePrivate(connection, streamID), connection)
+{
+    open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+}
+
+/*!
+    Destroys the response.
+*/
+QHttpServerResponse::~QHttpServerResponse()
+{
+}
+
+/*!
+    Returns the status code of the response, 200 by default.
+*/
+int QHttpServerResponse::statusCode() const
+{
+    Q_D(const QHttpServerResponse);
+    return d->statusCode;
+}
+
+/*!
+    Sets the status code of the response to \a code.
+*/
+void QHttpServerResponse::setStatusCode(int code)
+{
+    Q_D(QHttpServerResponse);
+    if (d->headersSent) {
+        qWarning("QHttpServerResponse::setStatusCode: headers have already been sent");
+        return;
+    }
+    d->statusCode = code;
+}
+
+/*!
+    Returns the header fields of the response.
+*/
+QList<QPair<QByteArray, QByteArray> > QHttpServerResponse::header() const
+{
+    Q_D(const QHttpServerResponse);
+    return d->header.fields;
+}
+
+/*!
+    Returns the value of the header field \a name, or \a defaultValue.
+*/
+QByteArray QHttpServerResponse::headerField(const QByteArray &name,
+                                            const QByteArray &defaultValue) const
+{
+    Q_D(const QHttpServerResponse);
+    return d->header.headerField(name, defaultValue);
+}
+
+/*!
+    Sets the header field \a name to \a data, replacing any previous value.
+*/
+void QHttpServerResponse::setHeaderField(const QByteArray &name, const QByteArray &data)
+{
+    Q_D(QHttpServerResponse);
+    if (d->headersSent) {
+        qWarning("QHttpServerResponse::setHeaderField: headers have already been sent");
+        return;
+    }
+    d->header.setHeaderField(name, data);
+}
+
+/*!
+    Completes the response; sends the headers if no body data was written.
+    Emits finished().
+*/
+void QHttpServerResponse::finish()
+{
+    Q_D(QHttpServerResponse);
+    if (d->finished || d->aborted)
+        return;
+
+    d->finished = true;
+    if (d->connection)
+        d->connection->finishResponse(this);
+    QIODevice::close();
+    emit finished();
+}
+
+/*!
+    Returns \c true if finish() has been called.
+*/
+bool QHttpServerResponse::isFinished() const
+{
+    Q_D(const QHttpServerResponse);
+    return d->finished;
+}
+
+/*!
+    \reimp
+*/
+bool QHttpServerResponse::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerResponse::bytesToWrite() const
+{
+    Q_D(const QHttpServerResponse);
+    return d->connection ? d->connection->responseBytesToWrite(this) : 0;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerResponse::readData(char *, qint64)
+{
+    return -1;
+}
+
+/*!
+    \reimp
+*/
+qint64 QHttpServerResponse::writeData(const char *data, qint64 size)
+{
+    Q_D(QHttpServerResponse);
+    if (d->finished || d->aborted || !d->connection)
+        return -1;
+
+    d->connection->writeResponseData(this, data, size);
+    return size;
+}
+
+QT_END_NAMESPACE
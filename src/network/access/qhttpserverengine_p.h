@@ -0,0 +1,255 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QHTTPSERVERENGINE_P_H
+#define QHTTPSERVERENGINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+#include <QtCore/qiodevice.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qurl.h>
+
+#include <private/qbytedata_p.h>
+#include <private/qiodevice_p.h>
+#include <private/qobject_p.h>
+#include <private/qhttpnetworkheader_p.h>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QAbstractSocket;
+class QTcpServer;
+class QHttpServerConnection;
+class QHttpServerRequest;
+class QHttpServerResponse;
+
+class QHttpServerEnginePrivate;
+class Q_NETWORK_EXPORT QHttpServerEngine : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QHttpServerEngine(QObject *parent = nullptr);
+    ~QHttpServerEngine();
+
+    bool listen(const QHostAddress &address = QHostAddress::Any, quint16 port = 0);
+    bool isListening() const;
+    void close();
+
+    quint16 serverPort() const;
+    QString errorString() const;
+
+    void handleConnection(QAbstractSocket *socket);
+
+    void setMaxConcurrentStreams(quint32 streams);
+    quint32 maxConcurrentStreams() const;
+
+    void setKeepAliveTimeout(int msecs);
+    int keepAliveTimeout() const;
+
+    void setRequestHeaderTimeout(int msecs);
+    int requestHeaderTimeout() const;
+
+    void setRequestBufferSize(qint64 size);
+    qint64 requestBufferSize() const;
+
+Q_SIGNALS:
+    void newRequest(QHttpServerRequest *request, QHttpServerResponse *response);
+
+private:
+    Q_DECLARE_PRIVATE(QHttpServerEngine)
+    Q_DISABLE_COPY(QHttpServerEngine)
+};
+
+class QHttpServerEnginePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QHttpServerEngine)
+public:
+    QHttpServerEnginePrivate();
+
+    void createConnection(QAbstractSocket *socket);
+
+    QTcpServer *server = nullptr;
+    quint32 maxConcurrentStreams;
+    int keepAliveTimeout = 30000;
+    int requestHeaderTimeout = 10000;
+    qint64 requestBufferSize = 64 * 1024;
+};
+
+class QHttpServerRequestPrivate;
+class Q_NETWORK_EXPORT QHttpServerRequest : public QIODevice
+{
+    Q_OBJECT
+public:
+    ~QHttpServerRequest();
+
+    QByteArray method() const;
+    QUrl url() const;
+
+    int majorVersion() const;
+    int minorVersion() const;
+
+    QList<QPair<QByteArray, QByteArray> > header() const;
+    QByteArray headerField(const QByteArray &name, const QByteArray &defaultValue = QByteArray()) const;
+    qint64 contentLength() const;
+
+    QHostAddress peerAddress() const;
+    quint16 peerPort() const;
+
+    bool isFinished() const;
+
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    bool atEnd() const override;
+
+Q_SIGNALS:
+    void aborted();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 size) override;
+
+private:
+    QHttpServerRequest(QHttpServerConnection *connection, quint32 streamID);
+
+    friend class QHttpServerConnection;
+    friend class QHttp1ServerConnection;
+    friend class QHttp2ServerConnection;
+    Q_DECLARE_PRIVATE(QHttpServerRequest)
+    Q_DISABLE_COPY(QHttpServerRequest)
+};
+
+class QHttpServerRequestPrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QHttpServerRequest)
+public:
+    QHttpServerRequestPrivate(QHttpServerConnection *connection, quint32 streamID);
+
+    void appendBody(const QByteArray &data);
+    void finishBody();
+    void abort();
+
+    QPointer<QHttpServerConnection> connection;
+    quint32 streamID;
+
+    QByteArray method;
+    QHttpNetworkHeaderPrivate header;
+    int majorVersion = 1;
+    int minorVersion = 1;
+
+    QByteDataBuffer body;
+    bool bodyFinished = false;
+    bool aborted = false;
+};
+
+class QHttpServerResponsePrivate;
+class Q_NETWORK_EXPORT QHttpServerResponse : public QIODevice
+{
+    Q_OBJECT
+public:
+    ~QHttpServerResponse();
+
+    int statusCode() const;
+    void setStatusCode(int code);
+
+    QList<QPair<QByteArray, QByteArray> > header() const;
+    QByteArray headerField(const QByteArray &name, const QByteArray &defaultValue = QByteArray()) const;
+    void setHeaderField(const QByteArray &name, const QByteArray &data);
+
+    void finish();
+    bool isFinished() const;
+
+    bool isSequential() const override;
+    qint64 bytesToWrite() const override;
+
+Q_SIGNALS:
+    void finished();
+    void aborted();
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 size) override;
+
+private:
+    QHttpServerResponse(QHttpServerConnection *connection, quint32 streamID);
+
+    friend class QHttpServerConnection;
+    friend class QHttp1ServerConnection;
+    friend class QHttp2ServerConnection;
+    Q_DECLARE_PRIVATE(QHttpServerResponse)
+    Q_DISABLE_COPY(QHttpServerResponse)
+};
+
+class QHttpServerResponsePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QHttpServerResponse)
+public:
+    QHttpServerResponsePrivate(QHttpServerConnection *connection, quint32 streamID);
+
+    void abort();
+
+    QPointer<QHttpServerConnection> connection;
+    quint32 streamID;
+
+    int statusCode = 200;
+    QHttpNetworkHeaderPrivate header;
+    bool headersSent = false;
+    bool finished = false;
+    bool aborted = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTPSERVERENGINE_P_H
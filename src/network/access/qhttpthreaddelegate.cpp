@@ -181,18 +181,22 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
 public:
 #ifdef QT_NO_BEARERMANAGEMENT
     QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
-                                       QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+                                       QHttpNetworkConnection::ConnectionType connectionType,
+                                       const QHttpConnectionPoolPolicy &policy)
+        : QHttpNetworkConnection(quint16(policy.maximumConnections()), hostName, port, encrypt,
+                                 /*parent=*/0, connectionType)
 #else
     QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType,
+                                       const QHttpConnectionPoolPolicy &policy,
                                        QSharedPointer<QNetworkSession> networkSession)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType, /*parent=*/0,
-                                 qMove(networkSession))
+        : QHttpNetworkConnection(quint16(policy.maximumConnections()), hostName, port, encrypt,
+                                 /*parent=*/0, qMove(networkSession), connectionType)
 #endif
     {
         setExpires(true);
         setShareable(true);
+        setExpiryTimeout(policy.idleTimeout());
     }
 
     virtual void dispose() override
@@ -327,17 +331,21 @@ void QHttpThreadDelegate::startRequest()
 
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    const bool newConnection = !httpConnection;
     if (httpConnection == 0) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
 #ifdef QT_NO_BEARERMANAGEMENT
         httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
-                                                                connectionType);
+                                                                connectionType,
+                                                                connectionPoolPolicy);
 #else
         httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
                                                                 connectionType,
+                                                                connectionPoolPolicy,
                                                                 networkSession);
 #endif // QT_NO_BEARERMANAGEMENT
+        httpConnection->setPoolStatistics(connectionPoolStatistics);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             && http2Parameters.validate()) {
             httpConnection->setHttp2Parameters(http2Parameters);
@@ -371,6 +379,11 @@ void QHttpThreadDelegate::startRequest()
     httpReply = httpConnection->sendRequest(httpRequest);
     httpReply->setParent(this);
 
+    // Open the rest of the pool ahead of time; the request above goes first.
+    // A synchronous request tears the pool down right after it finished.
+    if (newConnection && !synchronous && connectionPoolPolicy.prewarmedConnections() > 0)
+        httpConnection->prewarmConnections(connectionPoolPolicy.prewarmedConnections());
+
     // Connect the reply signals that we need to handle and then forward
     if (synchronous) {
         connect(httpReply,SIGNAL(headerChanged()), this, SLOT(synchronousHeaderChangedSlot()));
@@ -67,6 +67,7 @@
 #include "private/qnoncontiguousbytedevice_p.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
 #include <QtNetwork/private/http2protocol_p.h>
+#include "qhttpconnectionpool.h"
 
 QT_REQUIRE_CONFIG(http);
 
@@ -77,6 +78,7 @@ class QHttpNetworkReply;
 class QEventLoop;
 class QNetworkAccessCache;
 class QNetworkAccessCachedHttpConnection;
+class QHttpConnectionPoolStatisticsCollector;
 
 class QHttpThreadDelegate : public QObject
 {
@@ -117,6 +119,8 @@ public:
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
     Http2::ProtocolParameters http2Parameters;
+    QHttpConnectionPoolPolicy connectionPoolPolicy;
+    QSharedPointer<QHttpConnectionPoolStatisticsCollector> connectionPoolStatistics;
 #ifndef QT_NO_BEARERMANAGEMENT
     QSharedPointer<QNetworkSession> networkSession;
 #endif
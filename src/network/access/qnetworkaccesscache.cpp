@@ -77,8 +77,9 @@ struct QNetworkAccessCache::Node
 };
 
 QNetworkAccessCache::CacheableObject::CacheableObject()
+    : expiryTimeout(ExpiryTime * 1000)
 {
-    // leave the members uninitialized
+    // leave the other members uninitialized
     // they must be initialized by the derived class's constructor
 }
 
@@ -101,6 +102,15 @@ void QNetworkAccessCache::CacheableObject::setShareable(bool enable)
     shareable = enable;
 }
 
+/*!
+    Sets the time an unused entry stays in the cache to \a msecs.
+    The default is two minutes.
+ */
+void QNetworkAccessCache::CacheableObject::setExpiryTimeout(int msecs)
+{
+    expiryTimeout = msecs;
+}
+
 QNetworkAccessCache::QNetworkAccessCache()
     : oldest(0), newest(0)
 {
@@ -157,7 +167,7 @@ void QNetworkAccessCache::linkEntry(const QByteArray &key)
         oldest = node;
     }
 
-    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(ExpiryTime);
+    node->timestamp = QDateTime::currentDateTimeUtc().addMSecs(node->object->expiryTimeout);
     newest = node;
 }
 
@@ -196,15 +206,16 @@ void QNetworkAccessCache::updateTimer()
     if (!oldest)
         return;
 
-    int interval = QDateTime::currentDateTimeUtc().secsTo(oldest->timestamp);
-    if (interval <= 0) {
-        interval = 0;
-    } else {
-        // round up the interval
-        interval = (interval + 15) & ~16;
+    // entries may have different expiry timeouts, so the oldest one
+    // is not necessarily the first one to expire
+    QDateTime next = oldest->timestamp;
+    for (Node *node = oldest->newer; node; node = node->newer) {
+        if (node->timestamp < next)
+            next = node->timestamp;
     }
 
-    timer.start(interval * 1000, this);
+    const qint64 interval = QDateTime::currentDateTimeUtc().msecsTo(next);
+    timer.start(int(qBound(Q_INT64_C(0), interval, qint64(INT_MAX))), Qt::CoarseTimer, this);
 }
 
 bool QNetworkAccessCache::emitEntryReady(Node *node, QObject *target, const char *member)
@@ -224,20 +235,25 @@ void QNetworkAccessCache::timerEvent(QTimerEvent *)
     // expire old items
     const QDateTime now = QDateTime::currentDateTimeUtc();
 
-    while (oldest && oldest->timestamp < now) {
-        Node *next = oldest->newer;
-        oldest->object->dispose();
-
-        hash.remove(oldest->key); // oldest gets deleted
-        oldest = next;
+    Node *node = oldest;
+    while (node) {
+        Node *next = node->newer;
+        if (node->timestamp <= now) {
+            if (node->older)
+                node->older->newer = next;
+            else
+                oldest = next;
+            if (next)
+                next->older = node->older;
+            else
+                newest = node->older;
+
+            node->object->dispose();
+            hash.remove(node->key); // node gets deleted
+        }
+        node = next;
     }
 
-    // fixup the list
-    if (oldest)
-        oldest->older = 0;
-    else
-        newest = 0;
-
     updateTimer();
 }
 
@@ -47,6 +47,7 @@
 #include "qabstractnetworkcache.h"
 #include "qhstspolicy.h"
 #include "qhsts_p.h"
+#include "qhttpconnectionpool.h"
 
 #include "QtNetwork/qnetworksession.h"
 #include "QtNetwork/private/qsharednetworksession_p.h"
@@ -1246,6 +1247,90 @@ QNetworkRequest::RedirectPolicy QNetworkAccessManager::redirectPolicy() const
     return d->redirectPolicy;
 }
 
+/*!
+    \since 5.12
+
+    Sets the connection pool policy used for HTTP hosts that have no policy of
+    their own to \a policy.
+
+    The policy applies to connection pools created afterwards; pools that are
+    already open keep their size until they expire or clearConnectionCache()
+    is called.
+
+    \sa connectionPoolPolicy(), connectionPoolStatistics(), QHttpConnectionPoolPolicy
+*/
+void QNetworkAccessManager::setConnectionPoolPolicy(const QHttpConnectionPoolPolicy &policy)
+{
+    Q_D(QNetworkAccessManager);
+    d->defaultConnectionPoolPolicy = policy;
+}
+
+/*!
+    \since 5.12
+
+    Returns the connection pool policy used for HTTP hosts that have no policy
+    of their own.
+
+    \sa setConnectionPoolPolicy()
+*/
+QHttpConnectionPoolPolicy QNetworkAccessManager::connectionPoolPolicy() const
+{
+    Q_D(const QNetworkAccessManager);
+    return d->defaultConnectionPoolPolicy;
+}
+
+/*!
+    \since 5.12
+    \overload
+
+    Sets the connection pool policy for the HTTP server at \a hostName and
+    \a port to \a policy. The port must be given explicitly, also for the
+    default ports 80 and 443.
+
+    \sa connectionPoolStatistics()
+*/
+void QNetworkAccessManager::setConnectionPoolPolicy(const QString &hostName, quint16 port,
+                                                    const QHttpConnectionPoolPolicy &policy)
+{
+    Q_D(QNetworkAccessManager);
+    d->connectionPoolPolicies.insert(QNetworkAccessManagerPrivate::connectionPoolKey(hostName, port),
+                                     policy);
+}
+
+/*!
+    \since 5.12
+    \overload
+
+    Returns the connection pool policy that applies to the HTTP server at
+    \a hostName and \a port.
+*/
+QHttpConnectionPoolPolicy QNetworkAccessManager::connectionPoolPolicy(const QString &hostName,
+                                                                      quint16 port) const
+{
+    Q_D(const QNetworkAccessManager);
+    return d->connectionPoolPolicy(QNetworkAccessManagerPrivate::connectionPoolKey(hostName, port));
+}
+
+/*!
+    \since 5.12
+
+    Returns a snapshot of the usage statistics of the connection pool for the
+    HTTP server at \a hostName and \a port: how many requests had to wait for
+    a free connection, how many of them could reuse an open connection and how
+    long it took to open new ones. The statistics are collected for all hosts
+    contacted through this manager, whether they have a policy of their own or not.
+
+    \sa setConnectionPoolPolicy()
+*/
+QHttpConnectionPoolStatistics QNetworkAccessManager::connectionPoolStatistics(const QString &hostName,
+                                                                              quint16 port) const
+{
+    Q_D(const QNetworkAccessManager);
+    const auto collector = d->connectionPoolCollectors.value(
+            QNetworkAccessManagerPrivate::connectionPoolKey(hostName, port));
+    return collector ? collector->snapshot() : QHttpConnectionPoolStatistics();
+}
+
 /*!
     \since 4.7
 
@@ -1779,6 +1864,25 @@ void QNetworkAccessManagerPrivate::clearConnectionCache(QNetworkAccessManager *m
     manager->d_func()->destroyThread();
 }
 
+QString QNetworkAccessManagerPrivate::connectionPoolKey(const QString &hostName, quint16 port)
+{
+    return hostName.toLower() + QLatin1Char(':') + QString::number(port);
+}
+
+QHttpConnectionPoolPolicy QNetworkAccessManagerPrivate::connectionPoolPolicy(const QString &key) const
+{
+    return connectionPoolPolicies.value(key, defaultConnectionPoolPolicy);
+}
+
+QSharedPointer<QHttpConnectionPoolStatisticsCollector>
+QNetworkAccessManagerPrivate::connectionPoolStatistics(const QString &key)
+{
+    QSharedPointer<QHttpConnectionPoolStatisticsCollector> &collector = connectionPoolCollectors[key];
+    if (!collector)
+        collector = QSharedPointer<QHttpConnectionPoolStatisticsCollector>::create();
+    return collector;
+}
+
 QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
 {
     destroyThread();
@@ -64,6 +64,8 @@ class QNetworkProxy;
 class QNetworkProxyFactory;
 class QSslError;
 class QHstsPolicy;
+class QHttpConnectionPoolPolicy;
+class QHttpConnectionPoolStatistics;
 #ifndef QT_NO_BEARERMANAGEMENT
 class QNetworkConfiguration;
 #endif
@@ -164,6 +166,13 @@ public:
     void setRedirectPolicy(QNetworkRequest::RedirectPolicy policy);
     QNetworkRequest::RedirectPolicy redirectPolicy() const;
 
+    void setConnectionPoolPolicy(const QHttpConnectionPoolPolicy &policy);
+    QHttpConnectionPoolPolicy connectionPoolPolicy() const;
+    void setConnectionPoolPolicy(const QString &hostName, quint16 port,
+                                 const QHttpConnectionPoolPolicy &policy);
+    QHttpConnectionPoolPolicy connectionPoolPolicy(const QString &hostName, quint16 port) const;
+    QHttpConnectionPoolStatistics connectionPoolStatistics(const QString &hostName, quint16 port) const;
+
 Q_SIGNALS:
 #ifndef QT_NO_NETWORKPROXY
     void proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
@@ -58,6 +58,7 @@
 #include "qnetworkrequest.h"
 #include "qhstsstore_p.h"
 #include "qhsts_p.h"
+#include "qhttpconnectionpool_p.h"
 #include "private/qobject_p.h"
 #include "QtNetwork/qnetworkproxy.h"
 #include "QtNetwork/qnetworksession.h"
@@ -217,6 +218,14 @@ public:
     QScopedPointer<QHstsStore> stsStore;
     bool stsEnabled = false;
 
+    // HTTP/1.1 connection pools, keyed by connectionPoolKey()
+    static QString connectionPoolKey(const QString &hostName, quint16 port);
+    QHttpConnectionPoolPolicy connectionPoolPolicy(const QString &key) const;
+    QSharedPointer<QHttpConnectionPoolStatisticsCollector> connectionPoolStatistics(const QString &key);
+    QHttpConnectionPoolPolicy defaultConnectionPoolPolicy;
+    QHash<QString, QHttpConnectionPoolPolicy> connectionPoolPolicies;
+    QHash<QString, QSharedPointer<QHttpConnectionPoolStatisticsCollector> > connectionPoolCollectors;
+
 #ifndef QT_NO_BEARERMANAGEMENT
     Q_AUTOTEST_EXPORT static const QWeakPointer<const QNetworkSession> getNetworkSession(const QNetworkAccessManager *manager);
 #endif
@@ -792,6 +792,11 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     const QVariant blob(manager->property(Http2::http2ParametersPropertyName));
     if (blob.isValid() && blob.canConvert<Http2::ProtocolParameters>())
         delegate->http2Parameters = blob.value<Http2::ProtocolParameters>();
+    // The connection pool is keyed by the origin server, also when going through a proxy
+    const QString poolKey = QNetworkAccessManagerPrivate::connectionPoolKey(
+            httpRequest.url().host(), quint16(httpRequest.url().port(ssl ? 443 : 80)));
+    delegate->connectionPoolPolicy = managerPrivate->connectionPoolPolicy(poolKey);
+    delegate->connectionPoolStatistics = managerPrivate->connectionPoolStatistics(poolKey);
 #ifndef QT_NO_BEARERMANAGEMENT
     delegate->networkSession = managerPrivate->getNetworkSession();
 #endif
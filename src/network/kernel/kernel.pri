@@ -38,7 +38,13 @@ qtConfig(dnslookup) {
 }
 
 unix {
-    !integrity:qtConfig(dnslookup): SOURCES += kernel/qdnslookup_unix.cpp
+    !integrity:qtConfig(dnslookup) {
+        SOURCES += kernel/qdnslookup_unix.cpp
+        !android {
+            HEADERS += kernel/qdnsresolver_p.h
+            SOURCES += kernel/qdnsresolver_unix.cpp
+        }
+    }
     SOURCES += kernel/qhostinfo_unix.cpp
 
     qtConfig(linux-netlink): SOURCES += kernel/qnetworkinterface_linux.cpp
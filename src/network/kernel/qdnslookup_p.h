@@ -122,6 +122,11 @@ public:
     { }
     void run() override;
 
+#ifdef Q_OS_UNIX
+    // Parses a DNS response in wire format, as returned by a name server.
+    static void parseReply(const unsigned char *response, int responseLength, QDnsLookupReply *reply);
+#endif
+
 signals:
     void finished(const QDnsLookupReply &reply);
 
@@ -207,11 +207,30 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
         }
     }
 
-    unsigned char *response = buffer.data();
-    // Check the response header. Though res_nquery returns -1 as a
-    // responseLength in case of error, we still can extract the
-    // exact error code from the response.
-    HEADER *header = (HEADER*)response;
+    // Though res_nquery returns -1 as a responseLength in case of error,
+    // we still can extract the exact error code from the response.
+    parseReply(buffer.data(), qMax(responseLength, int(sizeof(HEADER))), reply);
+}
+
+void QDnsLookupRunnable::parseReply(const unsigned char *response, int responseLength, QDnsLookupReply *reply)
+{
+    // Load dn_expand on demand.
+    resolveLibrary();
+    if (!local_dn_expand) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("Resolver functions not found");
+        return;
+    }
+
+    // Check the reply is valid.
+    if (responseLength < int(sizeof(HEADER))) {
+        reply->error = QDnsLookup::InvalidReplyError;
+        reply->errorString = tr("Invalid reply received");
+        return;
+    }
+
+    // Check the response header.
+    const HEADER *header = reinterpret_cast<const HEADER *>(response);
     const int answerCount = ntohs(header->ancount);
     switch (header->rcode) {
     case NOERROR:
@@ -238,17 +257,11 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
         return;
     }
 
-    // Check the reply is valid.
-    if (responseLength < int(sizeof(HEADER))) {
-        reply->error = QDnsLookup::InvalidReplyError;
-        reply->errorString = tr("Invalid reply received");
-        return;
-    }
-
     // Skip the query host, type (2 bytes) and class (2 bytes).
     char host[PACKETSZ], answer[PACKETSZ];
-    unsigned char *p = response + sizeof(HEADER);
-    int status = local_dn_expand(response, response + responseLength, p, host, sizeof(host));
+    const unsigned char *end = response + responseLength;
+    const unsigned char *p = response + sizeof(HEADER);
+    int status = local_dn_expand(response, end, p, host, sizeof(host));
     if (status < 0) {
         reply->error = QDnsLookup::InvalidReplyError;
         reply->errorString = tr("Could not expand domain name");
@@ -258,8 +271,8 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
 
     // Extract results.
     int answerIndex = 0;
-    while ((p < response + responseLength) && (answerIndex < answerCount)) {
-        status = local_dn_expand(response, response + responseLength, p, host, sizeof(host));
+    while ((p < end) && (answerIndex < answerCount)) {
+        status = local_dn_expand(response, end, p, host, sizeof(host));
         if (status < 0) {
             reply->error = QDnsLookup::InvalidReplyError;
             reply->errorString = tr("Could not expand domain name");
@@ -268,6 +281,11 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
         const QString name = QUrl::fromAce(host);
 
         p += status;
+        if (end - p < 10) {
+            reply->error = QDnsLookup::InvalidReplyError;
+            reply->errorString = tr("Invalid reply received");
+            return;
+        }
         const quint16 type = (p[0] << 8) | p[1];
         p += 2; // RR type
         p += 2; // RR class
@@ -275,6 +293,11 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
         p += 4;
         const quint16 size = (p[0] << 8) | p[1];
         p += 2;
+        if (end - p < size) {
+            reply->error = QDnsLookup::InvalidReplyError;
+            reply->errorString = tr("Invalid reply received");
+            return;
+        }
 
         if (type == QDnsLookup::A) {
             if (size != 4) {
@@ -300,7 +323,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             record.d->value = QHostAddress(p);
             reply->hostAddressRecords.append(record);
         } else if (type == QDnsLookup::CNAME) {
-            status = local_dn_expand(response, response + responseLength, p, answer, sizeof(answer));
+            status = local_dn_expand(response, end, p, answer, sizeof(answer));
             if (status < 0) {
                 reply->error = QDnsLookup::InvalidReplyError;
                 reply->errorString = tr("Invalid canonical name record");
@@ -312,7 +335,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             record.d->value = QUrl::fromAce(answer);
             reply->canonicalNameRecords.append(record);
         } else if (type == QDnsLookup::NS) {
-            status = local_dn_expand(response, response + responseLength, p, answer, sizeof(answer));
+            status = local_dn_expand(response, end, p, answer, sizeof(answer));
             if (status < 0) {
                 reply->error = QDnsLookup::InvalidReplyError;
                 reply->errorString = tr("Invalid name server record");
@@ -324,7 +347,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             record.d->value = QUrl::fromAce(answer);
             reply->nameServerRecords.append(record);
         } else if (type == QDnsLookup::PTR) {
-            status = local_dn_expand(response, response + responseLength, p, answer, sizeof(answer));
+            status = local_dn_expand(response, end, p, answer, sizeof(answer));
             if (status < 0) {
                 reply->error = QDnsLookup::InvalidReplyError;
                 reply->errorString = tr("Invalid pointer record");
@@ -337,7 +360,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             reply->pointerRecords.append(record);
         } else if (type == QDnsLookup::MX) {
             const quint16 preference = (p[0] << 8) | p[1];
-            status = local_dn_expand(response, response + responseLength, p + 2, answer, sizeof(answer));
+            status = local_dn_expand(response, end, p + 2, answer, sizeof(answer));
             if (status < 0) {
                 reply->error = QDnsLookup::InvalidReplyError;
                 reply->errorString = tr("Invalid mail exchange record");
@@ -353,7 +376,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             const quint16 priority = (p[0] << 8) | p[1];
             const quint16 weight = (p[2] << 8) | p[3];
             const quint16 port = (p[4] << 8) | p[5];
-            status = local_dn_expand(response, response + responseLength, p + 6, answer, sizeof(answer));
+            status = local_dn_expand(response, end, p + 6, answer, sizeof(answer));
             if (status < 0) {
                 reply->error = QDnsLookup::InvalidReplyError;
                 reply->errorString = tr("Invalid service record");
@@ -368,7 +391,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
             record.d->weight = weight;
             reply->serviceRecords.append(record);
         } else if (type == QDnsLookup::TXT) {
-            unsigned char *txt = p;
+            const unsigned char *txt = p;
             QDnsTextRecord record;
             record.d->name = name;
             record.d->timeToLive = ttl;
@@ -380,7 +403,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
                     reply->errorString = tr("Invalid text record");
                     return;
                 }
-                record.d->values << QByteArray((char*)txt, length);
+                record.d->values << QByteArray(reinterpret_cast<const char *>(txt), length);
                 txt += length;
             }
             reply->textRecords.append(record);
@@ -401,6 +424,14 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
     return;
 }
 
+void QDnsLookupRunnable::parseReply(const unsigned char *response, int responseLength, QDnsLookupReply *reply)
+{
+    Q_UNUSED(response)
+    Q_UNUSED(responseLength)
+    reply->error = QDnsLookup::ResolverError;
+    reply->errorString = tr("Resolver library can't be loaded: No runtime library loading support");
+}
+
 #endif /* QT_CONFIG(library) */
 
 QT_END_NAMESPACE
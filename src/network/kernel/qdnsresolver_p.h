@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QDNSRESOLVER_P_H
+#define QDNSRESOLVER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QHostInfo class.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "QtNetwork/qhostaddress.h"
+#include "QtCore/qmutex.h"
+#include "QtCore/qpair.h"
+#include "QtCore/qstringlist.h"
+#include "QtCore/qthread.h"
+#include "QtCore/qvector.h"
+
+QT_REQUIRE_CONFIG(dnslookup);
+
+QT_BEGIN_NAMESPACE
+
+class QHostInfoLookupManager;
+class QHostInfoRunnable;
+class QDnsResolverWorker;
+
+class Q_AUTOTEST_EXPORT QDnsResolverConfiguration
+{
+public:
+    QVector<QPair<QHostAddress, quint16> > nameServers;
+    QStringList searchDomains;
+    int ndots = 1;
+    int timeout = 5000; // msecs per attempt
+    int attempts = 2;
+    QString hostsFile;
+
+    // Reads /etc/resolv.conf and uses /etc/hosts.
+    static QDnsResolverConfiguration system();
+};
+
+// Resolves host names by sending A and AAAA queries over UDP from a
+// thread of its own, instead of blocking a thread per lookup.
+class QDnsResolver
+{
+public:
+    explicit QDnsResolver(QHostInfoLookupManager *manager);
+    ~QDnsResolver();
+
+    static bool isEnabledByEnvironment();
+
+    // An empty configuration means the system configuration,
+    // which is reloaded when /etc/resolv.conf changes.
+    void setConfiguration(const QDnsResolverConfiguration &configuration);
+
+    // Reverse lookups are left to the system resolver.
+    static bool canResolve(const QString &name);
+
+    // Takes ownership of the runnable and hands it back through
+    // QHostInfoLookupManager::asyncLookupFinished() or
+    // QHostInfoLookupManager::rescheduleLookup().
+    void resolve(QHostInfoRunnable *runnable);
+
+private:
+    Q_DISABLE_COPY(QDnsResolver)
+
+    QThread thread;
+    QDnsResolverWorker *worker;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDNSRESOLVER_P_H
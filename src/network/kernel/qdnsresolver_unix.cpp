@@ -0,0 +1,580 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qdnsresolver_p.h"
+#include "qdnslookup_p.h"
+#include "qhostinfo_p.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qurl.h>
+#include <QtNetwork/qnetworkproxy.h>
+#include <QtNetwork/qudpsocket.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+static const char resolvConfPath[] = "/etc/resolv.conf";
+static const char systemHostsPath[] = "/etc/hosts";
+
+enum {
+    DnsHeaderSize = 12,
+    DnsClassIN = 1,
+    MaximumNameServers = 3 // MAXNS in resolv.h
+};
+
+QDnsResolverConfiguration QDnsResolverConfiguration::system()
+{
+    QDnsResolverConfiguration configuration;
+    configuration.hostsFile = QLatin1String(systemHostsPath);
+
+    QFile file(QString::fromLatin1(resolvConfPath));
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine().simplified();
+            if (line.isEmpty() || line.startsWith('#') || line.startsWith(';'))
+                continue;
+            const QList<QByteArray> fields = line.split(' ');
+            const QByteArray &keyword = fields.first();
+            if (keyword == "nameserver" && fields.size() > 1) {
+                QHostAddress address;
+                if (configuration.nameServers.size() < MaximumNameServers
+                    && address.setAddress(QString::fromLatin1(fields.at(1)))) {
+                    configuration.nameServers.append(qMakePair(address, quint16(53)));
+                }
+            } else if ((keyword == "domain" || keyword == "search") && fields.size() > 1) {
+                // the last "domain" or "search" line wins
+                configuration.searchDomains.clear();
+                for (int i = 1; i < fields.size(); ++i)
+                    configuration.searchDomains.append(QString::fromLatin1(fields.at(i)));
+            } else if (keyword == "options") {
+                for (int i = 1; i < fields.size(); ++i) {
+                    const QByteArray &option = fields.at(i);
+                    bool ok;
+                    if (option.startsWith("ndots:")) {
+                        const int value = option.mid(6).toInt(&ok);
+                        if (ok)
+                            configuration.ndots = qBound(0, value, 15);
+                    } else if (option.startsWith("timeout:")) {
+                        const int value = option.mid(8).toInt(&ok);
+                        if (ok)
+                            configuration.timeout = qBound(1, value, 30) * 1000;
+                    } else if (option.startsWith("attempts:")) {
+                        const int value = option.mid(9).toInt(&ok);
+                        if (ok)
+                            configuration.attempts = qBound(1, value, 5);
+                    }
+                }
+            }
+        }
+    }
+
+    // like the system resolver, fall back to a name server on the local host
+    if (configuration.nameServers.isEmpty())
+        configuration.nameServers.append(qMakePair(QHostAddress(QHostAddress::LocalHost), quint16(53)));
+    return configuration;
+}
+
+static QByteArray buildQuery(quint16 id, QDnsLookup::Type type, const QByteArray &name)
+{
+    QByteArray query;
+    query.reserve(DnsHeaderSize + name.size() + 6);
+    query.append(char(id >> 8)).append(char(id & 0xff));
+    query.append(char(0x01)).append(char(0x00)); // standard query, recursion desired
+    query.append(char(0x00)).append(char(0x01)); // one question
+    query.append(6, char(0x00));                 // no answer, authority or additional records
+
+    const QList<QByteArray> labels = name.split('.');
+    for (const QByteArray &label : labels) {
+        if (label.isEmpty() || label.size() > 63)
+            return QByteArray();
+        query.append(char(label.size())).append(label);
+    }
+    query.append(char(0x00));
+    query.append(char(type >> 8)).append(char(type & 0xff));
+    query.append(char(0x00)).append(char(DnsClassIN));
+    return query;
+}
+
+// Compares the question section at the start of \a reply with the one we
+// sent, the name case-insensitively; the trailing type and class exactly.
+static bool isSameQuestion(const uchar *reply, const QByteArray &question)
+{
+    const int nameSize = question.size() - 4;
+    return qstrnicmp(reinterpret_cast<const char *>(reply), question.constData(), nameSize) == 0
+            && memcmp(reply + nameSize, question.constData() + nameSize, 4) == 0;
+}
+
+class QDnsResolverWorker : public QObject
+{
+public:
+    explicit QDnsResolverWorker(QHostInfoLookupManager *manager)
+        : manager(manager)
+    {
+    }
+    ~QDnsResolverWorker();
+
+    void setConfiguration(const QDnsResolverConfiguration &configuration);
+    void resolve(QHostInfoRunnable *runnable);
+
+private:
+    struct Lookup
+    {
+        QHostInfoRunnable *runnable;
+        QList<QByteArray> candidates;
+        int candidate = 0;
+        int server = 0;
+        int attempt = 0;
+        quint16 ids[2] = { 0, 0 };
+        QByteArray questions[2];
+        bool answered[2];
+        QDnsLookup::Error errors[2];
+        QList<QHostAddress> addresses[2]; // A, AAAA
+        quint32 timeToLive;
+        QTimer timer;
+        QUdpSocket *socket = nullptr;
+    };
+
+    void reloadConfiguration();
+    bool lookupHostsFile(const QByteArray &name, QList<QHostAddress> *addresses);
+    bool openSocket(Lookup *lookup);
+    void closeSocket(Lookup *lookup);
+    void sendQueries(Lookup *lookup);
+    void retry(Lookup *lookup);
+    void readDatagrams(Lookup *lookup);
+    void processReply(Lookup *lookup, int index, const QDnsLookupReply &reply);
+    void finish(Lookup *lookup, const QHostInfo &info, int timeToLive);
+    void reschedule(Lookup *lookup);
+    void forget(Lookup *lookup);
+
+    QHostInfoLookupManager *manager;
+    QDnsResolverConfiguration configuration;
+    bool systemConfiguration = true;
+    QDateTime resolvConfModified;
+
+    QHash<QString, QList<QHostAddress> > hosts;
+    QString hostsFile;
+    QDateTime hostsModified;
+
+    QList<Lookup *> lookups;
+};
+
+QDnsResolverWorker::~QDnsResolverWorker()
+{
+    // the lookup manager is going away, nobody waits for the results anymore
+    for (Lookup *lookup : qAsConst(lookups)) {
+        delete lookup->runnable;
+        delete lookup;
+    }
+}
+
+void QDnsResolverWorker::setConfiguration(const QDnsResolverConfiguration &newConfiguration)
+{
+    systemConfiguration = newConfiguration.nameServers.isEmpty();
+    configuration = systemConfiguration ? QDnsResolverConfiguration::system() : newConfiguration;
+    resolvConfModified = QFileInfo(QLatin1String(resolvConfPath)).lastModified();
+}
+
+void QDnsResolverWorker::reloadConfiguration()
+{
+    if (!systemConfiguration)
+        return;
+    const QDateTime modified = QFileInfo(QLatin1String(resolvConfPath)).lastModified();
+    if (configuration.nameServers.isEmpty() || modified != resolvConfModified) {
+        configuration = QDnsResolverConfiguration::system();
+        resolvConfModified = modified;
+    }
+}
+
+bool QDnsResolverWorker::lookupHostsFile(const QByteArray &name, QList<QHostAddress> *addresses)
+{
+    const QDateTime modified = QFileInfo(configuration.hostsFile).lastModified();
+    if (hostsFile != configuration.hostsFile || modified != hostsModified) {
+        hosts.clear();
+        hostsFile = configuration.hostsFile;
+        hostsModified = modified;
+
+        QFile file(hostsFile);
+        if (!hostsFile.isEmpty() && file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            while (!file.atEnd()) {
+                QByteArray line = file.readLine();
+                const int comment = line.indexOf('#');
+                if (comment >= 0)
+                    line.truncate(comment);
+                const QList<QByteArray> fields = line.simplified().split(' ');
+                QHostAddress address;
+                if (fields.size() < 2 || !address.setAddress(QString::fromLatin1(fields.first())))
+                    continue;
+                for (int i = 1; i < fields.size(); ++i) {
+                    QList<QHostAddress> &known = hosts[QString::fromLatin1(fields.at(i).toLower())];
+                    if (!known.contains(address))
+                        known.append(address);
+                }
+            }
+        }
+    }
+
+    const auto it = hosts.constFind(QString::fromLatin1(name.toLower()));
+    if (it == hosts.cend())
+        return false;
+    // like getaddrinfo, list the IPv4 addresses first
+    for (const QHostAddress &address : it.value()) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol)
+            addresses->append(address);
+    }
+    for (const QHostAddress &address : it.value()) {
+        if (address.protocol() != QAbstractSocket::IPv4Protocol)
+            addresses->append(address);
+    }
+    return true;
+}
+
+bool QDnsResolverWorker::openSocket(Lookup *lookup)
+{
+    // Every attempt is sent from a new socket on a random port, so that a
+    // spoofed reply has to guess the port as well as the query ID. We pick
+    // the port ourselves, not every system randomizes ephemeral ports.
+    closeSocket(lookup);
+    QUdpSocket *socket = new QUdpSocket(this);
+#ifndef QT_NO_NETWORKPROXY
+    socket->setProxy(QNetworkProxy::NoProxy);
+#endif
+    const QHostAddress &server = configuration.nameServers.at(lookup->server).first;
+    const QHostAddress any(server.protocol() == QAbstractSocket::IPv6Protocol
+                           ? QHostAddress::AnyIPv6 : QHostAddress::AnyIPv4);
+    bool bound = false;
+    for (int i = 0; i < 8 && !bound; ++i) {
+        const quint16 port = quint16(QRandomGenerator::global()->bounded(1024, 65536));
+        bound = socket->bind(any, port, QUdpSocket::DontShareAddress);
+    }
+    if (!bound && !socket->bind(any, 0, QUdpSocket::DontShareAddress)) {
+        delete socket;
+        return false;
+    }
+    connect(socket, &QUdpSocket::readyRead, this, [this, lookup]() { readDatagrams(lookup); });
+    lookup->socket = socket;
+    return true;
+}
+
+void QDnsResolverWorker::closeSocket(Lookup *lookup)
+{
+    if (!lookup->socket)
+        return;
+    // we might be called from the socket's readyRead()
+    lookup->socket->disconnect(this);
+    lookup->socket->deleteLater();
+    lookup->socket = nullptr;
+}
+
+void QDnsResolverWorker::resolve(QHostInfoRunnable *runnable)
+{
+    reloadConfiguration();
+
+    const QString &name = runnable->toBeLookedUp;
+    QHostInfo info;
+    info.setHostName(name);
+
+    QByteArray ace = QUrl::toAce(name);
+    if (ace.isEmpty()) {
+        info.setError(QHostInfo::HostNotFound);
+        info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Invalid hostname"));
+        manager->asyncLookupFinished(runnable, info, -1);
+        return;
+    }
+    const bool absolute = ace.endsWith('.');
+    if (absolute)
+        ace.chop(1);
+
+    QList<QHostAddress> addresses;
+    if (lookupHostsFile(ace, &addresses)) {
+        info.setAddresses(addresses);
+        manager->asyncLookupFinished(runnable, info, -1);
+        return;
+    }
+
+    Lookup *lookup = new Lookup;
+    lookup->runnable = runnable;
+    // apply the search list the way the system resolver does
+    if (!absolute && ace.count('.') < configuration.ndots) {
+        for (const QString &domain : qAsConst(configuration.searchDomains))
+            lookup->candidates.append(ace + '.' + QUrl::toAce(domain));
+    }
+    lookup->candidates.append(ace);
+    if (!absolute && ace.count('.') >= configuration.ndots) {
+        for (const QString &domain : qAsConst(configuration.searchDomains))
+            lookup->candidates.append(ace + '.' + QUrl::toAce(domain));
+    }
+    lookup->timer.setSingleShot(true);
+    connect(&lookup->timer, &QTimer::timeout, this, [this, lookup]() { retry(lookup); });
+    lookups.append(lookup);
+
+    sendQueries(lookup);
+}
+
+void QDnsResolverWorker::sendQueries(Lookup *lookup)
+{
+    static const QDnsLookup::Type types[2] = { QDnsLookup::A, QDnsLookup::AAAA };
+
+    if (!openSocket(lookup)) {
+        reschedule(lookup);
+        return;
+    }
+
+    const QPair<QHostAddress, quint16> &server = configuration.nameServers.at(lookup->server);
+    const QByteArray &name = lookup->candidates.at(lookup->candidate);
+    lookup->timeToLive = std::numeric_limits<quint32>::max();
+    for (int i = 0; i < 2; ++i) {
+        quint16 id;
+        do {
+            id = quint16(QRandomGenerator::global()->generate());
+        } while (i && id == lookup->ids[0]);
+        lookup->ids[i] = id;
+        lookup->answered[i] = false;
+        lookup->errors[i] = QDnsLookup::NoError;
+        lookup->addresses[i].clear();
+
+        const QByteArray query = buildQuery(id, types[i], name);
+        if (query.isEmpty()) {
+            QHostInfo info;
+            info.setHostName(lookup->runnable->toBeLookedUp);
+            info.setError(QHostInfo::HostNotFound);
+            info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Invalid hostname"));
+            finish(lookup, info, -1);
+            return;
+        }
+        lookup->questions[i] = query.mid(DnsHeaderSize);
+        // both queries go out at once; a failed write is retried on timeout
+        lookup->socket->writeDatagram(query, server.first, server.second);
+    }
+    lookup->timer.start(configuration.timeout);
+}
+
+void QDnsResolverWorker::retry(Lookup *lookup)
+{
+    const int servers = configuration.nameServers.size();
+    if (++lookup->attempt >= configuration.attempts * servers) {
+        QHostInfo info;
+        info.setHostName(lookup->runnable->toBeLookedUp);
+        info.setError(QHostInfo::UnknownError);
+        info.setErrorString(QCoreApplication::translate("QHostInfoAgent",
+                                                        "Temporary failure in name resolution"));
+        finish(lookup, info, -1);
+        return;
+    }
+    lookup->server = (lookup->server + 1) % servers;
+    sendQueries(lookup);
+}
+
+void QDnsResolverWorker::readDatagrams(Lookup *lookup)
+{
+    QUdpSocket *socket = lookup->socket;
+    while (socket->hasPendingDatagrams()) {
+        const qint64 pendingSize = socket->pendingDatagramSize();
+        QByteArray datagram(int(qMax<qint64>(pendingSize, DnsHeaderSize)), Qt::Uninitialized);
+        QHostAddress sender;
+        quint16 senderPort;
+        const qint64 size = socket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+        if (size < DnsHeaderSize)
+            continue;
+
+        const uchar *data = reinterpret_cast<const uchar *>(datagram.constData());
+        const quint16 id = qFromBigEndian<quint16>(data);
+        const int index = id == lookup->ids[0] ? 0 : 1;
+        if (id != lookup->ids[index] || lookup->answered[index])
+            continue;
+        const QPair<QHostAddress, quint16> &server = configuration.nameServers.at(lookup->server);
+        const bool isResponse = data[2] & 0x80;
+        if (!isResponse || senderPort != server.second
+            || !sender.isEqual(server.first, QHostAddress::TolerantConversion)) {
+            continue;
+        }
+
+        // the reply has to repeat our question, name, type and class
+        const QByteArray &question = lookup->questions[index];
+        if (qFromBigEndian<quint16>(data + 4) != 1 || size < DnsHeaderSize + question.size()
+            || !isSameQuestion(data + DnsHeaderSize, question)) {
+            continue;
+        }
+
+        const bool truncated = data[2] & 0x02;
+        if (truncated) {
+            // answers that need TCP are left to the system resolver
+            reschedule(lookup);
+            return;
+        }
+
+        QDnsLookupReply reply;
+        QDnsLookupRunnable::parseReply(data, int(size), &reply);
+        if (reply.error == QDnsLookup::ResolverError) {
+            reschedule(lookup);
+            return;
+        }
+        processReply(lookup, index, reply);
+        // the lookup is done or moved on to a new socket
+        if (!lookups.contains(lookup) || lookup->socket != socket)
+            return;
+    }
+}
+
+void QDnsResolverWorker::processReply(Lookup *lookup, int index, const QDnsLookupReply &reply)
+{
+    const QAbstractSocket::NetworkLayerProtocol protocol =
+        index == 0 ? QAbstractSocket::IPv4Protocol : QAbstractSocket::IPv6Protocol;
+    lookup->answered[index] = true;
+    lookup->errors[index] = reply.error;
+    for (const QDnsHostAddressRecord &record : reply.hostAddressRecords) {
+        if (record.value().protocol() != protocol)
+            continue;
+        if (!lookup->addresses[index].contains(record.value()))
+            lookup->addresses[index].append(record.value());
+        lookup->timeToLive = qMin(lookup->timeToLive, record.timeToLive());
+    }
+    for (const QDnsDomainNameRecord &record : reply.canonicalNameRecords)
+        lookup->timeToLive = qMin(lookup->timeToLive, record.timeToLive());
+
+    if (!lookup->answered[0] || !lookup->answered[1])
+        return;
+
+    const QList<QHostAddress> addresses = lookup->addresses[0] + lookup->addresses[1];
+    if (!addresses.isEmpty()) {
+        QHostInfo info;
+        info.setHostName(lookup->runnable->toBeLookedUp);
+        info.setAddresses(addresses);
+        finish(lookup, info, int(qMin<quint32>(lookup->timeToLive, std::numeric_limits<int>::max())));
+        return;
+    }
+
+    auto isNotFound = [](QDnsLookup::Error error) {
+        // NoError without addresses means the name exists without such records
+        return error == QDnsLookup::NoError || error == QDnsLookup::NotFoundError;
+    };
+    if (!isNotFound(lookup->errors[0]) || !isNotFound(lookup->errors[1])) {
+        // the server failed us, try the next one
+        lookup->timer.stop();
+        retry(lookup);
+        return;
+    }
+
+    if (++lookup->candidate < lookup->candidates.size()) {
+        lookup->attempt = 0;
+        sendQueries(lookup);
+        return;
+    }
+
+    QHostInfo info;
+    info.setHostName(lookup->runnable->toBeLookedUp);
+    info.setError(QHostInfo::HostNotFound);
+    info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Host not found"));
+    finish(lookup, info, -1);
+}
+
+void QDnsResolverWorker::forget(Lookup *lookup)
+{
+    lookup->timer.stop();
+    closeSocket(lookup);
+    lookups.removeOne(lookup);
+}
+
+void QDnsResolverWorker::finish(Lookup *lookup, const QHostInfo &info, int timeToLive)
+{
+    forget(lookup);
+    QHostInfoRunnable *runnable = lookup->runnable;
+    delete lookup;
+    manager->asyncLookupFinished(runnable, info, timeToLive);
+}
+
+void QDnsResolverWorker::reschedule(Lookup *lookup)
+{
+    forget(lookup);
+    QHostInfoRunnable *runnable = lookup->runnable;
+    delete lookup;
+    manager->rescheduleLookup(runnable);
+}
+
+QDnsResolver::QDnsResolver(QHostInfoLookupManager *manager)
+    : worker(new QDnsResolverWorker(manager))
+{
+    thread.setObjectName(QStringLiteral("Qt DNS resolver"));
+    worker->moveToThread(&thread);
+    // QThread deletes the worker in its own thread once the event loop has quit
+    QObject::connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+    thread.start();
+}
+
+QDnsResolver::~QDnsResolver()
+{
+    thread.quit();
+    thread.wait();
+}
+
+bool QDnsResolver::isEnabledByEnvironment()
+{
+    return qEnvironmentVariableIntValue("QT_ASYNC_DNS_RESOLVER") != 0;
+}
+
+void QDnsResolver::setConfiguration(const QDnsResolverConfiguration &configuration)
+{
+    QDnsResolverWorker *worker = this->worker;
+    QMetaObject::invokeMethod(worker, [worker, configuration]() {
+        worker->setConfiguration(configuration);
+    }, Qt::QueuedConnection);
+}
+
+bool QDnsResolver::canResolve(const QString &name)
+{
+    QHostAddress address;
+    return !name.isEmpty() && !address.setAddress(name);
+}
+
+void QDnsResolver::resolve(QHostInfoRunnable *runnable)
+{
+    QDnsResolverWorker *worker = this->worker;
+    QMetaObject::invokeMethod(worker, [worker, runnable]() {
+        worker->resolve(runnable);
+    }, Qt::QueuedConnection);
+}
+
+QT_END_NAMESPACE
@@ -179,6 +179,12 @@ void emit_results_ready(const QHostInfo &hostInfo, const QObject *receiver,
     compared to previous versions of Qt.
     \note Since Qt 4.6.3 QHostInfo is using a small internal 60 second DNS cache
     for performance improvements.
+    \note Since Qt 5.12, setting the environment variable \c QT_ASYNC_DNS_RESOLVER
+    to 1 on Unix makes QHostInfo send the DNS queries itself instead of
+    blocking a thread per lookup. It reads the name servers and search domains
+    from \c /etc/resolv.conf, answers names found in \c /etc/hosts directly,
+    and caches results for the time to live of their DNS records. Other
+    name services configured in \c /etc/nsswitch.conf are not consulted.
 
     \sa QAbstractSocket, {http://www.rfc-editor.org/rfc/rfc3492.txt}{RFC 3492}
 */
@@ -694,6 +700,16 @@ void QHostInfoRunnable::run()
         hostInfo = QHostInfoAgent::fromName(toBeLookedUp);
     }
 
+    finishLookup(hostInfo);
+
+    // thread goes back to QThreadPool
+}
+
+// called with the result of the lookup, either from run() or from the asynchronous resolver
+void QHostInfoRunnable::finishLookup(QHostInfo hostInfo)
+{
+    QHostInfoLookupManager *manager = theHostInfoLookupManager();
+
     // check aborted again
     if (manager->wasAborted(id)) {
         manager->lookupFinished(this);
@@ -721,8 +737,6 @@ void QHostInfoRunnable::run()
     }
 
     manager->lookupFinished(this);
-
-    // thread goes back to QThreadPool
 }
 
 QHostInfoLookupManager::QHostInfoLookupManager() : mutex(QMutex::Recursive), wasDeleted(false)
@@ -730,11 +744,18 @@ QHostInfoLookupManager::QHostInfoLookupManager() : mutex(QMutex::Recursive), was
     moveToThread(QCoreApplicationPrivate::mainThread());
     connect(QCoreApplication::instance(), SIGNAL(destroyed()), SLOT(waitForThreadPoolDone()), Qt::DirectConnection);
     threadPool.setMaxThreadCount(20); // do up to 20 DNS lookups in parallel
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    if (QDnsResolver::isEnabledByEnvironment())
+        asyncResolver.reset(new QDnsResolver(this));
+#endif
 }
 
 QHostInfoLookupManager::~QHostInfoLookupManager()
 {
     wasDeleted = true;
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    stopAsyncResolver();
+#endif
 
     // don't qDeleteAll currentLookups, the QThreadPool has ownership
     clear();
@@ -777,6 +798,10 @@ void QHostInfoLookupManager::work()
     }
 
     auto isAlreadyRunning = [this](QHostInfoRunnable *lookup) {
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+        if (any_of(asyncLookups.cbegin(), asyncLookups.cend(), ToBeLookedUpEquals(lookup->toBeLookedUp)))
+            return true;
+#endif
         return any_of(currentLookups.cbegin(), currentLookups.cend(), ToBeLookedUpEquals(lookup->toBeLookedUp));
     };
 
@@ -796,6 +821,25 @@ void QHostInfoLookupManager::work()
                                        isAlreadyRunning).second,
                            scheduledLookups.end());
 
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    if (asyncResolver) {
+        // The asynchronous resolver does not take a thread per lookup; hand it
+        // everything it can resolve. Lookups for the same name were postponed
+        // above and are answered together when the first one finishes.
+        auto it = scheduledLookups.begin();
+        while (it != scheduledLookups.end()) {
+            QHostInfoRunnable *runnable = *it;
+            if (runnable->useAsyncResolver && QDnsResolver::canResolve(runnable->toBeLookedUp)) {
+                asyncLookups.append(runnable);
+                asyncResolver->resolve(runnable);
+                it = scheduledLookups.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+#endif
+
     const int availableThreads = threadPool.maxThreadCount() - currentLookups.size();
     if (availableThreads > 0) {
         int readyToStartCount = qMin(availableThreads, scheduledLookups.size());
@@ -867,10 +911,81 @@ void QHostInfoLookupManager::lookupFinished(QHostInfoRunnable *r)
 
     QMutexLocker locker(&this->mutex);
     currentLookups.removeOne(r);
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    asyncLookups.removeOne(r);
+#endif
     finishedLookups.append(r);
     work();
 }
 
+void QHostInfoLookupManager::waitForThreadPoolDone()
+{
+    threadPool.waitForDone();
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    stopAsyncResolver();
+#endif
+}
+
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+void QHostInfoLookupManager::setAsyncResolverEnabled(bool enabled, const QDnsResolverConfiguration &configuration)
+{
+    if (!enabled) {
+        stopAsyncResolver();
+        return;
+    }
+
+    QMutexLocker locker(&this->mutex);
+    if (!asyncResolver)
+        asyncResolver.reset(new QDnsResolver(this));
+    asyncResolver->setConfiguration(configuration);
+}
+
+void QHostInfoLookupManager::stopAsyncResolver()
+{
+    QScopedPointer<QDnsResolver> resolver;
+    {
+        QMutexLocker locker(&this->mutex);
+        resolver.swap(asyncResolver);
+    }
+    // not under the mutex: the resolver thread may be waiting for it
+    resolver.reset();
+
+    // the resolver deleted the lookups it did not finish
+    QMutexLocker locker(&this->mutex);
+    asyncLookups.clear();
+}
+
+// called from QDnsResolver
+void QHostInfoLookupManager::asyncLookupFinished(QHostInfoRunnable *r, const QHostInfo &info, int timeToLive)
+{
+    if (wasDeleted) {
+        delete r;
+        return;
+    }
+
+    if (cache.isEnabled())
+        cache.put(r->toBeLookedUp, info, timeToLive);
+    r->finishLookup(info);
+    delete r;
+}
+
+// called from QDnsResolver
+void QHostInfoLookupManager::rescheduleLookup(QHostInfoRunnable *r)
+{
+    if (wasDeleted) {
+        delete r;
+        return;
+    }
+
+    // leave it to the system resolver
+    QMutexLocker locker(&this->mutex);
+    asyncLookups.removeOne(r);
+    r->useAsyncResolver = false;
+    scheduledLookups.prepend(r);
+    work();
+}
+#endif // QT_HOSTINFO_ASYNC_RESOLVER
+
 // This function returns immediately when we had a result in the cache, else it will later emit a signal
 QHostInfo qt_qhostinfo_lookup(const QString &name, QObject *receiver, const char *member, bool *valid, int *id)
 {
@@ -918,6 +1033,15 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 
     manager->cache.put(hostname, resolution);
 }
+
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+void qt_qhostinfo_enable_async_resolver(bool e, const QDnsResolverConfiguration &configuration)
+{
+    QHostInfoLookupManager* manager = theHostInfoLookupManager();
+    if (manager)
+        manager->setAsyncResolverEnabled(e, configuration);
+}
+#endif
 #endif
 
 // cache for 60 seconds
@@ -948,7 +1072,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        if (element->age.elapsed() < element->maxAge)
             *valid = true;
         return element->info;
 
@@ -960,16 +1084,18 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
     return QHostInfo();
 }
 
-void QHostInfoCache::put(const QString &name, const QHostInfo &info)
+void QHostInfoCache::put(const QString &name, const QHostInfo &info, int timeToLive)
 {
     // if the lookup failed, don't cache
-    if (info.error() != QHostInfo::NoError)
+    if (info.error() != QHostInfo::NoError || timeToLive == 0)
         return;
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
     element->info = info;
     element->age = QElapsedTimer();
     element->age.start();
+    // honor the time to live of the DNS records, if the resolver told us
+    element->maxAge = qint64(timeToLive < 0 ? max_age : timeToLive) * 1000;
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
@@ -71,6 +71,11 @@
 #include <QNetworkSession>
 #include <QSharedPointer>
 
+#if QT_CONFIG(dnslookup) && defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID) && !defined(Q_OS_INTEGRITY)
+#  define QT_HOSTINFO_ASYNC_RESOLVER
+#  include "private/qdnsresolver_p.h"
+#endif
+
 
 QT_BEGIN_NAMESPACE
 
@@ -163,6 +168,9 @@ QHostInfo Q_NETWORK_EXPORT qt_qhostinfo_lookup(const QString &name, QObject *rec
 void Q_AUTOTEST_EXPORT qt_qhostinfo_clear_cache();
 void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_cache(bool e);
 void Q_AUTOTEST_EXPORT qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolution);
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_async_resolver(bool e, const QDnsResolverConfiguration &configuration = QDnsResolverConfiguration());
+#endif
 
 class QHostInfoCache
 {
@@ -171,7 +179,7 @@ public:
     const int max_age; // seconds
 
     QHostInfo get(const QString &name, bool *valid);
-    void put(const QString &name, const QHostInfo &info);
+    void put(const QString &name, const QHostInfo &info, int timeToLive = -1); // seconds, -1 for max_age
     void clear();
 
     bool isEnabled();
@@ -181,6 +189,7 @@ private:
     struct QHostInfoCacheElement {
         QHostInfo info;
         QElapsedTimer age;
+        qint64 maxAge; // msecs
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
@@ -195,9 +204,11 @@ public:
     QHostInfoRunnable(const QString &hn, int i, const QObject *receiver,
                       QtPrivate::QSlotObjectBase *slotObj);
     void run() override;
+    void finishLookup(QHostInfo hostInfo);
 
     QString toBeLookedUp;
     int id;
+    bool useAsyncResolver = true;
     QHostInfoResult resultEmitter;
 };
 
@@ -236,6 +247,14 @@ public:
     void lookupFinished(QHostInfoRunnable *r);
     bool wasAborted(int id);
 
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    void setAsyncResolverEnabled(bool enabled, const QDnsResolverConfiguration &configuration);
+
+    // called from QDnsResolver
+    void asyncLookupFinished(QHostInfoRunnable *r, const QHostInfo &info, int timeToLive);
+    void rescheduleLookup(QHostInfoRunnable *r);
+#endif
+
     friend class QHostInfoRunnable;
 protected:
     QList<QHostInfoRunnable*> currentLookups; // in progress
@@ -250,8 +269,15 @@ protected:
 
     bool wasDeleted;
 
+#ifdef QT_HOSTINFO_ASYNC_RESOLVER
+    QList<QHostInfoRunnable*> asyncLookups; // in progress in the asynchronous resolver
+    QScopedPointer<QDnsResolver> asyncResolver;
+
+    void stopAsyncResolver();
+#endif
+
 private slots:
-    void waitForThreadPoolDone() { threadPool.waitForDone(); }
+    void waitForThreadPoolDone();
 };
 
 QT_END_NAMESPACE
@@ -599,6 +599,7 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    pendingFiles.clear();
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -829,7 +830,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (isWriteQueueEmpty()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -847,8 +848,14 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().bufferedBytesBefore == 0)
+        return writeFileToSocket();
+
     qint64 nextSize = writeBuffer.nextDataBlockSize();
     const char *ptr = writeBuffer.readPointer();
+    // Don't write past the start of the next queued file region.
+    if (!pendingFiles.isEmpty())
+        nextSize = qMin(nextSize, pendingFiles.constFirst().bufferedBytesBefore);
 
     // Attempt to write it all in one chunk.
     qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
@@ -871,12 +878,68 @@ bool QAbstractSocketPrivate::writeToSocket()
     if (written > 0) {
         // Remove what we wrote so far.
         writeBuffer.free(written);
+        if (!pendingFiles.isEmpty())
+            pendingFiles.first().bufferedBytesBefore -= written;
 
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (isWriteQueueEmpty() && socketEngine && !socketEngine->bytesToWrite())
+        socketEngine->setWriteNotificationEnabled(false);
+    if (state == QAbstractSocket::ClosingState)
+        q->disconnectFromHost();
+
+    return written > 0;
+}
+
+/*! \internal
+
+    Sends data from the file region at the head of the pending file
+    queue. The socket engine is asked to transfer the data directly
+    from the file to the socket (e.g., with sendfile()), so it never
+    passes through the write buffer.
+
+    Emits bytesWritten().
+*/
+bool QAbstractSocketPrivate::writeFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    PendingFile &pending = pendingFiles.first();
+    if (!pending.file || !pending.file->isOpen()) {
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                        QAbstractSocket::tr("File was closed before its data was written"));
+        q->abort();
+        return false;
+    }
+
+    const qint64 written = socketEngine->writeFromFile(pending.file, pending.offset, pending.length);
+    if (written < 0) {
+#if defined (QABSTRACTSOCKET_DEBUG)
+        qDebug() << "QAbstractSocketPrivate::writeFileToSocket() write error, aborting."
+                 << socketEngine->errorString();
+#endif
+        setErrorAndEmit(socketEngine->error(), socketEngine->errorString());
+        // an unexpected error so close the socket.
+        q->abort();
+        return false;
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::writeFileToSocket() %lld bytes written to the network",
+           written);
+#endif
+
+    if (written > 0) {
+        pending.offset += written;
+        pending.length -= written;
+        if (pending.length == 0)
+            pendingFiles.removeFirst();
+
+        emitBytesWritten(written);
+    }
+
+    if (isWriteQueueEmpty() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -884,6 +947,35 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Appends a file region to the pending file queue, to be sent after the
+    data that is in the write buffer now.
+*/
+void QAbstractSocketPrivate::queueFile(QFile *file, qint64 offset, qint64 length)
+{
+    qint64 bufferedBytesBefore = writeBuffer.size();
+    for (const PendingFile &pending : qAsConst(pendingFiles))
+        bufferedBytesBefore -= pending.bufferedBytesBefore;
+    pendingFiles.append({ file, offset, length, bufferedBytesBefore });
+
+    if (socketEngine)
+        socketEngine->setWriteNotificationEnabled(true);
+}
+
+/*! \internal
+
+    Returns the number of bytes of queued file regions that have not been
+    written to the socket yet.
+*/
+qint64 QAbstractSocketPrivate::pendingFileBytes() const
+{
+    qint64 total = 0;
+    for (const PendingFile &pending : pendingFiles)
+        total += pending.length;
+    return total;
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -894,7 +986,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || !pendingFiles.isEmpty()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1687,6 +1779,7 @@ void QAbstractSocket::connectToHost(const QString &hostName, quint16 port,
     d->port = port;
     d->setReadChannelCount(0);
     d->setWriteChannelCount(0);
+    d->pendingFiles.clear();
     d->abortCalled = false;
     d->pendingClose = false;
     if (d->state != BoundState) {
@@ -1790,7 +1883,8 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    const qint64 pendingBytes = QIODevice::bytesToWrite() + d->pendingFileBytes();
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -1935,6 +2029,7 @@ bool QAbstractSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState
     d->resetSocketLayer();
     d->setReadChannelCount(0);
     d->setWriteChannelCount(0);
+    d->pendingFiles.clear();
     d->socketEngine = QAbstractSocketEngine::createSocketEngine(socketDescriptor, this);
     if (!d->socketEngine) {
         d->setError(UnsupportedSocketOperationError, tr("Operation on socket is not supported"));
@@ -2253,7 +2348,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->isWriteQueueEmpty(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2305,7 +2400,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (d->isWriteQueueEmpty())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2322,7 +2417,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  !d->isWriteQueueEmpty(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2401,7 +2496,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               !d->isWriteQueueEmpty(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2438,6 +2533,7 @@ void QAbstractSocket::abort()
     qDebug("QAbstractSocket::abort()");
 #endif
     d->setWriteChannelCount(0);
+    d->pendingFiles.clear();
     if (d->state == UnconnectedState)
         return;
 #ifndef QT_NO_SSL
@@ -2494,6 +2590,66 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 5.12
+
+    Queues \a length bytes of \a file, starting at \a offset, to be written
+    to the socket after any data already pending in the write buffer. If
+    \a length is -1, everything from \a offset to the end of the file is
+    queued. Returns the number of bytes queued, or -1 if an error occurred.
+
+    Where the platform supports it, the data is transferred from the file to
+    the socket by the kernel (e.g., using sendfile() on Linux) without being
+    copied into the write buffer. Otherwise, including for QSslSocket and
+    sockets connected through a proxy, the data is read from the file in
+    chunks as the previous ones are sent. In either case, bytesWritten() is
+    emitted as the data is sent and bytesToWrite() includes the queued file
+    data.
+
+    The file must be open for reading, and it must remain open and unmodified
+    until all of its data has been written. Only TCP sockets are supported.
+
+    \sa write(), bytesToWrite(), bytesWritten()
+*/
+qint64 QAbstractSocket::writeFromFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (!isWritable()) {
+        qWarning("QAbstractSocket::writeFromFile: device not open for writing");
+        return -1;
+    }
+    if (!file || !file->isReadable()) {
+        qWarning("QAbstractSocket::writeFromFile: file not open for reading");
+        return -1;
+    }
+    if (d->socketType != TcpSocket) {
+        d->setErrorAndEmit(UnsupportedSocketOperationError,
+                           tr("Operation on socket is not supported"));
+        return -1;
+    }
+    if (d->state == UnconnectedState) {
+        d->setError(UnknownSocketError, tr("Socket is not connected"));
+        return -1;
+    }
+
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        qWarning("QAbstractSocket::writeFromFile: offset out of range");
+        return -1;
+    }
+    if (length < 0 || length > fileSize - offset)
+        length = fileSize - offset;
+    if (length == 0)
+        return 0;
+
+    d->queueFile(file, offset, length);
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocket::writeFromFile(%p, %lld, %lld) queued", file, offset, length);
+#endif
+    return length;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2547,7 +2703,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && d->isWriteQueueEmpty()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2590,7 +2746,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     d->writeBuffer.append(data, size);
     qint64 written = size;
 
-    if (d->socketEngine && !d->writeBuffer.isEmpty())
+    if (d->socketEngine && !d->isWriteQueueEmpty())
         d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined (QABSTRACTSOCKET_DEBUG)
@@ -2778,7 +2934,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || !d->pendingFiles.isEmpty() || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
@@ -2808,6 +2964,7 @@ void QAbstractSocket::disconnectFromHost()
     d->peerAddress.clear();
     d->peerName.clear();
     d->setWriteChannelCount(0);
+    d->pendingFiles.clear();
 
 #if defined(QABSTRACTSOCKET_DEBUG)
         qDebug("QAbstractSocket::disconnectFromHost() disconnected!");
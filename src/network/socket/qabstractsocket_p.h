@@ -54,7 +54,9 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
+#include "QtCore/qfile.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
@@ -139,9 +141,23 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    bool writeFileToSocket();
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
+    // file regions queued with writeFromFile(), interleaved with the write buffer
+    struct PendingFile {
+        QPointer<QFile> file;
+        qint64 offset;
+        qint64 length;
+        qint64 bufferedBytesBefore; // bytes of the write buffer to send first
+    };
+    QList<PendingFile> pendingFiles;
+    virtual void queueFile(QFile *file, qint64 offset, qint64 length);
+    qint64 pendingFileBytes() const;
+    inline bool isWriteQueueEmpty() const
+    { return writeBuffer.isEmpty() && pendingFiles.isEmpty(); }
+
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
@@ -45,6 +45,7 @@
 #include "qnativesocketengine_winrt_p.h"
 #endif
 
+#include "qfile.h"
 #include "qmutex.h"
 #include "qnetworkproxy.h"
 
@@ -273,4 +274,93 @@ int QAbstractSocketEngine::outboundStreamCount() const
     return d_func()->outboundStreamCount;
 }
 
+/*!
+    \internal
+
+    Writes up to \a maxSize bytes of \a file, starting at \a offset, to
+    the socket and returns the number of bytes written, or -1 if an error
+    occurred.
+
+    Socket engines that can transfer data from a file to the socket without
+    copying it reimplement this function; this implementation reads a chunk
+    of the file and passes it to write().
+*/
+qint64 QAbstractSocketEngine::writeFromFile(QFile *file, qint64 offset, qint64 maxSize)
+{
+    char buffer[32768];
+    if (!file->seek(offset)) {
+        setError(QAbstractSocket::UnknownSocketError, file->errorString());
+        return -1;
+    }
+    const qint64 readBytes = file->read(buffer, qMin(maxSize, qint64(sizeof buffer)));
+    if (readBytes <= 0) {
+        setError(QAbstractSocket::UnknownSocketError,
+                 readBytes < 0 ? file->errorString()
+                               : QAbstractSocket::tr("Unexpected end of file"));
+        return -1;
+    }
+    return write(buffer, readBytes);
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    \internal
+
+    Reads up to \a count datagrams into \a datagrams, each of them at most
+    \a maxlen bytes long (or as long as the pending datagram, if \a maxlen is
+    -1). The header fields requested by \a options are stored in the
+    datagrams' headers.
+
+    Returns the number of datagrams read. If no datagram could be read,
+    returns -2 if none was pending and -1 if an error occurred.
+
+    Socket engines that can receive several datagrams with one system call
+    reimplement this function; this implementation calls readDatagram()
+    repeatedly.
+*/
+int QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                                         qint64 maxlen, PacketHeaderOptions options)
+{
+    for (int i = 0; i < count; ++i) {
+        QNetworkDatagramPrivate *datagram = datagrams[i];
+        qint64 size = maxlen < 0 ? pendingDatagramSize() : maxlen;
+        qint64 readBytes = -2; // no datagram pending
+        if (size >= 0) {
+            datagram->data.resize(size);
+            readBytes = readDatagram(datagram->data.data(), size, &datagram->header, options);
+        }
+        if (readBytes < 0) {
+            datagram->data.clear();
+            return i ? i : int(readBytes);
+        }
+        datagram->data.truncate(readBytes);
+    }
+    return count;
+}
+
+/*!
+    \internal
+
+    Writes the \a count datagrams in \a datagrams to the destinations
+    contained in their headers and returns the number of datagrams sent.
+    If not even the first datagram could be sent, returns -2 if the
+    operation would block and -1 if an error occurred.
+
+    Socket engines that can send several datagrams with one system call
+    reimplement this function; this implementation calls writeDatagram()
+    repeatedly.
+*/
+int QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate * const *datagrams, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams[i];
+        qint64 sent = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                    datagram->header);
+        if (sent < 0)
+            return i ? i : int(sent);
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
 QT_END_NAMESPACE
@@ -62,6 +62,7 @@ QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
 class QAbstractSocketEnginePrivate;
+class QFile;
 #ifndef QT_NO_NETWORKINTERFACE
 class QNetworkInterface;
 #endif
@@ -140,6 +141,7 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeFromFile(QFile *file, qint64 offset, qint64 maxSize);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -158,6 +160,11 @@ public:
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = 0,
                                 PacketHeaderOptions = WantNone) = 0;
     virtual qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &header) = 0;
+#ifndef QT_NO_UDPSOCKET
+    virtual int readDatagrams(QNetworkDatagramPrivate **datagrams, int count, qint64 maxlen,
+                              PacketHeaderOptions options = WantNone);
+    virtual int writeDatagrams(const QNetworkDatagramPrivate * const *datagrams, int count);
+#endif
     virtual qint64 bytesToWrite() const = 0;
 
     virtual int option(SocketOption option) const = 0;
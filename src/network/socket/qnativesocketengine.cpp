@@ -116,6 +116,7 @@
 
 #include "qnativesocketengine_p.h"
 
+#include <qfile.h>
 #include <qabstracteventdispatcher.h>
 #include <qsocketnotifier.h>
 #include <qnetworkinterface.h>
@@ -902,6 +903,51 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#if QT_CONFIG(sendmmsg)
+/*!
+    Reads up to \a count datagrams from the socket into \a datagrams,
+    using as few system calls as possible. Each datagram is at most
+    \a maxSize bytes long; if \a maxSize is -1, datagrams of any size are
+    received. The header fields requested by \a options are stored in the
+    datagrams' headers.
+
+    Returns the number of datagrams read, -2 if no datagram was pending,
+    or -1 if an error occurred.
+
+    \sa readDatagram()
+*/
+int QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate **datagrams, int count,
+                                       qint64 maxSize, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams to the destinations
+    contained in their headers, using as few system calls as possible.
+
+    Returns the number of datagrams sent. If not even the first datagram
+    could be sent, returns -2 if the operation would block or -1 if an
+    error occurred.
+
+    \sa writeDatagram()
+*/
+int QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate * const *datagrams, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeSendDatagrams(datagrams, count);
+}
+#endif // QT_CONFIG(sendmmsg)
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -918,6 +964,28 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+#ifdef Q_OS_LINUX
+/*!
+    Writes up to \a maxSize bytes of \a file, starting at \a offset, to
+    the socket without copying them to user space, if the file has a native
+    handle. Returns the number of bytes written, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeFromFile(QFile *file, qint64 offset, qint64 maxSize)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeFromFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeFromFile(), QAbstractSocket::ConnectedState, -1);
+    const int fd = file->handle();
+    if (fd != -1) {
+        const qint64 written = d->nativeSendFile(fd, offset, maxSize);
+        if (written != -2)
+            return written;
+    }
+    // not a regular file, or sendfile() is not supported for it
+    return QAbstractSocketEngine::writeFromFile(file, offset, maxSize);
+}
+#endif
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
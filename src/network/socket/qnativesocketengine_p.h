@@ -146,6 +146,9 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+#ifdef Q_OS_LINUX
+    qint64 writeFromFile(QFile *file, qint64 offset, qint64 maxSize) override;
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -164,6 +167,11 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = 0,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#if QT_CONFIG(sendmmsg)
+    int readDatagrams(QNetworkDatagramPrivate **datagrams, int count, qint64 maxlen,
+                      PacketHeaderOptions = WantNone) override;
+    int writeDatagrams(const QNetworkDatagramPrivate * const *datagrams, int count) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
@@ -277,8 +285,17 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(sendmmsg)
+    int nativeReceiveDatagrams(QNetworkDatagramPrivate **datagrams, int count, qint64 maxLength,
+                               QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(const QNetworkDatagramPrivate * const *datagrams, int count);
+    QByteArray receiveBuffer;
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(int fd, qint64 offset, qint64 length);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -430,6 +431,63 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 5.12
+
+    Sends the datagrams in \a datagrams, each to the host address and port
+    number contained in it and using the network interface and hop count
+    limit set there, like writeDatagram() does. Returns the number of
+    datagrams sent, which may be less than the number of datagrams in
+    \a datagrams if the socket's send buffer is full, or -1 if not even the
+    first datagram could be sent.
+
+    Where the operating system supports it (for example, sendmmsg() on
+    Linux), the datagrams are sent with as few system calls as possible.
+    The bytesWritten() signal is emitted once, with the total size of the
+    datagrams sent.
+
+    \warning Calling this function on a connected UDP socket may
+    result in an error and no packet being sent. If you are using a
+    connected socket, use write() to send datagrams.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+int QUdpSocket::writeDatagrams(const QVector<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%d)", datagrams.size());
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.constFirst().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> privates(datagrams.size());
+    for (int i = 0; i < datagrams.size(); ++i)
+        privates[i] = datagrams.at(i).d;
+
+    int sent = d->socketEngine->writeDatagrams(privates.constData(), privates.size());
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent > 0) {
+        qint64 bytes = 0;
+        for (int i = 0; i < sent; ++i)
+            bytes += privates.at(i)->data.size();
+        emit bytesWritten(bytes);
+    } else if (sent == -2) {
+        // Socket engine reports EAGAIN. Treat as a temporary error.
+        d->setErrorAndEmit(QAbstractSocket::TemporaryError,
+                           tr("Unable to send a datagram"));
+        return -1;
+    } else if (sent < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and returns it in the
     QNetworkDatagram object, along with the sender's host address and port. If
@@ -473,6 +531,62 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 5.12
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them in the order they arrived. Like
+    receiveDatagram(), this function also tries to determine each
+    datagram's sender, destination address and port, and hop count.
+
+    Returns an empty vector if no datagram is pending or an error occurred.
+
+    Where the operating system supports it (for example, recvmmsg() on
+    Linux), the datagrams are received with as few system calls as
+    possible, which makes this function considerably more efficient than
+    calling receiveDatagram() in a loop when datagrams arrive at a high
+    rate. If \a maxSize is -1 (the default), room is reserved for the
+    largest possible datagram; passing the largest size the application
+    expects allows more datagrams to be received with each system call.
+
+    If \a maxSize is too small, the rest of the datagram will be lost. If \a
+    maxSize is 0, the datagrams will be discarded.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QVector<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QVector<QNetworkDatagram>());
+
+    QVector<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+
+    result.resize(maxCount);
+    QVarLengthArray<QNetworkDatagramPrivate *, 64> privates(maxCount);
+    for (int i = 0; i < maxCount; ++i)
+        privates[i] = result[i].d;
+
+    int count = d->socketEngine->readDatagrams(privates.data(), maxCount, maxSize,
+                                               QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (count < 0) {
+        // -2 means that no datagram was pending, which is not an error
+        if (count == -1)
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        count = 0;
+    }
+
+    result.resize(count);
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
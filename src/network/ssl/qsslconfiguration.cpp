@@ -225,6 +225,7 @@ bool QSslConfiguration::operator==(const QSslConfiguration &other) const
         d->sslOptions == other.d->sslOptions &&
         d->sslSession == other.d->sslSession &&
         d->sslSessionTicketLifeTimeHint == other.d->sslSessionTicketLifeTimeHint &&
+        d->sessionCache == other.d->sessionCache &&
         d->nextAllowedProtocols == other.d->nextAllowedProtocols &&
         d->nextNegotiatedProtocol == other.d->nextNegotiatedProtocol &&
         d->nextProtocolNegotiationStatus == other.d->nextProtocolNegotiationStatus;
@@ -268,6 +269,7 @@ bool QSslConfiguration::isNull() const
             d->sslOptions == QSslConfigurationPrivate::defaultSslOptions &&
             d->sslSession.isNull() &&
             d->sslSessionTicketLifeTimeHint == -1 &&
+            d->sessionCache == nullptr &&
             d->preSharedKeyIdentityHint.isNull() &&
             d->nextAllowedProtocols.isEmpty() &&
             d->nextNegotiatedProtocol.isNull() &&
@@ -743,6 +745,39 @@ int QSslConfiguration::sessionTicketLifeTimeHint() const
     return d->sslSessionTicketLifeTimeHint;
 }
 
+/*!
+   \since 5.12
+
+   Returns the session cache shared by sockets using this configuration,
+   or \c nullptr if none was set (the default).
+
+   \sa setSessionCache()
+ */
+QSslSessionCache *QSslConfiguration::sessionCache() const
+{
+    return d->sessionCache;
+}
+
+/*!
+   \since 5.12
+
+   Sets the session cache shared by sockets using this configuration to
+   \a cache. Client sockets offer a session from the cache when connecting
+   to a peer they have connected to before, and store the session of every
+   successful handshake in it. Server sockets keep the sessions they create
+   in the cache and share their session ticket keys through it.
+
+   The cache is not owned by the configuration and must outlive every
+   socket using it. Passing \c nullptr disables the shared cache. Setting
+   QSsl::SslOptionDisableSessionSharing also disables it.
+
+   \sa sessionCache(), QSslSessionCache::globalInstance()
+ */
+void QSslConfiguration::setSessionCache(QSslSessionCache *cache)
+{
+    d->sessionCache = cache;
+}
+
 /*!
    \since 5.7
 
@@ -72,6 +72,7 @@ class QSslCipher;
 class QSslKey;
 class QSslEllipticCurve;
 class QSslDiffieHellmanParameters;
+class QSslSessionCache;
 
 class QSslConfigurationPrivate;
 class Q_NETWORK_EXPORT QSslConfiguration
@@ -137,6 +138,9 @@ public:
     void setSessionTicket(const QByteArray &sessionTicket);
     int sessionTicketLifeTimeHint() const;
 
+    QSslSessionCache *sessionCache() const;
+    void setSessionCache(QSslSessionCache *cache);
+
     QSslKey ephemeralServerKey() const;
 
     // EC settings
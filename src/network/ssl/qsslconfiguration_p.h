@@ -92,6 +92,7 @@ public:
           sslOptions(QSslConfigurationPrivate::defaultSslOptions),
           dhParams(QSslDiffieHellmanParameters::defaultParameters()),
           sslSessionTicketLifeTimeHint(-1),
+          sessionCache(nullptr),
           ephemeralServerKey(),
           preSharedKeyIdentityHint(),
           nextProtocolNegotiationStatus(QSslConfiguration::NextProtocolNegotiationNone)
@@ -128,6 +129,7 @@ public:
 
     QByteArray sslSession;
     int sslSessionTicketLifeTimeHint;
+    QSslSessionCache *sessionCache;
 
     QSslKey ephemeralServerKey;
 
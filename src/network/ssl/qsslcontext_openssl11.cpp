@@ -50,6 +50,7 @@
 #include "private/qsslsocket_openssl_p.h"
 #include "private/qsslsocket_openssl_symbols_p.h"
 #include "private/qssldiffiehellmanparameters_p.h"
+#include "private/qsslsessioncache_p.h"
 
 #include <vector>
 
@@ -64,6 +65,89 @@ static inline QString msgErrorSettingEllipticCurves(const QString &why)
     return QSslSocket::tr("Error when setting the elliptic curves (%1)").arg(why);
 }
 
+static inline QSslSocketBackendPrivate *socketFromSsl(SSL *ssl)
+{
+    return reinterpret_cast<QSslSocketBackendPrivate *>(q_SSL_get_ex_data(ssl, QSslSocketBackendPrivate::s_indexForSSLExtraData));
+}
+
+static QByteArray serverSessionCacheKey(const unsigned char *id, int length)
+{
+    return QByteArrayLiteral("server:") + QByteArray(reinterpret_cast<const char *>(id), length).toHex();
+}
+
+extern "C" {
+
+static int q_ssl_new_session_callback(SSL *ssl, SSL_SESSION *session)
+{
+    QSslSocketBackendPrivate *d = socketFromSsl(ssl);
+    if (!d || !d->configuration.sessionCache)
+        return 0;
+
+    if (d->mode == QSslSocket::SslClientMode) {
+        // With TLS 1.3 the session ticket arrives after the handshake,
+        // so this is the only place where a client sees a resumable session.
+        d->storeSessionInCache(session);
+        return 0;
+    }
+
+    const int length = q_i2d_SSL_SESSION(session, nullptr);
+    if (length <= 0)
+        return 0;
+    QByteArray asn1(length, Qt::Uninitialized);
+    unsigned char *data = reinterpret_cast<unsigned char *>(asn1.data());
+    if (q_i2d_SSL_SESSION(session, &data) != length)
+        return 0;
+
+    unsigned int idLength = 0;
+    const unsigned char *id = q_SSL_SESSION_get_id(session, &idLength);
+    d->configuration.sessionCache->insert(serverSessionCacheKey(id, int(idLength)), asn1,
+                                          int(q_SSL_SESSION_get_timeout(session)));
+    return 0; // we did not keep a reference to the session
+}
+
+static SSL_SESSION *q_ssl_get_session_callback(SSL *ssl, const unsigned char *id, int length, int *copy)
+{
+    *copy = 0;
+    QSslSocketBackendPrivate *d = socketFromSsl(ssl);
+    if (!d || !d->configuration.sessionCache)
+        return nullptr;
+
+    const QByteArray asn1 = QSslSessionCachePrivate::lookup(d->configuration.sessionCache,
+                                                           serverSessionCacheKey(id, length));
+    if (asn1.isEmpty())
+        return nullptr;
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(asn1.constData());
+    return q_d2i_SSL_SESSION(nullptr, &data, asn1.size()); // OpenSSL takes the reference
+}
+
+} // extern "C"
+
+static void initSessionCache(SSL_CTX *ctx, QSslSessionCache *cache, bool client)
+{
+    q_SSL_CTX_sess_set_new_cb(ctx, q_ssl_new_session_callback);
+    if (client) {
+        q_SSL_CTX_ctrl(ctx, SSL_CTRL_SET_SESS_CACHE_MODE,
+                       SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE, nullptr);
+        return;
+    }
+
+    QSslSessionCachePrivate *d = QSslSessionCachePrivate::get(cache);
+    q_SSL_CTX_ctrl(ctx, SSL_CTRL_SET_SESS_CACHE_MODE,
+                   SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL, nullptr);
+    q_SSL_CTX_sess_set_get_cb(ctx, q_ssl_get_session_callback);
+    q_SSL_CTX_set_session_id_context(ctx,
+                                     reinterpret_cast<const unsigned char *>(d->sessionIdContext.constData()),
+                                     uint(d->sessionIdContext.size()));
+
+    // Every socket has a context of its own; give them all the same ticket
+    // keys so that a ticket issued by one of them is accepted by the others.
+    const long keyLength = q_SSL_CTX_ctrl(ctx, SSL_CTRL_GET_TLSEXT_TICKET_KEYS, 0, nullptr);
+    if (keyLength > 0 && keyLength <= d->ticketKeys.size()) {
+        if (!q_SSL_CTX_ctrl(ctx, SSL_CTRL_SET_TLSEXT_TICKET_KEYS, keyLength, d->ticketKeys.data()))
+            qCWarning(lcSsl, "could not set the session ticket keys of the session cache");
+    }
+}
+
 // static
 void QSslContext::initSslContext(QSslContext *sslContext, QSslSocket::SslMode mode, const QSslConfiguration &configuration, bool allowRootCertOnDemandLoading)
 {
@@ -293,6 +377,12 @@ init_context:
     if (!configuration.sessionTicket().isEmpty())
         sslContext->setSessionASN1(configuration.sessionTicket());
 
+    // share sessions with other sockets if the user set a session cache
+    if (configuration.d->sessionCache
+        && !(configuration.d->sslOptions & QSsl::SslOptionDisableSessionSharing)) {
+        initSessionCache(sslContext->ctx, configuration.d->sessionCache, client);
+    }
+
     // Set temp DH params
     QSslDiffieHellmanParameters dhparams = configuration.diffieHellmanParameters();
 
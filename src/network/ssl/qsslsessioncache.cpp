@@ -0,0 +1,356 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsslsessioncache.h"
+#include "qsslsessioncache_p.h"
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSslSessionCache
+    \brief The QSslSessionCache class stores TLS sessions so that they can
+    be resumed by other QSslSocket instances.
+    \since 5.12
+
+    \reentrant
+    \ingroup network
+    \ingroup ssl
+    \inmodule QtNetwork
+
+    A full TLS handshake costs two network round trips and an expensive
+    key exchange. When a client reconnects to a server it has talked to
+    before, both sides can instead resume the previous session, either
+    from a server-side session cache or from a session ticket the server
+    handed out earlier.
+
+    By default every QSslSocket keeps the session of its last handshake to
+    itself (see QSslConfiguration::sessionTicket()). Installing a
+    QSslSessionCache with QSslConfiguration::setSessionCache() makes the
+    sessions available to all sockets sharing that configuration:
+
+    \list
+    \li Client sockets store the session of every successful handshake
+        under the peer's host name and port, and offer it the next time a
+        socket connects to the same peer.
+    \li Server sockets store the sessions they create and look them up when
+        a client asks to resume one. All server sockets sharing a cache
+        also encrypt their session tickets with the same keys, so a ticket
+        issued by one socket is accepted by any other.
+    \endlist
+
+    The cache holds at most maximumSize() sessions and evicts the least
+    recently used one when full. Sessions also expire when the lifetime
+    given by the TLS backend has passed. hitCount() and missCount() report
+    how often a lookup found a session.
+
+    The contents of a client cache can be written to disk with save() and
+    read back with load(), so that sessions survive a restart of the
+    application. The file contains session secrets and is created readable
+    by its owner only.
+
+    QSslSessionCache is thread-safe. Subclasses may reimplement find(),
+    insert(), remove() and clear() to share sessions with an external store.
+
+    \note Server-side caching requires OpenSSL 1.1 or later.
+
+    \sa QSslConfiguration::setSessionCache(), QSsl::SslOptionDisableSessionSharing
+*/
+
+static const quint32 sessionCacheMagic = 0x51534331; // "QSC1"
+static const quint16 sessionCacheVersion = 1;
+
+Q_GLOBAL_STATIC(QSslSessionCache, globalSessionCache)
+
+QSslSessionCachePrivate::QSslSessionCachePrivate(int maximumSize)
+    : entries(maximumSize),
+      hits(0),
+      misses(0)
+{
+    ticketKeys.resize(80);
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(ticketKeys.data()),
+                                          ticketKeys.size() / int(sizeof(quint32)));
+    sessionIdContext.resize(16);
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(sessionIdContext.data()),
+                                          sessionIdContext.size() / int(sizeof(quint32)));
+}
+
+QByteArray QSslSessionCachePrivate::lookup(QSslSessionCache *cache, const QByteArray &key)
+{
+    const QByteArray session = cache->find(key);
+    if (session.isEmpty())
+        cache->d_func()->misses.fetchAndAddRelaxed(1);
+    else
+        cache->d_func()->hits.fetchAndAddRelaxed(1);
+    return session;
+}
+
+/*!
+    Constructs a session cache holding at most \a maximumSize sessions.
+*/
+QSslSessionCache::QSslSessionCache(int maximumSize)
+    : d_ptr(new QSslSessionCachePrivate(qMax(1, maximumSize)))
+{
+}
+
+/*!
+    Destroys the session cache. Sockets that still refer to it through
+    their QSslConfiguration must not be used afterwards.
+*/
+QSslSessionCache::~QSslSessionCache()
+{
+}
+
+/*!
+    Returns an application-wide session cache, or \c nullptr if it has
+    already been destroyed.
+*/
+QSslSessionCache *QSslSessionCache::globalInstance()
+{
+    return globalSessionCache();
+}
+
+/*!
+    Sets the maximum number of sessions kept to \a size, evicting the least
+    recently used sessions if there are more.
+
+    \sa maximumSize()
+*/
+void QSslSessionCache::setMaximumSize(int size)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->entries.setMaxCost(qMax(1, size));
+}
+
+/*!
+    Returns the maximum number of sessions kept. The default is 1024.
+
+    \sa setMaximumSize()
+*/
+int QSslSessionCache::maximumSize() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->entries.maxCost();
+}
+
+/*!
+    Returns the number of sessions currently stored, including ones that
+    have expired but were not looked up since.
+*/
+int QSslSessionCache::size() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->entries.size();
+}
+
+/*!
+    Returns the serialized session stored under \a key, or an empty byte
+    array if there is none or it has expired.
+*/
+QByteArray QSslSessionCache::find(const QByteArray &key)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    // QCache::object() moves the entry to the front of the LRU list
+    QSslSessionCachePrivate::Entry *entry = d->entries.object(key);
+    if (!entry)
+        return QByteArray();
+    if (entry->expiry <= QDateTime::currentMSecsSinceEpoch()) {
+        d->entries.remove(key);
+        return QByteArray();
+    }
+    return entry->session;
+}
+
+/*!
+    Stores \a session under \a key for \a lifetime seconds, replacing any
+    session previously stored under that key.
+*/
+void QSslSessionCache::insert(const QByteArray &key, const QByteArray &session, int lifetime)
+{
+    if (session.isEmpty() || lifetime <= 0)
+        return;
+    Q_D(QSslSessionCache);
+    QSslSessionCachePrivate::Entry *entry = new QSslSessionCachePrivate::Entry;
+    entry->session = session;
+    entry->expiry = QDateTime::currentMSecsSinceEpoch() + qint64(lifetime) * 1000;
+    QMutexLocker locker(&d->mutex);
+    d->entries.insert(key, entry);
+}
+
+/*!
+    Removes the session stored under \a key.
+*/
+void QSslSessionCache::remove(const QByteArray &key)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->entries.remove(key);
+}
+
+/*!
+    Removes all sessions from the cache.
+*/
+void QSslSessionCache::clear()
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->entries.clear();
+}
+
+/*!
+    Returns the number of lookups made by sockets that found a session.
+
+    \sa missCount(), resetCounters()
+*/
+qint64 QSslSessionCache::hitCount() const
+{
+    Q_D(const QSslSessionCache);
+    return d->hits.load();
+}
+
+/*!
+    Returns the number of lookups made by sockets that found no session.
+
+    \sa hitCount(), resetCounters()
+*/
+qint64 QSslSessionCache::missCount() const
+{
+    Q_D(const QSslSessionCache);
+    return d->misses.load();
+}
+
+/*!
+    Resets hitCount() and missCount() to zero.
+*/
+void QSslSessionCache::resetCounters()
+{
+    Q_D(QSslSessionCache);
+    d->hits.store(0);
+    d->misses.store(0);
+}
+
+/*!
+    Writes the sessions that have not expired yet to \a fileName. Returns
+    \c true on success.
+
+    The ticket keys used by server sockets are not saved; tickets issued
+    before a restart are therefore not accepted afterwards.
+
+    \sa load()
+*/
+bool QSslSessionCache::save(const QString &fileName) const
+{
+    Q_D(const QSslSessionCache);
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << sessionCacheMagic << sessionCacheVersion;
+    {
+        QMutexLocker locker(&d->mutex);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        const QList<QByteArray> keys = d->entries.keys();
+        quint32 count = 0;
+        for (const QByteArray &key : keys) {
+            if (d->entries[key]->expiry > now)
+                ++count;
+        }
+        out << count;
+        for (const QByteArray &key : keys) {
+            const QSslSessionCachePrivate::Entry *entry = d->entries[key];
+            if (entry->expiry > now)
+                out << key << entry->session << entry->expiry;
+        }
+    }
+    if (out.status() != QDataStream::Ok)
+        return false;
+    return file.commit();
+}
+
+/*!
+    Adds the sessions saved in \a fileName by save() to the cache, skipping
+    those that have expired in the meantime. Returns \c true on success.
+
+    \sa save()
+*/
+bool QSslSessionCache::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_11);
+    quint32 magic;
+    quint16 version;
+    quint32 count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != sessionCacheMagic
+        || version != sessionCacheVersion) {
+        return false;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (quint32 i = 0; i < count; ++i) {
+        QByteArray key;
+        QByteArray session;
+        qint64 expiry;
+        in >> key >> session >> expiry;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        if (expiry > now)
+            insert(key, session, int(qMin<qint64>((expiry - now) / 1000 + 1, INT_MAX)));
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
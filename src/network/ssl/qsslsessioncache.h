@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSSLSESSIONCACHE_H
+#define QSSLSESSIONCACHE_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qscopedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+#ifndef QT_NO_SSL
+
+class QString;
+class QSslSessionCachePrivate;
+class Q_NETWORK_EXPORT QSslSessionCache
+{
+public:
+    explicit QSslSessionCache(int maximumSize = 1024);
+    virtual ~QSslSessionCache();
+
+    static QSslSessionCache *globalInstance();
+
+    void setMaximumSize(int size);
+    int maximumSize() const;
+    int size() const;
+
+    virtual QByteArray find(const QByteArray &key);
+    virtual void insert(const QByteArray &key, const QByteArray &session, int lifetime);
+    virtual void remove(const QByteArray &key);
+    virtual void clear();
+
+    qint64 hitCount() const;
+    qint64 missCount() const;
+    void resetCounters();
+
+    bool save(const QString &fileName) const;
+    bool load(const QString &fileName);
+
+private:
+    Q_DISABLE_COPY(QSslSessionCache)
+    Q_DECLARE_PRIVATE(QSslSessionCache)
+    QScopedPointer<QSslSessionCachePrivate> d_ptr;
+};
+
+#endif // QT_NO_SSL
+
+QT_END_NAMESPACE
+
+#endif // QSSLSESSIONCACHE_H
@@ -325,12 +325,17 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qhostinfo.h>
 
+#ifndef QSSLSOCKET_FILECHUNKSIZE
+#define QSSLSOCKET_FILECHUNKSIZE 32768
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QSslSocketGlobalData
@@ -742,9 +747,10 @@ qint64 QSslSocket::bytesAvailable() const
 qint64 QSslSocket::bytesToWrite() const
 {
     Q_D(const QSslSocket);
+    const qint64 queuedBytes = d->heldWriteBuffer.size() + d->pendingFileBytes();
     if (d->mode == UnencryptedMode)
-        return d->plainSocket ? d->plainSocket->bytesToWrite() : 0;
-    return d->writeBuffer.size();
+        return (d->plainSocket ? d->plainSocket->bytesToWrite() : 0) + queuedBytes;
+    return d->writeBuffer.size() + queuedBytes;
 }
 
 /*!
@@ -808,6 +814,7 @@ void QSslSocket::close()
     // must be cleared, reading/writing not possible on closed socket:
     d->buffer.clear();
     d->writeBuffer.clear();
+    d->heldWriteBuffer.clear();
 }
 
 /*!
@@ -926,6 +933,7 @@ void QSslSocket::setSslConfiguration(const QSslConfiguration &configuration)
     d->configuration.sslOptions = configuration.d->sslOptions;
     d->configuration.sslSession = configuration.sessionTicket();
     d->configuration.sslSessionTicketLifeTimeHint = configuration.sessionTicketLifeTimeHint();
+    d->configuration.sessionCache = configuration.sessionCache();
     d->configuration.nextAllowedProtocols = configuration.allowedNextProtocols();
     d->configuration.nextNegotiatedProtocol = configuration.nextNegotiatedProtocol();
     d->configuration.nextProtocolNegotiationStatus = configuration.nextProtocolNegotiationStatus();
@@ -1961,7 +1969,7 @@ void QSslSocket::disconnectFromHost()
         return;
     if (d->state == UnconnectedState)
         return;
-    if (d->mode == UnencryptedMode && !d->autoStartHandshake) {
+    if (d->mode == UnencryptedMode && !d->autoStartHandshake && d->pendingFiles.isEmpty()) {
         d->plainSocket->disconnectFromHost();
         return;
     }
@@ -1976,7 +1984,7 @@ void QSslSocket::disconnectFromHost()
         emit stateChanged(d->state);
     }
 
-    if (!d->writeBuffer.isEmpty()) {
+    if (!d->writeBuffer.isEmpty() || !d->pendingFiles.isEmpty()) {
         d->pendingClose = true;
         return;
     }
@@ -2022,20 +2030,118 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
 #ifdef QSSLSOCKET_DEBUG
     qCDebug(lcSsl) << "QSslSocket::writeData(" << (void *)data << ',' << len << ')';
 #endif
-    if (d->mode == UnencryptedMode && !d->autoStartHandshake)
-        return d->plainSocket->write(data, len);
+    if (!d->pendingFiles.isEmpty()) {
+        // keep the order with the data of the files queued before
+        d->heldWriteBuffer.append(data, len);
+        return len;
+    }
 
-    d->writeBuffer.append(data, len);
+    return d->writePlainData(data, len);
+}
+
+/*!
+    \internal
+
+    Passes \a len bytes of plain text to the encryption layer, or directly to
+    the plain socket if the connection is not encrypted.
+*/
+qint64 QSslSocketPrivate::writePlainData(const char *data, qint64 len)
+{
+    Q_Q(QSslSocket);
+    if (mode == QSslSocket::UnencryptedMode && !autoStartHandshake)
+        return plainSocket->write(data, len);
+
+    writeBuffer.append(data, len);
 
     // make sure we flush to the plain socket's buffer
-    if (!d->flushTriggered) {
-        d->flushTriggered = true;
-        QMetaObject::invokeMethod(this, "_q_flushWriteBuffer", Qt::QueuedConnection);
+    if (!flushTriggered) {
+        flushTriggered = true;
+        QMetaObject::invokeMethod(q, "_q_flushWriteBuffer", Qt::QueuedConnection);
     }
 
     return len;
 }
 
+/*!
+    \internal
+
+    Appends a file region to the pending file queue, after everything that
+    was written so far, and starts feeding it to the encryption layer.
+*/
+void QSslSocketPrivate::queueFile(QFile *file, qint64 offset, qint64 length)
+{
+    qint64 heldBytesBefore = heldWriteBuffer.size();
+    for (const PendingFile &pending : qAsConst(pendingFiles))
+        heldBytesBefore -= pending.bufferedBytesBefore;
+    pendingFiles.append({ file, offset, length, heldBytesBefore });
+
+    writePendingFiles();
+}
+
+/*!
+    \internal
+
+    Feeds the file regions queued with writeFromFile(), and the data written
+    after them, to the encryption layer. The files are read in chunks of
+    QSSLSOCKET_FILECHUNKSIZE bytes, and only once the plain socket has sent
+    most of the previous chunk; this is called again whenever it emits
+    bytesWritten().
+*/
+void QSslSocketPrivate::writePendingFiles()
+{
+    Q_Q(QSslSocket);
+    while (!pendingFiles.isEmpty() && plainSocket
+           && writeBuffer.size() + plainSocket->bytesToWrite() < QSSLSOCKET_FILECHUNKSIZE) {
+        PendingFile &pending = pendingFiles.first();
+        if (pending.bufferedBytesBefore > 0) {
+            writeHeldData(pending.bufferedBytesBefore);
+            pending.bufferedBytesBefore = 0;
+            continue;
+        }
+
+        if (!pending.file || !pending.file->isOpen()) {
+            setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                            QAbstractSocket::tr("File was closed before its data was written"));
+            q->abort();
+            return;
+        }
+
+        QByteArray chunk;
+        if (pending.file->seek(pending.offset))
+            chunk = pending.file->read(qMin(pending.length, qint64(QSSLSOCKET_FILECHUNKSIZE)));
+        if (chunk.isEmpty()) {
+            setErrorAndEmit(QAbstractSocket::UnknownSocketError, pending.file->errorString());
+            q->abort();
+            return;
+        }
+
+        pending.offset += chunk.size();
+        pending.length -= chunk.size();
+        if (pending.length == 0)
+            pendingFiles.removeFirst();
+        writePlainData(chunk.constData(), chunk.size());
+    }
+
+    if (pendingFiles.isEmpty() && !heldWriteBuffer.isEmpty())
+        writeHeldData(heldWriteBuffer.size());
+}
+
+/*!
+    \internal
+
+    Moves \a size bytes that were written while file regions were queued to
+    the encryption layer.
+*/
+void QSslSocketPrivate::writeHeldData(qint64 size)
+{
+    while (size > 0) {
+        const qint64 blockSize = qMin(size, heldWriteBuffer.nextDataBlockSize());
+        writePlainData(heldWriteBuffer.readPointer(), blockSize);
+        heldWriteBuffer.free(blockSize);
+        size -= blockSize;
+    }
+}
+
 /*!
     \internal
 */
@@ -2081,6 +2187,7 @@ void QSslSocketPrivate::init()
 
     buffer.clear();
     writeBuffer.clear();
+    heldWriteBuffer.clear();
     configuration.peerCertificate.clear();
     configuration.peerCertificateChain.clear();
 }
@@ -2258,6 +2365,7 @@ void QSslConfigurationPrivate::deepCopyDefaultConfiguration(QSslConfigurationPri
     ptr->sslOptions = global->sslOptions;
     ptr->ellipticCurves = global->ellipticCurves;
     ptr->backendConfig = global->backendConfig;
+    ptr->sessionCache = global->sessionCache;
 }
 
 /*!
@@ -2514,7 +2622,8 @@ void QSslSocketPrivate::_q_bytesWrittenSlot(qint64 written)
         emit q->bytesWritten(written);
     else
         emit q->encryptedBytesWritten(written);
-    if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty())
+    writePendingFiles();
+    if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty() && pendingFiles.isEmpty())
         q->disconnectFromHost();
 }
 
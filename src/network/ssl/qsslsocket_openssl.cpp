@@ -65,7 +65,9 @@
 #include "qsslellipticcurve.h"
 #include "qsslpresharedkeyauthenticator.h"
 #include "qsslpresharedkeyauthenticator_p.h"
+#include "qsslsessioncache_p.h"
 
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
@@ -137,7 +139,8 @@ QSslSocketBackendPrivate::QSslSocketBackendPrivate()
     : ssl(0),
       readBio(0),
       writeBio(0),
-      session(0)
+      session(0),
+      pendingCachedSessionLifetime(0)
 {
     // Calls SSL_library_init().
     ensureInitialized();
@@ -340,6 +343,27 @@ bool QSslSocketBackendPrivate::initSslContext()
         }
     }
 
+    // Offer a session from the shared cache, unless the context already
+    // resumes one of its own.
+    QSslSessionCache *sessionCache = configuration.sessionCache;
+    cachedSessionKey.clear();
+    pendingCachedSession.clear();
+    if (sessionCache && mode == QSslSocket::SslClientMode
+        && !(configuration.sslOptions & QSsl::SslOptionDisableSessionSharing)) {
+        cachedSessionKey = sessionCacheKey();
+    }
+    if (!cachedSessionKey.isEmpty() && !q_SSL_get_session(ssl)) {
+        const QByteArray asn1 = QSslSessionCachePrivate::lookup(sessionCache, cachedSessionKey);
+        if (!asn1.isEmpty()) {
+            const unsigned char *data = reinterpret_cast<const unsigned char *>(asn1.constData());
+            if (SSL_SESSION *cached = q_d2i_SSL_SESSION(0, &data, asn1.size())) {
+                if (!q_SSL_set_session(ssl, cached))
+                    qCWarning(lcSsl, "could not set SSL session from the session cache");
+                q_SSL_SESSION_free(cached); // SSL_set_session took its own reference
+            }
+        }
+    }
+
     // Clear the session.
     errorList.clear();
 
@@ -379,6 +403,68 @@ bool QSslSocketBackendPrivate::initSslContext()
     return true;
 }
 
+QByteArray QSslSocketBackendPrivate::sessionCacheKey() const
+{
+    Q_Q(const QSslSocket);
+    QString peer = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
+    if (peer.isEmpty())
+        peer = hostName;
+
+    // A resumed session skips certificate verification and authenticates
+    // us with the certificate of the original handshake, so it may only be
+    // offered by sockets that trust the same CAs and present the same
+    // certificate.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QSslCertificate &certificate : qAsConst(configuration.localCertificateChain))
+        hash.addData(certificate.toDer());
+    hash.addData(":", 1); // DER certificates never start with ':'
+    for (const QSslCertificate &caCertificate : qAsConst(configuration.caCertificates))
+        hash.addData(caCertificate.toDer());
+
+    return peer.toLower().toUtf8() + ':' + QByteArray::number(q->peerPort())
+           + '/' + hash.result().toHex();
+}
+
+void QSslSocketBackendPrivate::storeSessionInCache(SSL_SESSION *sslSession)
+{
+    if (cachedSessionKey.isEmpty() || !sslSession)
+        return;
+    const int length = q_i2d_SSL_SESSION(sslSession, 0);
+    if (length <= 0)
+        return;
+    QByteArray asn1(length, Qt::Uninitialized);
+    unsigned char *data = reinterpret_cast<unsigned char *>(asn1.data());
+    if (q_i2d_SSL_SESSION(sslSession, &data) != length)
+        return;
+
+    long lifetime = q_SSL_SESSION_get_ticket_lifetime_hint(sslSession);
+    if (lifetime <= 0)
+        lifetime = q_SSL_SESSION_get_timeout(sslSession);
+    pendingCachedSession = asn1;
+    pendingCachedSessionLifetime = int(qMin<long>(lifetime, INT_MAX));
+
+    // OpenSSL hands us the session before we have looked at the peer's
+    // certificate; continueHandshake() decides about it then.
+    if (connectionEncrypted)
+        insertSessionInCache();
+}
+
+void QSslSocketBackendPrivate::insertSessionInCache()
+{
+    // Only a handshake that verified the peer without (ignored) errors may
+    // be resumed by other sockets.
+    const bool verified = configuration.peerVerifyMode == QSslSocket::VerifyPeer
+                          || configuration.peerVerifyMode == QSslSocket::AutoVerifyPeer;
+    if (!verified || !sslErrors.isEmpty() || configuration.peerCertificate.isNull())
+        cachedSessionKey.clear();
+
+    if (!cachedSessionKey.isEmpty() && !pendingCachedSession.isEmpty()) {
+        configuration.sessionCache->insert(cachedSessionKey, pendingCachedSession,
+                                           pendingCachedSessionLifetime);
+    }
+    pendingCachedSession.clear();
+}
+
 void QSslSocketBackendPrivate::destroySslContext()
 {
     if (ssl) {
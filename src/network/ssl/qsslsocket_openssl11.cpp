@@ -196,6 +196,10 @@ void QSslSocketBackendPrivate::continueHandshake()
     if (q_SSL_session_reused(ssl))
         configuration.peerSessionShared = true;
 
+    // Sessions OpenSSL handed us during the handshake can be shared now
+    // that we know whether the peer was verified
+    insertSessionInCache();
+
 #ifdef QT_DECRYPT_SSL_TRAFFIC
     if (q_SSL_get_session(ssl)) {
         size_t master_key_len = q_SSL_SESSION_get_master_key(q_SSL_get_session(ssl), 0, 0);
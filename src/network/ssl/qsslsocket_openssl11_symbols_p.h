@@ -128,6 +128,14 @@ long q_OpenSSL_version_num();
 const char *q_OpenSSL_version(int type);
 
 unsigned long q_SSL_SESSION_get_ticket_lifetime_hint(const SSL_SESSION *session);
+long q_SSL_SESSION_get_timeout(const SSL_SESSION *session);
+const unsigned char *q_SSL_SESSION_get_id(const SSL_SESSION *session, unsigned int *len);
+
+typedef int (*q_SSL_CTX_new_session_cb)(SSL *, SSL_SESSION *);
+typedef SSL_SESSION *(*q_SSL_CTX_get_session_cb)(SSL *, const unsigned char *, int, int *);
+int q_SSL_CTX_set_session_id_context(SSL_CTX *ctx, const unsigned char *sid_ctx, unsigned int sid_ctx_len);
+void q_SSL_CTX_sess_set_new_cb(SSL_CTX *ctx, q_SSL_CTX_new_session_cb cb);
+void q_SSL_CTX_sess_set_get_cb(SSL_CTX *ctx, q_SSL_CTX_get_session_cb cb);
 
 #define q_SSL_CTX_set_min_proto_version(ctx, version) \
         q_SSL_CTX_ctrl(ctx, SSL_CTRL_SET_MIN_PROTO_VERSION, version, nullptr)
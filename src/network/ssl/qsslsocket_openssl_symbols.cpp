@@ -176,6 +176,11 @@ DEFINEFUNC3(void, CRYPTO_free, void *str, str, const char *file, file, int line,
 DEFINEFUNC(long, OpenSSL_version_num, void, DUMMYARG, return 0, return)
 DEFINEFUNC(const char *, OpenSSL_version, int a, a, return 0, return)
 DEFINEFUNC(unsigned long, SSL_SESSION_get_ticket_lifetime_hint, const SSL_SESSION *session, session, return 0, return)
+DEFINEFUNC(long, SSL_SESSION_get_timeout, const SSL_SESSION *session, session, return 0, return)
+DEFINEFUNC2(const unsigned char *, SSL_SESSION_get_id, const SSL_SESSION *session, session, unsigned int *len, len, return 0, return)
+DEFINEFUNC3(int, SSL_CTX_set_session_id_context, SSL_CTX *ctx, ctx, const unsigned char *sid_ctx, sid_ctx, unsigned int sid_ctx_len, sid_ctx_len, return 0, return)
+DEFINEFUNC2(void, SSL_CTX_sess_set_new_cb, SSL_CTX *ctx, ctx, q_SSL_CTX_new_session_cb cb, cb, return, DUMMYARG)
+DEFINEFUNC2(void, SSL_CTX_sess_set_get_cb, SSL_CTX *ctx, ctx, q_SSL_CTX_get_session_cb cb, cb, return, DUMMYARG)
 DEFINEFUNC4(void, DH_get0_pqg, const DH *dh, dh, const BIGNUM **p, p, const BIGNUM **q, q, const BIGNUM **g, g, return, DUMMYARG)
 DEFINEFUNC(int, DH_bits, DH *dh, dh, return 0, return)
 
@@ -920,6 +925,11 @@ bool q_resolveOpenSslSymbols()
     }
 
     RESOLVEFUNC(SSL_SESSION_get_ticket_lifetime_hint)
+    RESOLVEFUNC(SSL_SESSION_get_timeout)
+    RESOLVEFUNC(SSL_SESSION_get_id)
+    RESOLVEFUNC(SSL_CTX_set_session_id_context)
+    RESOLVEFUNC(SSL_CTX_sess_set_new_cb)
+    RESOLVEFUNC(SSL_CTX_sess_set_get_cb)
     RESOLVEFUNC(DH_bits)
     RESOLVEFUNC(DSA_bits)
 
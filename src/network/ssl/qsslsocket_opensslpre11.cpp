@@ -358,6 +358,10 @@ void QSslSocketBackendPrivate::continueHandshake()
     }
 #endif
 
+    // Share the session with other sockets through the session cache
+    storeSessionInCache(q_SSL_get_session(ssl));
+    insertSessionInCache();
+
     // Cache this SSL session inside the QSslContext
     if (!(configuration.sslOptions & QSsl::SslOptionDisableSessionSharing)) {
         if (!sslContextPointer->cacheSession(ssl)) {
@@ -195,6 +195,15 @@ public:
     qint64 skip(qint64 maxSize) override;
     bool flush() override;
 
+    // writeFromFile(): file data is fed to the encryption layer in chunks,
+    // data written meanwhile waits here; PendingFile::bufferedBytesBefore
+    // counts the bytes of it that go before each file
+    QRingBuffer heldWriteBuffer;
+    void queueFile(QFile *file, qint64 offset, qint64 length) override;
+    void writePendingFiles();
+    void writeHeldData(qint64 size);
+    qint64 writePlainData(const char *data, qint64 len);
+
     // Platform specific functions
     virtual void startClientEncryption() = 0;
     virtual void startServerEncryption() = 0;
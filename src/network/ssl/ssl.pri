@@ -20,7 +20,9 @@ qtConfig(ssl) {
                ssl/qsslpresharedkeyauthenticator.h \
                ssl/qsslpresharedkeyauthenticator_p.h \
                ssl/qsslcertificateextension.h \
-               ssl/qsslcertificateextension_p.h
+               ssl/qsslcertificateextension_p.h \
+               ssl/qsslsessioncache.h \
+               ssl/qsslsessioncache_p.h
     SOURCES += ssl/qasn1element.cpp \
                ssl/qssl.cpp \
                ssl/qsslcertificate.cpp \
@@ -32,7 +34,8 @@ qtConfig(ssl) {
                ssl/qsslerror.cpp \
                ssl/qsslsocket.cpp \
                ssl/qsslpresharedkeyauthenticator.cpp \
-               ssl/qsslcertificateextension.cpp
+               ssl/qsslcertificateextension.cpp \
+               ssl/qsslsessioncache.cpp
 
     winrt {
         HEADERS += ssl/qsslsocket_winrt_p.h
@@ -223,6 +223,7 @@ public:
 
     bool bindInValues();
     void bindBlobs();
+    void discardResultSet() override;
 
     bool hasBlobs;
     struct QMyField
@@ -251,6 +252,15 @@ public:
     bool preparedQuery;
 };
 
+void QMYSQLResultPrivate::discardResultSet()
+{
+#if MYSQL_VERSION_ID >= 40108
+    // the rows fetched by mysql_stmt_store_result()
+    if (stmt)
+        mysql_stmt_free_result(stmt);
+#endif
+}
+
 #ifndef QT_NO_TEXTCODEC
 static QTextCodec* codec(MYSQL* mysql)
 {
@@ -50,7 +50,9 @@
 #include <qsqlquery.h>
 #include <qsocketnotifier.h>
 #include <qstringlist.h>
+#include <qvarlengtharray.h>
 #include <qlocale.h>
+#include <QtSql/private/qsqlcolumnbuffer_p.h>
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 
@@ -140,6 +142,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -298,10 +301,13 @@ public:
         currentSize(-1),
         canFetchMoreRows(false),
         stmtId(InvalidStatementId),
-        preparedQueriesEnabled(false)
+        preparedQueriesEnabled(false),
+        batchRowsAffected(-1)
     { }
 
     QString fieldSerial(int i) const override { return QLatin1Char('$') + QString::number(i + 1); }
+    int fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows) override;
+    void discardResultSet() override { q_func()->cleanup(); }
     void deallocatePreparedStmt();
 
     PGresult *result;
@@ -311,8 +317,11 @@ public:
     StatementId stmtId;
     bool preparedQueriesEnabled;
     QString preparedStmtId;
+    int batchRowsAffected;
 
     bool processResults();
+    bool sendBatch(const QString &stmts);
+    bool finishBatch(StatementId batchId);
 };
 
 static QSqlError qMakeError(const QString& err, QSqlError::ErrorType type,
@@ -470,6 +479,7 @@ void QPSQLResult::cleanup()
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
     d->canFetchMoreRows = false;
+    d->batchRowsAffected = -1;
     setActive(false);
 }
 
@@ -724,6 +734,83 @@ QVariant QPSQLResult::data(int i)
     return QVariant();
 }
 
+static void qAppendColumnValue(QSqlColumnBufferPrivate *column, const PGresult *result,
+                               int row, int field, bool isUtf8)
+{
+    if (PQgetisnull(result, row, field)) {
+        column->appendNull();
+        return;
+    }
+    const char *val = PQgetvalue(result, row, field);
+    const int len = PQgetlength(result, row, field);
+    const Oid ptype = PQftype(result, field);
+    switch (column->type) {
+    case QSqlColumnBuffer::Int64: {
+        if (ptype == QBOOLOID) {
+            column->appendInt64(val[0] == 't');
+            break;
+        }
+        const QByteArray text = QByteArray::fromRawData(val, len);
+        bool ok;
+        const qint64 value = text.toLongLong(&ok);
+        column->appendInt64(ok ? value : qint64(text.toDouble()));
+        break;
+    }
+    case QSqlColumnBuffer::Double:
+        if (ptype == QBOOLOID)
+            column->appendDouble(val[0] == 't' ? 1.0 : 0.0);
+        else if (qstricmp(val, "Infinity") == 0)
+            column->appendDouble(qInf());
+        else if (qstricmp(val, "-Infinity") == 0)
+            column->appendDouble(-qInf());
+        else
+            column->appendDouble(QByteArray::fromRawData(val, len).toDouble());
+        break;
+    case QSqlColumnBuffer::String:
+        column->appendString(isUtf8 ? QString::fromUtf8(val, len) : QString::fromLatin1(val, len));
+        break;
+    case QSqlColumnBuffer::ByteArray:
+        if (ptype == QBYTEAOID) {
+            size_t size;
+            unsigned char *data = PQunescapeBytea(reinterpret_cast<const unsigned char *>(val), &size);
+            column->appendByteArray(QByteArray(reinterpret_cast<const char *>(data), int(size)));
+            qPQfreemem(data);
+        } else {
+            column->appendByteArray(QByteArray(val, len));
+        }
+        break;
+    }
+}
+
+int QPSQLResultPrivate::fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows)
+{
+    Q_Q(QPSQLResult);
+    QVarLengthArray<QSqlColumnBufferPrivate *, 16> buffers(columns.size());
+    for (int i = 0; i < columns.size(); ++i)
+        buffers[i] = QSqlColumnBufferPrivate::get(columns[i]);
+    const bool isUtf8 = drv_d_func()->isUtf8;
+
+    int rows = 0;
+    while (rows < maxRows) {
+        const bool fetched = q->at() == QSql::BeforeFirstRow ? q->fetchFirst() : q->fetchNext();
+        if (!fetched) {
+            q->setAt(QSql::AfterLastRow);
+            break;
+        }
+        // In single row mode every row arrives in a result of its own.
+        const int row = forwardOnly ? 0 : q->at();
+        const int fieldCount = PQnfields(result);
+        for (int i = 0; i < buffers.size(); ++i) {
+            if (i < fieldCount)
+                qAppendColumnValue(buffers[i], result, row, i, isUtf8);
+            else
+                buffers[i]->appendNull();
+        }
+        ++rows;
+    }
+    return rows;
+}
+
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
@@ -768,6 +855,8 @@ int QPSQLResult::size()
 int QPSQLResult::numRowsAffected()
 {
     Q_D(const QPSQLResult);
+    if (d->batchRowsAffected >= 0)
+        return d->batchRowsAffected;
     return QString::fromLatin1(PQcmdTuples(d->result)).toInt();
 }
 
@@ -953,6 +1042,124 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResultPrivate::sendBatch(const QString &stmts)
+{
+    Q_Q(QPSQLResult);
+    stmtId = drv_d_func()->sendQuery(stmts);
+    if (stmtId == InvalidStatementId) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to send query"), QSqlError::StatementError, drv_d_func()));
+        return false;
+    }
+    return true;
+}
+
+bool QPSQLResultPrivate::finishBatch(StatementId batchId)
+{
+    Q_Q(QPSQLResult);
+    // One result per statement; the server stops executing the string at
+    // the first failing statement, so there is at most one error result.
+    bool ok = true;
+    while (PGresult *result = drv_d_func()->getResult(batchId)) {
+        const int status = PQresultStatus(result);
+        if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+            batchRowsAffected += QString::fromLatin1(PQcmdTuples(result)).toInt();
+        } else if (ok) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                            "Unable to execute batch statement"), QSqlError::StatementError,
+                            drv_d_func(), result));
+            ok = false;
+        }
+        PQclear(result);
+    }
+    drv_d_func()->finishQuery(batchId);
+    stmtId = InvalidStatementId;
+    return ok;
+}
+
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    if (!d->preparedQueriesEnabled || d->preparedStmtId.isEmpty())
+        return QSqlResult::execBatch(arrayBind);
+
+    cleanup();
+
+    const QVector<QVariant> values = boundValues();
+    if (values.isEmpty())
+        return false;
+
+    QVector<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const int rows = columns.at(0).count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rows) {
+            setLastError(QSqlError(QLatin1String("QPSQL: ") + QCoreApplication::translate("QPSQLResult",
+                                   "Unable to execute batch statement"),
+                                   QCoreApplication::translate("QPSQLResult",
+                                   "All bound value lists must have the same size"),
+                                   QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    // Instead of one round trip per row, several EXECUTE statements are
+    // sent as one multi-statement query. The next query is formatted while
+    // the server executes the previous one. Unless a transaction is
+    // already active, the batch runs in its own transaction, so it is
+    // applied either completely or not at all.
+    const int maxQueryLength = 1 << 20;
+    PGconn *connection = d->drv_d_func()->connection;
+    const bool ownTransaction = PQtransactionStatus(connection) == PQTRANS_IDLE;
+    const QString execute = QLatin1String("EXECUTE ") + d->preparedStmtId;
+
+    d->batchRowsAffected = 0;
+    QString stmts;
+    if (ownTransaction)
+        stmts = QStringLiteral("BEGIN;");
+    StatementId pendingId = InvalidStatementId;
+    bool ok = true;
+    QVector<QVariant> row(columns.count());
+    for (int i = 0; i < rows && ok; ++i) {
+        for (int j = 0; j < columns.count(); ++j)
+            row[j] = columns.at(j).at(i);
+        const QString params = qCreateParamString(row, driver());
+        stmts += execute;
+        if (!params.isEmpty())
+            stmts += QLatin1String(" (") + params + QLatin1Char(')');
+        stmts += QLatin1Char(';');
+
+        if (stmts.size() >= maxQueryLength || i == rows - 1) {
+            if (i == rows - 1 && ownTransaction)
+                stmts += QLatin1String("COMMIT;");
+            if (pendingId != InvalidStatementId) {
+                ok = d->finishBatch(pendingId);
+                pendingId = InvalidStatementId;
+            }
+            if (ok) {
+                ok = d->sendBatch(stmts);
+                pendingId = d->stmtId;
+            }
+            stmts.clear();
+        }
+    }
+    if (pendingId != InvalidStatementId && !d->finishBatch(pendingId))
+        ok = false;
+
+    if (ownTransaction && PQtransactionStatus(connection) != PQTRANS_IDLE)
+        PQclear(d->drv_d_func()->exec("ROLLBACK"));
+
+    if (!ok) {
+        d->batchRowsAffected = -1;
+        return false;
+    }
+    setSelect(false);
+    setActive(true);
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
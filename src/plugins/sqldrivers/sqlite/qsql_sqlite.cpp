@@ -47,8 +47,10 @@
 #include <qsqlindex.h>
 #include <qsqlquery.h>
 #include <QtSql/private/qsqlcachedresult_p.h>
+#include <QtSql/private/qsqlcolumnbuffer_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
+#include <qvarlengtharray.h>
 #include <qvector.h>
 #include <qdebug.h>
 #if QT_CONFIG(regularexpression)
@@ -58,7 +60,6 @@
 #if QT_CONFIG(timezone)
 #include <QTimeZone>
 #endif
-#include <QScopedValueRollback>
 
 #if defined Q_OS_WIN
 # include <qt_windows.h>
@@ -163,14 +164,17 @@ public:
     QSQLiteResultPrivate(QSQLiteResult *q, const QSQLiteDriver *drv);
     void cleanup();
     bool fetchNext(QSqlCachedResult::ValueCache &values, int idx, bool initialFetch);
+    int fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows) override;
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    bool mapParameters(int valueCount, QVector<int> *valueIndexes) const;
 
     sqlite3_stmt *stmt;
 
     bool skippedStatus; // the status of the fetchNext() that's skipped
     bool skipRow; // skip the next fetchNext()?
+    int batchRowsAffected; // -1 unless the last execution was a batch
     QSqlRecord rInf;
     QVector<QVariant> firstRow;
 };
@@ -179,7 +183,8 @@ QSQLiteResultPrivate::QSQLiteResultPrivate(QSQLiteResult *q, const QSQLiteDriver
     : QSqlCachedResultPrivate(q, drv),
       stmt(0),
       skippedStatus(false),
-      skipRow(false)
+      skipRow(false),
+      batchRowsAffected(-1)
 {
 }
 
@@ -190,6 +195,7 @@ void QSQLiteResultPrivate::cleanup()
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
+    batchRowsAffected = -1;
     q->setAt(QSql::BeforeFirstRow);
     q->setActive(false);
     q->cleanup();
@@ -204,6 +210,55 @@ void QSQLiteResultPrivate::finalize()
     stmt = 0;
 }
 
+// Finds the bound value of each parameter of the statement. Returns false if
+// the values do not match the parameters.
+bool QSQLiteResultPrivate::mapParameters(int valueCount, QVector<int> *valueIndexes) const
+{
+    const int paramCount = sqlite3_bind_parameter_count(stmt);
+    valueIndexes->clear();
+    if (paramCount == valueCount) {
+        valueIndexes->reserve(paramCount);
+        for (int i = 0; i < paramCount; ++i)
+            valueIndexes->append(i);
+        return true;
+    }
+
+#if (SQLITE_VERSION_NUMBER >= 3003011)
+    // In the case of the reuse of a named placeholder
+    // We need to check explicitly that paramCount is greater than or equal to 1, as sqlite
+    // can end up in a case where for virtual tables it returns 0 even though it
+    // has parameters
+    if (paramCount >= 1 && paramCount < valueCount) {
+        const auto countIndexes = [](int counter, const QVector<int> &indexList) {
+                                      return counter + indexList.length();
+                                  };
+
+        const int bindParamCount = std::accumulate(indexes.cbegin(),
+                                                   indexes.cend(),
+                                                   0,
+                                                   countIndexes);
+        if (bindParamCount != valueCount)
+            return false;
+
+        // When using named placeholders, it will reuse the index for duplicated
+        // placeholders. So we need to ensure we bind only one instance of
+        // each value as SQLite will do the rest for us.
+        QVector<int> handledIndexes;
+        for (int i = 0, currentIndex = 0; i < valueCount; ++i) {
+            if (handledIndexes.contains(i))
+                continue;
+            const auto placeHolder = QString::fromUtf8(sqlite3_bind_parameter_name(stmt, currentIndex + 1));
+            const auto &placeHolderIndexes = indexes.value(placeHolder);
+            handledIndexes << placeHolderIndexes;
+            valueIndexes->append(placeHolderIndexes.first());
+            ++currentIndex;
+        }
+        return true;
+    }
+#endif
+    return false;
+}
+
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
 {
     Q_Q(QSQLiteResult);
@@ -360,6 +415,63 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     return false;
 }
 
+static void qAppendColumnValue(QSqlColumnBufferPrivate *column, sqlite3_stmt *stmt, int i)
+{
+    if (sqlite3_column_type(stmt, i) == SQLITE_NULL) {
+        column->appendNull();
+        return;
+    }
+    switch (column->type) {
+    case QSqlColumnBuffer::Int64:
+        column->appendInt64(sqlite3_column_int64(stmt, i));
+        break;
+    case QSqlColumnBuffer::Double:
+        column->appendDouble(sqlite3_column_double(stmt, i));
+        break;
+    case QSqlColumnBuffer::String:
+        column->appendString(QString(reinterpret_cast<const QChar *>(sqlite3_column_text16(stmt, i)),
+                                     sqlite3_column_bytes16(stmt, i) / sizeof(QChar)));
+        break;
+    case QSqlColumnBuffer::ByteArray:
+        column->appendByteArray(QByteArray(static_cast<const char *>(sqlite3_column_blob(stmt, i)),
+                                           sqlite3_column_bytes(stmt, i)));
+        break;
+    }
+}
+
+int QSQLiteResultPrivate::fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows)
+{
+    Q_Q(QSQLiteResult);
+    // Random access results must go through the row cache.
+    if (!forwardOnly || !stmt)
+        return -1;
+
+    QVarLengthArray<QSqlColumnBufferPrivate *, 16> buffers(columns.size());
+    for (int i = 0; i < columns.size(); ++i)
+        buffers[i] = QSqlColumnBufferPrivate::get(columns[i]);
+
+    int rows = 0;
+    while (rows < maxRows) {
+        // Only the values of the row the query ends up on are cached.
+        const int idx = rows == maxRows - 1 ? 0 : -1;
+        if (!fetchNext(cache, idx, false)) {
+            atEnd = true;
+            q->setAt(QSql::AfterLastRow);
+            break;
+        }
+        q->setAt(q->at() + 1);
+        const int colCount = rInf.count();
+        for (int i = 0; i < buffers.size(); ++i) {
+            if (i < colCount)
+                qAppendColumnValue(buffers[i], stmt, i);
+            else
+                buffers[i]->appendNull();
+        }
+        ++rows;
+    }
+    return rows;
+}
+
 QSQLiteResult::QSQLiteResult(const QSQLiteDriver* db)
     : QSqlCachedResult(*new QSQLiteResultPrivate(this, db))
 {
@@ -449,36 +561,176 @@ static QString timespecToString(const QDateTime &dateTime)
     }
 }
 
+static int qBindValue(sqlite3_stmt *stmt, int index, const QVariant &value)
+{
+    if (value.isNull())
+        return sqlite3_bind_null(stmt, index);
+
+    switch (value.type()) {
+    case QVariant::ByteArray: {
+        const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
+        return sqlite3_bind_blob(stmt, index, ba->constData(),
+                                 ba->size(), SQLITE_STATIC);
+    }
+    case QVariant::Int:
+    case QVariant::Bool:
+        return sqlite3_bind_int(stmt, index, value.toInt());
+    case QVariant::Double:
+        return sqlite3_bind_double(stmt, index, value.toDouble());
+    case QVariant::UInt:
+    case QVariant::LongLong:
+        return sqlite3_bind_int64(stmt, index, value.toLongLong());
+    case QVariant::DateTime: {
+        const QDateTime dateTime = value.toDateTime();
+        const QString str = dateTime.toString(QLatin1String("yyyy-MM-ddThh:mm:ss.zzz") + timespecToString(dateTime));
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+    }
+    case QVariant::Time: {
+        const QTime time = value.toTime();
+        const QString str = time.toString(QStringViewLiteral("hh:mm:ss.zzz"));
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+    }
+    case QVariant::String: {
+        // lifetime of string == lifetime of its qvariant
+        const QString *str = static_cast<const QString*>(value.constData());
+        return sqlite3_bind_text16(stmt, index, str->utf16(),
+                                   (str->size()) * sizeof(QChar), SQLITE_STATIC);
+    }
+    default: {
+        QString str = value.toString();
+        // SQLITE_TRANSIENT makes sure that sqlite buffers the data
+        return sqlite3_bind_text16(stmt, index, str.utf16(),
+                                   (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
+    }
+    }
+}
+
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
-    Q_D(QSqlResult);
-    QScopedValueRollback<QVector<QVariant>> valuesScope(d->values);
-    QVector<QVariant> values = d->values;
+    Q_D(QSQLiteResult);
+    const QVector<QVariant> values = boundValues();
     if (values.count() == 0)
         return false;
 
-    for (int i = 0; i < values.at(0).toList().count(); ++i) {
-        d->values.clear();
-        QScopedValueRollback<QHash<QString, QVector<int>>> indexesScope(d->indexes);
-        QHash<QString, QVector<int>>::const_iterator it = d->indexes.constBegin();
-        while (it != d->indexes.constEnd()) {
-            bindValue(it.key(), values.at(it.value().first()).toList().at(i), QSql::In);
-            ++it;
+    d->skippedStatus = false;
+    d->skipRow = false;
+    d->batchRowsAffected = -1;
+    d->rInf.clear();
+    clearValues();
+    setLastError(QSqlError());
+    setSelect(false);
+    setActive(false);
+
+    QVector<int> valueIndexes;
+    if (!d->mapParameters(values.count(), &valueIndexes)) {
+        setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                        "Parameter count mismatch"), QString(), QSqlError::StatementError));
+        return false;
+    }
+
+    // The statement is bound directly from the value lists, row by row,
+    // without going through bindValue() and exec().
+    QVector<QVariantList> columns;
+    columns.reserve(valueIndexes.count());
+    for (int index : qAsConst(valueIndexes))
+        columns.append(values.at(index).toList());
+    const int rowCount = values.at(0).toList().count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rowCount) {
+            setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                            "Unable to execute batch statement"),
+                            QCoreApplication::translate("QSQLiteResult",
+                            "All bound value lists must have the same size"),
+                            QSqlError::StatementError));
+            return false;
         }
-        if (!exec())
+    }
+
+    sqlite3 *access = d->drv_d_func()->access;
+    int res = sqlite3_reset(d->stmt);
+    if (res != SQLITE_OK) {
+        setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                     "Unable to reset statement"), QSqlError::StatementError, res));
+        d->finalize();
+        return false;
+    }
+
+    // Unless a transaction is active, the batch is applied completely or
+    // not at all, and is not committed row by row.
+    const bool ownSavepoint = sqlite3_get_autocommit(access);
+    if (ownSavepoint) {
+        res = sqlite3_exec(access, "SAVEPOINT qt_sql_batch", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to execute batch statement"), QSqlError::TransactionError, res));
             return false;
+        }
+    }
+
+    int rowsAffected = 0;
+    bool ok = true;
+    for (int row = 0; row < rowCount && ok; ++row) {
+        for (int i = 0; i < columns.count() && ok; ++i) {
+            res = qBindValue(d->stmt, i + 1, columns.at(i).at(row));
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to bind parameters"), QSqlError::StatementError, res));
+                ok = false;
+            }
+        }
+        if (!ok)
+            break;
+
+        do {
+            res = sqlite3_step(d->stmt);
+        } while (res == SQLITE_ROW);
+        if (res == SQLITE_DONE) {
+            rowsAffected += sqlite3_changes(access);
+            sqlite3_reset(d->stmt);
+        } else {
+            // sqlite3_reset() returns the specific error code.
+            res = sqlite3_reset(d->stmt);
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to execute statement"), QSqlError::StatementError, res));
+            ok = false;
+        }
+    }
+    // The bound strings and blobs belong to the value lists.
+    sqlite3_clear_bindings(d->stmt);
+
+    if (ownSavepoint) {
+        if (ok) {
+            res = sqlite3_exec(access, "RELEASE SAVEPOINT qt_sql_batch", nullptr, nullptr, nullptr);
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to execute batch statement"), QSqlError::TransactionError, res));
+                ok = false;
+            }
+        }
+        if (!ok) {
+            sqlite3_exec(access, "ROLLBACK TO SAVEPOINT qt_sql_batch; RELEASE SAVEPOINT qt_sql_batch",
+                         nullptr, nullptr, nullptr);
+        }
     }
+
+    if (!ok)
+        return false;
+    d->batchRowsAffected = rowsAffected;
+    setActive(true);
     return true;
 }
 
 bool QSQLiteResult::exec()
 {
     Q_D(QSQLiteResult);
-    QVector<QVariant> values = boundValues();
+    const QVector<QVariant> values = boundValues();
 
     d->skippedStatus = false;
     d->skipRow = false;
+    d->batchRowsAffected = -1;
     d->rInf.clear();
     clearValues();
     setLastError(QSqlError());
@@ -491,96 +743,10 @@ bool QSQLiteResult::exec()
         return false;
     }
 
-    int paramCount = sqlite3_bind_parameter_count(d->stmt);
-    bool paramCountIsValid = paramCount == values.count();
-
-#if (SQLITE_VERSION_NUMBER >= 3003011)
-    // In the case of the reuse of a named placeholder
-    // We need to check explicitly that paramCount is greater than or equal to 1, as sqlite
-    // can end up in a case where for virtual tables it returns 0 even though it
-    // has parameters
-    if (paramCount >= 1 && paramCount < values.count()) {
-        const auto countIndexes = [](int counter, const QVector<int> &indexList) {
-                                      return counter + indexList.length();
-                                  };
-
-        const int bindParamCount = std::accumulate(d->indexes.cbegin(),
-                                                   d->indexes.cend(),
-                                                   0,
-                                                   countIndexes);
-
-        paramCountIsValid = bindParamCount == values.count();
-        // When using named placeholders, it will reuse the index for duplicated
-        // placeholders. So we need to ensure the QVector has only one instance of
-        // each value as SQLite will do the rest for us.
-        QVector<QVariant> prunedValues;
-        QVector<int> handledIndexes;
-        for (int i = 0, currentIndex = 0; i < values.size(); ++i) {
-            if (handledIndexes.contains(i))
-                continue;
-            const auto placeHolder = QString::fromUtf8(sqlite3_bind_parameter_name(d->stmt, currentIndex + 1));
-            const auto &indexes = d->indexes.value(placeHolder);
-            handledIndexes << indexes;
-            prunedValues << values.at(indexes.first());
-            ++currentIndex;
-        }
-        values = prunedValues;
-    }
-#endif
-
-    if (paramCountIsValid) {
-        for (int i = 0; i < paramCount; ++i) {
-            res = SQLITE_OK;
-            const QVariant value = values.at(i);
-
-            if (value.isNull()) {
-                res = sqlite3_bind_null(d->stmt, i + 1);
-            } else {
-                switch (value.type()) {
-                case QVariant::ByteArray: {
-                    const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
-                    res = sqlite3_bind_blob(d->stmt, i + 1, ba->constData(),
-                                            ba->size(), SQLITE_STATIC);
-                    break; }
-                case QVariant::Int:
-                case QVariant::Bool:
-                    res = sqlite3_bind_int(d->stmt, i + 1, value.toInt());
-                    break;
-                case QVariant::Double:
-                    res = sqlite3_bind_double(d->stmt, i + 1, value.toDouble());
-                    break;
-                case QVariant::UInt:
-                case QVariant::LongLong:
-                    res = sqlite3_bind_int64(d->stmt, i + 1, value.toLongLong());
-                    break;
-                case QVariant::DateTime: {
-                    const QDateTime dateTime = value.toDateTime();
-                    const QString str = dateTime.toString(QLatin1String("yyyy-MM-ddThh:mm:ss.zzz") + timespecToString(dateTime));
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::Time: {
-                    const QTime time = value.toTime();
-                    const QString str = time.toString(QStringViewLiteral("hh:mm:ss.zzz"));
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::String: {
-                    // lifetime of string == lifetime of its qvariant
-                    const QString *str = static_cast<const QString*>(value.constData());
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str->utf16(),
-                                              (str->size()) * sizeof(QChar), SQLITE_STATIC);
-                    break; }
-                default: {
-                    QString str = value.toString();
-                    // SQLITE_TRANSIENT makes sure that sqlite buffers the data
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
-                    break; }
-                }
-            }
+    QVector<int> valueIndexes;
+    if (d->mapParameters(values.count(), &valueIndexes)) {
+        for (int i = 0; i < valueIndexes.count(); ++i) {
+            res = qBindValue(d->stmt, i + 1, values.at(valueIndexes.at(i)));
             if (res != SQLITE_OK) {
                 setLastError(qMakeError(d->drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
                              "Unable to bind parameters"), QSqlError::StatementError, res));
@@ -618,6 +784,8 @@ int QSQLiteResult::size()
 int QSQLiteResult::numRowsAffected()
 {
     Q_D(const QSQLiteResult);
+    if (d->batchRowsAffected >= 0)
+        return d->batchRowsAffected;
     return sqlite3_changes(d->drv_d_func()->access);
 }
 
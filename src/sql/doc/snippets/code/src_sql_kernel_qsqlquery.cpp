@@ -88,3 +88,24 @@ if (!q.execBatch())
 3  Trond
 4  NULL
 //! [3]
+
+
+//! [4]
+QSqlQuery q;
+q.setForwardOnly(true);
+q.exec("select id, salary, name from employees");
+
+QVector<QSqlColumnBuffer> columns;
+columns << QSqlColumnBuffer(QSqlColumnBuffer::Int64)
+        << QSqlColumnBuffer(QSqlColumnBuffer::Double)
+        << QSqlColumnBuffer(QSqlColumnBuffer::String);
+
+double total = 0;
+while (int rows = q.fetchColumns(columns, 1024)) {
+    const double *salaries = columns.at(1).doubleData();
+    for (int i = 0; i < rows; ++i) {
+        if (!columns.at(1).isNull(i))
+            total += salaries[i];
+    }
+}
+//! [4]
@@ -1,6 +1,8 @@
 HEADERS +=      kernel/qtsqlglobal.h \
                 kernel/qtsqlglobal_p.h \
                 kernel/qsqlquery.h \
+                kernel/qsqlcolumnbuffer.h \
+                kernel/qsqlcolumnbuffer_p.h \
                 kernel/qsqldatabase.h \
                 kernel/qsqlfield.h \
                 kernel/qsqlrecord.h \
@@ -15,6 +17,7 @@ HEADERS +=      kernel/qtsqlglobal.h \
                 kernel/qsqlindex.h
 
 SOURCES +=      kernel/qsqlquery.cpp \
+                kernel/qsqlcolumnbuffer.cpp \
                 kernel/qsqldatabase.cpp \
                 kernel/qsqlfield.cpp \
                 kernel/qsqlrecord.cpp \
@@ -76,6 +76,12 @@ void QSqlCachedResultPrivate::cleanup()
     rowCacheEnd = 0;
 }
 
+void QSqlCachedResultPrivate::discardResultSet()
+{
+    QSqlResultPrivate::discardResultSet();
+    cleanup();
+}
+
 void QSqlCachedResultPrivate::init(int count, bool fo)
 {
     Q_ASSERT(count);
@@ -108,6 +108,7 @@ public:
     void cleanup();
     int nextIndex();
     void revertLast();
+    void discardResultSet() override;
 
     QSqlCachedResult::ValueCache cache;
     int rowCacheEnd;
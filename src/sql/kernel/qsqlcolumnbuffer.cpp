@@ -0,0 +1,304 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsqlcolumnbuffer.h"
+#include "qsqlcolumnbuffer_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSqlColumnBuffer
+    \brief The QSqlColumnBuffer class holds the values of one result column
+    for a block of rows.
+
+    \ingroup database
+    \inmodule QtSql
+    \since 5.12
+
+    QSqlQuery::fetchColumns() fills one QSqlColumnBuffer per result
+    column. Each buffer stores its values in a contiguous array of a
+    single C++ type, chosen by type(), and marks NULL values in a
+    separate bitmap. Reading large result sets this way avoids
+    creating a QVariant for every value.
+
+    \snippet code/src_sql_kernel_qsqlquery.cpp 4
+
+    Rows that are NULL still occupy an entry in the value array, holding
+    a default constructed value, so that row \c i of every buffer is at
+    index \c i.
+
+    QSqlColumnBuffer is \l{implicitly shared}.
+
+    \sa QSqlQuery::fetchColumns()
+*/
+
+/*!
+    \enum QSqlColumnBuffer::Type
+
+    This enum type describes how the values of a column are stored.
+
+    \value Int64 Values are converted to \c qint64 and accessed with
+    int64Data().
+    \value Double Values are converted to \c double and accessed with
+    doubleData().
+    \value String Values are converted to QString and accessed with
+    stringData().
+    \value ByteArray Values are converted to QByteArray and accessed with
+    byteArrayData().
+*/
+
+/*!
+    Constructs an empty buffer that stores values as \a type.
+*/
+QSqlColumnBuffer::QSqlColumnBuffer(Type type)
+    : d(new QSqlColumnBufferPrivate(type))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSqlColumnBuffer::QSqlColumnBuffer(const QSqlColumnBuffer &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Assigns \a other to this buffer and returns a reference to it.
+*/
+QSqlColumnBuffer &QSqlColumnBuffer::operator=(const QSqlColumnBuffer &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QSqlColumnBuffer &QSqlColumnBuffer::operator=(QSqlColumnBuffer &&other)
+
+    Move-assigns \a other to this buffer and returns a reference to it.
+*/
+
+/*!
+    Destroys the buffer.
+*/
+QSqlColumnBuffer::~QSqlColumnBuffer()
+{
+}
+
+/*!
+    \fn void QSqlColumnBuffer::swap(QSqlColumnBuffer &other)
+
+    Swaps buffer \a other with this buffer. This operation is very fast
+    and never fails.
+*/
+
+/*!
+    Returns the type the values of this buffer are stored as.
+*/
+QSqlColumnBuffer::Type QSqlColumnBuffer::type() const
+{
+    return d->type;
+}
+
+/*!
+    Returns the number of rows in the buffer, including NULL values.
+
+    \sa isEmpty()
+*/
+int QSqlColumnBuffer::size() const
+{
+    return d->size;
+}
+
+/*!
+    \fn bool QSqlColumnBuffer::isEmpty() const
+
+    Returns \c true if the buffer holds no rows; otherwise returns \c false.
+
+    \sa size()
+*/
+
+/*!
+    Reserves space for \a size rows.
+*/
+void QSqlColumnBuffer::reserve(int size)
+{
+    d->nulls.reserve((size + 31) / 32);
+    switch (d->type) {
+    case Int64:
+        d->int64s.reserve(size);
+        break;
+    case Double:
+        d->doubles.reserve(size);
+        break;
+    case String:
+        d->strings.reserve(size);
+        break;
+    case ByteArray:
+        d->byteArrays.reserve(size);
+        break;
+    }
+}
+
+/*!
+    Removes all rows from the buffer. The memory allocated for them is
+    kept for the next rows appended.
+*/
+void QSqlColumnBuffer::clear()
+{
+    d->size = 0;
+    d->nullCount = 0;
+    d->nulls.clear();
+    d->int64s.clear();
+    d->doubles.clear();
+    d->strings.clear();
+    d->byteArrays.clear();
+}
+
+/*!
+    Returns \c true if the value at \a row is NULL; otherwise returns
+    \c false.
+
+    \sa nullBitmap()
+*/
+bool QSqlColumnBuffer::isNull(int row) const
+{
+    Q_ASSERT_X(row >= 0 && row < d->size, "QSqlColumnBuffer::isNull", "row out of range");
+    return d->nulls.at(row >> 5) & (1u << (row & 31));
+}
+
+/*!
+    Returns the number of NULL values in the buffer.
+*/
+int QSqlColumnBuffer::nullCount() const
+{
+    return d->nullCount;
+}
+
+/*!
+    Returns the NULL bitmap of the buffer. Bit \c{(i % 32)} of word
+    \c{(i / 32)} is set if the value at row \c i is NULL.
+
+    The pointer remains valid as long as the buffer is not modified.
+
+    \sa isNull()
+*/
+const quint32 *QSqlColumnBuffer::nullBitmap() const
+{
+    return d->nulls.constData();
+}
+
+/*!
+    Returns the values of an \l Int64 buffer, or \c nullptr for other
+    types. The pointer remains valid as long as the buffer is not modified.
+*/
+const qint64 *QSqlColumnBuffer::int64Data() const
+{
+    return d->type == Int64 ? d->int64s.constData() : nullptr;
+}
+
+/*!
+    Returns the values of a \l Double buffer, or \c nullptr for other
+    types. The pointer remains valid as long as the buffer is not modified.
+*/
+const double *QSqlColumnBuffer::doubleData() const
+{
+    return d->type == Double ? d->doubles.constData() : nullptr;
+}
+
+/*!
+    Returns the values of a \l String buffer, or \c nullptr for other
+    types. The pointer remains valid as long as the buffer is not modified.
+*/
+const QString *QSqlColumnBuffer::stringData() const
+{
+    return d->type == String ? d->strings.constData() : nullptr;
+}
+
+/*!
+    Returns the values of a \l ByteArray buffer, or \c nullptr for other
+    types. The pointer remains valid as long as the buffer is not modified.
+*/
+const QByteArray *QSqlColumnBuffer::byteArrayData() const
+{
+    return d->type == ByteArray ? d->byteArrays.constData() : nullptr;
+}
+
+/*!
+    Appends a NULL value.
+*/
+void QSqlColumnBuffer::appendNull()
+{
+    d->appendNull();
+}
+
+/*!
+    Appends \a value to an \l Int64 buffer.
+*/
+void QSqlColumnBuffer::appendInt64(qint64 value)
+{
+    d->appendInt64(value);
+}
+
+/*!
+    Appends \a value to a \l Double buffer.
+*/
+void QSqlColumnBuffer::appendDouble(double value)
+{
+    d->appendDouble(value);
+}
+
+/*!
+    Appends \a value to a \l String buffer.
+*/
+void QSqlColumnBuffer::appendString(const QString &value)
+{
+    d->appendString(value);
+}
+
+/*!
+    Appends \a value to a \l ByteArray buffer.
+*/
+void QSqlColumnBuffer::appendByteArray(const QByteArray &value)
+{
+    d->appendByteArray(value);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSQLCOLUMNBUFFER_H
+#define QSQLCOLUMNBUFFER_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QSqlColumnBufferPrivate;
+
+class Q_SQL_EXPORT QSqlColumnBuffer
+{
+public:
+    enum Type { Int64, Double, String, ByteArray };
+
+    explicit QSqlColumnBuffer(Type type = String);
+    QSqlColumnBuffer(const QSqlColumnBuffer &other);
+    QSqlColumnBuffer &operator=(const QSqlColumnBuffer &other);
+#ifdef Q_COMPILER_RVALUE_REFS
+    QSqlColumnBuffer &operator=(QSqlColumnBuffer &&other) Q_DECL_NOTHROW { swap(other); return *this; }
+#endif
+    ~QSqlColumnBuffer();
+
+    void swap(QSqlColumnBuffer &other) Q_DECL_NOTHROW { qSwap(d, other.d); }
+
+    Type type() const;
+    int size() const;
+    inline bool isEmpty() const { return size() == 0; }
+    void reserve(int size);
+    void clear();
+
+    bool isNull(int row) const;
+    int nullCount() const;
+    const quint32 *nullBitmap() const;
+
+    const qint64 *int64Data() const;
+    const double *doubleData() const;
+    const QString *stringData() const;
+    const QByteArray *byteArrayData() const;
+
+    void appendNull();
+    void appendInt64(qint64 value);
+    void appendDouble(double value);
+    void appendString(const QString &value);
+    void appendByteArray(const QByteArray &value);
+
+private:
+    friend class QSqlColumnBufferPrivate;
+    QSharedDataPointer<QSqlColumnBufferPrivate> d;
+};
+
+Q_DECLARE_SHARED(QSqlColumnBuffer)
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBUFFER_H
@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSQLCOLUMNBUFFER_P_H
+#define QSQLCOLUMNBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Qt SQL driver plugins.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include "qsqlcolumnbuffer.h"
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlColumnBufferPrivate : public QSharedData
+{
+public:
+    explicit QSqlColumnBufferPrivate(QSqlColumnBuffer::Type t)
+        : type(t), size(0), nullCount(0)
+    { }
+
+    // Detaches the buffer, so drivers can fill it without going through
+    // the public API for every value.
+    static QSqlColumnBufferPrivate *get(QSqlColumnBuffer &buffer)
+    { return buffer.d.data(); }
+
+    inline void appendRow(bool isNull)
+    {
+        const int word = size >> 5;
+        if (word == nulls.size())
+            nulls.append(0);
+        if (isNull) {
+            nulls[word] |= 1u << (size & 31);
+            ++nullCount;
+        }
+        ++size;
+    }
+
+    inline void appendNull()
+    {
+        appendRow(true);
+        switch (type) {
+        case QSqlColumnBuffer::Int64:
+            int64s.append(0);
+            break;
+        case QSqlColumnBuffer::Double:
+            doubles.append(0.0);
+            break;
+        case QSqlColumnBuffer::String:
+            strings.append(QString());
+            break;
+        case QSqlColumnBuffer::ByteArray:
+            byteArrays.append(QByteArray());
+            break;
+        }
+    }
+
+    inline void appendInt64(qint64 value)
+    {
+        Q_ASSERT(type == QSqlColumnBuffer::Int64);
+        appendRow(false);
+        int64s.append(value);
+    }
+
+    inline void appendDouble(double value)
+    {
+        Q_ASSERT(type == QSqlColumnBuffer::Double);
+        appendRow(false);
+        doubles.append(value);
+    }
+
+    inline void appendString(const QString &value)
+    {
+        Q_ASSERT(type == QSqlColumnBuffer::String);
+        appendRow(false);
+        strings.append(value);
+    }
+
+    inline void appendByteArray(const QByteArray &value)
+    {
+        Q_ASSERT(type == QSqlColumnBuffer::ByteArray);
+        appendRow(false);
+        byteArrays.append(value);
+    }
+
+    QSqlColumnBuffer::Type type;
+    int size;
+    int nullCount;
+    QVector<quint32> nulls;
+    QVector<qint64> int64s;
+    QVector<double> doubles;
+    QVector<QString> strings;
+    QVector<QByteArray> byteArrays;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBUFFER_P_H
@@ -138,8 +138,11 @@ QSqlDatabasePrivate::QSqlDatabasePrivate(const QSqlDatabasePrivate &other) : ref
 
 QSqlDatabasePrivate::~QSqlDatabasePrivate()
 {
-    if (driver != shared_null()->driver)
+    if (driver != shared_null()->driver) {
+        // cached statements need the connection to be released
+        driver->clearPreparedQueryCache();
         delete driver;
+    }
 }
 
 void QSqlDatabasePrivate::cleanConnections()
@@ -266,6 +269,7 @@ void QSqlDatabasePrivate::copy(const QSqlDatabasePrivate *other)
 void QSqlDatabasePrivate::disable()
 {
     if (driver != shared_null()->driver) {
+        driver->clearPreparedQueryCache();
         delete driver;
         driver = shared_null()->driver;
     }
@@ -755,6 +759,7 @@ QSqlQuery QSqlDatabase::exec(const QString & query) const
 
 bool QSqlDatabase::open()
 {
+    d->driver->clearPreparedQueryCache();
     return d->driver->open(d->dbname, d->uname, d->pword, d->hname,
                             d->port, d->connOptions);
 }
@@ -776,6 +781,7 @@ bool QSqlDatabase::open()
 bool QSqlDatabase::open(const QString& user, const QString& password)
 {
     setUserName(user);
+    d->driver->clearPreparedQueryCache();
     return d->driver->open(d->dbname, user, password, d->hname,
                             d->port, d->connOptions);
 }
@@ -792,6 +798,7 @@ bool QSqlDatabase::open(const QString& user, const QString& password)
 
 void QSqlDatabase::close()
 {
+    d->driver->clearPreparedQueryCache();
     d->driver->close();
 }
 
@@ -59,6 +59,30 @@ static QString prepareIdentifier(const QString &identifier,
     return ret;
 }
 
+QSqlResult *QSqlDriverPrivate::takePreparedQuery(const QString &query)
+{
+    QSqlResult *result = preparedQueries.take(query);
+    if (result)
+        ++preparedQueryHits;
+    else
+        ++preparedQueryMisses;
+    return result;
+}
+
+void QSqlDriverPrivate::cachePreparedQuery(const QString &query, int generation, QSqlResult *result)
+{
+    if (!isOpen || generation != preparedQueryGeneration)
+        delete result;
+    else
+        preparedQueries.insert(query, result); // deletes the result if the cache is disabled
+}
+
+void QSqlDriverPrivate::clearPreparedQueries()
+{
+    preparedQueries.clear();
+    ++preparedQueryGeneration;
+}
+
 /*!
     \class QSqlDriver
     \brief The QSqlDriver class is an abstract base class for accessing
@@ -99,6 +123,8 @@ QSqlDriver::QSqlDriver(QSqlDriverPrivate &dd, QObject *parent)
 
 QSqlDriver::~QSqlDriver()
 {
+    Q_D(QSqlDriver);
+    d->clearPreparedQueries();
 }
 
 /*!
@@ -806,6 +832,92 @@ QSql::NumericalPrecisionPolicy QSqlDriver::numericalPrecisionPolicy() const
     return d->precisionPolicy;
 }
 
+/*!
+    \since 5.12
+
+    Sets the maximum number of prepared statements that are kept for reuse
+    on this connection to \a size. The default is 0, which disables the
+    cache.
+
+    With the cache enabled, a QSqlQuery that is prepared with the same text
+    as an earlier query takes over the statement of that query instead of
+    having the database prepare it again, provided the earlier query has
+    been prepared with another text, executed a statement directly or been
+    destroyed since. Bound values are not carried over. Up to \a size
+    statements are kept, the least recently used one is discarded first.
+
+    The cache only has an effect if the driver supports
+    \l{QSqlDriver::}{PreparedQueries}. It is cleared when the connection is
+    opened or closed through QSqlDatabase, and when a \c CREATE, \c ALTER
+    or \c DROP statement is executed with a QSqlQuery on this connection.
+    Call clearPreparedQueryCache() after the schema has been changed in
+    another way.
+
+    \sa preparedQueryCacheSize(), preparedQueryCacheHits(), QSqlQuery::prepare()
+*/
+void QSqlDriver::setPreparedQueryCacheSize(int size)
+{
+    Q_D(QSqlDriver);
+    d->preparedQueries.setMaxCost(qMax(size, 0));
+}
+
+/*!
+    \since 5.12
+
+    Returns the maximum number of prepared statements that are kept for
+    reuse on this connection.
+
+    \sa setPreparedQueryCacheSize()
+*/
+int QSqlDriver::preparedQueryCacheSize() const
+{
+    Q_D(const QSqlDriver);
+    return d->preparedQueries.maxCost();
+}
+
+/*!
+    \since 5.12
+
+    Discards all prepared statements that are kept for reuse. Statements
+    of queries that are currently prepared are not kept after this call
+    either.
+
+    \sa setPreparedQueryCacheSize()
+*/
+void QSqlDriver::clearPreparedQueryCache()
+{
+    Q_D(QSqlDriver);
+    d->clearPreparedQueries();
+}
+
+/*!
+    \since 5.12
+
+    Returns how often QSqlQuery::prepare() reused a statement from the
+    prepared statement cache.
+
+    \sa preparedQueryCacheMisses(), setPreparedQueryCacheSize()
+*/
+qint64 QSqlDriver::preparedQueryCacheHits() const
+{
+    Q_D(const QSqlDriver);
+    return d->preparedQueryHits;
+}
+
+/*!
+    \since 5.12
+
+    Returns how often QSqlQuery::prepare() had to prepare a statement while
+    the prepared statement cache was enabled.
+
+    \sa preparedQueryCacheHits(), setPreparedQueryCacheSize()
+*/
+qint64 QSqlDriver::preparedQueryCacheMisses() const
+{
+    Q_D(const QSqlDriver);
+    return d->preparedQueryMisses;
+}
+
 /*!
     \since 5.4
     \internal
@@ -131,6 +131,12 @@ public:
 
     DbmsType dbmsType() const;
 
+    void setPreparedQueryCacheSize(int size);
+    int preparedQueryCacheSize() const;
+    void clearPreparedQueryCache();
+    qint64 preparedQueryCacheHits() const;
+    qint64 preparedQueryCacheMisses() const;
+
 public Q_SLOTS:
     virtual bool cancelQuery();
 
@@ -55,6 +55,8 @@
 #include "private/qobject_p.h"
 #include "qsqldriver.h"
 #include "qsqlerror.h"
+#include "qsqlresult.h"
+#include <QtCore/qcache.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -68,14 +70,33 @@ public:
         isOpen(false),
         isOpenError(false),
         precisionPolicy(QSql::LowPrecisionDouble),
-        dbmsType(QSqlDriver::UnknownDbms)
+        dbmsType(QSqlDriver::UnknownDbms),
+        preparedQueries(0),
+        preparedQueryGeneration(0),
+        preparedQueryHits(0),
+        preparedQueryMisses(0)
     { }
 
+    static QSqlDriverPrivate *get(const QSqlDriver *driver)
+    { return static_cast<QSqlDriverPrivate *>(QObjectPrivate::get(const_cast<QSqlDriver *>(driver))); }
+
+    bool isPreparedQueryCacheEnabled() const { return preparedQueries.maxCost() > 0; }
+    QSqlResult *takePreparedQuery(const QString &query);
+    void cachePreparedQuery(const QString &query, int generation, QSqlResult *result);
+    void clearPreparedQueries();
+
     uint isOpen;
     uint isOpenError;
     QSqlError error;
     QSql::NumericalPrecisionPolicy precisionPolicy;
     QSqlDriver::DbmsType dbmsType;
+
+    // Idle results holding a prepared statement, by query text. Results
+    // prepared before the last clearPreparedQueries() are not cached again.
+    QCache<QString, QSqlResult> preparedQueries;
+    int preparedQueryGeneration;
+    qint64 preparedQueryHits;
+    qint64 preparedQueryMisses;
 };
 
 QT_END_NAMESPACE
@@ -44,11 +44,14 @@
 #include "qdebug.h"
 #include "qelapsedtimer.h"
 #include "qatomic.h"
+#include "qsqlcolumnbuffer.h"
 #include "qsqlrecord.h"
 #include "qsqlresult.h"
 #include "qsqldriver.h"
 #include "qsqldatabase.h"
 #include "private/qsqlnulldriver_p.h"
+#include "private/qsqldriver_p.h"
+#include "private/qsqlresult_p.h"
 #include "qvector.h"
 #include "qmap.h"
 
@@ -61,6 +64,14 @@ public:
     ~QSqlQueryPrivate();
     QAtomicInt ref;
     QSqlResult* sqlResult;
+    // Set while sqlResult holds a statement that goes to the prepared
+    // query cache of the driver when it is no longer needed.
+    QString cachedQuery;
+    int cacheGeneration;
+
+    void setResult(QSqlResult *result);
+    void releaseResult();
+    void clearBindings();
 
     static QSqlQueryPrivate* shared_null();
 };
@@ -80,7 +91,7 @@ QSqlQueryPrivate* QSqlQueryPrivate::shared_null()
 \internal
 */
 QSqlQueryPrivate::QSqlQueryPrivate(QSqlResult* result)
-    : ref(1), sqlResult(result)
+    : ref(1), sqlResult(result), cacheGeneration(0)
 {
     if (!sqlResult)
         sqlResult = nullResult();
@@ -88,10 +99,88 @@ QSqlQueryPrivate::QSqlQueryPrivate(QSqlResult* result)
 
 QSqlQueryPrivate::~QSqlQueryPrivate()
 {
+    releaseResult();
+}
+
+/*!
+    \internal
+
+    Replaces the result, keeping its settings.
+*/
+void QSqlQueryPrivate::setResult(QSqlResult *result)
+{
+    const bool forwardOnly = sqlResult->isForwardOnly();
+    const QSql::NumericalPrecisionPolicy precisionPolicy = sqlResult->numericalPrecisionPolicy();
+    releaseResult();
+    sqlResult = result;
+    sqlResult->setForwardOnly(forwardOnly);
+    sqlResult->setNumericalPrecisionPolicy(precisionPolicy);
+}
+
+/*!
+    \internal
+
+    Hands the result over to the prepared query cache of the driver if it
+    holds a cacheable statement, deletes it otherwise.
+*/
+void QSqlQueryPrivate::releaseResult()
+{
+    QSqlResult *result = sqlResult;
+    sqlResult = nullptr;
     QSqlResult *nr = nullResult();
-    if (!nr || sqlResult == nr)
+    if (!nr || !result || result == nr)
         return;
-    delete sqlResult;
+
+    const QSqlDriver *driver = result->driver();
+    if (cachedQuery.isEmpty() || !driver) {
+        delete result;
+        return;
+    }
+    if (result->isActive()) {
+        result->setLastError(QSqlError());
+        result->setAt(QSql::BeforeFirstRow);
+        result->d_ptr->discardResultSet();
+        result->setActive(false);
+    }
+    QSqlDriverPrivate::get(driver)->cachePreparedQuery(cachedQuery, cacheGeneration, result);
+    cachedQuery.clear();
+}
+
+/*!
+    \internal
+
+    Clears the values bound to a statement taken from the prepared query
+    cache.
+*/
+void QSqlQueryPrivate::clearBindings()
+{
+    sqlResult->d_ptr->clearValues();
+    sqlResult->d_ptr->types.clear();
+}
+
+/*!
+    \internal
+
+    Schema changes may invalidate prepared statements, so they clear the
+    prepared query cache of the driver.
+*/
+static void qCheckSchemaChange(const QSqlDriver *driver, const QString &query)
+{
+    if (!driver)
+        return;
+    QSqlDriverPrivate *driverPrivate = QSqlDriverPrivate::get(driver);
+    if (!driverPrivate->isPreparedQueryCacheEnabled())
+        return;
+
+    int i = 0;
+    while (i < query.size() && query.at(i).isSpace())
+        ++i;
+    const QStringRef statement = query.midRef(i, 6);
+    if (statement.startsWith(QLatin1String("create"), Qt::CaseInsensitive)
+            || statement.startsWith(QLatin1String("alter"), Qt::CaseInsensitive)
+            || statement.startsWith(QLatin1String("drop"), Qt::CaseInsensitive)) {
+        driverPrivate->clearPreparedQueries();
+    }
 }
 
 /*!
@@ -380,6 +469,9 @@ bool QSqlQuery::exec(const QString& query)
         d->sqlResult->setNumericalPrecisionPolicy(d->sqlResult->numericalPrecisionPolicy());
         setForwardOnly(fo);
     } else {
+        // Keep a cached prepared statement for later use.
+        if (!d->cachedQuery.isEmpty() && driver())
+            d->setResult(driver()->createResult());
         d->sqlResult->clear();
         d->sqlResult->setActive(false);
         d->sqlResult->setLastError(QSqlError());
@@ -397,6 +489,8 @@ bool QSqlQuery::exec(const QString& query)
     }
 
     bool retval = d->sqlResult->reset(query);
+    if (retval)
+        qCheckSchemaChange(driver(), query);
 #ifdef QT_DEBUG_SQL
     qDebug().nospace() << "Executed query (" << t.elapsed() << "ms, " << d->sqlResult->size()
                        << " results, " << d->sqlResult->numRowsAffected()
@@ -756,6 +850,72 @@ bool QSqlQuery::last()
     return d->sqlResult->fetchLast();
 }
 
+/*!
+  \since 5.12
+
+  Retrieves up to \a maxRows records following the current one and
+  stores their values in \a columns, one QSqlColumnBuffer per field of
+  the result. Returns the number of records retrieved, which is 0 once
+  the end of the result is reached.
+
+  The buffers are cleared first. The value of field \c i of each record
+  is converted to the QSqlColumnBuffer::Type of \c{columns[i]}; fields
+  without a buffer are skipped, and buffers without a field receive
+  NULL values.
+
+  This is equivalent to calling next() up to \a maxRows times and
+  reading every value with value(), and leaves the query positioned the
+  same way. It is much faster for large results, because the SQLite and
+  PostgreSQL drivers store the values directly in the buffers instead
+  of creating a QVariant for each of them. The SQLite driver only does
+  so for \l{setForwardOnly()}{forward only} queries; other drivers
+  always fall back to value().
+
+  \snippet code/src_sql_kernel_qsqlquery.cpp 4
+
+  \sa next(), setForwardOnly(), QSqlColumnBuffer
+*/
+int QSqlQuery::fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows)
+{
+    for (QSqlColumnBuffer &column : columns)
+        column.clear();
+    if (!isSelect() || !isActive() || maxRows <= 0 || at() == QSql::AfterLastRow)
+        return 0;
+
+    const int fetched = d->sqlResult->d_ptr->fetchColumns(columns, maxRows);
+    if (fetched >= 0)
+        return fetched;
+
+    const int fieldCount = d->sqlResult->record().count();
+    int rows = 0;
+    while (rows < maxRows && next()) {
+        for (int i = 0; i < columns.size(); ++i) {
+            QSqlColumnBuffer &column = columns[i];
+            if (i >= fieldCount || d->sqlResult->isNull(i)) {
+                column.appendNull();
+                continue;
+            }
+            const QVariant value = d->sqlResult->data(i);
+            switch (column.type()) {
+            case QSqlColumnBuffer::Int64:
+                column.appendInt64(value.toLongLong());
+                break;
+            case QSqlColumnBuffer::Double:
+                column.appendDouble(value.toDouble());
+                break;
+            case QSqlColumnBuffer::String:
+                column.appendString(value.toString());
+                break;
+            case QSqlColumnBuffer::ByteArray:
+                column.appendByteArray(value.toByteArray());
+                break;
+            }
+        }
+        ++rows;
+    }
+    return rows;
+}
+
 /*!
   Returns the size of the result (number of rows returned), or -1 if
   the size cannot be determined or if the database does not support
@@ -950,6 +1110,10 @@ void QSqlQuery::clear()
   For SQLite, the query string can contain only one statement at a time.
   If more than one statement is given, the function returns \c false.
 
+  If the prepared statement cache of the driver is enabled, a statement
+  that was prepared with the same text before may be reused. Values bound
+  to it before are cleared. See QSqlDriver::setPreparedQueryCacheSize().
+
   Example:
 
   \snippet sqldatabase/sqldatabase.cpp 9
@@ -984,7 +1148,32 @@ bool QSqlQuery::prepare(const QString& query)
 #ifdef QT_DEBUG_SQL
     qDebug("\n QSqlQuery::prepare: %s", query.toLocal8Bit().constData());
 #endif
-    return d->sqlResult->savePrepare(query);
+    QSqlDriverPrivate *driverPrivate = QSqlDriverPrivate::get(driver());
+    if (!driverPrivate->isPreparedQueryCacheEnabled()
+            || !driver()->hasFeature(QSqlDriver::PreparedQueries)) {
+        d->cachedQuery.clear();
+        return d->sqlResult->savePrepare(query);
+    }
+
+    if (d->cachedQuery == query && d->cacheGeneration == driverPrivate->preparedQueryGeneration) {
+        ++driverPrivate->preparedQueryHits;
+        d->sqlResult->detachFromResultSet();
+        d->clearBindings();
+        return true;
+    }
+    if (QSqlResult *cached = driverPrivate->takePreparedQuery(query)) {
+        d->setResult(cached);
+        d->clearBindings();
+    } else {
+        // Keep the statement of the previous query for later use.
+        if (!d->cachedQuery.isEmpty())
+            d->setResult(driver()->createResult());
+        if (!d->sqlResult->savePrepare(query))
+            return false;
+    }
+    d->cachedQuery = query;
+    d->cacheGeneration = driverPrivate->preparedQueryGeneration;
+    return true;
 }
 
 /*!
@@ -1008,6 +1197,8 @@ bool QSqlQuery::exec()
         d->sqlResult->setLastError(QSqlError());
 
     bool retval = d->sqlResult->exec();
+    if (retval)
+        qCheckSchemaChange(driver(), d->sqlResult->lastQuery());
 #ifdef QT_DEBUG_SQL
     qDebug().nospace() << "Executed prepared query (" << t.elapsed() << "ms, "
                        << d->sqlResult->size() << " results, " << d->sqlResult->numRowsAffected()
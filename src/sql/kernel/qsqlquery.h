@@ -52,7 +52,9 @@ class QSqlDriver;
 class QSqlError;
 class QSqlResult;
 class QSqlRecord;
+class QSqlColumnBuffer;
 template <class Key, class T> class QMap;
+template <typename T> class QVector;
 class QSqlQueryPrivate;
 
 class Q_SQL_EXPORT QSqlQuery
@@ -93,6 +95,7 @@ public:
     bool previous();
     bool first();
     bool last();
+    int fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows);
 
     void clear();
 
@@ -59,6 +59,25 @@ QString QSqlResultPrivate::holderAt(int index) const
     return holders.size() > index ? holders.at(index).holderName : fieldSerial(index);
 }
 
+// Fills the column buffers with up to maxRows rows following the current
+// one, as QSqlQuery::fetchColumns() documents. Drivers that can read their
+// rows without QVariants reimplement this; returning -1 makes QSqlQuery
+// fall back to fetchNext() and data().
+int QSqlResultPrivate::fetchColumns(QVector<QSqlColumnBuffer> &, int)
+{
+    return -1;
+}
+
+// Frees the rows of the current result set but keeps the prepared
+// statement, before the result goes to the prepared query cache of the
+// driver. Drivers that keep their rows outside of the statement handle
+// reimplement this.
+void QSqlResultPrivate::discardResultSet()
+{
+    Q_Q(QSqlResult);
+    q->detachFromResultSet();
+}
+
 // return a unique id for bound names
 QString QSqlResultPrivate::fieldSerial(int i) const
 {
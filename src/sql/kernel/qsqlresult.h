@@ -62,6 +62,7 @@ class Q_SQL_EXPORT QSqlResult
 {
     Q_DECLARE_PRIVATE(QSqlResult)
     friend class QSqlQuery;
+    friend class QSqlQueryPrivate;
     friend class QSqlTableModelPrivate;
     // for testing:
     friend class ::tst_QSqlQuery;
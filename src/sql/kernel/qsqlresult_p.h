@@ -59,6 +59,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QSqlColumnBuffer;
+
 // convenience method Q*ResultPrivate::drv_d_func() returns pointer to private driver. Compare to Q_DECLARE_PRIVATE in qglobal.h.
 #define Q_DECLARE_SQLDRIVER_PRIVATE(Class) \
     inline const Class##Private* drv_d_func() const { return !sqldriver ? nullptr : reinterpret_cast<const Class *>(static_cast<const QSqlDriver*>(sqldriver))->d_func(); } \
@@ -115,6 +117,8 @@ public:
     }
 
     virtual QString fieldSerial(int) const;
+    virtual int fetchColumns(QVector<QSqlColumnBuffer> &columns, int maxRows);
+    virtual void discardResultSet();
     QString positionalToNamedBinding(const QString &query) const;
     QString namedToPositionalBinding(const QString &query);
     QString holderAt(int index) const;
@@ -58,8 +58,21 @@ void QSqlQueryModelPrivate::prefetch(int limit)
     QModelIndex newBottom;
     const int oldBottomRow = qMax(bottom.row(), 0);
 
-    // try to seek directly
-    if (query.seek(limit)) {
+    if (windowed) {
+        // move the window past the known rows until it reaches limit
+        int lastRow = bottom.row();
+        while (!atEnd && lastRow < limit) {
+            if (!loadWindow(lastRow + 1) || windowStart + windowRowCount - 1 <= lastRow) {
+                atEnd = true;
+                break;
+            }
+            lastRow = windowStart + windowRowCount - 1;
+            if (windowRowCount < windowSize)
+                atEnd = true;
+        }
+        newBottom = q->createIndex(lastRow, bottom.column());
+    } else if (query.seek(limit)) {
+        // try to seek directly
         newBottom = q->createIndex(limit, bottom.column());
     } else {
         // have to seek back to our old position for MS Access
@@ -100,6 +113,100 @@ int QSqlQueryModelPrivate::columnInQuery(int modelColumn) const
     return modelColumn - colOffsets[modelColumn];
 }
 
+// The window is read by appending LIMIT and OFFSET to the statement
+// itself; wrapping it in a derived table would neither keep its ORDER BY
+// nor accept duplicate column names on MySQL. That is only done for a
+// single SELECT that does not end in clauses of its own which LIMIT
+// would conflict with.
+bool QSqlQueryModelPrivate::canUseWindow(const QSqlDatabase &db, const QString &statement)
+{
+    switch (db.driver()->dbmsType()) {
+    case QSqlDriver::SQLite:
+    case QSqlDriver::PostgreSQL:
+    case QSqlDriver::MySqlServer:
+        break;
+    default:
+        return false;
+    }
+
+    bool first = true;
+    for (int i = 0; i < statement.size(); ) {
+        const QChar c = statement.at(i);
+        if (c == QLatin1Char('\'') || c == QLatin1Char('"') || c == QLatin1Char('`')) {
+            // skip quoted strings and identifiers
+            const int end = statement.indexOf(c, i + 1);
+            if (end < 0)
+                return false;
+            i = end + 1;
+        } else if (c == QLatin1Char(';') || c == QLatin1Char('#')
+                   || statement.midRef(i, 2) == QLatin1String("--")
+                   || statement.midRef(i, 2) == QLatin1String("/*")) {
+            // several statements, or a comment that would swallow the LIMIT
+            return false;
+        } else if (c.isLetter() || c == QLatin1Char('_')) {
+            int end = i + 1;
+            while (end < statement.size()
+                   && (statement.at(end).isLetterOrNumber() || statement.at(end) == QLatin1Char('_')))
+                ++end;
+            const QStringRef word = statement.midRef(i, end - i);
+            if (first) {
+                if (word.compare(QLatin1String("select"), Qt::CaseInsensitive) != 0)
+                    return false;
+                first = false;
+            } else if (word.compare(QLatin1String("limit"), Qt::CaseInsensitive) == 0
+                       || word.compare(QLatin1String("offset"), Qt::CaseInsensitive) == 0
+                       || word.compare(QLatin1String("fetch"), Qt::CaseInsensitive) == 0
+                       || word.compare(QLatin1String("for"), Qt::CaseInsensitive) == 0
+                       || word.compare(QLatin1String("into"), Qt::CaseInsensitive) == 0) {
+                return false;
+            }
+            i = end;
+        } else {
+            ++i;
+        }
+    }
+    return !first;
+}
+
+// Reads the window of rows around row, keeping a quarter of the window
+// before it for scrolling back.
+bool QSqlQueryModelPrivate::loadWindow(int row)
+{
+    const int start = qMax(row - windowSize / 4, 0);
+    const QString statement = windowQuery + QLatin1String(" LIMIT ") + QString::number(windowSize)
+            + QLatin1String(" OFFSET ") + QString::number(start);
+
+    windowValues.clear();
+    windowStart = start;
+    windowRowCount = 0;
+
+    QSqlQuery page(windowDb);
+    page.setForwardOnly(true);
+    if (!page.exec(statement)) {
+        error = page.lastError();
+        return false;
+    }
+    windowColumnCount = page.record().count();
+    while (page.next()) {
+        for (int i = 0; i < windowColumnCount; ++i)
+            windowValues.append(page.value(i));
+        ++windowRowCount;
+    }
+    query = page;
+    return true;
+}
+
+void QSqlQueryModelPrivate::clearWindow()
+{
+    windowed = false;
+    windowQuery.clear();
+    windowDb = QSqlDatabase();
+    windowValues = QVector<QVariant>();
+    windowStart = 0;
+    windowRowCount = 0;
+    windowColumnCount = 0;
+}
+
 /*!
     \class QSqlQueryModel
     \brief The QSqlQueryModel class provides a read-only data model for SQL
@@ -144,6 +251,11 @@ int QSqlQueryModelPrivate::columnInQuery(int modelColumn) const
     a query, the model will fetch rows incrementally.
     See fetchMore() for more information.
 
+    By default the query keeps every row that was read, so scrolling
+    through a large result eventually holds all of it in memory. See
+    setWindowSize() for a mode that only keeps the rows around the
+    ones accessed last.
+
     \sa QSqlTableModel, QSqlRelationalTableModel, QSqlQuery,
         {Model/View Programming}, {Query Model Example}
 */
@@ -378,6 +490,18 @@ QVariant QSqlQueryModel::data(const QModelIndex &item, int role) const
     if (dItem.row() > d->bottom.row())
         const_cast<QSqlQueryModelPrivate *>(d)->prefetch(dItem.row());
 
+    if (d->windowed) {
+        if (!dItem.isValid() || dItem.row() > d->bottom.row())
+            return v;
+        if (!d->windowContains(dItem.row())
+            && !const_cast<QSqlQueryModelPrivate *>(d)->loadWindow(dItem.row()))
+            return v;
+        if (!d->windowContains(dItem.row()) || dItem.column() >= d->windowColumnCount)
+            return v;
+        return d->windowValues.at((dItem.row() - d->windowStart) * d->windowColumnCount
+                                  + dItem.column());
+    }
+
     if (!d->query.seek(dItem.row())) {
         d->error = d->query.lastError();
         return v;
@@ -443,6 +567,7 @@ void QSqlQueryModel::setQuery(const QSqlQuery &query)
 
     d->bottom = QModelIndex();
     d->error = QSqlError();
+    d->clearWindow();
     d->query = query;
     d->rec = newRec;
     d->atEnd = true;
@@ -488,11 +613,99 @@ void QSqlQueryModel::setQuery(const QSqlQuery &query)
     Example:
     \snippet code/src_sql_models_qsqlquerymodel.cpp 1
 
+    If windowSize() is greater than 0, the model only keeps a window of
+    rows of the result; see setWindowSize().
+
     \sa query(), queryChange(), lastError()
 */
 void QSqlQueryModel::setQuery(const QString &query, const QSqlDatabase &db)
 {
-    setQuery(QSqlQuery(query, db));
+    Q_D(QSqlQueryModel);
+    const QSqlDatabase database = db.isValid() ? db : QSqlDatabase::database();
+    QString statement = query.trimmed();
+    while (statement.endsWith(QLatin1Char(';')))
+        statement.chop(1);
+    if (d->windowSize <= 0 || !d->canUseWindow(database, statement)) {
+        setQuery(QSqlQuery(query, db));
+        return;
+    }
+
+    beginResetModel();
+
+    d->bottom = QModelIndex();
+    d->error = QSqlError();
+    d->clearWindow();
+    d->windowed = true;
+    d->windowQuery = statement;
+    d->windowDb = database;
+    d->atEnd = true;
+
+    QSqlRecord newRec;
+    if (d->loadWindow(0))
+        newRec = d->query.record();
+    if (d->colOffsets.size() != newRec.count() || newRec != d->rec)
+        d->initColOffsets(newRec.count());
+    d->rec = newRec;
+
+    if (d->error.isValid()) {
+        endResetModel();
+        return;
+    }
+
+    // the number of rows becomes known as the window moves down
+    d->bottom = createIndex(d->windowRowCount - 1, d->rec.count() - 1);
+    d->atEnd = d->windowRowCount < d->windowSize;
+
+    endResetModel();
+    queryChange();
+}
+
+/*!
+    \since 5.12
+
+    Sets the number of rows the model keeps in memory to \a rows.
+
+    By default, or if \a rows is 0, the query set on the model keeps
+    every row it has read. Otherwise, setQuery(const QString &, const
+    QSqlDatabase &) runs the statement one window of \a rows rows at a
+    time, with a forward only query and \c LIMIT and \c OFFSET
+    clauses appended to it. Only the current window is kept. Accessing a row outside
+    of it runs the statement again for the window around that row.
+    rowCount() grows as the window moves down the result, and
+    canFetchMore() returns \c true until its end is reached, so views
+    read the result incrementally, as they do for databases that do
+    not report the size of a query.
+
+    Rows are only found again at the same position if the statement
+    orders them uniquely, for example with an \c{ORDER BY} on the
+    primary key. The windowed mode is supported for SQLite, PostgreSQL
+    and MySQL, and for a single \c SELECT statement without comments
+    and without \c LIMIT, \c OFFSET, \c FETCH, \c FOR or \c INTO
+    clauses. For other databases and statements, and for queries set
+    with setQuery(const QSqlQuery &), the whole result is kept as usual.
+
+    The new size takes effect the next time a query is set.
+
+    \sa windowSize(), fetchMore()
+*/
+void QSqlQueryModel::setWindowSize(int rows)
+{
+    Q_D(QSqlQueryModel);
+    d->windowSize = qMax(rows, 0);
+}
+
+/*!
+    \since 5.12
+
+    Returns the number of rows the model keeps in memory, or 0 if it
+    keeps all of them.
+
+    \sa setWindowSize()
+*/
+int QSqlQueryModel::windowSize() const
+{
+    Q_D(const QSqlQueryModel);
+    return d->windowSize;
 }
 
 /*!
@@ -509,6 +722,7 @@ void QSqlQueryModel::clear()
     d->colOffsets.clear();
     d->bottom = QModelIndex();
     d->headers.clear();
+    d->clearWindow();
     endResetModel();
 }
 
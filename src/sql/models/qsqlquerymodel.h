@@ -79,6 +79,9 @@ public:
     void setQuery(const QString &query, const QSqlDatabase &db = QSqlDatabase());
     QSqlQuery query() const;
 
+    void setWindowSize(int rows);
+    int windowSize() const;
+
     virtual void clear();
 
     QSqlError lastError() const;
@@ -66,21 +66,39 @@ class QSqlQueryModelPrivate: public QAbstractItemModelPrivate
 {
     Q_DECLARE_PUBLIC(QSqlQueryModel)
 public:
-    QSqlQueryModelPrivate() : atEnd(false), nestedResetLevel(0) {}
+    QSqlQueryModelPrivate() : atEnd(false), windowed(false), nestedResetLevel(0),
+        windowSize(0), windowStart(0), windowRowCount(0), windowColumnCount(0) {}
     ~QSqlQueryModelPrivate();
 
     void prefetch(int);
     void initColOffsets(int size);
     int columnInQuery(int modelColumn) const;
 
+    static bool canUseWindow(const QSqlDatabase &db, const QString &statement);
+    bool loadWindow(int row);
+    void clearWindow();
+    inline bool windowContains(int row) const
+    { return row >= windowStart && row < windowStart + windowRowCount; }
+
     mutable QSqlQuery query;
     mutable QSqlError error;
     QModelIndex bottom;
     QSqlRecord rec;
     uint atEnd : 1;
+    uint windowed : 1;
     QVector<QHash<int, QVariant> > headers;
     QVarLengthArray<int, 56> colOffsets; // used to calculate indexInQuery of columns
     int nestedResetLevel;
+
+    // windowed mode: only the rows [windowStart, windowStart + windowRowCount)
+    // are kept, the statement is re-run with LIMIT/OFFSET to move the window
+    int windowSize;
+    QString windowQuery;
+    QSqlDatabase windowDb;
+    QVector<QVariant> windowValues;
+    int windowStart;
+    int windowRowCount;
+    int windowColumnCount;
 };
 
 // helpers for building SQL expressions
@@ -587,6 +587,122 @@ void tst_QCoreApplication::globalPostedEventsCount()
     QCOMPARE(x.globalPostedEventsCount, expected);
 }
 
+class QueuedCallRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    QList<int> recorded;
+
+    bool event(QEvent *event)
+    {
+        if (event->type() >= QEvent::User) {
+            recorded.append(event->type());
+            return true;
+        }
+        return QObject::event(event);
+    }
+
+public slots:
+    void record(int value)
+    {
+        recorded.append(value);
+    }
+};
+
+void tst_QCoreApplication::queuedCallsAndPostedEvents()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    // queued calls don't take the posted event list lock, but must still be
+    // delivered in order with the other posted events
+    QueuedCallRecorder recorder;
+    QMetaObject::invokeMethod(&recorder, "record", Qt::QueuedConnection, Q_ARG(int, 1));
+    QCoreApplication::postEvent(&recorder, new QEvent(QEvent::Type(QEvent::User + 2)));
+    QMetaObject::invokeMethod(&recorder, "record", Qt::QueuedConnection, Q_ARG(int, 3));
+    QCoreApplication::postEvent(&recorder, new QEvent(QEvent::Type(QEvent::User + 4)), Qt::HighEventPriority);
+    QMetaObject::invokeMethod(&recorder, "record", Qt::QueuedConnection, Q_ARG(int, 5));
+    QCOMPARE(qGlobalPostedEventsCount(), 5u);
+
+    QCoreApplication::sendPostedEvents();
+    QList<int> expected = QList<int>()
+                          << QEvent::User + 4
+                          << 1
+                          << QEvent::User + 2
+                          << 3
+                          << 5;
+    QCOMPARE(recorder.recorded, expected);
+    QCOMPARE(qGlobalPostedEventsCount(), 0u);
+
+    // and they can be removed like any other posted event
+    recorder.recorded.clear();
+    QMetaObject::invokeMethod(&recorder, "record", Qt::QueuedConnection, Q_ARG(int, 6));
+    QCoreApplication::removePostedEvents(&recorder, QEvent::MetaCall);
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(recorder.recorded.isEmpty());
+
+    // including when the receiver is destroyed
+    QPointer<QueuedCallRecorder> destroyed = new QueuedCallRecorder;
+    QMetaObject::invokeMethod(destroyed, "record", Qt::QueuedConnection, Q_ARG(int, 7));
+    delete destroyed;
+    QCoreApplication::sendPostedEvents();
+}
+
+#ifndef QT_NO_THREAD
+class QueuedCallProducer : public QThread
+{
+public:
+    QueuedCallProducer(QObject *receiver, int first, int count)
+        : receiver(receiver), first(first), count(count)
+    { }
+
+protected:
+    void run() override
+    {
+        for (int i = first; i < first + count; ++i)
+            QMetaObject::invokeMethod(receiver, "record", Qt::QueuedConnection, Q_ARG(int, i));
+    }
+
+private:
+    QObject *receiver;
+    int first;
+    int count;
+};
+
+void tst_QCoreApplication::queuedCallsFromThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const int producerCount = 4;
+    const int callCount = 5000;
+
+    QueuedCallRecorder recorder;
+    QVector<QueuedCallProducer *> producers;
+    for (int i = 0; i < producerCount; ++i)
+        producers.append(new QueuedCallProducer(&recorder, i * callCount, callCount));
+    for (QueuedCallProducer *producer : qAsConst(producers))
+        producer->start();
+    for (QueuedCallProducer *producer : qAsConst(producers))
+        QVERIFY(producer->wait());
+    qDeleteAll(producers);
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(recorder.recorded.size(), producerCount * callCount);
+
+    // the calls made by one thread arrive in the order they were made
+    QVector<int> last(producerCount, -1);
+    for (int value : qAsConst(recorder.recorded)) {
+        const int producer = value / callCount;
+        QVERIFY(value > last.at(producer));
+        last[producer] = value;
+    }
+}
+#endif
+
 class ProcessEventsAlwaysSendsPostedEventsObject : public QObject
 {
 public:
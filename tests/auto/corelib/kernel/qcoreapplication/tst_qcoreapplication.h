@@ -48,6 +48,10 @@ private slots:
 #endif
     void applicationPid();
     void globalPostedEventsCount();
+    void queuedCallsAndPostedEvents();
+#ifndef QT_NO_THREAD
+    void queuedCallsFromThreads();
+#endif
     void processEventsAlwaysSendsPostedEvents();
     void reexec();
     void execAfterExit();
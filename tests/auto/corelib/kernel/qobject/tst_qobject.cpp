@@ -91,6 +91,7 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void queuedBatchedConnection();
     void childEvents();
     void installEventFilter();
     void deleteSelfInSlot();
@@ -3074,6 +3075,135 @@ void tst_QObject::blockingQueuedConnection()
     }
 }
 
+class BatchedSender : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void valueChanged(int value, const QString &text);
+};
+
+class BatchedReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    BatchedReceiver() : metaCallEvents(0) { }
+
+    QVector<int> values;
+    QStringList texts;
+    int metaCallEvents;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() == QEvent::MetaCall)
+            ++metaCallEvents;
+        return QObject::event(event);
+    }
+
+public slots:
+    void receive(int value, const QString &text)
+    {
+        values.append(value);
+        texts.append(text);
+    }
+};
+
+class BatchedEmitterThread : public QThread
+{
+public:
+    BatchedEmitterThread(BatchedSender *sender, int count)
+        : sender(sender), count(count)
+    { }
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            emit sender->valueChanged(i, QString::number(i));
+    }
+
+private:
+    BatchedSender *sender;
+    int count;
+};
+
+void tst_QObject::queuedBatchedConnection()
+{
+    BatchedSender sender;
+    BatchedReceiver receiver;
+
+    // consecutive emissions are delivered with a single event, in order
+    QVERIFY(connect(&sender, SIGNAL(valueChanged(int,QString)),
+                    &receiver, SLOT(receive(int,QString)), Qt::QueuedBatchedConnection));
+    for (int i = 0; i < 100; ++i)
+        emit sender.valueChanged(i, QString::number(i));
+    QVERIFY(receiver.values.isEmpty());
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.metaCallEvents, 1);
+    QCOMPARE(receiver.values.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(receiver.values.at(i), i);
+        QCOMPARE(receiver.texts.at(i), QString::number(i));
+    }
+
+    // once delivered, the next emission starts a new batch
+    emit sender.valueChanged(100, QStringLiteral("last"));
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.metaCallEvents, 2);
+    QCOMPARE(receiver.values.size(), 101);
+    QCOMPARE(receiver.texts.last(), QStringLiteral("last"));
+    QVERIFY(sender.disconnect(&receiver));
+
+    // functors
+    int sum = 0;
+    int calls = 0;
+    connect(&sender, &BatchedSender::valueChanged, &receiver, [&](int value) {
+        sum += value;
+        ++calls;
+    }, Qt::QueuedBatchedConnection);
+    for (int i = 1; i <= 10; ++i)
+        emit sender.valueChanged(i, QString());
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(calls, 10);
+    QCOMPARE(sum, 55);
+    QVERIFY(sender.disconnect(&receiver));
+
+    // pending emissions are dropped with the receiver
+    BatchedReceiver *deleted = new BatchedReceiver;
+    connect(&sender, &BatchedSender::valueChanged, deleted, &BatchedReceiver::receive,
+            Qt::QueuedBatchedConnection);
+    emit sender.valueChanged(1, QStringLiteral("one"));
+    emit sender.valueChanged(2, QStringLiteral("two"));
+    delete deleted;
+    QCoreApplication::sendPostedEvents();
+
+    // removing the pending event drops the emissions it carries
+    connect(&sender, &BatchedSender::valueChanged, &receiver, &BatchedReceiver::receive,
+            Qt::QueuedBatchedConnection);
+    receiver.values.clear();
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    emit sender.valueChanged(1, QString());
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    emit sender.valueChanged(2, QString());
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.values, QVector<int>() << 2);
+    QVERIFY(sender.disconnect(&receiver));
+
+    // from another thread
+    receiver.values.clear();
+    receiver.texts.clear();
+    connect(&sender, &BatchedSender::valueChanged, &receiver, &BatchedReceiver::receive,
+            Qt::QueuedBatchedConnection);
+    BatchedEmitterThread thread(&sender, 10000);
+    thread.start();
+    QVERIFY(thread.wait());
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.values.size(), 10000);
+    for (int i = 0; i < 10000; ++i)
+        QCOMPARE(receiver.values.at(i), i);
+}
+
 class EventSpy : public QObject
 {
     Q_OBJECT
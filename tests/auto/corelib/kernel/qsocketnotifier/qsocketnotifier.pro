@@ -1,8 +1,6 @@
-CONFIG += testcase
-TARGET = tst_qsocketnotifier
-QT = core-private network-private testlib
-SOURCES = tst_qsocketnotifier.cpp
+TEMPLATE = subdirs
+SUBDIRS = test
 
-requires(qtConfig(private_tests))
-
-include(../../../network/socket/platformsocketengine/platformsocketengine.pri)
+# runs the same tests with the epoll backend of QEventDispatcherUNIX
+QT_FOR_CONFIG += core-private
+qtConfig(epoll): SUBDIRS += epoll
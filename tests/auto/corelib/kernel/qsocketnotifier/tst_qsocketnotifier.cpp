@@ -33,6 +33,8 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QThread>
+#include <QtCore/QEventLoop>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -44,8 +46,10 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
+#include <algorithm>
 #include <limits>
 
 #if defined (Q_CC_MSVC) && defined(max)
@@ -53,6 +57,16 @@
 #  undef min
 #endif // Q_CC_MSVC
 
+#ifdef TST_QSOCKETNOTIFIER_EPOLL
+// tst_qsocketnotifier_epoll runs all tests with the epoll backend
+static void useEpollBackend()
+{
+    qputenv("QT_NO_GLIB", "1");
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+}
+Q_CONSTRUCTOR_FUNCTION(useEpollBackend)
+#endif
+
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
@@ -61,6 +75,8 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void invalidSocket();
+    void epollBackend();
 #endif
     void asyncMultipleDatagram();
 
@@ -323,6 +339,116 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+void tst_QSocketNotifier::invalidSocket()
+{
+    // a descriptor that is already closed when the notifier is created
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds), 0);
+    qt_safe_close(fds[0]);
+    {
+        QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+        QTest::ignoreMessage(QtWarningMsg, qPrintable(QString::fromLatin1(
+            "QSocketNotifier: Invalid socket %1 with type Read, disabling...").arg(fds[0])));
+        QTRY_VERIFY(!notifier.isEnabled());
+    }
+    qt_safe_close(fds[1]);
+
+    // a descriptor that is closed while its notifier is enabled, with a
+    // duplicate keeping the file open; the peer hanging up wakes it
+    int sockets[2];
+    QCOMPARE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    {
+        QSocketNotifier notifier(sockets[0], QSocketNotifier::Read);
+        QCoreApplication::processEvents();
+        const int duplicate = qt_safe_dup(sockets[0]);
+        QVERIFY(duplicate != -1);
+        qt_safe_close(sockets[0]);
+        qt_safe_close(sockets[1]);
+        QTest::ignoreMessage(QtWarningMsg, qPrintable(QString::fromLatin1(
+            "QSocketNotifier: Invalid socket %1 with type Read, disabling...").arg(sockets[0])));
+        QTRY_VERIFY(!notifier.isEnabled());
+        qt_safe_close(duplicate);
+    }
+}
+
+class ManyPipesThread : public QThread
+{
+public:
+    enum { PipeCount = 64, Stride = 8 };
+
+    QVector<int> activated;
+    bool reenabledActivated = false;
+
+protected:
+    void run() override
+    {
+        int fds[PipeCount][2];
+        QVector<QSocketNotifier *> notifiers;
+        QEventLoop loop;
+
+        for (int i = 0; i < PipeCount; ++i) {
+            if (qt_safe_pipe(fds[i], O_NONBLOCK) == -1)
+                return;
+            QSocketNotifier *notifier = new QSocketNotifier(fds[i][0], QSocketNotifier::Read);
+            QObject::connect(notifier, &QSocketNotifier::activated, [&, i](int fd) {
+                char c;
+                qt_safe_read(fd, &c, 1);
+                if (i == 0) {
+                    reenabledActivated = true;
+                    loop.quit();
+                    return;
+                }
+                activated.append(i);
+                if (activated.size() == PipeCount / Stride - 1)
+                    loop.quit();
+            });
+            notifiers.append(notifier);
+        }
+
+        // a disabled notifier must stay silent even though its pipe is readable
+        notifiers.at(0)->setEnabled(false);
+        for (int i = 0; i < PipeCount; i += Stride)
+            qt_safe_write(fds[i][1], "x", 1);
+        QTimer::singleShot(2000, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        notifiers.at(0)->setEnabled(true);
+        QTimer::singleShot(2000, &loop, &QEventLoop::quit);
+        loop.exec();
+
+        qDeleteAll(notifiers);
+        for (int i = 0; i < PipeCount; ++i) {
+            qt_safe_close(fds[i][0]);
+            qt_safe_close(fds[i][1]);
+        }
+    }
+};
+
+void tst_QSocketNotifier::epollBackend()
+{
+#if !QT_CONFIG(epoll)
+    QSKIP("This test requires epoll support");
+#else
+    const bool epollSelected = qEnvironmentVariableIsSet("QT_EVENT_DISPATCHER_EPOLL");
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX *dispatcher = new QEventDispatcherUNIX;
+    if (!epollSelected)
+        qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    ManyPipesThread thread;
+    thread.setEventDispatcher(dispatcher);
+    thread.start();
+    QVERIFY(thread.wait(10000));
+
+    std::sort(thread.activated.begin(), thread.activated.end());
+    QVector<int> expected;
+    for (int i = ManyPipesThread::Stride; i < ManyPipesThread::PipeCount; i += ManyPipesThread::Stride)
+        expected.append(i);
+    QCOMPARE(thread.activated, expected);
+    QVERIFY(thread.reenabledActivated);
+#endif
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
@@ -67,6 +67,7 @@ private slots:
     void timerFiresOnlyOncePerProcessEvents();
     void timerIdPersistsAfterThreadExit();
     void cancelLongTimer();
+    void timersFireInOrder();
     void singleShotStaticFunctionZeroTimeout();
     void recurseOnTimeoutAndStopTimer();
     void singleShotToFunctors();
@@ -645,6 +646,31 @@ void tst_QTimer::cancelLongTimer()
     QVERIFY(!timer.isActive());
 }
 
+void tst_QTimer::timersFireInOrder()
+{
+    // the intervals span several levels of the timer wheel in QTimerInfoList
+    const int intervals[] = { 700, 0, 270, 30, 1, 600, 255, 256, 60 * 60 * 1000 };
+
+    QVector<int> fired;
+    QObject context;
+    QTimer longTimer;
+    longTimer.setSingleShot(true);
+    for (int interval : intervals) {
+        if (interval == 60 * 60 * 1000) {
+            longTimer.start(interval);
+            continue;
+        }
+        QTimer::singleShot(interval, Qt::PreciseTimer, &context, [&fired, interval]() {
+            fired << interval;
+        });
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(fired.size(), 8, 5000);
+    QCOMPARE(fired, QVector<int>({ 0, 1, 30, 255, 256, 270, 600, 700 }));
+    QVERIFY(longTimer.isActive());
+    QVERIFY(longTimer.remainingTime() > 59 * 60 * 1000);
+}
+
 class TimeoutCounter : public QObject
 {
     Q_OBJECT
@@ -119,6 +119,11 @@ private Q_SLOTS:
     void testCompactionError();
 
     void parseUnicodeEscapes();
+    void parseStringRuns_data();
+    void parseStringRuns();
+    void parseMultiByteRuns_data();
+    void parseMultiByteRuns();
+    void parseWhitespaceRuns();
 
     void assignObjects();
     void assignArrays();
@@ -2357,6 +2362,120 @@ void tst_QtJson::parseUnicodeEscapes()
     QCOMPARE(array.first().toString(), result);
 }
 
+void tst_QtJson::parseStringRuns_data()
+{
+    QTest::addColumn<QByteArray>("special");
+    QTest::addColumn<QString>("decoded");
+
+    QTest::newRow("escape") << QByteArray("\\t") << QString("\t");
+    QTest::newRow("unicode-escape") << QByteArray("\\u00e4") << QString(QChar(0xe4));
+    QTest::newRow("latin1") << QByteArray("\xc3\xa4") << QString(QChar(0xe4));
+    QTest::newRow("non-latin1") << QByteArray("\xe2\x82\xac") << QString(QChar(0x20ac));
+    QTest::newRow("non-bmp") << QByteArray("\xf0\x9f\x98\x80") << QString::fromUcs4(U"\U0001F600");
+    QTest::newRow("control") << QByteArray("\x01") << QString(QChar(1));
+}
+
+void tst_QtJson::parseStringRuns()
+{
+    // plain ASCII runs are scanned in blocks; check that the special
+    // characters are found wherever they are relative to block boundaries
+    QFETCH(QByteArray, special);
+    QFETCH(QString, decoded);
+
+    for (int prefix = 0; prefix < 40; ++prefix) {
+        for (int suffix : {0, 1, 15, 16, 17}) {
+            const QByteArray json = "[\"" + QByteArray(prefix, 'a') + special
+                    + QByteArray(suffix, 'b') + "\"]";
+            const QString expected = QString(prefix, 'a') + decoded + QString(suffix, 'b');
+
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().first().toString(), expected);
+
+            // truncated documents must not read past the end
+            doc = QJsonDocument::fromJson(json.left(json.size() - 2), &error);
+            QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+        }
+    }
+}
+
+void tst_QtJson::parseMultiByteRuns_data()
+{
+    QTest::addColumn<QByteArray>("special");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("ascii") << QByteArray("x") << true;
+    QTest::newRow("two-byte") << QByteArray("\xc3\xa4") << true;
+    QTest::newRow("three-byte") << QByteArray("\xe2\x82\xac") << true;
+    QTest::newRow("four-byte") << QByteArray("\xf0\x9f\x98\x80") << true;
+    QTest::newRow("max") << QByteArray("\xf4\x8f\xbf\xbf") << true;
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf") << true;
+    QTest::newRow("escape") << QByteArray("\\n") << true;
+    QTest::newRow("stray-continuation") << QByteArray("\x80") << false;
+    QTest::newRow("missing-continuation") << QByteArray("\xe2\x82") << false;
+    QTest::newRow("extra-continuation") << QByteArray("\xc3\xa4\xa4") << false;
+    QTest::newRow("overlong-2") << QByteArray("\xc1\xbf") << false;
+    QTest::newRow("overlong-3") << QByteArray("\xe0\x9f\xbf") << false;
+    QTest::newRow("overlong-4") << QByteArray("\xf0\x8f\xbf\xbf") << false;
+    QTest::newRow("surrogate") << QByteArray("\xed\xa0\x80") << false;
+    QTest::newRow("too-large") << QByteArray("\xf4\x90\x80\x80") << false;
+    QTest::newRow("invalid-lead") << QByteArray("\xf8\x88\x80\x80\x80") << false;
+}
+
+void tst_QtJson::parseMultiByteRuns()
+{
+    // runs of multi-byte characters are validated in blocks; check that
+    // errors are found wherever they are relative to block boundaries
+    QFETCH(QByteArray, special);
+    QFETCH(bool, valid);
+
+    const QByteArray text = QByteArray("\xe2\x82\xac\xc3\xa4a\xf0\x9f\x98\x80").repeated(8);
+    for (int prefix = 0; prefix < 40; ++prefix) {
+        for (int suffix : {0, 1, 15, 16, 17, 40}) {
+            const QByteArray before = text.left(prefix);
+            const QByteArray after = text.mid(prefix, suffix);
+            const QByteArray json = "[\"" + before + special + after + "\"]";
+
+            // cutting the text may have split a character
+            const bool split = QString::fromUtf8(before).contains(QChar::ReplacementCharacter)
+                    || QString::fromUtf8(after).contains(QChar::ReplacementCharacter);
+            if (split && !valid)
+                continue;
+
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            if (split || !valid) {
+                QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+                continue;
+            }
+            QString expected = special == "\\n" ? QString("\n") : QString::fromUtf8(special);
+            if (special.startsWith("\xef\xbb\xbf"))
+                expected = QChar(QChar::ByteOrderMark);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().first().toString(),
+                     QString::fromUtf8(before) + expected + QString::fromUtf8(after));
+        }
+    }
+}
+
+void tst_QtJson::parseWhitespaceRuns()
+{
+    for (int n = 0; n < 40; ++n) {
+        const QByteArray ws = QByteArray(" \t\r\n").repeated(n).left(n);
+        const QByteArray json = ws + '[' + ws + '1' + ws + ',' + ws + "\"x\"" + ws + ']' + ws;
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.array().size(), 2);
+        QCOMPARE(doc.array().at(1).toString(), QString("x"));
+
+        doc = QJsonDocument::fromJson(json + "x", &error);
+        QCOMPARE(error.error, QJsonParseError::GarbageAtEnd);
+    }
+}
+
 void tst_QtJson::assignObjects()
 {
     const char *json =
@@ -0,0 +1,417 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qcborstream.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qurl.h>
+#include <QtCore/quuid.h>
+
+class tst_QCborStream : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void writer_data();
+    void writer();
+    void reader_data() { writer_data(); }
+    void reader();
+    void indefiniteLengthString();
+    void incrementalData();
+    void incrementalIndefiniteLengthString();
+    void readFromDevice();
+    void readLongStringFromDevice();
+    void jsonRoundTrip();
+    void variantRoundTrip();
+    void errors_data();
+    void errors();
+};
+
+// Encodings taken from the examples in RFC 7049, appendix A.
+void tst_QCborStream::writer_data()
+{
+    QTest::addColumn<QVariant>("value");
+    QTest::addColumn<QByteArray>("encoded");
+
+    QTest::newRow("0") << QVariant(0) << QByteArray::fromHex("00");
+    QTest::newRow("23") << QVariant(23) << QByteArray::fromHex("17");
+    QTest::newRow("24") << QVariant(24) << QByteArray::fromHex("1818");
+    QTest::newRow("100") << QVariant(100) << QByteArray::fromHex("1864");
+    QTest::newRow("1000") << QVariant(1000) << QByteArray::fromHex("1903e8");
+    QTest::newRow("1000000") << QVariant(1000000) << QByteArray::fromHex("1a000f4240");
+    QTest::newRow("1000000000000") << QVariant(Q_INT64_C(1000000000000))
+                                   << QByteArray::fromHex("1b000000e8d4a51000");
+    QTest::newRow("18446744073709551615") << QVariant(Q_UINT64_C(18446744073709551615))
+                                          << QByteArray::fromHex("1bffffffffffffffff");
+    QTest::newRow("-1") << QVariant(-1) << QByteArray::fromHex("20");
+    QTest::newRow("-100") << QVariant(-100) << QByteArray::fromHex("3863");
+    QTest::newRow("-1000") << QVariant(-1000) << QByteArray::fromHex("3903e7");
+    QTest::newRow("1.1") << QVariant(1.1) << QByteArray::fromHex("fb3ff199999999999a");
+    QTest::newRow("100000.0f") << QVariant(100000.0f) << QByteArray::fromHex("fa47c35000");
+    QTest::newRow("false") << QVariant(false) << QByteArray::fromHex("f4");
+    QTest::newRow("true") << QVariant(true) << QByteArray::fromHex("f5");
+    QTest::newRow("null") << QVariant::fromValue(nullptr) << QByteArray::fromHex("f6");
+    QTest::newRow("undefined") << QVariant() << QByteArray::fromHex("f7");
+    QTest::newRow("empty-bytes") << QVariant(QByteArray("")) << QByteArray::fromHex("40");
+    QTest::newRow("bytes") << QVariant(QByteArray::fromHex("01020304"))
+                           << QByteArray::fromHex("4401020304");
+    QTest::newRow("a") << QVariant(QStringLiteral("a")) << QByteArray::fromHex("6161");
+    QTest::newRow("IETF") << QVariant(QStringLiteral("IETF")) << QByteArray::fromHex("6449455446");
+    QTest::newRow("u00fc") << QVariant(QString(QChar(0xfc))) << QByteArray::fromHex("62c3bc");
+    QTest::newRow("u6c34") << QVariant(QString(QChar(0x6c34))) << QByteArray::fromHex("63e6b0b4");
+    QTest::newRow("empty-array") << QVariant(QVariantList()) << QByteArray::fromHex("80");
+    QTest::newRow("array") << QVariant(QVariantList{1, 2, 3}) << QByteArray::fromHex("83010203");
+    QTest::newRow("nested-array") << QVariant(QVariantList{1, QVariantList{2, 3}, QVariantList{4, 5}})
+                                  << QByteArray::fromHex("8301820203820405");
+    QTest::newRow("empty-map") << QVariant(QVariantMap()) << QByteArray::fromHex("a0");
+    QVariantMap map;
+    map.insert(QStringLiteral("a"), 1);
+    map.insert(QStringLiteral("b"), QVariantList{2, 3});
+    QTest::newRow("map") << QVariant(map) << QByteArray::fromHex("a26161016162820203");
+    QTest::newRow("datetime")
+            << QVariant(QDateTime(QDate(2013, 3, 21), QTime(20, 4, 0), Qt::UTC))
+            << QByteArray::fromHex("c07818323031332d30332d32315432303a30343a30302e3030305a");
+    QTest::newRow("url") << QVariant(QUrl(QStringLiteral("http://www.example.com")))
+                         << QByteArray::fromHex("d82076687474703a2f2f7777772e6578616d706c652e636f6d");
+}
+
+void tst_QCborStream::writer()
+{
+    QFETCH(QVariant, value);
+    QFETCH(QByteArray, encoded);
+
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    writer.appendVariant(value);
+    QCOMPARE(data.toHex(), encoded.toHex());
+
+    // the same through a QIODevice
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    QCborStreamWriter deviceWriter(&buffer);
+    QCOMPARE(deviceWriter.device(), &buffer);
+    deviceWriter.appendVariant(value);
+    QCOMPARE(buffer.data().toHex(), encoded.toHex());
+}
+
+void tst_QCborStream::reader()
+{
+    QFETCH(QVariant, value);
+    QFETCH(QByteArray, encoded);
+
+    QCborStreamReader reader(encoded);
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.currentOffset(), qint64(0));
+    const QVariant result = reader.readVariant();
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+    QCOMPARE(reader.currentOffset(), qint64(encoded.size()));
+    QVERIFY(!reader.hasNext());
+
+    if (value.userType() == QMetaType::Int) {
+        QCOMPARE(result.toLongLong(), value.toLongLong());
+    } else if (value.userType() == QMetaType::QVariantList) {
+        // integers come back as qint64
+        QCOMPARE(QCborStreamReader(encoded).readJsonValue(),
+                 QJsonValue::fromVariant(value));
+    } else if (value.userType() == QMetaType::QVariantMap) {
+        QCOMPARE(QJsonValue::fromVariant(result), QJsonValue::fromVariant(value));
+    } else {
+        QCOMPARE(result.userType(), value.userType());
+        if (value.userType() != QMetaType::Nullptr)
+            QCOMPARE(result, value);
+    }
+
+    // skipping the element must consume the same bytes
+    QCborStreamReader skipper(encoded);
+    QVERIFY(skipper.next());
+    QCOMPARE(skipper.currentOffset(), qint64(encoded.size()));
+}
+
+void tst_QCborStream::indefiniteLengthString()
+{
+    // (_ "strea", "ming")
+    QCborStreamReader reader(QByteArray::fromHex("7f657374726561646d696e67ff01"));
+    QVERIFY(reader.isString());
+    QVERIFY(!reader.isLengthKnown());
+
+    auto r = reader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::Ok));
+    QCOMPARE(r.data, QStringLiteral("strea"));
+    r = reader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::Ok));
+    QCOMPARE(r.data, QStringLiteral("ming"));
+    r = reader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::EndOfString));
+
+    QVERIFY(reader.isUnsignedInteger());
+    QCOMPARE(reader.toUnsignedInteger(), Q_UINT64_C(1));
+
+    // indefinite-length array of indefinite-length byte strings
+    reader.addData(QByteArray::fromHex("9f5f42010243030405ffff"));
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readVariant(), QVariant(QVariantList{ QByteArray::fromHex("0102030405") }));
+}
+
+void tst_QCborStream::incrementalData()
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("key"), QStringLiteral("value"));
+    map.insert(QStringLiteral("list"), QVariantList{ 1, QStringLiteral("two"), 3.5 });
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.appendVariant(map);
+
+    QCborStreamReader reader;
+    QVERIFY(!reader.isValid());
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+
+    // feed one byte at a time, restarting the element each time
+    for (int i = 0; i < encoded.size(); ++i) {
+        reader.addData(encoded.constData() + i, 1);
+        reader.reparse();
+        QVERIFY(reader.isValid() || reader.lastError() == QCborError::EndOfFile);
+    }
+    QVERIFY(reader.isMap());
+    QCOMPARE(reader.readVariant(), QVariant(map));
+
+    // reading a string that arrives in pieces
+    QCborStreamReader stringReader(QByteArray::fromHex("6568"));
+    QVERIFY(stringReader.isString());
+    QCOMPARE(int(stringReader.readString().status), int(QCborStreamReader::Error));
+    QCOMPARE(int(stringReader.lastError()), int(QCborError::EndOfFile));
+    stringReader.addData(QByteArray("ello"));
+    stringReader.reparse();
+    auto r = stringReader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::Ok));
+    QCOMPARE(r.data, QStringLiteral("hello"));
+}
+
+void tst_QCborStream::incrementalIndefiniteLengthString()
+{
+    // the string's header is only consumed together with the first chunk
+    QCborStreamReader reader(QByteArray::fromHex("7f65"));
+    QVERIFY(reader.isString());
+    QCOMPARE(int(reader.readString().status), int(QCborStreamReader::Error));
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+    QCOMPARE(reader.currentOffset(), qint64(0));
+
+    reader.addData(QByteArray("hello"));
+    reader.reparse();
+    QVERIFY(reader.isString());
+    QVERIFY(!reader.isLengthKnown());
+    auto r = reader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::Ok));
+    QCOMPARE(r.data, QStringLiteral("hello"));
+
+    // so is the header of the following chunk
+    QCOMPARE(int(reader.readString().status), int(QCborStreamReader::Error));
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+    reader.addData(QByteArray::fromHex("63"));
+    reader.reparse();
+    QCOMPARE(int(reader.readString().status), int(QCborStreamReader::Error));
+    QCOMPARE(reader.currentOffset(), qint64(7));
+    reader.addData(QByteArray::fromHex("616263ff"));
+    reader.reparse();
+    r = reader.readString();
+    QCOMPARE(int(r.status), int(QCborStreamReader::Ok));
+    QCOMPARE(r.data, QStringLiteral("abc"));
+    QCOMPARE(int(reader.readString().status), int(QCborStreamReader::EndOfString));
+    QCOMPARE(reader.currentOffset(), qint64(12));
+}
+
+void tst_QCborStream::readFromDevice()
+{
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.startArray();
+    for (int i = 0; i < 10000; ++i) {
+        writer.append(i);
+        writer.append(QString::number(i));
+    }
+    writer.endArray();
+
+    QBuffer buffer(&encoded);
+    buffer.open(QIODevice::ReadOnly);
+    QCborStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+    QVERIFY(reader.parentContainerType() == QCborStreamReader::Array);
+    for (int i = 0; i < 10000; ++i) {
+        QVERIFY(reader.hasNext());
+        QVERIFY(reader.isInteger());
+        QCOMPARE(reader.toInteger(), qint64(i));
+        QVERIFY(reader.next());
+        QCOMPARE(reader.readVariant().toString(), QString::number(i));
+    }
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.currentOffset(), qint64(encoded.size()));
+}
+
+void tst_QCborStream::readLongStringFromDevice()
+{
+    // 3 bytes per character, so that the pieces cannot all end on a
+    // character boundary
+    const QString text = QString(QChar(0x20ac)).repeated(100000) + QLatin1Char('!');
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.append(text);
+
+    QBuffer buffer(&encoded);
+    buffer.open(QIODevice::ReadOnly);
+    QCborStreamReader reader(&buffer);
+    QVERIFY(reader.isString());
+
+    QString result;
+    int pieces = 0;
+    auto r = reader.readString();
+    while (r.status == QCborStreamReader::Ok) {
+        QVERIFY(r.data.size() <= 64 * 1024);
+        result += r.data;
+        ++pieces;
+        r = reader.readString();
+    }
+    QCOMPARE(int(r.status), int(QCborStreamReader::EndOfString));
+    QVERIFY(pieces > 1);
+    QCOMPARE(result, text);
+    QCOMPARE(reader.currentOffset(), qint64(encoded.size()));
+}
+
+void tst_QCborStream::jsonRoundTrip()
+{
+    const QByteArray json =
+            "{\"name\":\"caf\\u00e9\",\"count\":42,\"ratio\":-0.25,\"negative\":-7,"
+            "\"big\":1e300,\"ok\":true,\"nothing\":null,"
+            "\"list\":[1,\"two\",[3],{\"four\":4}],\"empty\":{}}";
+    const QJsonDocument doc = QJsonDocument::fromJson(json);
+    QVERIFY(doc.isObject());
+
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.appendJsonValue(doc.object());
+    QVERIFY(encoded.size() < QJsonDocument(doc).toJson(QJsonDocument::Compact).size());
+
+    QCborStreamReader reader(encoded);
+    const QJsonValue result = reader.readJsonValue();
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+    QCOMPARE(result, QJsonValue(doc.object()));
+
+    // byte strings and tags have no JSON equivalent
+    QCborStreamReader other(QByteArray::fromHex("a2430102036178c11a514b67b0f6"));
+    QJsonObject object = other.readJsonValue().toObject();
+    QCOMPARE(object.value(QLatin1String("AQID")).toString(), QStringLiteral("x"));
+    QCOMPARE(object.value(QLatin1String("1363896240")), QJsonValue(QJsonValue::Null));
+}
+
+void tst_QCborStream::variantRoundTrip()
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("int"), qint64(-123456789));
+    map.insert(QStringLiteral("uint"), std::numeric_limits<quint64>::max());
+    map.insert(QStringLiteral("double"), 2.5);
+    map.insert(QStringLiteral("string"), QString::fromUtf8("\xc3\xa9t\xc3\xa9"));
+    map.insert(QStringLiteral("bytes"), QByteArray("\0\1\2", 3));
+    map.insert(QStringLiteral("bool"), true);
+    map.insert(QStringLiteral("null"), QVariant::fromValue(nullptr));
+    map.insert(QStringLiteral("list"), QVariantList{ qint64(1), QStringLiteral("a") });
+    map.insert(QStringLiteral("datetime"),
+               QDateTime(QDate(2018, 6, 1), QTime(12, 30, 15, 250), Qt::UTC));
+    map.insert(QStringLiteral("url"), QUrl(QStringLiteral("https://qt.io/a%20b")));
+    map.insert(QStringLiteral("uuid"),
+               QUuid(QStringLiteral("{67c8770b-44f1-410a-ab9a-f9b5446f13ee}")));
+
+    QByteArray encoded;
+    QCborStreamWriter writer(&encoded);
+    writer.appendVariant(map);
+
+    QCborStreamReader reader(encoded);
+    const QVariantMap result = reader.readVariant().toMap();
+    QCOMPARE(int(reader.lastError()), int(QCborError::EndOfFile));
+    QCOMPARE(result.keys(), map.keys());
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        QCOMPARE(result.value(it.key()).userType(), it.value().userType());
+        if (it.value().userType() != QMetaType::Nullptr)
+            QCOMPARE(result.value(it.key()), it.value());
+    }
+}
+
+void tst_QCborStream::errors_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<int>("error");
+
+    QTest::newRow("empty") << QByteArray() << int(QCborError::EndOfFile);
+    QTest::newRow("truncated-integer") << QByteArray::fromHex("1903") << int(QCborError::EndOfFile);
+    QTest::newRow("truncated-string") << QByteArray::fromHex("6461") << int(QCborError::EndOfFile);
+    QTest::newRow("truncated-array") << QByteArray::fromHex("830102") << int(QCborError::EndOfFile);
+    QTest::newRow("unterminated-array") << QByteArray::fromHex("9f01") << int(QCborError::EndOfFile);
+    QTest::newRow("reserved-length") << QByteArray::fromHex("1c") << int(QCborError::IllegalNumber);
+    QTest::newRow("indefinite-integer") << QByteArray::fromHex("1f") << int(QCborError::IllegalNumber);
+    QTest::newRow("unexpected-break") << QByteArray::fromHex("81ff") << int(QCborError::UnexpectedBreak);
+    QTest::newRow("illegal-simple-type") << QByteArray::fromHex("f814") << int(QCborError::IllegalSimpleType);
+    QTest::newRow("invalid-utf8") << QByteArray::fromHex("62c328") << int(QCborError::InvalidUtf8String);
+    QTest::newRow("mixed-chunks") << QByteArray::fromHex("7f4161ff") << int(QCborError::IllegalType);
+    QTest::newRow("too-large") << QByteArray::fromHex("5b00000001ffffffff") << int(QCborError::DataTooLarge);
+
+    QByteArray deep(2000, char(0x81));
+    deep += char(0);
+    QTest::newRow("nesting-too-deep") << deep << int(QCborError::NestingTooDeep);
+}
+
+void tst_QCborStream::errors()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(int, error);
+
+    QCborStreamReader reader(data);
+    reader.readVariant();
+    QCOMPARE(int(reader.lastError()), error);
+    if (error != QCborError::EndOfFile)
+        QVERIFY(!reader.isValid());
+
+    QCborStreamReader jsonReader(data);
+    jsonReader.readJsonValue();
+    QCOMPARE(int(jsonReader.lastError()), error);
+
+    // skipping does not validate UTF-8
+    if (error != QCborError::EndOfFile && error != QCborError::InvalidUtf8String) {
+        QCborStreamReader skipper(data);
+        QVERIFY(!skipper.next(1000));
+        QCOMPARE(int(skipper.lastError()), error);
+    }
+}
+
+QTEST_MAIN(tst_QCborStream)
+#include "tst_qcborstream.moc"
@@ -0,0 +1,379 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonstreamreader.h>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tokens_data();
+    void tokens();
+    void incremental_data() { tokens_data(); }
+    void incremental();
+    void topLevelScalars_data();
+    void topLevelScalars();
+    void errors_data();
+    void errors();
+    void readValue();
+    void skipCurrentValue();
+    void names();
+    void multipleDocuments();
+    void readFromDevice();
+};
+
+static QString dumpTokens(QJsonStreamReader &reader)
+{
+    QStringList tokens;
+    do {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        if (type == QJsonStreamReader::Invalid || type == QJsonStreamReader::NoToken)
+            break;
+        QString token = reader.tokenString();
+        switch (type) {
+        case QJsonStreamReader::Name:
+        case QJsonStreamReader::String:
+        case QJsonStreamReader::Number:
+            token += QLatin1Char('(') + reader.text() + QLatin1Char(')');
+            break;
+        case QJsonStreamReader::Bool:
+            token += reader.toBool() ? QLatin1String("(true)") : QLatin1String("(false)");
+            break;
+        default:
+            break;
+        }
+        tokens << token;
+    } while (!reader.atEnd());
+    return tokens.join(QLatin1Char(' '));
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty-object") << QByteArray("{}")
+        << "StartDocument StartObject EndObject EndDocument";
+    QTest::newRow("empty-array") << QByteArray(" [ ] ")
+        << "StartDocument StartArray EndArray EndDocument";
+    QTest::newRow("object")
+        << QByteArray("{\"a\": 1, \"b\" :\"x\",\"c\":true,\"d\":false,\"e\":null}")
+        << "StartDocument StartObject Name(a) Number(1) Name(b) String(x) Name(c) Bool(true) "
+           "Name(d) Bool(false) Name(e) Null EndObject EndDocument";
+    QTest::newRow("nested")
+        << QByteArray("[[], {\"a\": [1, {}]}, [[2]]]")
+        << "StartDocument StartArray StartArray EndArray StartObject Name(a) StartArray Number(1) "
+           "StartObject EndObject EndArray EndObject StartArray StartArray Number(2) EndArray "
+           "EndArray EndArray EndDocument";
+    QTest::newRow("numbers")
+        << QByteArray("[0, -0, 12.5, -3e2, 1E+10, 2.5e-3]")
+        << "StartDocument StartArray Number(0) Number(-0) Number(12.5) Number(-3e2) "
+           "Number(1E+10) Number(2.5e-3) EndArray EndDocument";
+    QTest::newRow("escapes")
+        << QByteArray("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\", \"\\u0041\\u00e9\\ud83d\\ude00\"]")
+        << QString::fromUtf8("StartDocument StartArray String(\"\\/\b\f\n\r\t) "
+                             "String(A\xc3\xa9\xf0\x9f\x98\x80) EndArray EndDocument");
+    QTest::newRow("utf8")
+        << QByteArray("{\"caf\xc3\xa9\": \"\xe6\xb0\xb4\"}")
+        << QString::fromUtf8("StartDocument StartObject Name(caf\xc3\xa9) String(\xe6\xb0\xb4) "
+                             "EndObject EndDocument");
+    QTest::newRow("string-document") << QByteArray("\"text\"")
+        << "StartDocument String(text) EndDocument";
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(dumpTokens(reader), expected);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.characterOffset(), qint64(json.trimmed().size())
+             + json.indexOf(json.trimmed().at(0)));
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // Feed the data one byte at a time; the reader must report a premature
+    // end of the document and then continue where it stopped.
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (int i = 0; i < json.size(); ++i) {
+        reader.addData(json.mid(i, 1));
+        for (;;) {
+            const QJsonStreamReader::TokenType type = reader.readNext();
+            if (type == QJsonStreamReader::Invalid) {
+                QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+                QVERIFY(!reader.atEnd());
+                break;
+            }
+            if (type == QJsonStreamReader::NoToken)
+                break;
+            QString token = reader.tokenString();
+            if (type == QJsonStreamReader::Name || type == QJsonStreamReader::String
+                    || type == QJsonStreamReader::Number)
+                token += QLatin1Char('(') + reader.text() + QLatin1Char(')');
+            else if (type == QJsonStreamReader::Bool)
+                token += reader.toBool() ? QLatin1String("(true)") : QLatin1String("(false)");
+            tokens << token;
+        }
+    }
+    QCOMPARE(tokens.join(QLatin1Char(' ')), expected);
+}
+
+class SequentialBuffer : public QBuffer
+{
+public:
+    using QBuffer::QBuffer;
+    bool isSequential() const override { return true; }
+};
+
+void tst_QJsonStreamReader::topLevelScalars_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("number") << QByteArray("42") << "StartDocument Number(42) EndDocument";
+    QTest::newRow("negative-number") << QByteArray("-12.5e3")
+        << "StartDocument Number(-12.5e3) EndDocument";
+    QTest::newRow("true") << QByteArray("true") << "StartDocument Bool(true) EndDocument";
+    QTest::newRow("null") << QByteArray("null") << "StartDocument Null EndDocument";
+    QTest::newRow("string") << QByteArray("\"text\"") << "StartDocument String(text) EndDocument";
+}
+
+void tst_QJsonStreamReader::topLevelScalars()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // the data passed to the constructor is the whole document
+    QJsonStreamReader reader(json);
+    QCOMPARE(dumpTokens(reader), expected);
+    QVERIFY(!reader.hasError());
+
+    // so is the data of a device that is at its end
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    reader.setDevice(&buffer);
+    QCOMPARE(dumpTokens(reader), expected);
+    QVERIFY(!reader.hasError());
+
+    SequentialBuffer sequential(&json);
+    QVERIFY(sequential.open(QIODevice::ReadOnly));
+    reader.setDevice(&sequential);
+    QCOMPARE(dumpTokens(reader), expected);
+    QVERIFY(!reader.hasError());
+
+    // data added with addData() may be continued
+    for (int split = 1; split < json.size(); ++split) {
+        QJsonStreamReader reader;
+        reader.addData(json.left(split));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::StartDocument);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+        QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+        reader.addData(json.mid(split) + '\n');
+        QCOMPARE(QLatin1String("StartDocument ") + dumpTokens(reader), expected);
+        QVERIFY(!reader.hasError());
+    }
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<int>("error");
+
+    QTest::newRow("empty") << QByteArray() << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("whitespace") << QByteArray(" \n") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("unterminated-array") << QByteArray("[1, 2") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc") << int(QJsonStreamReader::PrematureEndOfDocumentError);
+    QTest::newRow("trailing-comma") << QByteArray("[1,]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("missing-colon") << QByteArray("{\"a\" 1}") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("unquoted-name") << QByteArray("{a: 1}") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("mismatched") << QByteArray("{\"a\": 1]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("leading-zero") << QByteArray("[01]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("bad-number") << QByteArray("[1.]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("bad-top-level-number") << QByteArray("-") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("bad-literal") << QByteArray("[tru]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("bad-escape") << QByteArray("[\"\\x\"]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("bad-unicode-escape") << QByteArray("[\"\\u12g4\"]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("control-character") << QByteArray("[\"a\tb\"]") << int(QJsonStreamReader::NotWellFormedError);
+    QTest::newRow("invalid-utf8") << QByteArray("[\"\xc3\x28\"]") << int(QJsonStreamReader::NotWellFormedError);
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(int, error);
+
+    QJsonStreamReader reader(json);
+    dumpTokens(reader);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(int(reader.error()), error);
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.atEnd(), error != QJsonStreamReader::PrematureEndOfDocumentError);
+
+    // reading stops at a fatal error
+    if (error != QJsonStreamReader::PrematureEndOfDocumentError)
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+
+    reader.raiseError(QStringLiteral("custom"));
+    QCOMPARE(reader.error(), QJsonStreamReader::CustomError);
+    QCOMPARE(reader.errorString(), QStringLiteral("custom"));
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    const QByteArray json =
+            "{\"name\":\"caf\\u00e9\",\"count\":42,\"ratio\":-0.25,\"ok\":true,\"nothing\":null,"
+            "\"list\":[1,\"two\",[3],{\"four\":4}],\"empty\":{},\"a\":{\"b\":{\"c\":[]}}}";
+    const QJsonObject expected = QJsonDocument::fromJson(json).object();
+    QVERIFY(!expected.isEmpty());
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartDocument);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readValue(), QJsonValue(expected));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // reading a member's value from its name
+    QJsonStreamReader memberReader(json);
+    while (memberReader.readNext() != QJsonStreamReader::Name
+           || memberReader.name() != QLatin1String("list")) {
+        QVERIFY(!memberReader.atEnd());
+    }
+    QCOMPARE(memberReader.readValue(), expected.value(QLatin1String("list")));
+    QCOMPARE(memberReader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(memberReader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(memberReader.name(), QStringLiteral("empty"));
+}
+
+void tst_QJsonStreamReader::skipCurrentValue()
+{
+    QJsonStreamReader reader(QByteArray("[{\"a\": [1, [2, {\"b\": 3}]], \"c\": 4}, 5]"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartDocument);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    reader.skipCurrentValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.name(), QStringLiteral("c"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toDouble(), 5.);
+
+    // skipping a scalar does nothing
+    reader.skipCurrentValue();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Number);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 0);
+}
+
+void tst_QJsonStreamReader::names()
+{
+    QJsonStreamReader reader(QByteArray("{\"a\": 1, \"b\": {\"c\": [2]}, \"d\": [3]}"));
+    QStringList names;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        names << reader.tokenString() + QLatin1Char(':') + reader.name();
+    }
+    QCOMPARE(names.join(QLatin1Char(' ')),
+             QStringLiteral("StartDocument: StartObject: Name:a Number:a Name:b StartObject:b "
+                            "Name:c StartArray:c Number: EndArray:c EndObject:b Name:d "
+                            "StartArray:d Number: EndArray:d EndObject: EndDocument:"));
+}
+
+void tst_QJsonStreamReader::multipleDocuments()
+{
+    QJsonStreamReader reader(QByteArray("{\"a\":1}\n[2]\n\"three\"\n"));
+    QCOMPARE(dumpTokens(reader), QStringLiteral("StartDocument StartObject Name(a) Number(1) "
+                                                "EndObject EndDocument"));
+    QVERIFY(reader.atEnd());
+    QCOMPARE(dumpTokens(reader), QStringLiteral("StartDocument StartArray Number(2) EndArray "
+                                                "EndDocument"));
+    QCOMPARE(dumpTokens(reader), QStringLiteral("StartDocument String(three) EndDocument"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+
+    // more data can follow
+    reader.addData("[]");
+    QCOMPARE(dumpTokens(reader), QStringLiteral("StartDocument StartArray EndArray EndDocument"));
+}
+
+void tst_QJsonStreamReader::readFromDevice()
+{
+    // a document much larger than the reader's read chunks
+    QByteArray json = "[";
+    const int count = 20000;
+    for (int i = 0; i < count; ++i) {
+        if (i)
+            json += ',';
+        json += "{\"index\":" + QByteArray::number(i) + ",\"text\":\""
+                + QByteArray(i % 100, 'x') + "\"}";
+    }
+    json += "]";
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+
+    int objects = 0;
+    while (!reader.atEnd()) {
+        if (reader.readNext() != QJsonStreamReader::Number)
+            continue;
+        QCOMPARE(reader.name(), QStringLiteral("index"));
+        QCOMPARE(int(reader.toDouble()), objects);
+        QVERIFY(reader.readNext() == QJsonStreamReader::Name);
+        QVERIFY(reader.readNext() == QJsonStreamReader::String);
+        QCOMPARE(reader.text().size(), objects % 100);
+        ++objects;
+    }
+    QVERIFY(!reader.hasError());
+    QCOMPARE(objects, count);
+    QCOMPARE(reader.characterOffset(), qint64(json.size()));
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
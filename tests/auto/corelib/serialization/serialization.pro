@@ -1,7 +1,9 @@
 TEMPLATE = subdirs
 SUBDIRS = \
     json \
+    qcborstream \
     qdatastream \
+    qjsonstreamreader \
     qtextstream \
     qxmlstream
 
@@ -100,6 +100,9 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing();
+    void workStealingClearAndTake();
+    void workStealingOrder();
 
 private:
     QMutex m_functionTestMutex;
@@ -1343,5 +1346,174 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing()
+{
+    class TreeTask : public QRunnable
+    {
+    public:
+        TreeTask(QThreadPool *pool, QAtomicInt *count, int depth)
+            : pool(pool), count(count), depth(depth)
+        {}
+
+        void run()
+        {
+            count->ref();
+            if (depth > 0) {
+                pool->start(new TreeTask(pool, count, depth - 1));
+                pool->start(new TreeTask(pool, count, depth - 1));
+            }
+        }
+
+    private:
+        QThreadPool *pool;
+        QAtomicInt *count;
+        int depth;
+    };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    for (int i = 0; i < 10; ++i) {
+        QAtomicInt count;
+        threadPool.start(new TreeTask(&threadPool, &count, 10));
+        QVERIFY(threadPool.waitForDone(30000));
+        QCOMPARE(count.load(), (1 << 11) - 1);
+    }
+}
+
+void tst_QThreadPool::workStealingClearAndTake()
+{
+    class Task : public QRunnable
+    {
+    public:
+        Task(QAtomicInt *count)
+            : count(count)
+        { setAutoDelete(false); }
+
+        void run() { count->ref(); }
+
+    private:
+        QAtomicInt *count;
+    };
+
+    class Spawner : public QRunnable
+    {
+    public:
+        Spawner(QThreadPool *pool, const QVector<QRunnable *> &tasks,
+                QSemaphore *started, QSemaphore *proceed)
+            : pool(pool), tasks(tasks), started(started), proceed(proceed)
+        {}
+
+        void run()
+        {
+            for (QRunnable *task : qAsConst(tasks))
+                pool->start(task);
+            started->release();
+            proceed->acquire();
+        }
+
+    private:
+        QThreadPool *pool;
+        QVector<QRunnable *> tasks;
+        QSemaphore *started;
+        QSemaphore *proceed;
+    };
+
+    QAtomicInt count;
+    QScopedPointer<Task> task1(new Task(&count));
+    QScopedPointer<Task> task2(new Task(&count));
+    QScopedPointer<Task> task3(new Task(&count));
+    QSemaphore started;
+    QSemaphore proceed;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+    threadPool.start(new Spawner(&threadPool, { task1.data(), task2.data(), task3.data() },
+                                 &started, &proceed));
+    started.acquire();
+
+    // all three are waiting in the local queue of the only worker thread
+    QVERIFY(threadPool.tryTake(task2.data()));
+    QVERIFY(!threadPool.tryTake(task2.data()));
+    threadPool.clear();
+    proceed.release();
+
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(count.load(), 0);
+
+    threadPool.start(task1.data());
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(count.load(), 1);
+}
+
+void tst_QThreadPool::workStealingOrder()
+{
+    class Task : public QRunnable
+    {
+    public:
+        Task(QMutex *mutex, QStringList *order, const QString &name)
+            : mutex(mutex), order(order), name(name)
+        {}
+
+        void run()
+        {
+            QMutexLocker locker(mutex);
+            order->append(name);
+        }
+
+    private:
+        QMutex *mutex;
+        QStringList *order;
+        QString name;
+    };
+
+    class Spawner : public QRunnable
+    {
+    public:
+        Spawner(QThreadPool *pool, QMutex *mutex, QStringList *order,
+                QSemaphore *started, QSemaphore *proceed)
+            : pool(pool), mutex(mutex), order(order), started(started), proceed(proceed)
+        {}
+
+        void run()
+        {
+            pool->start(new Task(mutex, order, QStringLiteral("local1")));
+            pool->start(new Task(mutex, order, QStringLiteral("local2")));
+            started->release();
+            proceed->acquire();
+        }
+
+    private:
+        QThreadPool *pool;
+        QMutex *mutex;
+        QStringList *order;
+        QSemaphore *started;
+        QSemaphore *proceed;
+    };
+
+    QMutex mutex;
+    QStringList order;
+    QSemaphore started;
+    QSemaphore proceed;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+    threadPool.start(new Spawner(&threadPool, &mutex, &order, &started, &proceed));
+    started.acquire();
+
+    // queued on the shared queue while the worker's own queue is not empty
+    threadPool.start(new Task(&mutex, &order, QStringLiteral("shared")));
+    proceed.release();
+
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(order, QStringList() << QStringLiteral("local2") << QStringLiteral("local1")
+                                  << QStringLiteral("shared"));
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -43,6 +43,7 @@ class tst_QByteArrayMatcher : public QObject
 private slots:
     void interface();
     void indexIn();
+    void blockBoundaries();
     void staticByteArrayMatcher();
 };
 
@@ -137,6 +138,44 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+// Place the needle at every position of haystacks of various lengths, and
+// surround it with near misses, so that all vector and tail paths are taken.
+void tst_QByteArrayMatcher::blockBoundaries()
+{
+    static const auto staticMatcher = qMakeStaticByteArrayMatcher("X0123456789abcdefghiY");
+    const QByteArray staticNeedle = staticMatcher.pattern();
+
+    for (int needleLength : {2, 3, 15, 16, 17, 31, 32, 33, 64}) {
+        QByteArray needle;
+        for (int i = 0; i < needleLength; ++i)
+            needle += char('a' + (i * 7) % 26);
+        needle[0] = 'X';
+        needle[needleLength - 1] = '\xff';
+        QByteArray nearMiss = needle;
+        nearMiss[needleLength / 2] = '-';
+
+        const QByteArrayMatcher matcher(needle);
+        for (int haystackLength = needleLength; haystackLength < needleLength + 72; ++haystackLength) {
+            for (int pos = 0; pos + needleLength <= haystackLength; ++pos) {
+                QByteArray haystack(haystackLength, 'x');
+                if (needleLength > 2 && pos >= needleLength)
+                    haystack.replace(0, needleLength, nearMiss);
+                haystack.replace(pos, needleLength, needle);
+                QCOMPARE(matcher.indexIn(haystack), pos);
+                QCOMPARE(haystack.indexOf(needle), pos);
+                QCOMPARE(haystack.indexOf(needle, pos), pos);
+                QCOMPARE(haystack.indexOf(needle, pos + 1), -1);
+            }
+        }
+    }
+
+    for (int pos = 0; pos < 72; ++pos) {
+        QByteArray haystack(pos + 72, 'x');
+        haystack.replace(pos, staticNeedle.size(), staticNeedle);
+        QCOMPARE(staticMatcher.indexIn(haystack), pos);
+    }
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -43,6 +43,12 @@ private slots:
     void sha1();
     void sha3_data();
     void sha3();
+    void crc32c_data();
+    void crc32c();
+    void blockBoundaries_data();
+    void blockBoundaries();
+    void hashMany_data();
+    void hashMany();
     void files_data();
     void files();
 };
@@ -109,6 +115,10 @@ void tst_QCryptographicHash::intermediary_result_data()
                             << QByteArray("abc") << QByteArray("abc")
                             << QByteArray::fromHex("DDAF35A193617ABACC417349AE20413112E6FA4E89A97EA20A9EEEE64B55D39A2192992A274FC1A836BA3C23A3FEEBBD454D4423643CE80E2A9AC94FA54CA49F")
                             << QByteArray::fromHex("F3C41E7B63EE869596FC28BAD64120612C520F65928AB4D126C72C6998B551B8FF1CEDDFED4373E6717554DC89D1EEE6F0AB22FD3675E561ABA9AE26A3EEC53B");
+    QTest::newRow("crc32c") << int(QCryptographicHash::Crc32c)
+                            << QByteArray("abc") << QByteArray("abc")
+                            << QByteArray::fromHex("364B3FB7")
+                            << QByteArray::fromHex("27BF04CC");
 
     QTest::newRow("sha3_224_empty_abc")
             << int(QCryptographicHash::Sha3_224)
@@ -262,6 +272,130 @@ void tst_QCryptographicHash::sha3()
     QCOMPARE(result, expectedResult);
 }
 
+void tst_QCryptographicHash::crc32c_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    QByteArray ascending(32, Qt::Uninitialized);
+    QByteArray descending(32, Qt::Uninitialized);
+    for (int i = 0; i < 32; ++i) {
+        ascending[i] = char(i);
+        descending[i] = char(31 - i);
+    }
+
+    QTest::newRow("empty") << QByteArray() << QByteArray::fromHex("00000000");
+    QTest::newRow("check") << QByteArray("123456789") << QByteArray::fromHex("e3069283");
+    QTest::newRow("pangram") << QByteArray("The quick brown fox jumps over the lazy dog")
+                             << QByteArray::fromHex("22620404");
+    // RFC 3720, B.4
+    QTest::newRow("zeros") << QByteArray(32, '\0') << QByteArray::fromHex("8a9136aa");
+    QTest::newRow("ones") << QByteArray(32, '\xff') << QByteArray::fromHex("62a8ab43");
+    QTest::newRow("ascending") << ascending << QByteArray::fromHex("46dd794e");
+    QTest::newRow("descending") << descending << QByteArray::fromHex("113fdb5c");
+}
+
+void tst_QCryptographicHash::crc32c()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expectedResult);
+
+    QCOMPARE(QCryptographicHash::hash(data, QCryptographicHash::Crc32c), expectedResult);
+
+    QCryptographicHash hash(QCryptographicHash::Crc32c);
+    for (char c : qAsConst(data))
+        hash.addData(&c, 1);
+    QCOMPARE(hash.result(), expectedResult);
+}
+
+static QByteArray blockBoundaryMessage(int length)
+{
+    QByteArray message(length, Qt::Uninitialized);
+    for (int i = 0; i < length; ++i)
+        message[i] = char(i * 7 + length);
+    return message;
+}
+
+void tst_QCryptographicHash::blockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    // MD5 of the concatenated hashes of blockBoundaryMessage(0) ... (299)
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+                          << QByteArray::fromHex("52f48cd627fb360baf45ed5bfd623ff1");
+    QTest::newRow("sha224") << QCryptographicHash::Sha224
+                            << QByteArray::fromHex("bbb31148b787b2a468ebbce412bfbd03");
+    QTest::newRow("sha256") << QCryptographicHash::Sha256
+                            << QByteArray::fromHex("56a84980a4837f808aeffd524f49d498");
+    QTest::newRow("crc32c") << QCryptographicHash::Crc32c
+                            << QByteArray::fromHex("5c65313dac2150e2b836485959487d1c");
+}
+
+void tst_QCryptographicHash::blockBoundaries()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArray, expectedResult);
+
+    QByteArray hashes;
+    QCryptographicHash hash(algorithm);
+    for (int length = 0; length < 300; ++length) {
+        const QByteArray message = blockBoundaryMessage(length);
+        const QByteArray result = QCryptographicHash::hash(message, algorithm);
+        hashes += result;
+
+        // feed the same message in pieces that straddle the block boundaries
+        for (int chunk : { 1, 13, 63, 64, 65 }) {
+            hash.reset();
+            for (int i = 0; i < length; i += chunk)
+                hash.addData(message.constData() + i, qMin(chunk, length - i));
+            QCOMPARE(hash.result(), result);
+        }
+    }
+    QCOMPARE(QCryptographicHash::hash(hashes, QCryptographicHash::Md5), expectedResult);
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArrayList>("messages");
+
+    QByteArrayList mixed;
+    for (int length = 0; length < 150; ++length)
+        mixed << blockBoundaryMessage(length * 3);
+    mixed.insert(17, blockBoundaryMessage(100000));
+
+    QByteArrayList uneven;
+    uneven << blockBoundaryMessage(5000) << blockBoundaryMessage(3) << blockBoundaryMessage(64)
+           << blockBoundaryMessage(20000) << blockBoundaryMessage(55) << blockBoundaryMessage(56)
+           << blockBoundaryMessage(0) << blockBoundaryMessage(119) << blockBoundaryMessage(120)
+           << blockBoundaryMessage(4097);
+
+    const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha224,
+        QCryptographicHash::Sha256, QCryptographicHash::Sha512, QCryptographicHash::Crc32c
+    };
+    const QMetaEnum metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (QCryptographicHash::Algorithm algorithm : algorithms) {
+        const char *name = metaEnum.valueToKey(algorithm);
+        QTest::newRow(QByteArray(name) + "-none") << algorithm << QByteArrayList();
+        QTest::newRow(QByteArray(name) + "-one") << algorithm << (QByteArrayList() << "abc");
+        QTest::newRow(QByteArray(name) + "-mixed") << algorithm << mixed;
+        QTest::newRow(QByteArray(name) + "-uneven") << algorithm << uneven;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(QCryptographicHash::Algorithm, algorithm);
+    QFETCH(QByteArrayList, messages);
+
+    const QByteArrayList results = QCryptographicHash::hashMany(messages, algorithm);
+    QCOMPARE(results.size(), messages.size());
+    for (int i = 0; i < messages.size(); ++i)
+        QCOMPARE(results.at(i), QCryptographicHash::hash(messages.at(i), algorithm));
+}
+
 void tst_QCryptographicHash::files_data() {
     QTest::addColumn<QString>("filename");
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
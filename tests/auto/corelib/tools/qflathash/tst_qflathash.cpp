@@ -0,0 +1,409 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflathash.h>
+#include <qhash.h>
+#include <qstring.h>
+
+// counts live instances to catch leaks and double destruction
+struct Counted
+{
+    static int instances;
+    int v;
+
+    Counted(int value = 0) : v(value) { ++instances; }
+    Counted(const Counted &other) : v(other.v) { ++instances; }
+    Counted &operator=(const Counted &other) { v = other.v; return *this; }
+    ~Counted() { --instances; }
+
+    bool operator==(const Counted &other) const { return v == other.v; }
+};
+int Counted::instances = 0;
+
+inline uint qHash(const Counted &c, uint seed = 0) { return qHash(c.v, seed); }
+
+// all keys collide, so lookups have to probe past full groups
+struct BadKey
+{
+    int v;
+    bool operator==(const BadKey &other) const { return v == other.v; }
+};
+inline uint qHash(const BadKey &, uint = 0) { return 42; }
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndLookup();
+    void operatorBracket();
+    void remove();
+    void removeAndReinsert();
+    void iterators();
+    void erase();
+    void copyAndMove();
+    void reserveAndSqueeze();
+    void collisions();
+    void equality();
+    void complexTypes();
+    void initializerList();
+    void compareWithQHash();
+    void set();
+};
+
+void tst_QFlatHash::insertAndLookup()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1), 0);
+    QCOMPARE(hash.value(1, -1), -1);
+    QVERIFY(hash.find(1) == hash.end());
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 1000);
+    QVERIFY(hash.capacity() >= 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(hash.contains(i));
+        QCOMPARE(hash.value(i), i * 2);
+        QCOMPARE(hash.count(i), 1);
+        QFlatHash<int, int>::const_iterator it = hash.constFind(i);
+        QVERIFY(it != hash.constEnd());
+        QCOMPARE(it.key(), i);
+        QCOMPARE(it.value(), i * 2);
+    }
+    QVERIFY(!hash.contains(1000));
+    QVERIFY(!hash.contains(-1));
+
+    // inserting an existing key replaces the value
+    QFlatHash<int, int>::iterator it = hash.insert(10, -42);
+    QCOMPARE(it.key(), 10);
+    QCOMPARE(*it, -42);
+    QCOMPARE(hash.size(), 1000);
+    QCOMPARE(hash.value(10), -42);
+    QCOMPARE(hash.key(-42), 10);
+    QCOMPARE(hash.key(-5, -1), -1);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(10));
+    QVERIFY(hash.capacity() >= 1000);
+}
+
+void tst_QFlatHash::operatorBracket()
+{
+    QFlatHash<QString, int> hash;
+    hash[QStringLiteral("one")] = 1;
+    hash[QStringLiteral("two")] += 2;
+    ++hash[QStringLiteral("one")];
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(QStringLiteral("one")), 2);
+    QCOMPARE(hash.value(QStringLiteral("two")), 2);
+
+    const QFlatHash<QString, int> &constHash = hash;
+    QCOMPARE(constHash[QStringLiteral("three")], 0);
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+
+    QCOMPARE(hash.remove(100), 0);
+    for (int i = 0; i < 100; i += 2)
+        QCOMPARE(hash.remove(i), 1);
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+
+    QCOMPARE(hash.take(1), 1);
+    QCOMPARE(hash.take(1), 0);
+    QCOMPARE(hash.size(), 49);
+}
+
+void tst_QFlatHash::removeAndReinsert()
+{
+    // many more insertions than the capacity, with the size kept constant,
+    // must not grow the table
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 40; ++i)
+        hash.insert(i, i);
+    const int capacity = hash.capacity();
+    for (int i = 40; i < 100000; ++i) {
+        QCOMPARE(hash.remove(i - 40), 1);
+        hash.insert(i, i);
+    }
+    QCOMPARE(hash.size(), 40);
+    QCOMPARE(hash.capacity(), capacity);
+    for (int i = 100000 - 40; i < 100000; ++i)
+        QCOMPARE(hash.value(i), i);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.cbegin() == hash.cend());
+
+    for (int i = 0; i < 500; ++i)
+        hash.insert(i, i);
+
+    QSet<int> seen;
+    for (QFlatHash<int, int>::iterator it = hash.begin(); it != hash.end(); ++it) {
+        QCOMPARE(it.key(), it.value());
+        seen.insert(it.key());
+        it.value() = -it.key();
+    }
+    QCOMPARE(seen.size(), 500);
+
+    int count = 0;
+    for (QFlatHash<int, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(*it, -it.key());
+        ++count;
+    }
+    QCOMPARE(count, 500);
+
+    QList<int> keys = hash.keys();
+    QList<int> values = hash.values();
+    QCOMPARE(keys.size(), 500);
+    for (int i = 0; i < keys.size(); ++i)
+        QCOMPARE(values.at(i), -keys.at(i));
+    std::sort(keys.begin(), keys.end());
+    for (int i = 0; i < keys.size(); ++i)
+        QCOMPARE(keys.at(i), i);
+}
+
+void tst_QFlatHash::erase()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 300; ++i)
+        hash.insert(i, i);
+
+    QFlatHash<int, int>::iterator it = hash.begin();
+    while (it != hash.end()) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+}
+
+void tst_QFlatHash::copyAndMove()
+{
+    QFlatHash<int, QString> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, QString::number(i));
+
+    QFlatHash<int, QString> copy = hash;
+    QCOMPARE(copy.size(), 100);
+    QVERIFY(copy == hash);
+
+    // copies are deep
+    copy.insert(0, QStringLiteral("zero"));
+    QCOMPARE(hash.value(0), QStringLiteral("0"));
+    QVERIFY(copy != hash);
+
+    QFlatHash<int, QString> moved = std::move(copy);
+    QCOMPARE(moved.size(), 100);
+    QCOMPARE(moved.value(0), QStringLiteral("zero"));
+
+    QFlatHash<int, QString> assigned;
+    assigned.insert(1000, QStringLiteral("x"));
+    assigned = hash;
+    QVERIFY(assigned == hash);
+    QVERIFY(!assigned.contains(1000));
+
+    QFlatHash<int, QString> empty;
+    assigned.swap(empty);
+    QVERIFY(assigned.isEmpty());
+    QCOMPARE(empty.size(), 100);
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const int capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QCOMPARE(hash.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+}
+
+void tst_QFlatHash::collisions()
+{
+    QFlatHash<BadKey, int> hash;
+    for (int i = 0; i < 200; ++i) {
+        BadKey k = { i };
+        hash.insert(k, i);
+    }
+    QCOMPARE(hash.size(), 200);
+    for (int i = 0; i < 200; ++i) {
+        BadKey k = { i };
+        QCOMPARE(hash.value(k, -1), i);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        BadKey k = { i };
+        QCOMPARE(hash.remove(k), 1);
+    }
+    for (int i = 0; i < 200; ++i) {
+        BadKey k = { i };
+        QCOMPARE(hash.contains(k), i % 2 == 1);
+    }
+    BadKey missing = { 1000 };
+    QVERIFY(!hash.contains(missing));
+}
+
+void tst_QFlatHash::equality()
+{
+    QFlatHash<int, int> a;
+    QFlatHash<int, int> b;
+    QVERIFY(a == b);
+
+    // same contents, different history
+    for (int i = 0; i < 100; ++i)
+        a.insert(i, i);
+    for (int i = 199; i >= 0; --i)
+        b.insert(i, i);
+    for (int i = 100; i < 200; ++i)
+        b.remove(i);
+    QVERIFY(a == b);
+
+    b.insert(5, 6);
+    QVERIFY(a != b);
+}
+
+void tst_QFlatHash::complexTypes()
+{
+    QCOMPARE(Counted::instances, 0);
+    {
+        QFlatHash<Counted, Counted> hash;
+        for (int i = 0; i < 1000; ++i)
+            hash.insert(Counted(i), Counted(-i));
+        QCOMPARE(Counted::instances, 2000);
+        for (int i = 0; i < 1000; i += 2)
+            hash.remove(Counted(i));
+        QCOMPARE(Counted::instances, 1000);
+        QCOMPARE(hash.take(Counted(1)).v, -1);
+        QCOMPARE(Counted::instances, 998);
+
+        QFlatHash<Counted, Counted> copy = hash;
+        QCOMPARE(Counted::instances, 1996);
+        copy.clear();
+        QCOMPARE(Counted::instances, 998);
+        hash.squeeze();
+        QCOMPARE(Counted::instances, 998);
+        QCOMPARE(hash.value(Counted(3)).v, -3);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+void tst_QFlatHash::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatHash<int, QString> hash = { { 1, QStringLiteral("a") }, { 2, QStringLiteral("b") } };
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(2), QStringLiteral("b"));
+
+    QFlatSet<int> set = { 1, 2, 3, 2 };
+    QCOMPARE(set.size(), 3);
+    QVERIFY(set.contains(3));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    // random operations must leave both containers with the same contents
+    QHash<uint, uint> reference;
+    QFlatHash<uint, uint> hash;
+    uint state = 12345;
+    for (int i = 0; i < 50000; ++i) {
+        state = state * 1103515245 + 12345;
+        const uint key = (state >> 8) % 2000;
+        if (state & 1) {
+            reference.insert(key, uint(i));
+            hash.insert(key, uint(i));
+        } else {
+            QCOMPARE(hash.remove(key), reference.remove(key));
+        }
+    }
+    QCOMPARE(hash.size(), reference.size());
+    for (QHash<uint, uint>::const_iterator it = reference.constBegin(); it != reference.constEnd(); ++it)
+        QCOMPARE(hash.value(it.key(), uint(-1)), it.value());
+}
+
+void tst_QFlatHash::set()
+{
+    QFlatSet<QString> set;
+    QVERIFY(set.isEmpty());
+    for (int i = 0; i < 100; ++i)
+        set.insert(QString::number(i));
+    set.insert(QStringLiteral("5"));
+    QCOMPARE(set.size(), 100);
+    QVERIFY(set.contains(QStringLiteral("42")));
+    QVERIFY(!set.contains(QStringLiteral("100")));
+    QVERIFY(set.find(QStringLiteral("42")) != set.end());
+    QCOMPARE(*set.find(QStringLiteral("42")), QStringLiteral("42"));
+
+    QVERIFY(set.remove(QStringLiteral("42")));
+    QVERIFY(!set.remove(QStringLiteral("42")));
+    QCOMPARE(set.size(), 99);
+
+    int count = 0;
+    for (QFlatSet<QString>::const_iterator it = set.begin(); it != set.end(); ++it)
+        ++count;
+    QCOMPARE(count, 99);
+    QCOMPARE(set.values().size(), 99);
+
+    QFlatSet<QString> copy = set;
+    QVERIFY(copy == set);
+    copy.erase(copy.find(QStringLiteral("0")));
+    QVERIFY(copy != set);
+    QCOMPARE(copy.size(), 98);
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
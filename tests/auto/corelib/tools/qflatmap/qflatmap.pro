@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qflatmap
+QT = core testlib
+SOURCES = tst_qflatmap.cpp
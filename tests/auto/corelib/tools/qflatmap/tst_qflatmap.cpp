@@ -0,0 +1,277 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflatmap.h>
+#include <qmap.h>
+#include <qstring.h>
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void insertAndLookup();
+    void ordering();
+    void bulkConstruction();
+    void fromMap();
+    void remove();
+    void erase();
+    void bounds();
+    void implicitSharing();
+    void initializerList();
+    void compareWithQMap();
+};
+
+void tst_QFlatMap::insertAndLookup()
+{
+    QFlatMap<int, QString> map;
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.contains(1));
+    QCOMPARE(map.value(1), QString());
+    QCOMPARE(map.value(1, QStringLiteral("x")), QStringLiteral("x"));
+    QVERIFY(map.find(1) == map.end());
+
+    for (int i = 99; i >= 0; --i)
+        map.insert(i, QString::number(i));
+    QCOMPARE(map.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(map.contains(i));
+        QCOMPARE(map.count(i), 1);
+        QCOMPARE(map.value(i), QString::number(i));
+        QCOMPARE(map.constFind(i).value(), QString::number(i));
+    }
+    QVERIFY(!map.contains(100));
+
+    QFlatMap<int, QString>::iterator it = map.insert(5, QStringLiteral("five"));
+    QCOMPARE(it.key(), 5);
+    QCOMPARE(*it, QStringLiteral("five"));
+    QCOMPARE(map.size(), 100);
+    QCOMPARE(map.key(QStringLiteral("five")), 5);
+    QCOMPARE(map.key(QStringLiteral("none"), -1), -1);
+
+    map[200] = QStringLiteral("200");
+    map[5] += QLatin1Char('!');
+    QCOMPARE(map.value(200), QStringLiteral("200"));
+    QCOMPARE(map.value(5), QStringLiteral("five!"));
+    const QFlatMap<int, QString> &constMap = map;
+    QCOMPARE(constMap[300], QString());
+    QCOMPARE(map.size(), 101);
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+}
+
+void tst_QFlatMap::ordering()
+{
+    QFlatMap<QString, int> map;
+    const char *words[] = { "pear", "apple", "fig", "cherry", "banana" };
+    for (int i = 0; i < 5; ++i)
+        map.insert(QLatin1String(words[i]), i);
+
+    QStringList expected;
+    expected << "apple" << "banana" << "cherry" << "fig" << "pear";
+    QCOMPARE(QStringList(map.keys()), expected);
+    QCOMPARE(map.firstKey(), QStringLiteral("apple"));
+    QCOMPARE(map.lastKey(), QStringLiteral("pear"));
+    QCOMPARE(map.first(), 1);
+    QCOMPARE(map.last(), 0);
+
+    QStringList iterated;
+    for (QFlatMap<QString, int>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it)
+        iterated << it.key();
+    QCOMPARE(iterated, expected);
+
+    iterated.clear();
+    for (QFlatMap<QString, int>::key_iterator it = map.keyBegin(); it != map.keyEnd(); ++it)
+        iterated << *it;
+    QCOMPARE(iterated, expected);
+
+    QFlatMap<QString, int>::iterator it = map.end();
+    --it;
+    QCOMPARE(it.key(), QStringLiteral("pear"));
+    QCOMPARE((it - 4).key(), QStringLiteral("apple"));
+    QCOMPARE(map.end() - map.begin(), 5);
+}
+
+void tst_QFlatMap::bulkConstruction()
+{
+    QVector<int> keys;
+    QVector<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        keys << (i * 7919) % 1000;
+        values << i;
+    }
+    // duplicates: the value that comes last wins
+    keys << 3 << 3;
+    values << -1 << -2;
+
+    QFlatMap<int, int> map(keys, values);
+    QCOMPARE(map.size(), 1000);
+    int previous = -1;
+    for (QFlatMap<int, int>::const_iterator it = map.begin(); it != map.end(); ++it) {
+        QVERIFY(it.key() > previous);
+        previous = it.key();
+    }
+    QCOMPARE(map.value(3), -2);
+    for (int i = 0; i < 1000; ++i) {
+        const int key = (i * 7919) % 1000;
+        if (key != 3)
+            QCOMPARE(map.value(key), i);
+    }
+
+    QFlatMap<int, int> empty((QVector<int>()), QVector<int>());
+    QVERIFY(empty.isEmpty());
+}
+
+void tst_QFlatMap::fromMap()
+{
+    QMap<int, int> source;
+    for (int i = 0; i < 50; ++i)
+        source.insert(i, i * i);
+    source.insertMulti(7, -7);
+
+    QFlatMap<int, int> map(source);
+    QCOMPARE(map.size(), 50);
+    QCOMPARE(map.value(7), -7);
+    QCOMPARE(map.value(8), 64);
+    QCOMPARE(map.keys(), source.uniqueKeys());
+}
+
+void tst_QFlatMap::remove()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, i);
+
+    QCOMPARE(map.remove(100), 0);
+    for (int i = 0; i < 100; i += 2)
+        QCOMPARE(map.remove(i), 1);
+    QCOMPARE(map.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(map.contains(i), i % 2 == 1);
+
+    QCOMPARE(map.take(1), 1);
+    QCOMPARE(map.take(1), 0);
+    QCOMPARE(map.size(), 49);
+}
+
+void tst_QFlatMap::erase()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 30; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int>::iterator it = map.begin();
+    while (it != map.end()) {
+        if (it.key() % 3 == 0)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(map.size(), 20);
+    for (int i = 0; i < 30; ++i)
+        QCOMPARE(map.contains(i), i % 3 != 0);
+}
+
+void tst_QFlatMap::bounds()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i * 10, i);
+
+    QCOMPARE(map.lowerBound(20).key(), 20);
+    QCOMPARE(map.upperBound(20).key(), 30);
+    QCOMPARE(map.lowerBound(25).key(), 30);
+    QCOMPARE(map.upperBound(25).key(), 30);
+    QCOMPARE(map.lowerBound(-5).key(), 0);
+    QVERIFY(map.lowerBound(95) == map.end());
+    QVERIFY(map.upperBound(90) == map.end());
+
+    const QFlatMap<int, int> &constMap = map;
+    QCOMPARE(constMap.lowerBound(40).value(), 4);
+    QCOMPARE(constMap.upperBound(40).value(), 5);
+}
+
+void tst_QFlatMap::implicitSharing()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i);
+
+    QFlatMap<int, int> copy = map;
+    QVERIFY(copy == map);
+
+    copy.insert(0, 100);
+    QCOMPARE(map.value(0), 0);
+    QCOMPARE(copy.value(0), 100);
+    QVERIFY(copy != map);
+
+    QFlatMap<int, int> other = map;
+    *other.begin() = 42;
+    QCOMPARE(map.value(0), 0);
+    QCOMPARE(other.value(0), 42);
+
+    QFlatMap<int, int> swapped;
+    swapped.swap(map);
+    QVERIFY(map.isEmpty());
+    QCOMPARE(swapped.size(), 10);
+}
+
+void tst_QFlatMap::initializerList()
+{
+#ifdef Q_COMPILER_INITIALIZER_LISTS
+    QFlatMap<int, QString> map = { { 2, QStringLiteral("b") }, { 1, QStringLiteral("a") }, { 2, QStringLiteral("c") } };
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(map.firstKey(), 1);
+    QCOMPARE(map.value(2), QStringLiteral("c"));
+#else
+    QSKIP("Compiler doesn't support initializer lists");
+#endif
+}
+
+void tst_QFlatMap::compareWithQMap()
+{
+    QMap<uint, uint> reference;
+    QFlatMap<uint, uint> map;
+    uint state = 12345;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245 + 12345;
+        const uint key = (state >> 8) % 500;
+        if (state & 1) {
+            reference.insert(key, uint(i));
+            map.insert(key, uint(i));
+        } else {
+            QCOMPARE(map.remove(key), reference.remove(key));
+        }
+    }
+    QCOMPARE(map.keys(), reference.keys());
+    QCOMPARE(map.values(), reference.values());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatMap)
+#include "tst_qflatmap.moc"
@@ -38,6 +38,7 @@ private slots:
     void result();
     void result_incremental_data();
     void result_incremental();
+    void unsupportedAlgorithm();
 };
 
 Q_DECLARE_METATYPE(QCryptographicHash::Algorithm)
@@ -134,5 +135,14 @@ void tst_QMessageAuthenticationCode::result_incremental()
     QCOMPARE(result, code);
 }
 
+void tst_QMessageAuthenticationCode::unsupportedAlgorithm()
+{
+    QMessageAuthenticationCode mac(QCryptographicHash::Crc32c, "key");
+    mac.addData("message");
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QMessageAuthenticationCode: QCryptographicHash::Crc32c is not supported");
+    QVERIFY(mac.result().isEmpty());
+}
+
 QTEST_MAIN(tst_QMessageAuthenticationCode)
 #include "tst_qmessageauthenticationcode.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qmultistringmatcher
+QT = core testlib
+SOURCES = tst_qmultistringmatcher.cpp
@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qmultistringmatcher.h>
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void indexIn_data();
+    void indexIn();
+    void leftmostMatch();
+    void emptyPattern();
+    void nonLatin1();
+    void copy();
+    void compareWithIndexOf_data();
+    void compareWithIndexOf();
+};
+
+void tst_QMultiStringMatcher::empty()
+{
+    QMultiStringMatcher matcher;
+    QCOMPARE(matcher.patternCount(), 0);
+    QCOMPARE(matcher.indexIn(QByteArray("abc")), -1);
+    QCOMPARE(matcher.indexIn(QStringView(u"abc")), -1);
+    QCOMPARE(matcher.indexIn(QByteArray()), -1);
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("expectedIndex");
+    QTest::addColumn<int>("expectedPattern");
+
+    const QStringList keywords = QStringList() << "error" << "warning" << "fatal" << "err";
+    QTest::newRow("none") << keywords << "everything is fine" << 0 << -1 << -1;
+    QTest::newRow("start") << keywords << "fatal: out of memory" << 0 << 0 << 2;
+    QTest::newRow("end") << keywords << "there was a warning" << 0 << 12 << 1;
+    QTest::newRow("prefix-first") << keywords << "an error occurred" << 0 << 3 << 0;
+    QTest::newRow("from") << keywords << "error, then a warning" << 1 << 14 << 1;
+    QTest::newRow("from-negative") << keywords << "error" << -5 << 0 << 0;
+    QTest::newRow("from-past-end") << keywords << "error" << 10 << -1 << -1;
+    QTest::newRow("partial-at-end") << keywords << "a warnin" << 0 << -1 << -1;
+    QTest::newRow("short-shared-prefix") << keywords << "it's an err" << 0 << 8 << 3;
+    QTest::newRow("single-char") << (QStringList() << "x" << "y") << "abcdefy" << 0 << 6 << 1;
+
+    // long enough for the 32-byte blocks and the scalar tail
+    const QString filler(100, QLatin1Char('-'));
+    QTest::newRow("long-none") << keywords << filler << 0 << -1 << -1;
+    for (int pos : {0, 15, 16, 31, 32, 33, 63, 64, 90, 95}) {
+        QString haystack = filler;
+        haystack.replace(pos, 5, QStringLiteral("fatal"));
+        QTest::newRow(qPrintable(QString::fromLatin1("long-%1").arg(pos)))
+                << keywords << haystack << 0 << pos << 2;
+    }
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, haystack);
+    QFETCH(int, from);
+    QFETCH(int, expectedIndex);
+    QFETCH(int, expectedPattern);
+
+    const QMultiStringMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.patternCount(), patterns.size());
+
+    int pattern = -1;
+    QCOMPARE(matcher.indexIn(haystack, from, &pattern), expectedIndex);
+    QCOMPARE(pattern, expectedPattern);
+
+    pattern = -1;
+    const QByteArray latin1 = haystack.toLatin1();
+    QCOMPARE(matcher.indexIn(latin1, from, &pattern), expectedIndex);
+    QCOMPARE(pattern, expectedPattern);
+    QCOMPARE(matcher.indexIn(latin1.constData(), latin1.size(), from), expectedIndex);
+
+    QList<QByteArray> bytePatterns;
+    for (const QString &p : patterns)
+        bytePatterns << p.toLatin1();
+    const QMultiStringMatcher byteMatcher(bytePatterns);
+    QCOMPARE(byteMatcher.indexIn(latin1, from), expectedIndex);
+    QCOMPARE(byteMatcher.indexIn(haystack, from), expectedIndex);
+}
+
+void tst_QMultiStringMatcher::leftmostMatch()
+{
+    // a pattern that starts earlier wins over one listed first
+    QMultiStringMatcher matcher(QList<QByteArray>() << "cde" << "bcdef");
+    int pattern = -1;
+    QCOMPARE(matcher.indexIn(QByteArray("abcdefg"), 0, &pattern), 1);
+    QCOMPARE(pattern, 1);
+
+    // at the same position, the pattern listed first wins
+    matcher.setPatterns(QList<QByteArray>() << "bcdef" << "bc");
+    QCOMPARE(matcher.indexIn(QByteArray("abcdefg"), 0, &pattern), 1);
+    QCOMPARE(pattern, 0);
+    matcher.setPatterns(QList<QByteArray>() << "bc" << "bcdef");
+    QCOMPARE(matcher.indexIn(QByteArray("abcdefg"), 0, &pattern), 1);
+    QCOMPARE(pattern, 0);
+}
+
+void tst_QMultiStringMatcher::emptyPattern()
+{
+    QMultiStringMatcher matcher(QList<QByteArray>() << "abc" << "" << "xyz");
+    int pattern = -1;
+    QCOMPARE(matcher.indexIn(QByteArray("xyz"), 0, &pattern), 0);
+    QCOMPARE(pattern, 1);
+    QCOMPARE(matcher.indexIn(QByteArray("abc"), 0, &pattern), 0);
+    QCOMPARE(pattern, 0);
+    QCOMPARE(matcher.indexIn(QByteArray("abc"), 3, &pattern), 3);
+    QCOMPARE(matcher.indexIn(QByteArray("abc"), 4, &pattern), -1);
+}
+
+void tst_QMultiStringMatcher::nonLatin1()
+{
+    const QString snowman = QString(QChar(0x2603));
+    const QString euro = QString(QChar(0x20ac));
+    const QMultiStringMatcher matcher(QStringList() << snowman + "x" << euro + euro);
+
+    // both saturate to the same byte in the filter
+    QString haystack = QString(40, QLatin1Char('a')) + QChar(0x2604) + "x" + QString(40, QLatin1Char('a'))
+            + euro + euro;
+    int pattern = -1;
+    QCOMPARE(matcher.indexIn(haystack, 0, &pattern), 82);
+    QCOMPARE(pattern, 1);
+    haystack[40] = QChar(0x2603);
+    QCOMPARE(matcher.indexIn(haystack, 0, &pattern), 40);
+    QCOMPARE(pattern, 0);
+
+    // the byte array search uses the UTF-8 encoding of the patterns
+    const QByteArray utf8 = haystack.toUtf8();
+    QCOMPARE(matcher.indexIn(utf8, 0, &pattern), 40);
+    QCOMPARE(pattern, 0);
+}
+
+void tst_QMultiStringMatcher::copy()
+{
+    QMultiStringMatcher matcher(QStringList() << "foo");
+    QMultiStringMatcher copy = matcher;
+    matcher.setPatterns(QStringList() << "bar");
+    QCOMPARE(copy.indexIn(QByteArray("a foo bar")), 2);
+    QCOMPARE(matcher.indexIn(QByteArray("a foo bar")), 6);
+    copy = matcher;
+    QCOMPARE(copy.indexIn(QByteArray("a foo bar")), 6);
+}
+
+void tst_QMultiStringMatcher::compareWithIndexOf_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::addColumn<int>("minLength");
+
+    QTest::newRow("1-1") << 1 << 1;
+    QTest::newRow("5-2") << 5 << 2;
+    QTest::newRow("20-3") << 20 << 3;
+    QTest::newRow("100-4") << 100 << 4;
+    QTest::newRow("500-6") << 500 << 6;
+}
+
+void tst_QMultiStringMatcher::compareWithIndexOf()
+{
+    QFETCH(int, patternCount);
+    QFETCH(int, minLength);
+
+    // a small alphabet, so that there are lots of partial matches
+    uint state = uint(patternCount * 31 + minLength);
+    auto random = [&state](int bound) {
+        state = state * 1103515245 + 12345;
+        return int((state >> 8) % uint(bound));
+    };
+    QList<QByteArray> patterns;
+    for (int i = 0; i < patternCount; ++i) {
+        QByteArray p;
+        const int len = minLength + random(4);
+        for (int j = 0; j < len; ++j)
+            p += char('a' + random(6));
+        patterns << p;
+    }
+    const QMultiStringMatcher matcher(patterns);
+
+    for (int round = 0; round < 20; ++round) {
+        QByteArray haystack;
+        const int len = random(300);
+        for (int j = 0; j < len; ++j)
+            haystack += char('a' + random(7));
+        const QString string = QString::fromLatin1(haystack);
+
+        for (int from = 0; from <= len; from += 1 + random(40)) {
+            int expectedIndex = -1;
+            int expectedPattern = -1;
+            for (int p = 0; p < patterns.size(); ++p) {
+                const int i = haystack.indexOf(patterns.at(p), from);
+                if (i >= 0 && (expectedIndex < 0 || i < expectedIndex)) {
+                    expectedIndex = i;
+                    expectedPattern = p;
+                }
+            }
+            int pattern = -1;
+            QCOMPARE(matcher.indexIn(haystack, from, &pattern), expectedIndex);
+            if (expectedIndex >= 0)
+                QCOMPARE(pattern, expectedPattern);
+            QCOMPARE(matcher.indexIn(string, from, &pattern), expectedIndex);
+            if (expectedIndex >= 0)
+                QCOMPARE(pattern, expectedPattern);
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+#include "tst_qmultistringmatcher.moc"
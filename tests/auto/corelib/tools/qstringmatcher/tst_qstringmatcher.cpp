@@ -41,6 +41,11 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void indexInStringView();
+    void blockBoundaries_data();
+    void blockBoundaries();
+    void caseFoldingOutsideLatin1_data();
+    void caseFoldingOutsideLatin1();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -142,6 +147,93 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::indexInStringView()
+{
+    const QString haystack = QStringLiteral("foo bar foo bar");
+    QStringMatcher matcher(QStringLiteral("bar"));
+    QCOMPARE(matcher.indexIn(QStringView(haystack)), qsizetype(4));
+    QCOMPARE(matcher.indexIn(QStringView(haystack), 5), qsizetype(12));
+    QCOMPARE(matcher.indexIn(QStringView(haystack).left(14)), qsizetype(4));
+    QCOMPARE(matcher.indexIn(QStringView(haystack).mid(5, 9)), qsizetype(-1));
+    QCOMPARE(matcher.indexIn(QStringView()), qsizetype(-1));
+}
+
+void tst_QStringMatcher::blockBoundaries_data()
+{
+    QTest::addColumn<int>("needleLength");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    for (int len : {2, 3, 7, 8, 9, 16, 17, 31, 33}) {
+        QTest::addRow("%d-cs", len) << len << Qt::CaseSensitive;
+        QTest::addRow("%d-ci", len) << len << Qt::CaseInsensitive;
+    }
+}
+
+// Place the needle at every position of haystacks of various lengths, and
+// surround it with near misses, so that all vector and tail paths are taken.
+void tst_QStringMatcher::blockBoundaries()
+{
+    QFETCH(int, needleLength);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QString needle;
+    for (int i = 0; i < needleLength; ++i)
+        needle += QLatin1Char('a' + (i * 7) % 26);
+    needle[0] = QLatin1Char('X');
+    needle[needleLength - 1] = QChar(0xe9); // LATIN SMALL LETTER E WITH ACUTE
+    QString nearMiss = needle;
+    nearMiss[needleLength / 2] = QLatin1Char('-');
+    const QString found = cs == Qt::CaseSensitive ? needle : needle.toUpper();
+
+    const QStringMatcher matcher(needle, cs);
+    for (int haystackLength = needleLength; haystackLength < needleLength + 40; ++haystackLength) {
+        for (int pos = 0; pos + needleLength <= haystackLength; ++pos) {
+            QString haystack(haystackLength, QLatin1Char('x'));
+            if (needleLength > 2 && pos >= needleLength)
+                haystack.replace(0, needleLength, nearMiss);
+            haystack.replace(pos, needleLength, found);
+            QCOMPARE(matcher.indexIn(haystack), pos);
+            QCOMPARE(haystack.indexOf(needle, 0, cs), pos);
+            QCOMPARE(haystack.indexOf(needle, pos, cs), pos);
+            QCOMPARE(haystack.indexOf(needle, pos + 1, cs), -1);
+            QCOMPARE(QStringView(haystack).indexOf(needle, 0, cs), qsizetype(pos));
+        }
+    }
+}
+
+void tst_QStringMatcher::caseFoldingOutsideLatin1_data()
+{
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<int>("indexIn");
+
+    QTest::newRow("kelvin-first") << QString("kelvin") << QString::fromUtf8("degrees \xe2\x84\xaa" "elvin") << 8;
+    QTest::newRow("kelvin-last") << QString("geek") << QString::fromUtf8("a gee\xe2\x84\xaa") << 2;
+    QTest::newRow("long-s-first") << QString("sun") << QString::fromUtf8("the \xc5\xbfun") << 4;
+    QTest::newRow("long-s-last") << QString("gas") << QString::fromUtf8("some ga\xc5\xbf") << 5;
+    QTest::newRow("sharp-s") << QString::fromUtf8("ma\xc3\x9f") << QString::fromUtf8("MA\xe1\xba\x9e") << 0;
+    QTest::newRow("angstrom") << QString::fromUtf8("\xc3\xa5ngstr\xc3\xb6m") << QString::fromUtf8("1 \xe2\x84\xabNGSTR\xc3\x96M") << 2;
+    QTest::newRow("y-diaeresis") << QString::fromUtf8("na\xc3\xbf") << QString::fromUtf8("NA\xc5\xb8") << 0;
+    QTest::newRow("micro") << QString::fromUtf8("\xc2\xb5s") << QString::fromUtf8("10 \xce\x9cS") << 3;
+    QTest::newRow("latin1") << QString::fromUtf8("\xc3\xa9t\xc3\xa9") << QString::fromUtf8("en \xc3\x89T\xc3\x89") << 3;
+}
+
+void tst_QStringMatcher::caseFoldingOutsideLatin1()
+{
+    QFETCH(QString, needle);
+    QFETCH(QString, haystack);
+    QFETCH(int, indexIn);
+
+    // pad the haystack so that the vectorized code paths are used as well
+    const QString padding(64, QLatin1Char('.'));
+    for (const QString &prefix : {QString(), padding}) {
+        const QString paddedHaystack = prefix + haystack + padding;
+        const int expected = indexIn < 0 ? -1 : indexIn + prefix.size();
+        QCOMPARE(QStringMatcher(needle, Qt::CaseInsensitive).indexIn(paddedHaystack), expected);
+        QCOMPARE(paddedHaystack.indexOf(needle, 0, Qt::CaseInsensitive), expected);
+    }
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
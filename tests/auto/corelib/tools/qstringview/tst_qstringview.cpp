@@ -133,6 +133,7 @@ private Q_SLOTS:
     void basics() const;
     void literals() const;
     void at() const;
+    void indexOf() const;
 
     void fromQString() const;
     void fromQStringRef() const;
@@ -423,6 +424,25 @@ void tst_QStringView::at() const
     QCOMPARE(sv.at(4), QChar('o')); QCOMPARE(sv[4], QChar('o'));
 }
 
+void tst_QStringView::indexOf() const
+{
+    QString hello("Hello, World! Hello again!");
+    QStringView sv(hello);
+    QCOMPARE(sv.indexOf(QStringView(u"Hello")), 0);
+    QCOMPARE(sv.indexOf(QStringView(u"Hello"), 1), 14);
+    QCOMPARE(sv.indexOf(QStringView(u"Hello"), -12), 14);
+    QCOMPARE(sv.indexOf(QStringView(u"Hello"), 15), -1);
+    QCOMPARE(sv.indexOf(QStringView(u"WORLD")), -1);
+    QCOMPARE(sv.indexOf(QStringView(u"WORLD"), 0, Qt::CaseInsensitive), 7);
+    QCOMPARE(sv.indexOf(QStringView()), 0);
+    QCOMPARE(sv.mid(14).indexOf(QStringView(u"again")), 6);
+
+    QVERIFY(sv.contains(QStringView(u"World")));
+    QVERIFY(!sv.contains(QStringView(u"world")));
+    QVERIFY(sv.contains(QStringView(u"world"), Qt::CaseInsensitive));
+    QVERIFY(!QStringView().contains(QStringView(u"world")));
+}
+
 void tst_QStringView::fromQString() const
 {
     QString null;
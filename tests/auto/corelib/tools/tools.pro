@@ -20,6 +20,8 @@ SUBDIRS=\
     qdatetime \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflathash \
+    qflatmap \
     qfreelist \
     qhash \
     qhash_strictiterators \
@@ -34,6 +36,7 @@ SUBDIRS=\
     qmap_strictiterators \
     qmargins \
     qmessageauthenticationcode \
+    qmultistringmatcher \
     qpair \
     qpoint \
     qpointf \
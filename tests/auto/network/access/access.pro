@@ -14,7 +14,8 @@ SUBDIRS=\
    qabstractnetworkcache \
    hpack \
    http2 \
-   hsts
+   hsts \
+   qhttpserverengine
 
 !qtConfig(private_tests): SUBDIRS -= \
           qhttpnetworkconnection \
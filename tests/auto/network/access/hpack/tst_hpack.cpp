@@ -54,6 +54,9 @@ private Q_SLOTS:
     void bitstreamReadWrite();
     void bitstreamCompression();
     void bitstreamErrors();
+    void huffmanRoundTrip();
+    void huffmanErrors_data();
+    void huffmanErrors();
 
     void lookupTableConstructor();
 
@@ -71,6 +74,10 @@ private Q_SLOTS:
     void hpackDecodeResponse_data();
     void hpackDecodeResponse();
 
+    void hpackDecodeViews_data();
+    void hpackDecodeViews();
+    void hpackEncodeWithoutIndexing();
+
     // TODO: more-more-more tests needed!
 
 private:
@@ -343,6 +350,77 @@ void tst_Hpack::bitstreamErrors()
     }
 }
 
+void tst_Hpack::huffmanRoundTrip()
+{
+    // All octets, each string starting at a different offset
+    // (and thus crossing the code boundaries differently):
+    QByteArray allOctets;
+    for (int i = 0; i < 256; ++i)
+        allOctets.append(char(i));
+
+    std::vector<QByteArray> strings;
+    strings.push_back(QByteArray());
+    for (int i = 0; i < 256; ++i)
+        strings.push_back(allOctets.mid(i) + allOctets.left(i));
+
+    for (int i = 0; i < 1000; ++i) {
+        QByteArray random(QRandomGenerator::global()->bounded(200), Qt::Uninitialized);
+        for (char &c : random)
+            c = char(QRandomGenerator::global()->bounded(256));
+        strings.push_back(random);
+    }
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    for (const auto &s : strings)
+        out.write(s, true);
+
+    BitIStream in(out.begin(), out.end());
+    for (const auto &s : strings) {
+        QByteArray data;
+        QVERIFY(in.read(&data));
+        QCOMPARE(in.error(), StreamError::NoError);
+        QCOMPARE(data, s);
+    }
+    QCOMPARE(in.streamOffset(), in.bitLength());
+}
+
+void tst_Hpack::huffmanErrors_data()
+{
+    // A Huffman-encoded string literal: the first octet is the
+    // 'H' bit plus the length.
+    QTest::addColumn<QByteArray>("literal");
+    QTest::addColumn<bool>("valid");
+
+    // 'a' is 00011, padded with the 3 most significant bits of EOS:
+    QTest::newRow("valid-padding") << QByteArray("\x81\x1f", 2) << true;
+    // ... the padding must consist of 1s:
+    QTest::newRow("zero-padding") << QByteArray("\x81\x18", 2) << false;
+    // ... and must be shorter than 8 bits:
+    QTest::newRow("long-padding") << QByteArray("\x82\x1f\xff", 3) << false;
+    // EOS (30 1s) in the string is a decoding error:
+    QTest::newRow("eos") << QByteArray("\x84\xff\xff\xff\xff", 5) << false;
+    // 'a' followed by EOS:
+    QTest::newRow("symbol-eos") << QByteArray("\x85\x1f\xff\xff\xff\xff", 6) << false;
+}
+
+void tst_Hpack::huffmanErrors()
+{
+    QFETCH(QByteArray, literal);
+    QFETCH(bool, valid);
+
+    const uchar *first = reinterpret_cast<const uchar *>(literal.constData());
+    BitIStream in(first, first + literal.size());
+    QByteArray data;
+    QCOMPARE(in.read(&data), valid);
+    if (valid) {
+        QCOMPARE(data, QByteArray("a"));
+    } else {
+        QCOMPARE(in.error(), StreamError::CompressionError);
+        QCOMPARE(in.streamOffset(), quint64(0));
+    }
+}
+
 void tst_Hpack::lookupTableConstructor()
 {
     {
@@ -847,6 +925,66 @@ void tst_Hpack::hpackDecodeResponse()
     }
 }
 
+void tst_Hpack::hpackDecodeViews_data()
+{
+    hpackEncodeRequest_data();
+}
+
+void tst_Hpack::hpackDecodeViews()
+{
+    QFETCH(bool, compression);
+
+    // Response encoding adds fields to the dynamic table and (with a small
+    // table) evicts them, views must survive both.
+    hpackEncodeResponse(compression);
+
+    Decoder decoder(256);
+    Decoder viewDecoder(256);
+    const BitOStream *blocks[] = {&request1, &request2, &request3};
+    for (const BitOStream *block : blocks) {
+        QVERIFY(block->byteLength());
+        BitIStream inputStream(block->begin(), block->end());
+        QVERIFY(decoder.decodeHeaderFields(inputStream));
+        BitIStream viewStream(block->begin(), block->end());
+        QVERIFY(viewDecoder.decodeHeaderFieldViews(viewStream));
+        QCOMPARE(viewDecoder.dynamicTableSize(), decoder.dynamicTableSize());
+
+        const auto &decoded = decoder.decodedHeader();
+        const auto &views = viewDecoder.decodedHeaderView();
+        QCOMPARE(views.size(), decoded.size());
+        for (std::size_t i = 0; i < views.size(); ++i) {
+            QCOMPARE(QByteArray(views[i].name.data(), views[i].name.size()), decoded[i].name);
+            QCOMPARE(QByteArray(views[i].value.data(), views[i].value.size()), decoded[i].value);
+        }
+    }
+}
+
+void tst_Hpack::hpackEncodeWithoutIndexing()
+{
+    const HttpHeader header = {{"accept-encoding", "gzip, deflate"}, // Static table
+                               {"user-agent", "tst_hpack"},          // Static name
+                               {"x-custom", "some value"}};          // Literal
+
+    for (bool compression : {false, true}) {
+        Encoder encoder(4096, compression);
+        std::vector<uchar> buffer;
+        BitOStream outputStream(buffer);
+        QVERIFY(encoder.encodeHeaderFieldsWithoutIndexing(outputStream, header));
+        QCOMPARE(encoder.dynamicTableSize(), quint32(0));
+
+        Decoder decoder(4096);
+        BitIStream inputStream(outputStream.begin(), outputStream.end());
+        QVERIFY(decoder.decodeHeaderFields(inputStream));
+        QCOMPARE(decoder.dynamicTableSize(), quint32(0));
+        QVERIFY(decoder.decodedHeader() == header);
+
+        // The same octets can be decoded again, in any block:
+        BitIStream secondStream(outputStream.begin(), outputStream.end());
+        QVERIFY(decoder.decodeHeaderFields(secondStream));
+        QVERIFY(decoder.decodedHeader() == header);
+    }
+}
+
 QTEST_MAIN(tst_Hpack)
 
 #include "tst_hpack.moc"
@@ -0,0 +1,6 @@
+QT = core network network-private testlib
+CONFIG += testcase parallel_test c++11
+TEMPLATE = app
+TARGET = tst_qhttpserverengine
+
+SOURCES += tst_qhttpserverengine.cpp
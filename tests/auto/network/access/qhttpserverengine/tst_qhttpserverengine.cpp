@@ -0,0 +1,503 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qtcpsocket.h>
+
+#include <QtNetwork/private/qhttpserverengine_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qurl.h>
+
+QT_USE_NAMESPACE
+
+// Serves a few resources over QHttpServerEngine:
+//  /hello         - a fixed body with Content-Length,
+//  /echo          - streams the request body back as it arrives,
+//  /chunks        - a body written in pieces, without Content-Length,
+//  anything else  - 404.
+class RequestHandler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit RequestHandler(QHttpServerEngine *engine)
+    {
+        connect(engine, &QHttpServerEngine::newRequest, this, &RequestHandler::handleRequest);
+    }
+
+    QVector<quint16> peerPorts;
+    QVector<int> majorVersions;
+
+private Q_SLOTS:
+    void handleRequest(QHttpServerRequest *request, QHttpServerResponse *response)
+    {
+        peerPorts.append(request->peerPort());
+        majorVersions.append(request->majorVersion());
+
+        const QString path = request->url().path();
+        response->setHeaderField("X-Method", request->method());
+
+        if (path == QLatin1String("/hello")) {
+            const QByteArray body("Hello, world");
+            response->setHeaderField("Content-Length", QByteArray::number(body.size()));
+            response->write(body);
+            response->finish();
+        } else if (path == QLatin1String("/echo")) {
+            QPointer<QHttpServerResponse> target(response);
+            auto echo = [request, target]() {
+                if (!target)
+                    return;
+                while (request->bytesAvailable())
+                    target->write(request->read(16 * 1024));
+                if (request->isFinished())
+                    target->finish();
+            };
+            connect(request, &QIODevice::readyRead, response, echo);
+            connect(request, &QIODevice::readChannelFinished, response, echo);
+            echo();
+        } else if (path == QLatin1String("/chunks")) {
+            for (int i = 0; i < 10; ++i)
+                response->write(QByteArray::number(i) + ';');
+            response->finish();
+        } else {
+            response->setStatusCode(404);
+            response->finish();
+        }
+    }
+};
+
+enum class Protocol
+{
+    Http1,
+    Http2Upgrade,
+    Http2Direct
+};
+
+Q_DECLARE_METATYPE(Protocol)
+
+class tst_QHttpServerEngine : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void get_data();
+    void get();
+    void post_data();
+    void post();
+    void chunkedResponse_data();
+    void chunkedResponse();
+    void notFound_data();
+    void notFound();
+    void keepAlive();
+    void pipelining();
+    void multiplexing();
+    void malformedRequest();
+    void transferEncoding_data();
+    void transferEncoding();
+    void oversizedRequestHeaders();
+    void requestHeaderTimeout();
+    void continuationFlood();
+
+private:
+    QNetworkRequest makeRequest(const QString &path, Protocol protocol) const;
+    bool waitForReplies(const QVector<QNetworkReply *> &replies);
+    QByteArray exchangeRaw(const QByteArray &data);
+
+    QHttpServerEngine *engine = nullptr;
+    RequestHandler *handler = nullptr;
+    QNetworkAccessManager *manager = nullptr;
+};
+
+void tst_QHttpServerEngine::init()
+{
+    engine = new QHttpServerEngine;
+    QVERIFY2(engine->listen(QHostAddress::LocalHost), qPrintable(engine->errorString()));
+    handler = new RequestHandler(engine);
+    manager = new QNetworkAccessManager;
+}
+
+void tst_QHttpServerEngine::cleanup()
+{
+    delete manager;
+    delete handler;
+    delete engine;
+}
+
+QNetworkRequest tst_QHttpServerEngine::makeRequest(const QString &path, Protocol protocol) const
+{
+    QUrl url;
+    url.setScheme(QStringLiteral("http"));
+    url.setHost(QStringLiteral("127.0.0.1"));
+    url.setPort(engine->serverPort());
+    url.setPath(path);
+
+    QNetworkRequest request(url);
+    if (protocol == Protocol::Http2Upgrade)
+        request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+    else if (protocol == Protocol::Http2Direct)
+        request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+    return request;
+}
+
+bool tst_QHttpServerEngine::waitForReplies(const QVector<QNetworkReply *> &replies)
+{
+    const auto allFinished = [&replies]() {
+        for (QNetworkReply *reply : replies) {
+            if (!reply->isFinished())
+                return false;
+        }
+        return true;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!allFinished() && timer.elapsed() < 10000)
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 100);
+    return allFinished();
+}
+
+// Writes data to a new connection and returns everything received until
+// the engine closes it.
+QByteArray tst_QHttpServerEngine::exchangeRaw(const QByteArray &data)
+{
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, engine->serverPort());
+    if (!socket.waitForConnected())
+        return QByteArray();
+
+    socket.write(data);
+
+    // The engine lives in this thread, so keep the event loop running.
+    QByteArray received;
+    connect(&socket, &QIODevice::readyRead, [&]() { received += socket.readAll(); });
+    QElapsedTimer timer;
+    timer.start();
+    while (socket.state() != QAbstractSocket::UnconnectedState && timer.elapsed() < 10000)
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 100);
+    return received + socket.readAll();
+}
+
+void tst_QHttpServerEngine::get_data()
+{
+    QTest::addColumn<Protocol>("protocol");
+    QTest::addColumn<bool>("http2Used");
+
+    QTest::newRow("http/1.1") << Protocol::Http1 << false;
+    QTest::newRow("h2c-upgrade") << Protocol::Http2Upgrade << true;
+    QTest::newRow("h2-direct") << Protocol::Http2Direct << true;
+}
+
+void tst_QHttpServerEngine::get()
+{
+    QFETCH(Protocol, protocol);
+    QFETCH(bool, http2Used);
+
+    QScopedPointer<QNetworkReply> reply(manager->get(makeRequest(QStringLiteral("/hello"), protocol)));
+    QVERIFY(waitForReplies({reply.data()}));
+
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+    QCOMPARE(reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool(), http2Used);
+    QCOMPARE(reply->rawHeader("X-Method"), QByteArray("GET"));
+    QCOMPARE(reply->readAll(), QByteArray("Hello, world"));
+    QCOMPARE(handler->majorVersions.size(), 1);
+    // The h2c upgrade request itself is an HTTP/1.1 request.
+    QCOMPARE(handler->majorVersions.at(0), protocol == Protocol::Http2Direct ? 2 : 1);
+}
+
+void tst_QHttpServerEngine::post_data()
+{
+    QTest::addColumn<Protocol>("protocol");
+    QTest::addColumn<int>("size");
+
+    // Larger than the request buffer and the HTTP/2 stream window, so the
+    // body has to be streamed through the application.
+    for (int size : {0, 1, 100 * 1024, 1024 * 1024}) {
+        QTest::addRow("http/1.1-%d", size) << Protocol::Http1 << size;
+        QTest::addRow("h2c-upgrade-%d", size) << Protocol::Http2Upgrade << size;
+        QTest::addRow("h2-direct-%d", size) << Protocol::Http2Direct << size;
+    }
+}
+
+void tst_QHttpServerEngine::post()
+{
+    QFETCH(Protocol, protocol);
+    QFETCH(int, size);
+
+    QByteArray body(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        body[i] = char('a' + i % 26);
+
+    QNetworkRequest request(makeRequest(QStringLiteral("/echo"), protocol));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArray("application/octet-stream"));
+    QScopedPointer<QNetworkReply> reply(manager->post(request, body));
+    QVERIFY(waitForReplies({reply.data()}));
+
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->rawHeader("X-Method"), QByteArray("POST"));
+    const QByteArray echo = reply->readAll();
+    QCOMPARE(echo.size(), body.size());
+    QVERIFY(echo == body);
+}
+
+void tst_QHttpServerEngine::chunkedResponse_data()
+{
+    get_data();
+}
+
+void tst_QHttpServerEngine::chunkedResponse()
+{
+    QFETCH(Protocol, protocol);
+
+    QScopedPointer<QNetworkReply> reply(manager->get(makeRequest(QStringLiteral("/chunks"), protocol)));
+    QVERIFY(waitForReplies({reply.data()}));
+
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), QByteArray("0;1;2;3;4;5;6;7;8;9;"));
+}
+
+void tst_QHttpServerEngine::notFound_data()
+{
+    get_data();
+}
+
+void tst_QHttpServerEngine::notFound()
+{
+    QFETCH(Protocol, protocol);
+
+    QScopedPointer<QNetworkReply> reply(manager->get(makeRequest(QStringLiteral("/nothing"), protocol)));
+    QVERIFY(waitForReplies({reply.data()}));
+
+    QCOMPARE(reply->error(), QNetworkReply::ContentNotFoundError);
+    QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 404);
+    QVERIFY(reply->readAll().isEmpty());
+}
+
+void tst_QHttpServerEngine::keepAlive()
+{
+    for (int i = 0; i < 3; ++i) {
+        QScopedPointer<QNetworkReply> reply(manager->get(makeRequest(QStringLiteral("/hello"),
+                                                                     Protocol::Http1)));
+        QVERIFY(waitForReplies({reply.data()}));
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+
+    QCOMPARE(handler->peerPorts.size(), 3);
+    QCOMPARE(handler->peerPorts.at(1), handler->peerPorts.at(0));
+    QCOMPARE(handler->peerPorts.at(2), handler->peerPorts.at(0));
+}
+
+void tst_QHttpServerEngine::pipelining()
+{
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, engine->serverPort());
+    QVERIFY(socket.waitForConnected());
+
+    // All three requests in one write; the responses must come in order.
+    socket.write("GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                 "POST /echo HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nabcde"
+                 "GET /nothing HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+
+    // The engine lives in this thread, so keep the event loop running.
+    QByteArray received;
+    connect(&socket, &QIODevice::readyRead, [&]() { received += socket.readAll(); });
+    QTRY_COMPARE_WITH_TIMEOUT(socket.state(), QAbstractSocket::UnconnectedState, 10000);
+    received += socket.readAll();
+
+    const int first = received.indexOf("HTTP/1.1 200 OK");
+    const int second = received.indexOf("HTTP/1.1 200 OK", first + 1);
+    const int third = received.indexOf("HTTP/1.1 404 Not Found");
+    QVERIFY(first == 0);
+    QVERIFY(second > first);
+    QVERIFY(third > second);
+    QVERIFY(received.indexOf("Hello, world") > first);
+    QVERIFY(received.indexOf("5\r\nabcde\r\n0\r\n\r\n") > second);
+    QVERIFY(received.indexOf("Connection: close") > third);
+    QCOMPARE(handler->peerPorts.size(), 3);
+}
+
+void tst_QHttpServerEngine::multiplexing()
+{
+    engine->setMaxConcurrentStreams(4);
+
+    QVector<QNetworkReply *> replies;
+    for (int i = 0; i < 20; ++i)
+        replies.append(manager->get(makeRequest(QStringLiteral("/hello"), Protocol::Http2Direct)));
+
+    QVERIFY(waitForReplies(replies));
+    for (QNetworkReply *reply : qAsConst(replies)) {
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QVERIFY(reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool());
+        QCOMPARE(reply->readAll(), QByteArray("Hello, world"));
+    }
+    qDeleteAll(replies);
+
+    // QNAM uses a single connection for HTTP/2:
+    QCOMPARE(handler->peerPorts.size(), 20);
+    for (quint16 port : qAsConst(handler->peerPorts))
+        QCOMPARE(port, handler->peerPorts.at(0));
+}
+
+void tst_QHttpServerEngine::malformedRequest()
+{
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, engine->serverPort());
+    QVERIFY(socket.waitForConnected());
+
+    socket.write("NONSENSE\r\n\r\n");
+
+    // The engine lives in this thread, so keep the event loop running.
+    QByteArray received;
+    connect(&socket, &QIODevice::readyRead, [&]() { received += socket.readAll(); });
+    QTRY_COMPARE_WITH_TIMEOUT(socket.state(), QAbstractSocket::UnconnectedState, 10000);
+    received += socket.readAll();
+
+    QVERIFY(received.startsWith("HTTP/1.1 400 Bad Request\r\n"));
+    QCOMPARE(socket.state(), QAbstractSocket::UnconnectedState);
+    QVERIFY(handler->peerPorts.isEmpty());
+}
+
+void tst_QHttpServerEngine::transferEncoding_data()
+{
+    QTest::addColumn<QByteArray>("fields");
+    QTest::addColumn<QByteArray>("status");
+
+    QTest::newRow("chunked") << QByteArray("Transfer-Encoding: chunked\r\n")
+                             << QByteArray("200 OK");
+    QTest::newRow("case") << QByteArray("Transfer-Encoding: Chunked\r\n")
+                          << QByteArray("200 OK");
+    QTest::newRow("content-length") << QByteArray("Transfer-Encoding: chunked\r\nContent-Length: 3\r\n")
+                                    << QByteArray("200 OK");
+    // The body length is undefined unless chunked comes last:
+    QTest::newRow("identity") << QByteArray("Transfer-Encoding: identity\r\n")
+                              << QByteArray("400 Bad Request");
+    QTest::newRow("not-last") << QByteArray("Transfer-Encoding: chunked, gzip\r\n")
+                              << QByteArray("400 Bad Request");
+    QTest::newRow("twice") << QByteArray("Transfer-Encoding: chunked, chunked\r\n")
+                           << QByteArray("400 Bad Request");
+    QTest::newRow("empty") << QByteArray("Transfer-Encoding: ,\r\n")
+                           << QByteArray("400 Bad Request");
+    // ...and no coding other than chunked is implemented:
+    QTest::newRow("gzip") << QByteArray("Transfer-Encoding: gzip, chunked\r\n")
+                          << QByteArray("501 Not Implemented");
+    QTest::newRow("split") << QByteArray("Transfer-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n")
+                           << QByteArray("501 Not Implemented");
+}
+
+void tst_QHttpServerEngine::transferEncoding()
+{
+    QFETCH(QByteArray, fields);
+    QFETCH(QByteArray, status);
+
+    const QByteArray received = exchangeRaw("POST /echo HTTP/1.1\r\nHost: localhost\r\n"
+                                            "Connection: close\r\n" + fields + "\r\n"
+                                            "5\r\nhello\r\n0\r\n\r\n");
+    QVERIFY2(received.startsWith("HTTP/1.1 " + status + "\r\n"), received.constData());
+    if (status == "200 OK") {
+        QVERIFY(received.contains("hello"));
+        QCOMPARE(handler->peerPorts.size(), 1);
+    } else {
+        QVERIFY(handler->peerPorts.isEmpty());
+    }
+}
+
+void tst_QHttpServerEngine::oversizedRequestHeaders()
+{
+    // Every field is within the line length limit, their sum is not:
+    QByteArray request("GET /hello HTTP/1.1\r\nHost: localhost\r\n");
+    for (int i = 0; i < 80; ++i)
+        request += "X-Field-" + QByteArray::number(i) + ": " + QByteArray(1000, 'x') + "\r\n";
+    request += "\r\n";
+
+    const QByteArray received = exchangeRaw(request);
+    QVERIFY(received.startsWith("HTTP/1.1 431 Request Header Fields Too Large\r\n"));
+    QVERIFY(handler->peerPorts.isEmpty());
+}
+
+void tst_QHttpServerEngine::requestHeaderTimeout()
+{
+    engine->setRequestHeaderTimeout(200);
+
+    // The request line arrives, the rest of the head never does:
+    QElapsedTimer timer;
+    timer.start();
+    const QByteArray received = exchangeRaw("GET /hello HTTP/1.1\r\nHost: local");
+    QVERIFY(received.startsWith("HTTP/1.1 408 Request Timeout\r\n"));
+    QVERIFY(timer.elapsed() < 5000);
+    QVERIFY(handler->peerPorts.isEmpty());
+}
+
+static QByteArray http2Frame(uchar type, uchar flags, quint32 streamID, const QByteArray &payload)
+{
+    QByteArray frame(9, Qt::Uninitialized);
+    qToBigEndian(quint32(payload.size()) << 8 | type, frame.data());
+    frame[4] = char(flags);
+    qToBigEndian(streamID, frame.data() + 5);
+    return frame + payload;
+}
+
+void tst_QHttpServerEngine::continuationFlood()
+{
+    // HEADERS without END_HEADERS followed by CONTINUATION frames that
+    // never end the header block:
+    QByteArray data("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+    data += http2Frame(0x4, 0x0, 0, QByteArray());
+    data += http2Frame(0x1, 0x1, 1, QByteArray(1024, char(0x40)));
+    for (int i = 0; i < 16; ++i)
+        data += http2Frame(0x9, 0x0, 1, QByteArray(16 * 1024, char(0x40)));
+
+    const QByteArray received = exchangeRaw(data);
+
+    // The engine answers with GOAWAY(ENHANCE_YOUR_CALM) long before the
+    // client is done sending:
+    bool goAway = false;
+    for (int pos = 0; pos + 9 <= received.size();) {
+        const quint32 length = qFromBigEndian<quint32>(received.constData() + pos) >> 8;
+        const uchar type = uchar(received.at(pos + 3));
+        if (type == 0x7 && length >= 8 && pos + 9 + 8 <= received.size()) {
+            QCOMPARE(qFromBigEndian<quint32>(received.constData() + pos + 13), quint32(0xb));
+            goAway = true;
+        }
+        pos += 9 + int(length);
+    }
+    QVERIFY(goAway);
+    QVERIFY(handler->peerPorts.isEmpty());
+}
+
+QTEST_MAIN(tst_QHttpServerEngine)
+
+#include "tst_qhttpserverengine.moc"
@@ -30,6 +30,9 @@
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QHttpConnectionPoolPolicy>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 #ifndef QT_NO_BEARERMANAGEMENT
 #include <QtNetwork/QNetworkConfigurationManager>
 #endif
@@ -50,6 +53,8 @@ public:
 private slots:
     void networkAccessible();
     void alwaysCacheRequest();
+    void connectionPoolPolicy();
+    void connectionPoolStatistics();
 };
 
 tst_QNetworkAccessManager::tst_QNetworkAccessManager()
@@ -138,5 +143,97 @@ void tst_QNetworkAccessManager::alwaysCacheRequest()
     delete reply;
 }
 
+void tst_QNetworkAccessManager::connectionPoolPolicy()
+{
+    QHttpConnectionPoolPolicy policy;
+    QCOMPARE(policy.maximumConnections(), 6);
+    QCOMPARE(policy.idleTimeout(), 120000);
+    QCOMPARE(policy.prewarmedConnections(), 0);
+
+    policy.setMaximumConnections(32);
+    policy.setIdleTimeout(5000);
+    policy.setPrewarmedConnections(4);
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolPolicy::setMaximumConnections: invalid count 0");
+    policy.setMaximumConnections(0);
+    QCOMPARE(policy.maximumConnections(), 32);
+    QVERIFY(policy != QHttpConnectionPoolPolicy());
+
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.connectionPoolPolicy(), QHttpConnectionPoolPolicy());
+    manager.setConnectionPoolPolicy(QStringLiteral("Backend.example"), 8080, policy);
+    QCOMPARE(manager.connectionPoolPolicy(QStringLiteral("backend.example"), 8080), policy);
+    QCOMPARE(manager.connectionPoolPolicy(QStringLiteral("backend.example"), 80),
+             QHttpConnectionPoolPolicy());
+
+    QHttpConnectionPoolPolicy defaultPolicy;
+    defaultPolicy.setMaximumConnections(2);
+    manager.setConnectionPoolPolicy(defaultPolicy);
+    QCOMPARE(manager.connectionPoolPolicy(), defaultPolicy);
+    QCOMPARE(manager.connectionPoolPolicy(QStringLiteral("backend.example"), 80), defaultPolicy);
+    QCOMPARE(manager.connectionPoolPolicy(QStringLiteral("backend.example"), 8080), policy);
+}
+
+void tst_QNetworkAccessManager::connectionPoolStatistics()
+{
+#if !QT_CONFIG(http)
+    QSKIP("This test requires http");
+#else
+    // A keep-alive server answering every request with an empty body
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    int connections = 0;
+    connect(&server, &QTcpServer::newConnection, [&server, &connections]() {
+        while (QTcpSocket *socket = server.nextPendingConnection()) {
+            ++connections;
+            connect(socket, &QTcpSocket::readyRead, [socket]() {
+                if (socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+                    socket->readAll();
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+                }
+            });
+        }
+    });
+
+    const QString host = QStringLiteral("127.0.0.1");
+    QUrl url;
+    url.setScheme(QStringLiteral("http"));
+    url.setHost(host);
+    url.setPort(server.serverPort());
+
+    QHttpConnectionPoolPolicy policy;
+    policy.setMaximumConnections(1);
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolPolicy(host, server.serverPort(), policy);
+
+    // Sequential requests share the single connection of the pool
+    for (int i = 0; i < 3; ++i) {
+        QScopedPointer<QNetworkReply> reply(manager.get(QNetworkRequest(url)));
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+
+    QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics(host, server.serverPort());
+    QCOMPARE(connections, 1);
+    QCOMPARE(statistics.connectionCount(), qint64(1));
+    QCOMPARE(statistics.requestCount(), qint64(3));
+    QCOMPARE(statistics.reusedConnectionRequestCount(), qint64(2));
+    QCOMPARE(statistics.queueDepth(), 0);
+    QVERIFY(statistics.maximumConnectLatency() >= statistics.averageConnectLatency());
+
+    // A prewarmed pool opens its connections right away
+    manager.clearConnectionCache();
+    connections = 0;
+    policy.setMaximumConnections(4);
+    policy.setPrewarmedConnections(3);
+    manager.setConnectionPoolPolicy(host, server.serverPort(), policy);
+    QScopedPointer<QNetworkReply> reply(manager.get(QNetworkRequest(url)));
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QTRY_COMPARE(connections, 3);
+
+    QCOMPARE(manager.connectionPoolStatistics(QStringLiteral("localhost"), 1).requestCount(), qint64(0));
+#endif
+}
+
 QTEST_MAIN(tst_QNetworkAccessManager)
 #include "tst_qnetworkaccessmanager.moc"
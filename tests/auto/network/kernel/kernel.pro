@@ -1,5 +1,6 @@
 TEMPLATE=subdirs
 SUBDIRS=\
+   qasyncdnsresolver \
    qdnslookup \
    qdnslookup_appless \
    qhostinfo \
@@ -19,6 +20,7 @@ osx: SUBDIRS -= \ # QTBUG-41847
     qhostinfo \
 
 !qtConfig(private_tests): SUBDIRS -= \
+    qasyncdnsresolver \
     qauthenticator \
     qhostinfo \
 
@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_qasyncdnsresolver
+
+SOURCES  += tst_qasyncdnsresolver.cpp
+
+requires(qtConfig(private_tests))
+QT = core-private network-private testlib
@@ -0,0 +1,297 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QHostInfo>
+#include <QUdpSocket>
+#include <QTemporaryFile>
+#include <QtEndian>
+
+#include "private/qhostinfo_p.h"
+
+// Answers A and AAAA queries for a fixed set of names, NXDOMAIN otherwise.
+// Unlike tst_QHostInfo, this test does not need the network test server.
+class StubDnsServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Record { QHostAddress address; quint32 ttl; };
+
+    StubDnsServer()
+    {
+        socket.bind(QHostAddress(QHostAddress::LocalHost), 0);
+        connect(&socket, &QUdpSocket::readyRead, this, &StubDnsServer::readQueries);
+    }
+
+    quint16 port() const { return socket.localPort(); }
+
+    QMultiHash<QString, Record> records;
+    int queryCount = 0;
+    QSet<quint16> senderPorts;
+    bool echoOtherQuestion = false; // like a spoofed reply that guessed the ID
+
+private slots:
+    void readQueries()
+    {
+        while (socket.hasPendingDatagrams()) {
+            QHostAddress sender;
+            quint16 senderPort;
+            QByteArray query(int(socket.pendingDatagramSize()), Qt::Uninitialized);
+            socket.readDatagram(query.data(), query.size(), &sender, &senderPort);
+            if (query.size() < 12)
+                continue;
+            ++queryCount;
+            senderPorts.insert(senderPort);
+
+            // question name, as a sequence of labels
+            QStringList labels;
+            int pos = 12;
+            while (pos < query.size() && query.at(pos)) {
+                const int length = quint8(query.at(pos));
+                labels << QString::fromLatin1(query.mid(pos + 1, length));
+                pos += length + 1;
+            }
+            pos += 1;
+            if (pos + 4 > query.size())
+                continue;
+            const quint16 type = qFromBigEndian<quint16>(query.constData() + pos);
+            pos += 4;
+
+            const QString name = labels.join(QLatin1Char('.'));
+            const QAbstractSocket::NetworkLayerProtocol protocol = type == 28
+                    ? QAbstractSocket::IPv6Protocol : QAbstractSocket::IPv4Protocol;
+            QVector<Record> answers;
+            for (const Record &record : records.values(name)) {
+                if (record.address.protocol() == protocol)
+                    answers << record;
+            }
+
+            QByteArray response = query.left(pos);
+            if (echoOtherQuestion)
+                response[13] = response.at(13) == 'x' ? 'y' : 'x';
+            response[2] = char(0x81);                                       // QR, RD
+            response[3] = char(records.contains(name) ? 0x80 : 0x83);       // RA, NXDOMAIN
+            qToBigEndian<quint16>(answers.size(), response.data() + 6);
+            for (const Record &record : qAsConst(answers)) {
+                char rr[12];
+                rr[0] = char(0xc0);                                         // pointer to the question
+                rr[1] = 12;
+                qToBigEndian<quint16>(type, rr + 2);
+                qToBigEndian<quint16>(1, rr + 4);                           // class IN
+                qToBigEndian<quint32>(record.ttl, rr + 6);
+                QByteArray rdata;
+                if (type == 28) {
+                    const Q_IPV6ADDR ip6 = record.address.toIPv6Address();
+                    rdata = QByteArray(reinterpret_cast<const char *>(ip6.c), 16);
+                } else {
+                    rdata.resize(4);
+                    qToBigEndian<quint32>(record.address.toIPv4Address(), rdata.data());
+                }
+                qToBigEndian<quint16>(rdata.size(), rr + 10);
+                response.append(rr, sizeof rr);
+                response.append(rdata);
+            }
+            socket.writeDatagram(response, sender, senderPort);
+        }
+    }
+
+private:
+    QUdpSocket socket;
+};
+
+class tst_QAsyncDnsResolver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase_data();
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void sharedQueries();
+    void hostsFile();
+    void searchDomains();
+    void notFound();
+    void cacheTtl();
+    void sourcePorts();
+    void spoofedReply();
+
+private:
+    bool lookup(const QString &name, QHostInfo *result);
+
+    QScopedPointer<StubDnsServer> server;
+    QTemporaryFile hosts;
+    const QList<QHostAddress> expected = { QHostAddress(QStringLiteral("192.0.2.1")),
+                                           QHostAddress(QStringLiteral("2001:db8::1")) };
+};
+
+void tst_QAsyncDnsResolver::initTestCase_data()
+{
+    QTest::addColumn<bool>("cache");
+    QTest::newRow("WithCache") << true;
+    QTest::newRow("WithoutCache") << false;
+}
+
+void tst_QAsyncDnsResolver::initTestCase()
+{
+#if !defined(QT_BUILD_INTERNAL) || !defined(QT_HOSTINFO_ASYNC_RESOLVER)
+    QSKIP("The asynchronous resolver is not available on this platform");
+#endif
+    QVERIFY(hosts.open());
+    hosts.write("# comment\n192.0.2.99 hosts.example.test alias.example.test\n");
+    hosts.close();
+}
+
+void tst_QAsyncDnsResolver::init()
+{
+#if defined(QT_BUILD_INTERNAL) && defined(QT_HOSTINFO_ASYNC_RESOLVER)
+    qt_qhostinfo_clear_cache();
+    QFETCH_GLOBAL(bool, cache);
+    qt_qhostinfo_enable_cache(cache);
+
+    server.reset(new StubDnsServer);
+    QVERIFY(server->port());
+    server->records.insert(QStringLiteral("www.example.test"), { expected.at(0), 3600 });
+    server->records.insert(QStringLiteral("www.example.test"), { expected.at(1), 3600 });
+    server->records.insert(QStringLiteral("short.example.test"), { QHostAddress(QStringLiteral("192.0.2.2")), 0 });
+
+    QDnsResolverConfiguration configuration;
+    configuration.nameServers.append(qMakePair(QHostAddress(QHostAddress::LocalHost), server->port()));
+    configuration.searchDomains << QStringLiteral("example.test");
+    configuration.hostsFile = hosts.fileName();
+    configuration.timeout = 1000;
+    configuration.attempts = 1;
+    qt_qhostinfo_enable_async_resolver(true, configuration);
+#endif
+}
+
+void tst_QAsyncDnsResolver::cleanup()
+{
+#if defined(QT_BUILD_INTERNAL) && defined(QT_HOSTINFO_ASYNC_RESOLVER)
+    qt_qhostinfo_enable_async_resolver(false);
+#endif
+    server.reset();
+}
+
+bool tst_QAsyncDnsResolver::lookup(const QString &name, QHostInfo *result)
+{
+    bool done = false;
+    QHostInfo::lookupHost(name, this, [&](const QHostInfo &info) { *result = info; done = true; });
+    return QTest::qWaitFor([&]() { return done; });
+}
+
+void tst_QAsyncDnsResolver::sharedQueries()
+{
+    // concurrent lookups of the same name share a single A and AAAA query
+    int finished = 0;
+    QList<QHostAddress> first, second;
+    QHostInfo::lookupHost(QStringLiteral("www.example.test"), this,
+                          [&](const QHostInfo &info) { first = info.addresses(); ++finished; });
+    QHostInfo::lookupHost(QStringLiteral("www.example.test"), this,
+                          [&](const QHostInfo &info) { second = info.addresses(); ++finished; });
+    QTRY_COMPARE_WITH_TIMEOUT(finished, 2, 5000);
+    QCOMPARE(first, expected);
+    QCOMPARE(second, expected);
+    QCOMPARE(server->queryCount, 2);
+}
+
+void tst_QAsyncDnsResolver::hostsFile()
+{
+    // the hosts file is consulted before any query is sent
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("alias.example.test"), &info));
+    QCOMPARE(info.error(), QHostInfo::NoError);
+    QCOMPARE(info.addresses(), QList<QHostAddress>() << QHostAddress(QStringLiteral("192.0.2.99")));
+    QCOMPARE(server->queryCount, 0);
+}
+
+void tst_QAsyncDnsResolver::searchDomains()
+{
+    // names with fewer dots than ndots try the search domains first
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("www"), &info));
+    QCOMPARE(info.error(), QHostInfo::NoError);
+    QCOMPARE(info.addresses(), expected);
+    QCOMPARE(server->queryCount, 2);
+}
+
+void tst_QAsyncDnsResolver::notFound()
+{
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("missing.example.test"), &info));
+    QCOMPARE(info.error(), QHostInfo::HostNotFound);
+    QVERIFY(info.addresses().isEmpty());
+    QCOMPARE(server->queryCount, 4); // the name as is, then with the search domain appended
+}
+
+void tst_QAsyncDnsResolver::cacheTtl()
+{
+    QFETCH_GLOBAL(bool, cache);
+
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("www.example.test"), &info));
+    QCOMPARE(info.addresses(), expected);
+    QCOMPARE(server->queryCount, 2);
+
+    // answers are cached for their TTL...
+    QVERIFY(lookup(QStringLiteral("www.example.test"), &info));
+    QCOMPARE(info.addresses(), expected);
+    QCOMPARE(server->queryCount, cache ? 2 : 4);
+
+    // ...so a zero TTL is not cached at all
+    const int queryCount = server->queryCount;
+    QVERIFY(lookup(QStringLiteral("short.example.test"), &info));
+    QCOMPARE(info.addresses(), QList<QHostAddress>() << QHostAddress(QStringLiteral("192.0.2.2")));
+    QCOMPARE(server->queryCount, queryCount + 2);
+    QVERIFY(lookup(QStringLiteral("short.example.test"), &info));
+    QCOMPARE(info.addresses(), QList<QHostAddress>() << QHostAddress(QStringLiteral("192.0.2.2")));
+    QCOMPARE(server->queryCount, queryCount + 4);
+}
+
+void tst_QAsyncDnsResolver::sourcePorts()
+{
+    // every lookup is sent from a port of its own
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("www.example.test"), &info));
+    QVERIFY(lookup(QStringLiteral("short.example.test"), &info));
+    QVERIFY(server->senderPorts.size() > 1);
+}
+
+void tst_QAsyncDnsResolver::spoofedReply()
+{
+    // replies that do not repeat the question are ignored
+    server->echoOtherQuestion = true;
+    QHostInfo info;
+    QVERIFY(lookup(QStringLiteral("spoofed.example.test"), &info));
+    QCOMPARE(info.error(), QHostInfo::UnknownError);
+    QVERIFY(info.addresses().isEmpty());
+}
+
+QTEST_MAIN(tst_QAsyncDnsResolver)
+#include "tst_qasyncdnsresolver.moc"
@@ -202,6 +202,7 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void writeFromFile();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3120,6 +3121,66 @@ void tst_QTcpSocket::writeOnReadBufferOverflow()
     delete socket;
 }
 
+void tst_QTcpSocket::writeFromFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray contents(1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < contents.size(); ++i)
+        contents[i] = char(i * 7 + (i >> 10));
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+    QVERIFY(file.flush());
+
+    QTcpServer tcpServer;
+    QTcpSocket *socket = newSocket();
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    QSignalSpy bytesWrittenSpy(socket, &QIODevice::bytesWritten);
+    QByteArray expected = "head";
+    QCOMPARE(socket->write("head"), qint64(4));
+    QCOMPARE(socket->writeFromFile(&file, 100, contents.size() - 200),
+             qint64(contents.size() - 200));
+    expected += contents.mid(100, contents.size() - 200);
+    QCOMPARE(socket->write("middle"), qint64(6));
+    expected += "middle";
+    // the length is clamped to the end of the file
+    QCOMPARE(socket->writeFromFile(&file, contents.size() - 10, 1000), qint64(10));
+    expected += contents.right(10);
+    QCOMPARE(socket->write("tail"), qint64(4));
+    expected += "tail";
+    QCOMPARE(socket->bytesToWrite(), qint64(expected.size()));
+
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 10000) {
+        socket->flush();
+        if (newConnection->waitForReadyRead(100))
+            received += newConnection->readAll();
+    }
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(socket->bytesToWrite(), qint64(0));
+
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &args : qAsConst(bytesWrittenSpy))
+        totalWritten += args.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+
+    delete newConnection;
+    delete socket;
+}
+
 // Test that the socket does not enable the read notifications in bind()
 void tst_QTcpSocket::readNotificationsAfterBind()
 {
@@ -3141,4 +3202,5 @@ void tst_QTcpSocket::readNotificationsAfterBind()
 }
 
 QTEST_MAIN(tst_QTcpSocket)
+
 #include "tst_qtcpsocket.moc"
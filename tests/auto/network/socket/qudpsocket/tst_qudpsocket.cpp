@@ -98,6 +98,7 @@ private slots:
     void outOfProcessConnectedClientServerTest();
     void outOfProcessUnconnectedClientServerTest();
     void zeroLengthDatagram();
+    void batchedDatagrams();
     void multicastTtlOption_data();
     void multicastTtlOption();
     void multicastLoopbackOption_data();
@@ -1219,6 +1220,76 @@ void tst_QUdpSocket::zeroLengthDatagram()
     QCOMPARE(receiver.readDatagram(&buf, 1), qint64(0));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY2(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0), qPrintable(receiver.errorString()));
+    QVERIFY(receiver.receiveDatagrams(16).isEmpty());
+
+    QUdpSocket sender;
+    QVERIFY2(sender.bind(QHostAddress(QHostAddress::LocalHost), 0), qPrintable(sender.errorString()));
+
+    const int count = 100;
+    QVector<QNetworkDatagram> datagrams;
+    for (int i = 0; i < count; ++i) {
+        QNetworkDatagram dgram(QByteArray(i % 7, char('a' + i % 26)) + QByteArray::number(i),
+                               QHostAddress::LocalHost, receiver.localPort());
+        dgram.setHopLimit(42);
+        datagrams << dgram;
+    }
+
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    int sent = 0;
+    while (sent < count) {
+        const int n = sender.writeDatagrams(datagrams.mid(sent));
+        QVERIFY2(n > 0, qPrintable(sender.errorString()));
+        sent += n;
+    }
+    qint64 bytesWritten = 0;
+    for (const QList<QVariant> &signal : qAsConst(bytesWrittenSpy))
+        bytesWritten += signal.at(0).toLongLong();
+    qint64 totalSize = 0;
+    for (const QNetworkDatagram &dgram : qAsConst(datagrams))
+        totalSize += dgram.data().size();
+    QCOMPARE(bytesWritten, totalSize);
+
+    QVector<QNetworkDatagram> received;
+    while (received.size() < count) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += receiver.receiveDatagrams(count);
+    }
+
+    QCOMPARE(received.size(), count);
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagram &dgram = received.at(i);
+        QVERIFY(dgram.isValid());
+        QCOMPARE(dgram.data(), datagrams.at(i).data());
+        QCOMPARE(dgram.senderAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(dgram.senderPort(), int(sender.localPort()));
+#if defined(Q_OS_LINUX)
+        QCOMPARE(dgram.destinationAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(dgram.destinationPort(), int(receiver.localPort()));
+        QCOMPARE(dgram.hopLimit(), 42);
+#endif
+    }
+
+    // a size limit truncates each datagram
+    QCOMPARE(sender.writeDatagrams(datagrams.mid(10, 4)), 4);
+    received.clear();
+    while (received.size() < 4) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += receiver.receiveDatagrams(4 - received.size(), 2);
+    }
+    for (int i = 0; i < 4; ++i)
+        QCOMPARE(received.at(i).data(), datagrams.at(10 + i).data().left(2));
+}
+
 void tst_QUdpSocket::multicastTtlOption_data()
 {
     QTest::addColumn<QHostAddress>("bindAddress");
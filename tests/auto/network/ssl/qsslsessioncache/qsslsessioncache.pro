@@ -0,0 +1,10 @@
+CONFIG += testcase
+
+SOURCES += tst_qsslsessioncache.cpp
+QT = core network-private testlib
+
+TARGET = tst_qsslsessioncache
+
+TESTDATA += certs
+
+requires(qtConfig(private_tests))
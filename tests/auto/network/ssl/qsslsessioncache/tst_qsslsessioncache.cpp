@@ -0,0 +1,275 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtNetwork/qsslsessioncache.h>
+#include <QtNetwork/qsslconfiguration.h>
+#include <QtNetwork/qsslkey.h>
+#include <QtNetwork/qsslsocket.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/private/qsslconfiguration_p.h>
+
+class tst_QSslSessionCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndFind();
+    void leastRecentlyUsedEviction();
+    void saveAndLoad();
+    void resumeSession_data();
+    void resumeSession();
+    void unverifiedSessionsNotShared_data();
+    void unverifiedSessionsNotShared();
+};
+
+static QSslCertificate serverCertificate()
+{
+    const QList<QSslCertificate> certificates =
+        QSslCertificate::fromPath(QFINDTESTDATA("certs/server.crt"));
+    return certificates.value(0);
+}
+
+class SessionServer : public QTcpServer
+{
+public:
+    SessionServer(QSslSessionCache *cache, bool tickets)
+        : cache(cache), tickets(tickets)
+    {
+    }
+
+    QList<QSslSocket *> sockets;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        QSslSocket *socket = new QSslSocket(this);
+        QSslConfiguration configuration = socket->sslConfiguration();
+        QFile keyFile(QFINDTESTDATA("certs/server.key"));
+        QVERIFY(keyFile.open(QIODevice::ReadOnly));
+        configuration.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa));
+        const QSslCertificate certificate = serverCertificate();
+        QVERIFY(!certificate.isNull());
+        configuration.setLocalCertificate(certificate);
+        configuration.setSslOption(QSsl::SslOptionDisableSessionTickets, !tickets);
+        configuration.setSessionCache(cache);
+        socket->setSslConfiguration(configuration);
+        QVERIFY(socket->setSocketDescriptor(socketDescriptor));
+        socket->startServerEncryption();
+        sockets << socket;
+    }
+
+private:
+    QSslSessionCache *cache;
+    bool tickets;
+};
+
+void tst_QSslSessionCache::insertAndFind()
+{
+    QSslSessionCache cache;
+    QCOMPARE(cache.maximumSize(), 1024);
+    QCOMPARE(cache.size(), 0);
+    QVERIFY(cache.find("example.com:443").isEmpty());
+
+    cache.insert("example.com:443", "session", 300);
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.find("example.com:443"), QByteArray("session"));
+
+    // sessions without a lifetime are not stored
+    cache.insert("example.org:443", "session", 0);
+    QCOMPARE(cache.size(), 1);
+
+    cache.remove("example.com:443");
+    QCOMPARE(cache.size(), 0);
+
+    cache.insert("example.com:443", "session", 300);
+    cache.clear();
+    QVERIFY(cache.find("example.com:443").isEmpty());
+
+    // direct lookups are not counted, only those made by sockets
+    QCOMPARE(cache.hitCount(), qint64(0));
+    QCOMPARE(cache.missCount(), qint64(0));
+}
+
+void tst_QSslSessionCache::leastRecentlyUsedEviction()
+{
+    QSslSessionCache cache(2);
+    cache.insert("a", "1", 300);
+    cache.insert("b", "2", 300);
+    QCOMPARE(cache.find("a"), QByteArray("1"));
+
+    cache.insert("c", "3", 300);
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.find("a"), QByteArray("1"));
+    QVERIFY(cache.find("b").isEmpty());
+    QCOMPARE(cache.find("c"), QByteArray("3"));
+
+    cache.setMaximumSize(1);
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.find("c"), QByteArray("3"));
+}
+
+void tst_QSslSessionCache::saveAndLoad()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("sessions"));
+
+    QSslSessionCache cache;
+    cache.insert("example.com:443", "first", 300);
+    cache.insert("example.org:443", "second", 300);
+    QVERIFY(cache.save(fileName));
+#ifdef Q_OS_UNIX
+    QCOMPARE(QFile::permissions(fileName) & (QFile::ReadOther | QFile::ReadGroup),
+             QFile::Permissions());
+#endif
+
+    QSslSessionCache restored;
+    QVERIFY(restored.load(fileName));
+    QCOMPARE(restored.size(), 2);
+    QCOMPARE(restored.find("example.com:443"), QByteArray("first"));
+    QCOMPARE(restored.find("example.org:443"), QByteArray("second"));
+
+    QFile garbage(fileName);
+    QVERIFY(garbage.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    garbage.write("not a session cache");
+    garbage.close();
+    QVERIFY(!restored.load(fileName));
+    QVERIFY(!restored.load(dir.filePath(QStringLiteral("missing"))));
+}
+
+void tst_QSslSessionCache::resumeSession_data()
+{
+    QTest::addColumn<bool>("tickets");
+
+    QTest::newRow("session-tickets") << true;
+    QTest::newRow("server-cache") << false;
+}
+
+void tst_QSslSessionCache::resumeSession()
+{
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No SSL support");
+
+    QFETCH(bool, tickets);
+
+    QSslSessionCache serverCache;
+    QSslSessionCache clientCache;
+    SessionServer server(&serverCache, tickets);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    for (int i = 0; i < 2; ++i) {
+        QSslSocket client;
+        QSslConfiguration configuration = client.sslConfiguration();
+        configuration.setCaCertificates(QList<QSslCertificate>() << serverCertificate());
+        configuration.setSessionCache(&clientCache);
+        client.setSslConfiguration(configuration);
+        client.connectToHostEncrypted(QStringLiteral("127.0.0.1"), server.serverPort(),
+                                      QStringLiteral("sessioncache.test"));
+        QTRY_VERIFY(client.isEncrypted());
+        // TLS 1.3 servers send their session ticket after the handshake
+        QTRY_COMPARE(clientCache.size(), 1);
+        QCOMPARE(QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()), i == 1);
+        client.disconnectFromHost();
+    }
+
+    QCOMPARE(clientCache.missCount(), qint64(1));
+    QCOMPARE(clientCache.hitCount(), qint64(1));
+    if (!tickets)
+        QVERIFY(serverCache.size() > 0);
+}
+
+void tst_QSslSessionCache::unverifiedSessionsNotShared_data()
+{
+    QTest::addColumn<bool>("verifyNone");
+
+    QTest::newRow("verify-none") << true;
+    QTest::newRow("ignored-errors") << false;
+}
+
+void tst_QSslSessionCache::unverifiedSessionsNotShared()
+{
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No SSL support");
+
+    QFETCH(bool, verifyNone);
+
+    QSslSessionCache serverCache;
+    QSslSessionCache clientCache;
+    SessionServer server(&serverCache, true);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    // A session that was not verified must not let a verifying socket
+    // skip the verification:
+    {
+        QSslSocket client;
+        QSslConfiguration configuration = client.sslConfiguration();
+        if (verifyNone)
+            configuration.setPeerVerifyMode(QSslSocket::VerifyNone);
+        configuration.setSessionCache(&clientCache);
+        client.setSslConfiguration(configuration);
+        connect(&client, QOverload<const QList<QSslError> &>::of(&QSslSocket::sslErrors),
+                &client, QOverload<>::of(&QSslSocket::ignoreSslErrors));
+        client.connectToHostEncrypted(QStringLiteral("127.0.0.1"), server.serverPort(),
+                                      QStringLiteral("sessioncache.test"));
+        QTRY_VERIFY(client.isEncrypted());
+        QTest::qWait(100);
+        client.disconnectFromHost();
+    }
+    QCOMPARE(clientCache.size(), 0);
+
+    // A verified session is not offered to a socket trusting other CAs:
+    {
+        QSslSocket client;
+        QSslConfiguration configuration = client.sslConfiguration();
+        configuration.setCaCertificates(QList<QSslCertificate>() << serverCertificate());
+        configuration.setSessionCache(&clientCache);
+        client.setSslConfiguration(configuration);
+        client.connectToHostEncrypted(QStringLiteral("127.0.0.1"), server.serverPort(),
+                                      QStringLiteral("sessioncache.test"));
+        QTRY_VERIFY(client.isEncrypted());
+        QTRY_COMPARE(clientCache.size(), 1);
+        client.disconnectFromHost();
+    }
+    {
+        QSslSocket client;
+        QSslConfiguration configuration = client.sslConfiguration();
+        configuration.setPeerVerifyMode(QSslSocket::VerifyNone);
+        configuration.setSessionCache(&clientCache);
+        client.setSslConfiguration(configuration);
+        client.connectToHostEncrypted(QStringLiteral("127.0.0.1"), server.serverPort(),
+                                      QStringLiteral("sessioncache.test"));
+        QTRY_VERIFY(client.isEncrypted());
+        QVERIFY(!QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()));
+        client.disconnectFromHost();
+    }
+    QCOMPARE(clientCache.hitCount(), qint64(0));
+}
+
+QTEST_MAIN(tst_QSslSessionCache)
+#include "tst_qsslsessioncache.moc"
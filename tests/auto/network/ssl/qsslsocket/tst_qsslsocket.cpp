@@ -195,6 +195,7 @@ private slots:
     void wildcard();
     void setEmptyKey();
     void spontaneousWrite();
+    void writeFromFile();
     void setReadBufferSize();
     void setReadBufferSize_task_250027();
     void waitForMinusOne();
@@ -1894,6 +1895,69 @@ void tst_QSslSocket::spontaneousWrite()
     QCOMPARE(receiver->readAll(), data);
 }
 
+void tst_QSslSocket::writeFromFile()
+{
+#ifdef Q_OS_WINRT
+    QSKIP("Server-side encryption is not implemented on WinRT.");
+#endif
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray contents(1024 * 1024, Qt::Uninitialized);
+    for (int i = 0; i < contents.size(); ++i)
+        contents[i] = char(i * 7 + (i >> 10));
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+    QVERIFY(file.flush());
+
+    SslServer server;
+    QSslSocket *receiver = new QSslSocket(this);
+    connect(receiver, SIGNAL(encrypted()), SLOT(exitLoop()));
+
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    receiver->connectToHost("127.0.0.1", server.serverPort());
+    QVERIFY(receiver->waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(0));
+
+    QSslSocket *sender = server.socket;
+    QVERIFY(sender);
+    receiver->ignoreSslErrors();
+    receiver->startClientEncryption();
+    enterLoop(1);
+    QVERIFY(!timeout());
+    QVERIFY(sender->isEncrypted());
+
+    QByteArray expected = "head";
+    QCOMPARE(sender->write("head"), qint64(4));
+    QCOMPARE(sender->writeFromFile(&file, 100, contents.size() - 200),
+             qint64(contents.size() - 200));
+    expected += contents.mid(100, contents.size() - 200);
+    QCOMPARE(sender->write("middle"), qint64(6));
+    expected += "middle";
+    QCOMPARE(sender->writeFromFile(&file, contents.size() - 10, 1000), qint64(10));
+    expected += contents.right(10);
+    QCOMPARE(sender->write("tail"), qint64(4));
+    expected += "tail";
+    QCOMPARE(sender->bytesToWrite(), qint64(expected.size()));
+
+    // the file is encrypted chunk by chunk as the connection drains
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 10000) {
+        QVERIFY(sender->encryptedBytesToWrite() < 256 * 1024);
+        QTest::qWait(1);
+        received += receiver->readAll();
+    }
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(sender->bytesToWrite(), qint64(0));
+
+    delete receiver;
+}
+
 void tst_QSslSocket::setReadBufferSize()
 {
 #ifdef Q_OS_WINRT
@@ -11,6 +11,7 @@ SUBDIRS=\
 qtConfig(ssl) {
     qtConfig(private_tests) {
         SUBDIRS += \
+            qsslsessioncache \
             qsslsocket \
             qsslsocket_onDemandCertificates_member \
             qsslsocket_onDemandCertificates_static \
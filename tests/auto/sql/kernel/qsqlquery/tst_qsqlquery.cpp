@@ -152,6 +152,10 @@ private slots:
     void batchExec();
     void QTBUG_43874_data() { generic_data(); }
     void QTBUG_43874();
+    void preparedQueryCache_data() { generic_data(); }
+    void preparedQueryCache();
+    void fetchColumns_data() { generic_data(); }
+    void fetchColumns();
     void oraArrayBind_data() { generic_data("QOCI"); }
     void oraArrayBind();
     void lastInsertId_data() { generic_data(); }
@@ -164,6 +168,8 @@ private slots:
     void psql_bindWithDoubleColonCastOperator();
     void psql_specialFloatValues_data() { generic_data("QPSQL"); }
     void psql_specialFloatValues();
+    void psql_batchExec_data() { generic_data("QPSQL"); }
+    void psql_batchExec();
     void queryOnInvalidDatabase_data() { generic_data(); }
     void queryOnInvalidDatabase();
     void createQueryOnClosedDatabase_data() { generic_data(); }
@@ -247,6 +253,9 @@ private slots:
     void sqlite_real_data() { generic_data("QSQLITE"); }
     void sqlite_real();
 
+    void sqlite_batchExec_data() { generic_data("QSQLITE"); }
+    void sqlite_batchExec();
+
     void aggregateFunctionTypes_data() { generic_data(); }
     void aggregateFunctionTypes();
 
@@ -2596,6 +2605,234 @@ void tst_QSqlQuery::QTBUG_43874()
     QCOMPARE(q.value(0).toInt(), 1);
 }
 
+void tst_QSqlQuery::preparedQueryCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlDriver *driver = db.driver();
+    if (!driver->hasFeature(QSqlDriver::PreparedQueries))
+        QSKIP("Test requires prepared queries");
+
+    const QString tableName = qTableName("qtest_stmtcache", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("create table " + tableName + " (id int, name varchar(20))"));
+    QVERIFY_SQL(q, exec("insert into " + tableName + " values (1, 'one')"));
+    QVERIFY_SQL(q, exec("insert into " + tableName + " values (2, 'two')"));
+
+    const QString select = "select name from " + tableName + " where id = ?";
+    const QString count = "select count(*) from " + tableName + " where id >= ?";
+    const QString other = "select id from " + tableName + " where name = ?";
+
+    QCOMPARE(driver->preparedQueryCacheSize(), 0);
+    driver->setPreparedQueryCacheSize(2);
+    QCOMPARE(driver->preparedQueryCacheSize(), 2);
+    qint64 hits = driver->preparedQueryCacheHits();
+    qint64 misses = driver->preparedQueryCacheMisses();
+
+    const auto selectName = [&](QSqlQuery &query, int id) {
+        query.addBindValue(id);
+        if (!query.exec() || !query.next())
+            return QString();
+        return query.value(0).toString();
+    };
+
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(selectName(q1, 1), QString("one"));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+
+        // Preparing the same text again reuses the statement, without
+        // the previous bindings.
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(driver->preparedQueryCacheHits(), ++hits);
+        QCOMPARE(q1.boundValues().size(), 0);
+        QCOMPARE(selectName(q1, 2), QString("two"));
+
+        // Preparing another text keeps the statement in the cache ...
+        QVERIFY_SQL(q1, prepare(count));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+        q1.addBindValue(1);
+        QVERIFY_SQL(q1, exec());
+        QVERIFY(q1.next());
+        QCOMPARE(q1.value(0).toInt(), 2);
+
+        // ... for other queries.
+        QSqlQuery q2(db);
+        QVERIFY_SQL(q2, prepare(select));
+        QCOMPARE(driver->preparedQueryCacheHits(), ++hits);
+        QCOMPARE(selectName(q2, 1), QString("one"));
+
+        // Executing a statement directly keeps it too.
+        QVERIFY_SQL(q2, exec("select count(*) from " + tableName));
+        QVERIFY(q2.next());
+        QCOMPARE(q2.value(0).toInt(), 2);
+    }
+
+    // Destroyed queries leave their statements in the cache, the least
+    // recently used one (the select) is dropped first.
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(other));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+        q1.addBindValue("two");
+        QVERIFY_SQL(q1, exec());
+        QVERIFY(q1.next());
+        QCOMPARE(q1.value(0).toInt(), 2);
+    }
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(other));
+        QCOMPARE(driver->preparedQueryCacheHits(), ++hits);
+        QSqlQuery q2(db);
+        QVERIFY_SQL(q2, prepare(count));
+        QCOMPARE(driver->preparedQueryCacheHits(), ++hits);
+        QSqlQuery q3(db);
+        QVERIFY_SQL(q3, prepare(select));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+    }
+
+    // Schema changes clear the cache.
+    QVERIFY_SQL(q, exec("alter table " + tableName + " add column extra int"));
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+        QCOMPARE(selectName(q1, 2), QString("two"));
+    }
+
+    // So does closing the connection.
+    q.clear();
+    db.close();
+    QVERIFY_SQL(db, open());
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(driver->preparedQueryCacheMisses(), ++misses);
+        QCOMPARE(selectName(q1, 1), QString("one"));
+    }
+
+    driver->clearPreparedQueryCache();
+    driver->setPreparedQueryCacheSize(0);
+    {
+        QSqlQuery q1(db);
+        QVERIFY_SQL(q1, prepare(select));
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(selectName(q1, 1), QString("one"));
+    }
+    QCOMPARE(driver->preparedQueryCacheHits(), hits);
+    QCOMPARE(driver->preparedQueryCacheMisses(), misses);
+
+    // Removing a connection that is still open releases the cached
+    // statements before the connection itself.
+    const QString cloneName = dbName + QLatin1String("_stmtcache");
+    {
+        QSqlDatabase clone = QSqlDatabase::cloneDatabase(db, cloneName);
+        QVERIFY_SQL(clone, open());
+        clone.driver()->setPreparedQueryCacheSize(2);
+        QSqlQuery q1(clone);
+        QVERIFY_SQL(q1, prepare(select));
+        QCOMPARE(selectName(q1, 2), QString("two"));
+    }
+    QSqlDatabase::removeDatabase(cloneName);
+}
+
+void tst_QSqlQuery::fetchColumns()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName = qTableName("qtest_columns", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("create table " + tableName + " (id int, num double precision, "
+                        "txt varchar(20), bin " + tst_Databases::blobTypeName(db) + ")"));
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " values (?, ?, ?, ?)"));
+    const int rowCount = 10;
+    for (int i = 0; i < rowCount; ++i) {
+        q.addBindValue(i);
+        q.addBindValue(i % 3 ? QVariant(i / 2.0) : QVariant(QVariant::Double));
+        q.addBindValue(QString::number(i));
+        q.addBindValue(QByteArray(i + 1, char(i)));
+        QVERIFY_SQL(q, exec());
+    }
+
+    // Forward only SQLite queries, and all PostgreSQL queries, are read
+    // without QVariants; the others through value().
+    for (bool forwardOnly : {true, false}) {
+        q.setForwardOnly(forwardOnly);
+        QVERIFY_SQL(q, exec("select id, num, txt, bin, id from " + tableName + " order by id"));
+
+        // The last buffer has no field and only receives NULL values.
+        QVector<QSqlColumnBuffer> columns;
+        columns << QSqlColumnBuffer(QSqlColumnBuffer::Int64)
+                << QSqlColumnBuffer(QSqlColumnBuffer::Double)
+                << QSqlColumnBuffer(QSqlColumnBuffer::String)
+                << QSqlColumnBuffer(QSqlColumnBuffer::ByteArray)
+                << QSqlColumnBuffer(QSqlColumnBuffer::String)
+                << QSqlColumnBuffer(QSqlColumnBuffer::Int64);
+
+        const auto verifyRows = [&](int firstRow, int rows) {
+            for (const QSqlColumnBuffer &column : qAsConst(columns))
+                QCOMPARE(column.size(), rows);
+            int nulls = 0;
+            for (int i = 0; i < rows; ++i) {
+                const int row = firstRow + i;
+                QCOMPARE(columns.at(0).int64Data()[i], qint64(row));
+                QVERIFY(!columns.at(0).isNull(i));
+                QCOMPARE(columns.at(1).isNull(i), row % 3 == 0);
+                if (row % 3)
+                    QCOMPARE(columns.at(1).doubleData()[i], row / 2.0);
+                else
+                    ++nulls;
+                QCOMPARE(columns.at(2).stringData()[i], QString::number(row));
+                QCOMPARE(columns.at(3).byteArrayData()[i], QByteArray(row + 1, char(row)));
+                QCOMPARE(columns.at(4).stringData()[i], QString::number(row));
+                QVERIFY(columns.at(5).isNull(i));
+            }
+            QCOMPARE(columns.at(0).nullCount(), 0);
+            QCOMPARE(columns.at(1).nullCount(), nulls);
+            QCOMPARE(columns.at(5).nullCount(), rows);
+        };
+
+        // A full block leaves the query on its last record ...
+        QCOMPARE(q.fetchColumns(columns, 4), 4);
+        verifyRows(0, 4);
+        QCOMPARE(q.at(), 3);
+        QCOMPARE(q.value(0).toInt(), 3);
+        QCOMPARE(q.value(2).toString(), QString("3"));
+
+        // ... from where row-wise access continues, and the other way around.
+        QVERIFY_SQL(q, next());
+        QCOMPARE(q.value(0).toInt(), 4);
+        QCOMPARE(q.fetchColumns(columns, 4), 4);
+        verifyRows(5, 4);
+        QCOMPARE(q.at(), 8);
+        QCOMPARE(q.value(0).toInt(), 8);
+
+        // A partial block means the end of the result was reached.
+        QCOMPARE(q.fetchColumns(columns, 4), 1);
+        verifyRows(9, 1);
+        QVERIFY(!q.isValid());
+        QCOMPARE(q.fetchColumns(columns, 4), 0);
+        verifyRows(0, 0);
+        QVERIFY(!q.next());
+
+        QVERIFY_SQL(q, exec("select id from " + tableName + " where id < 0"));
+        QCOMPARE(q.fetchColumns(columns, 4), 0);
+        verifyRows(0, 0);
+
+        QVERIFY_SQL(q, exec("update " + tableName + " set id = id"));
+        QCOMPARE(q.fetchColumns(columns, 4), 0);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 void tst_QSqlQuery::oraArrayBind()
 {
     QFETCH( QString, dbName );
@@ -2863,6 +3100,67 @@ void tst_QSqlQuery::psql_specialFloatValues()
     QVERIFY_SQL( query, exec("drop table " + tableName) );
 }
 
+void tst_QSqlQuery::psql_batchExec()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    if (!db.driver()->hasFeature(QSqlDriver::PreparedQueries))
+        QSKIP("Test requires prepared queries");
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_batch_psql", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec("create table " + tableName + " (id int primary key, name varchar(200))"));
+
+    // Enough data for several round trips.
+    const int rowCount = 20000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < rowCount; ++i) {
+        ids << i;
+        names << QString(100, QLatin1Char('a' + i % 26));
+    }
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), rowCount);
+
+    QVERIFY_SQL(q, exec("select count(*), sum(id) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+    QCOMPARE(q.value(1).toLongLong(), qlonglong(rowCount) * (rowCount - 1) / 2);
+
+    // A failing row rolls back the whole batch ...
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(QVariantList{ rowCount, rowCount + 1, 0, rowCount + 2 });
+    q.addBindValue(QVariantList{ "x", "y", "duplicate", "z" });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().isValid());
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+
+    // ... and a transaction that is already active is left to the caller.
+    QVERIFY_SQL(db, transaction());
+    QVERIFY_SQL(q, prepare("delete from " + tableName + " where id = ?"));
+    q.addBindValue(QVariantList{ 0, 1, 2 });
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 3);
+    QVERIFY_SQL(db, rollback());
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+
+    // All value lists must have the same size.
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(QVariantList{ rowCount, rowCount + 1 });
+    q.addBindValue(QVariantList{ "x" });
+    QVERIFY(!q.execBatch());
+}
+
 /* For task 157397: Using QSqlQuery with an invalid QSqlDatabase
    does not set the last error of the query.
    This test function will output some warnings, that's ok.
@@ -4322,6 +4620,87 @@ void tst_QSqlQuery::sqlite_real()
     QCOMPARE(q.value(0).toDouble(), 5.6);
 }
 
+void tst_QSqlQuery::sqlite_batchExec()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_batch_sqlite", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec("create table " + tableName + " (id integer primary key, name text, data blob)"));
+
+    const int rowCount = 1000;
+    QVariantList ids;
+    QVariantList names;
+    QVariantList blobs;
+    for (int i = 0; i < rowCount; ++i) {
+        ids << i;
+        names << (i % 10 ? QVariant(QString::number(i)) : QVariant(QVariant::String));
+        blobs << QByteArray(i % 50, char(i));
+    }
+
+    // Named placeholders, one of them used twice.
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name, data) values (:id, :name, :data)"));
+    q.bindValue(":id", ids);
+    q.bindValue(":name", names);
+    q.bindValue(":data", blobs);
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), rowCount);
+
+    QVERIFY_SQL(q, exec("select id, name, data from " + tableName + " order by id"));
+    for (int i = 0; i < rowCount; ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), i);
+        QCOMPARE(q.value(1).isNull(), names.at(i).isNull());
+        QCOMPARE(q.value(1).toString(), names.at(i).toString());
+        QCOMPARE(q.value(2).toByteArray(), blobs.at(i).toByteArray());
+    }
+    QVERIFY(!q.next());
+
+    QVERIFY_SQL(q, prepare("update " + tableName + " set name = :name where id = :id or id = :id + 1"));
+    q.bindValue(":id", QVariantList{ 0, 10 });
+    q.bindValue(":name", QVariantList{ "zero", "ten" });
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 4);
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName + " where name in ('zero', 'ten')"));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 4);
+
+    // A failing row rolls back the whole batch ...
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(QVariantList{ rowCount, rowCount + 1, 0, rowCount + 2 });
+    q.addBindValue(QVariantList{ "x", "y", "duplicate", "z" });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().isValid());
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+
+    // ... unless a transaction is active, which is left to the caller.
+    QVERIFY_SQL(db, transaction());
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(QVariantList{ rowCount, 0 });
+    q.addBindValue(QVariantList{ "x", "duplicate" });
+    QVERIFY(!q.execBatch());
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount + 1);
+    q.finish();
+    QVERIFY_SQL(db, rollback());
+
+    // All value lists must have the same size.
+    QVERIFY_SQL(q, prepare("insert into " + tableName + " (id, name) values (?, ?)"));
+    q.addBindValue(QVariantList{ rowCount, rowCount + 1 });
+    q.addBindValue(QVariantList{ "x" });
+    QVERIFY(!q.execBatch());
+
+    QVERIFY_SQL(q, exec("select count(*) from " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+}
+
 void tst_QSqlQuery::aggregateFunctionTypes()
 {
     QFETCH(QString, dbName);
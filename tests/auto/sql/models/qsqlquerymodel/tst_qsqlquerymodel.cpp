@@ -70,6 +70,8 @@ private slots:
     void setHeaderData();
     void fetchMore_data() { generic_data(); }
     void fetchMore();
+    void windowedQuery_data() { generic_data(); }
+    void windowedQuery();
 
     //problem specific tests
     void withSortFilterProxyModel_data() { generic_data(); }
@@ -490,6 +492,82 @@ void tst_QSqlQueryModel::fetchMore()
     }
 }
 
+void tst_QSqlQueryModel::windowedQuery()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlDriver::DbmsType dbType = tst_Databases::getDatabaseType(db);
+    if (dbType != QSqlDriver::SQLite && dbType != QSqlDriver::PostgreSQL
+        && dbType != QSqlDriver::MySqlServer)
+        QSKIP("Windowed mode is not supported by this database");
+
+    const QString many = qTableName("many", __FILE__, db);
+    QSqlQueryModel model;
+    QCOMPARE(model.windowSize(), 0);
+    model.setWindowSize(100);
+    QCOMPARE(model.windowSize(), 100);
+
+    QSignalSpy rowsInsertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    model.setQuery("select id, name from " + many + " order by id", db);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    QVERIFY(model.query().isForwardOnly());
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.rowCount(), 100);
+    QVERIFY(model.canFetchMore());
+    QCOMPARE(model.data(model.index(42, 0)).toInt(), 42);
+    QCOMPARE(model.data(model.index(42, 1)).toString(), QString("harry"));
+
+    // Rows become known as the window moves down the result.
+    model.fetchMore();
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(rowsInsertedSpy.value(0).value(1).toInt(), 100);
+    QCOMPARE(rowsInsertedSpy.value(0).value(2).toInt(), model.rowCount() - 1);
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+
+    // Rows outside of the window are read again.
+    for (int row : {2047, 0, 1024, 1000, 1100, 1, 2046})
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), row);
+    QCOMPARE(model.record(1234).value(0).toInt(), 1234);
+    QVERIFY(!model.data(model.index(2048, 0)).isValid());
+
+    model.setQuery("select id from " + many + " where id < 10;", db);
+    QCOMPARE(model.rowCount(), 10);
+    QVERIFY(!model.canFetchMore());
+
+    // The statement keeps its own order and column names.
+    model.setQuery("select id, id from " + many + " order by id desc", db);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    QVERIFY(model.query().isForwardOnly());
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.data(model.index(0, 0)).toInt(), 2047);
+    QCOMPARE(model.data(model.index(0, 1)).toInt(), 2047);
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+    QCOMPARE(model.data(model.index(1500, 0)).toInt(), 547);
+
+    // Statements that limit themselves are kept whole.
+    model.setQuery("select id from " + many + " order by id limit 5", db);
+    QVERIFY(!model.query().isForwardOnly());
+    QCOMPARE(model.rowCount(), 5);
+
+    model.setQuery("select nonexistent from " + many, db);
+    QVERIFY(model.lastError().isValid());
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.columnCount(), 0);
+
+    // Queries that are already executed are kept whole.
+    model.setQuery(QSqlQuery("select id from " + many, db));
+    QVERIFY(!model.query().isForwardOnly());
+
+    model.setWindowSize(0);
+    model.setQuery("select id from " + many, db);
+    QVERIFY(!model.query().isForwardOnly());
+}
+
 // For task 149491: When used with QSortFilterProxyModel, a view and a
 // database that doesn't support the QuerySize feature, blank rows was
 // appended if the query returned more than 256 rows and setQuery()
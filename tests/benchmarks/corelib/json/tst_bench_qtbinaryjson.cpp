@@ -27,8 +27,10 @@
 ****************************************************************************/
 
 #include <QtTest>
+#include <qcborstream.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
 
 class BenchmarkQtBinaryJson: public QObject
 {
@@ -44,10 +46,20 @@ private Q_SLOTS:
 
     void parseNumbers();
     void parseJson();
+    void parseFormatted_data();
+    void parseFormatted();
     void parseJsonToVariant();
+    void parseJsonStreaming();
 
     void toByteArray();
     void fromByteArray();
+    void toCbor();
+    void fromCbor();
+
+    void serialize_data();
+    void serialize();
+    void deserialize_data() { serialize_data(); }
+    void deserialize();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -106,6 +118,43 @@ void BenchmarkQtBinaryJson::parseJson()
     }
 }
 
+void BenchmarkQtBinaryJson::parseFormatted_data()
+{
+    QTest::addColumn<QByteArray>("testJson");
+
+    for (const char *name : {"test.json", "numbers.json"}) {
+        QString testFile = QFINDTESTDATA(name);
+        QVERIFY2(!testFile.isEmpty(), "cannot find test file!");
+        QFile file(testFile);
+        file.open(QFile::ReadOnly);
+        const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+
+        QTest::addRow("%s-compact", name) << doc.toJson(QJsonDocument::Compact);
+        QTest::addRow("%s-indented", name) << doc.toJson(QJsonDocument::Indented);
+    }
+
+    // long strings, mostly ASCII with the occasional escape and non-ASCII character
+    QByteArray strings = "[";
+    for (int i = 0; i < 1000; ++i) {
+        if (i)
+            strings += ',';
+        strings += '"' + QByteArray(200, 'a') + "\\n" + QByteArray(100, 'b') + '"';
+        strings += ",\"" + QByteArray(150, 'c') + "\xc3\xa9" + QByteArray(150, 'd') + '"';
+    }
+    strings += ']';
+    QTest::newRow("long-strings") << strings;
+}
+
+void BenchmarkQtBinaryJson::parseFormatted()
+{
+    QFETCH(QByteArray, testJson);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(testJson);
+        QVERIFY(!doc.isNull());
+    }
+}
+
 void BenchmarkQtBinaryJson::parseJsonToVariant()
 {
     QString testFile = QFINDTESTDATA("test.json");
@@ -120,6 +169,21 @@ void BenchmarkQtBinaryJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtBinaryJson::parseJsonStreaming()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        while (!reader.atEnd())
+            reader.readNext();
+    }
+}
+
 void BenchmarkQtBinaryJson::toByteArray()
 {
     // Example: send information over a datastream to another process
@@ -150,6 +214,111 @@ void BenchmarkQtBinaryJson::fromByteArray()
     }
 }
 
+void BenchmarkQtBinaryJson::toCbor()
+{
+    // Same as toByteArray(), using CBOR instead of the binary JSON format
+    QBENCHMARK {
+        QVariantMap message;
+        message.insert("command", 1);
+        message.insert("key", "some information");
+        message.insert("env", "some environment variables");
+        QByteArray msg;
+        QCborStreamWriter writer(&msg);
+        writer.appendVariant(message);
+    }
+}
+
+void BenchmarkQtBinaryJson::fromCbor()
+{
+    // Same as fromByteArray(), using CBOR instead of the binary JSON format
+    QVariantMap message;
+    message.insert("command", 1);
+    message.insert("key", "some information");
+    message.insert("env", "some environment variables");
+    QByteArray msg;
+    QCborStreamWriter writer(&msg);
+    writer.appendVariant(message);
+
+    QBENCHMARK {
+        QCborStreamReader reader(msg);
+        QVariantMap message = reader.readVariant().toMap();
+    }
+}
+
+static QByteArray encode(const QJsonDocument &doc, const QByteArray &format)
+{
+    if (format == "json")
+        return doc.toJson(QJsonDocument::Compact);
+    if (format == "binary")
+        return doc.toBinaryData();
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    writer.appendJsonValue(doc.object());
+    return data;
+}
+
+void BenchmarkQtBinaryJson::serialize_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QByteArray>("format");
+
+    for (const char *fileName : { "test.json", "numbers.json" }) {
+        for (const char *format : { "json", "binary", "cbor" }) {
+            QTest::addRow("%s:%s", fileName, format)
+                    << QString::fromLatin1(fileName) << QByteArray(format);
+        }
+    }
+}
+
+void BenchmarkQtBinaryJson::serialize()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QByteArray, format);
+
+    QString testFile = QFINDTESTDATA(fileName);
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject())
+        doc = QJsonDocument(QJsonObject{ { QLatin1String("root"), doc.array() } });
+    qDebug("%s: %d bytes", format.constData(), encode(doc, format).size());
+
+    QBENCHMARK {
+        QByteArray data = encode(doc, format);
+    }
+}
+
+void BenchmarkQtBinaryJson::deserialize()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QByteArray, format);
+
+    QString testFile = QFINDTESTDATA(fileName);
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject())
+        doc = QJsonDocument(QJsonObject{ { QLatin1String("root"), doc.array() } });
+    const QByteArray data = encode(doc, format);
+
+    if (format == "json") {
+        QBENCHMARK {
+            QJsonObject object = QJsonDocument::fromJson(data).object();
+        }
+    } else if (format == "binary") {
+        QBENCHMARK {
+            QJsonObject object = QJsonDocument::fromBinaryData(data, QJsonDocument::Validate).object();
+        }
+    } else {
+        QBENCHMARK {
+            QCborStreamReader reader(data);
+            QJsonObject object = reader.readJsonValue().toObject();
+        }
+    }
+}
+
 void BenchmarkQtBinaryJson::jsonObjectInsert()
 {
     QJsonObject object;
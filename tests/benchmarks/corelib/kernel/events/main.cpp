@@ -30,6 +30,11 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#ifdef Q_OS_UNIX
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 class PingPong : public QObject
 {
 public:
@@ -96,6 +101,10 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+#ifdef Q_OS_UNIX
+    void socketNotifier_data();
+    void socketNotifier();
+#endif
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +178,92 @@ void EventsBench::postEvent()
     }
 }
 
+#ifdef Q_OS_UNIX
+class PipePingPong : public QObject
+{
+public:
+    PipePingPong(int readFd, int writeFd)
+        : m_notifier(readFd, QSocketNotifier::Read), m_writeFd(writeFd), m_counter(0)
+    {
+        connect(&m_notifier, &QSocketNotifier::activated, this, &PipePingPong::activated);
+    }
+
+    void start()
+    {
+        m_counter = 100;
+        ping();
+    }
+
+private:
+    void ping()
+    {
+        char c = 0;
+        if (::write(m_writeFd, &c, 1) != 1)
+            QTestEventLoop::instance().exitLoop();
+    }
+
+    void activated(int fd)
+    {
+        char c;
+        if (::read(fd, &c, 1) == 1 && --m_counter > 0)
+            ping();
+        else
+            QTestEventLoop::instance().exitLoop();
+    }
+
+    QSocketNotifier m_notifier;
+    int m_writeFd;
+    int m_counter;
+};
+
+void EventsBench::socketNotifier_data()
+{
+    QTest::addColumn<int>("idleNotifiers");
+    QTest::newRow("0") << 0;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("4000") << 4000;
+}
+
+// Compare the poll(2) and epoll(7) backends by running this once more
+// with QT_EVENT_DISPATCHER_EPOLL=1 set in the environment.
+void EventsBench::socketNotifier()
+{
+    QFETCH(int, idleNotifiers);
+
+    // released on every return path, including the skip
+    struct Descriptors {
+        QVector<int> fds;
+        QVector<QSocketNotifier *> notifiers;
+        ~Descriptors()
+        {
+            qDeleteAll(notifiers);
+            for (int fd : qAsConst(fds))
+                ::close(fd);
+        }
+    } descriptors;
+
+    for (int i = 0; i < idleNotifiers; ++i) {
+        int pipefd[2];
+        if (::pipe(pipefd) == -1)
+            QSKIP("Not enough file descriptors available");
+        descriptors.fds << pipefd[0] << pipefd[1];
+        descriptors.notifiers << new QSocketNotifier(pipefd[0], QSocketNotifier::Read);
+    }
+
+    int pipefd[2];
+    QVERIFY(::pipe(pipefd) == 0);
+    ::fcntl(pipefd[0], F_SETFL, ::fcntl(pipefd[0], F_GETFL) | O_NONBLOCK);
+    descriptors.fds << pipefd[0] << pipefd[1];
+
+    PipePingPong pingPong(pipefd[0], pipefd[1]);
+    QBENCHMARK {
+        pingPong.start();
+        QTestEventLoop::instance().enterLoop(61);
+    }
+}
+#endif
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
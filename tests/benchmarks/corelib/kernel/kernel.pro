@@ -5,6 +5,7 @@ SUBDIRS = \
         qmetatype \
         qobject \
         qvariant \
+        qtimer \
         qcoreapplication
 
 !qtHaveModule(widgets): SUBDIRS -= \
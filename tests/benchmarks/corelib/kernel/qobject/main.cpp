@@ -34,7 +34,8 @@
 
 enum {
     CreationDeletionBenckmarkConstant = 34567,
-    SignalsAndSlotsBenchmarkConstant = 456789
+    SignalsAndSlotsBenchmarkConstant = 456789,
+    CrossThreadSignalsBenchmarkConstant = 20000
 };
 
 class QObjectBenchmark : public QObject
@@ -51,6 +52,8 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void queued_cross_thread_benchmark_data();
+    void queued_cross_thread_benchmark();
 };
 
 struct Functor {
@@ -258,6 +261,51 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+void QObjectBenchmark::queued_cross_thread_benchmark_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<int>("type");
+    for (int producers : {1, 2, 4, 8}) {
+        QTest::addRow("queued, %d producers", producers) << producers << int(Qt::QueuedConnection);
+        QTest::addRow("batched, %d producers", producers) << producers << int(Qt::QueuedBatchedConnection);
+    }
+}
+
+void QObjectBenchmark::queued_cross_thread_benchmark()
+{
+    QFETCH(int, producers);
+    QFETCH(int, type);
+
+    Object sender;
+    QObject receiver;
+    QEventLoop loop;
+    int received = 0;
+    int total = 0;
+    QObject::connect(&sender, &Object::signal0, &receiver, [&]() {
+        if (++received == total)
+            loop.quit();
+    }, Qt::ConnectionType(type));
+
+    QBENCHMARK {
+        received = 0;
+        total = producers * CrossThreadSignalsBenchmarkConstant;
+
+        QVector<QThread *> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.append(QThread::create([&sender]() {
+                for (int j = 0; j < CrossThreadSignalsBenchmarkConstant; ++j)
+                    sender.emitSignal0();
+            }));
+            threads.last()->start();
+        }
+        loop.exec();
+
+        for (QThread *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore>
+#include <qtest.h>
+
+class TimerObject : public QObject
+{
+public:
+    int fired = 0;
+protected:
+    void timerEvent(QTimerEvent *) override { ++fired; }
+};
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void startStop_data();
+    void startStop();
+    void restart_data();
+    void restart();
+    void processEvents_data();
+    void processEvents();
+
+private:
+    void populate(QObject *object, int count, bool equal, QVector<int> *ids = nullptr);
+};
+
+static int timerInterval(int i, bool equal)
+{
+    return equal ? 30 * 1000 : 1000 + (i * 7919) % (60 * 60 * 1000);
+}
+
+// Registers count timers on object, with intervals spread between one
+// second and one hour, or all with the same interval of 30 seconds like
+// per-connection idle timeouts, so that none of them fires during the
+// benchmark
+void tst_QTimer::populate(QObject *object, int count, bool equal, QVector<int> *ids)
+{
+    for (int i = 0; i < count; ++i) {
+        const int id = object->startTimer(timerInterval(i, equal), Qt::PreciseTimer);
+        if (ids)
+            ids->append(id);
+    }
+}
+
+static void addTimerCountRows()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("equal");
+    QTest::newRow("0") << 0 << false;
+    QTest::newRow("100") << 100 << false;
+    QTest::newRow("10000") << 10000 << false;
+    QTest::newRow("100000") << 100000 << false;
+    QTest::newRow("100-equal") << 100 << true;
+    QTest::newRow("10000-equal") << 10000 << true;
+    QTest::newRow("100000-equal") << 100000 << true;
+}
+
+void tst_QTimer::startStop_data()
+{
+    addTimerCountRows();
+}
+
+void tst_QTimer::startStop()
+{
+    QFETCH(int, count);
+    QFETCH(bool, equal);
+
+    TimerObject object;
+    populate(&object, count, equal);
+
+    QBENCHMARK {
+        const int id = object.startTimer(5000);
+        object.killTimer(id);
+    }
+}
+
+void tst_QTimer::restart_data()
+{
+    addTimerCountRows();
+}
+
+void tst_QTimer::restart()
+{
+    QFETCH(int, count);
+    QFETCH(bool, equal);
+
+    TimerObject object;
+    QVector<int> ids;
+    populate(&object, qMax(count, 1), equal, &ids);
+
+    // same as QTimer::start() on an active timer: kill and register again
+    int i = 0;
+    QBENCHMARK {
+        const int index = i++ % ids.size();
+        object.killTimer(ids.at(index));
+        ids[index] = object.startTimer(timerInterval(i, equal), Qt::PreciseTimer);
+    }
+}
+
+void tst_QTimer::processEvents_data()
+{
+    addTimerCountRows();
+}
+
+void tst_QTimer::processEvents()
+{
+    QFETCH(int, count);
+    QFETCH(bool, equal);
+
+    TimerObject object;
+    populate(&object, count, equal);
+
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(object.fired, 0);
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "main.moc"
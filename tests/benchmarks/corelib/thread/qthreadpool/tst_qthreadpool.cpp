@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void fanOut_data();
+    void fanOut();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +77,55 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+class FanOutRunnable : public QRunnable
+{
+public:
+    FanOutRunnable(QThreadPool *pool, int depth)
+        : m_pool(pool), m_depth(depth)
+    {}
+
+    void run() override {
+        if (m_depth > 0) {
+            m_pool->start(new FanOutRunnable(m_pool, m_depth - 1));
+            m_pool->start(new FanOutRunnable(m_pool, m_depth - 1));
+        }
+    }
+
+private:
+    QThreadPool *m_pool;
+    int m_depth;
+};
+
+void tst_QThreadPool::fanOut_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int threadCount = 1; ; threadCount *= 2) {
+        threadCount = qMin(threadCount, idealThreadCount);
+        const QByteArray threads = QByteArray::number(threadCount) + " threads";
+        QTest::newRow((threads + ", shared queue").constData()) << threadCount << false;
+        QTest::newRow((threads + ", work stealing").constData()) << threadCount << true;
+        if (threadCount == idealThreadCount)
+            break;
+    }
+}
+
+// Each runnable starts two more from within the pool, 2^16 - 1 in total.
+void tst_QThreadPool::fanOut()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+    QBENCHMARK {
+        threadPool.start(new FanOutRunnable(&threadPool, 15));
+        threadPool.waitForDone();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
@@ -26,9 +26,19 @@
 **
 ****************************************************************************/
 #include <QString>
+#include <QFlatHash>
+#include <QFlatMap>
 
 #include <qtest.h>
 
+enum Container {
+    Hash,
+    Map,
+    FlatHash,
+    FlatMap
+};
+Q_DECLARE_METATYPE(Container)
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
@@ -52,30 +62,38 @@ void testInsert(int size)
 
 void tst_associative_containers::insert_data()
 {
-    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<Container>("container");
     QTest::addColumn<int>("size");
 
     for (int size = 10; size < 20000; size += 100) {
 
         const QByteArray sizeString = QByteArray::number(size);
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << Hash << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << Map << size;
+        QTest::newRow(QByteArray("flathash--" + sizeString).constData()) << FlatHash << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMap << size;
     }
 }
 
 void tst_associative_containers::insert()
 {
-    QFETCH(bool, useHash);
+    QFETCH(Container, container);
     QFETCH(int, size);
 
-    QHash<int, int> testHash;
-    QMap<int, int> testMap;
-
-    if (useHash) {
+    switch (container) {
+    case Hash:
         testInsert<QHash<int, int> >(size);
-    } else {
+        break;
+    case Map:
         testInsert<QMap<int, int> >(size);
+        break;
+    case FlatHash:
+        testInsert<QFlatHash<int, int> >(size);
+        break;
+    case FlatMap:
+        testInsert<QFlatMap<int, int> >(size);
+        break;
     }
 }
 
@@ -84,15 +102,17 @@ void tst_associative_containers::lookup_data()
 //    setReportType(LineChartReport);
 //    setChartTitle("Time to call value(), with an increasing number of items in the container");
 
-    QTest::addColumn<bool>("useHash");
+    QTest::addColumn<Container>("container");
     QTest::addColumn<int>("size");
 
     for (int size = 10; size < 20000; size += 100) {
 
         const QByteArray sizeString = QByteArray::number(size);
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << Hash << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << Map << size;
+        QTest::newRow(QByteArray("flathash--" + sizeString).constData()) << FlatHash << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMap << size;
     }
 }
 
@@ -104,7 +124,7 @@ void testLookup(int size)
     for (int i = 0; i < size; ++i)
         container.insert(i, i);
 
-    int val;
+    volatile int val;
 
     QBENCHMARK {
         for (int i = 0; i < size; ++i)
@@ -115,13 +135,22 @@ void testLookup(int size)
 
 void tst_associative_containers::lookup()
 {
-    QFETCH(bool, useHash);
+    QFETCH(Container, container);
     QFETCH(int, size);
 
-    if (useHash) {
+    switch (container) {
+    case Hash:
         testLookup<QHash<int, int> >(size);
-    } else {
+        break;
+    case Map:
         testLookup<QMap<int, int> >(size);
+        break;
+    case FlatHash:
+        testLookup<QFlatHash<int, int> >(size);
+        break;
+    case FlatMap:
+        testLookup<QFlatMap<int, int> >(size);
+        break;
     }
 }
 
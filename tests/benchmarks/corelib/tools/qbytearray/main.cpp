@@ -30,6 +30,8 @@
 #include <QIODevice>
 #include <QFile>
 #include <QString>
+#include <QByteArrayMatcher>
+#include <QMultiStringMatcher>
 
 #include <qtest.h>
 
@@ -48,6 +50,20 @@ private slots:
     void latin1Uppercasing_xlate_checked();
     void latin1Uppercasing_category();
     void latin1Uppercasing_bitcheck();
+
+    void multiPatternSearch_indexOf_data() { multiPatternSearch_data(); }
+    void multiPatternSearch_indexOf();
+    void multiPatternSearch_matcher_data() { multiPatternSearch_data(); }
+    void multiPatternSearch_matcher();
+
+    void indexOf_data() { needleSearch_data(); }
+    void indexOf();
+    void indexOf_matcher_data() { needleSearch_data(); }
+    void indexOf_matcher();
+
+private:
+    void multiPatternSearch_data();
+    void needleSearch_data();
 };
 
 void tst_qbytearray::initTestCase()
@@ -258,6 +274,106 @@ void tst_qbytearray::latin1Uppercasing_bitcheck()
     }
 }
 
+// words that hardly ever occur in the source code, like the keywords of a
+// log filter that most lines don't match
+static QList<QByteArray> makeKeywords(int count)
+{
+    QList<QByteArray> keywords;
+    uint state = 42;
+    for (int i = 0; i < count; ++i) {
+        QByteArray word;
+        state = state * 1103515245 + 12345;
+        const int len = 6 + (state >> 16) % 7;
+        for (int j = 0; j < len; ++j) {
+            state = state * 1103515245 + 12345;
+            word += char('a' + (state >> 16) % 26);
+        }
+        keywords << word;
+    }
+    return keywords;
+}
+
+void tst_qbytearray::multiPatternSearch_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::newRow("1") << 1;
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("500") << 500;
+}
+
+void tst_qbytearray::multiPatternSearch_indexOf()
+{
+    QFETCH(int, patternCount);
+    const QList<QByteArray> keywords = makeKeywords(patternCount);
+    const QByteArray haystack = sourcecode.repeated(qMax(1, (1 << 20) / sourcecode.size()));
+
+    int found = 0;
+    QBENCHMARK {
+        for (const QByteArray &keyword : keywords) {
+            if (haystack.indexOf(keyword) >= 0)
+                ++found;
+        }
+    }
+    QCOMPARE(found, 0);
+}
+
+void tst_qbytearray::multiPatternSearch_matcher()
+{
+    QFETCH(int, patternCount);
+    const QMultiStringMatcher matcher(makeKeywords(patternCount));
+    const QByteArray haystack = sourcecode.repeated(qMax(1, (1 << 20) / sourcecode.size()));
+
+    int found = 0;
+    QBENCHMARK {
+        if (matcher.indexIn(haystack) >= 0)
+            ++found;
+    }
+    QCOMPARE(found, 0);
+}
+
+// A needle that only occurs at the very end of a 4 MB haystack, so that
+// the whole haystack is scanned.
+void tst_qbytearray::needleSearch_data()
+{
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<QByteArray>("needle");
+
+    const QList<QByteArray> words = makeKeywords(16);
+    const QByteArray text = sourcecode.repeated(qMax(1, (4 << 20) / sourcecode.size()));
+    for (int len : {2, 4, 8, 16, 32, 64, 256}) {
+        QByteArray needle;
+        for (int i = 0; needle.size() < len; ++i)
+            needle += words.at(i % words.size());
+        needle.truncate(len);
+        QTest::addRow("%d", len) << (text + needle) << needle;
+    }
+}
+
+void tst_qbytearray::indexOf()
+{
+    QFETCH(QByteArray, haystack);
+    QFETCH(QByteArray, needle);
+
+    int result = -1;
+    QBENCHMARK {
+        result = haystack.indexOf(needle);
+    }
+    QCOMPARE(result, haystack.size() - needle.size());
+}
+
+void tst_qbytearray::indexOf_matcher()
+{
+    QFETCH(QByteArray, haystack);
+    QFETCH(QByteArray, needle);
+    const QByteArrayMatcher matcher(needle);
+
+    int result = -1;
+    QBENCHMARK {
+        result = matcher.indexIn(haystack);
+    }
+    QCOMPARE(result, haystack.size() - needle.size());
+}
 
 QTEST_MAIN(tst_qbytearray)
 
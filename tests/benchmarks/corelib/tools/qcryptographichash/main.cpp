@@ -50,9 +50,13 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashMany_data();
+    void hashMany();
+    void hashManyLoop_data() { hashMany_data(); }
+    void hashManyLoop();
 };
 
-const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
+const int MaxCryptoAlgorithm = QCryptographicHash::Crc32c;
 const int MaxBlockSize = 65536;
 
 const char *algoname(int i)
@@ -88,6 +92,8 @@ const char *algoname(int i)
         return "keccak_384-";
     case QCryptographicHash::Keccak_512:
         return "keccak_512-";
+    case QCryptographicHash::Crc32c:
+        return "crc32c-";
     }
     Q_UNREACHABLE();
     return 0;
@@ -167,6 +173,50 @@ void tst_bench_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_bench_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<QByteArrayList>("messages");
+
+    // 64 messages of each size, as e.g. when hashing the chunks of a file
+    static const int datasizes[] = { 64, 1024, 16384 };
+    static const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Sha1, QCryptographicHash::Sha224, QCryptographicHash::Sha256,
+        QCryptographicHash::Crc32c
+    };
+    for (int size : datasizes) {
+        QByteArrayList messages;
+        for (int i = 0; i < 64; ++i)
+            messages << QByteArray::fromRawData(blockOfData.constData() + i, size);
+
+        for (QCryptographicHash::Algorithm algo : algorithms)
+            QTest::newRow(algoname(algo) + QByteArray::number(size)) << int(algo) << messages;
+    }
+}
+
+void tst_bench_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QByteArrayList, messages);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QCryptographicHash::hashMany(messages, algo);
+    }
+}
+
+void tst_bench_QCryptographicHash::hashManyLoop()
+{
+    QFETCH(int, algorithm);
+    QFETCH(QByteArrayList, messages);
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        for (const QByteArray &message : messages)
+            QCryptographicHash::hash(message, algo);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_bench_QCryptographicHash)
 
 #include "main.moc"
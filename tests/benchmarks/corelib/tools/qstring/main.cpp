@@ -27,6 +27,7 @@
 ****************************************************************************/
 #include <QStringList>
 #include <QFile>
+#include <QMultiStringMatcher>
 #include <QtTest/QtTest>
 
 class tst_QString: public QObject
@@ -49,8 +50,20 @@ private slots:
     void toCaseFolded_data();
     void toCaseFolded();
 
+    void multiPatternSearch_indexOf_data() { multiPatternSearch_data(); }
+    void multiPatternSearch_indexOf();
+    void multiPatternSearch_matcher_data() { multiPatternSearch_data(); }
+    void multiPatternSearch_matcher();
+
+    void indexOf_data() { needleSearch_data(); }
+    void indexOf();
+    void indexOf_matcher_data() { needleSearch_data(); }
+    void indexOf_matcher();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
+    void multiPatternSearch_data();
+    void needleSearch_data();
     template <typename RX> void section_impl();
 };
 
@@ -188,6 +201,120 @@ void tst_QString::toCaseFolded()
     }
 }
 
+// Pseudo-random lowercase words. The haystack and the patterns use
+// different seeds, so that the patterns (almost) never occur.
+static QStringList makeWords(int count, uint seed)
+{
+    QStringList words;
+    for (int i = 0; i < count; ++i) {
+        QString word;
+        seed = seed * 1103515245 + 12345;
+        const int len = 2 + (seed >> 16) % 11;
+        for (int j = 0; j < len; ++j) {
+            seed = seed * 1103515245 + 12345;
+            word += QLatin1Char('a' + (seed >> 16) % 26);
+        }
+        words << word;
+    }
+    return words;
+}
+
+static QStringList makeKeywords(int count)
+{
+    QStringList keywords;
+    for (const QString &word : makeWords(count * 2, 42)) {
+        if (word.size() >= 6 && keywords.size() < count)
+            keywords << word;
+    }
+    return keywords;
+}
+
+void tst_QString::multiPatternSearch_data()
+{
+    QTest::addColumn<int>("patternCount");
+    QTest::newRow("1") << 1;
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("500") << 500;
+}
+
+void tst_QString::multiPatternSearch_indexOf()
+{
+    QFETCH(int, patternCount);
+    const QStringList keywords = makeKeywords(patternCount);
+    const QString haystack = makeWords(1 << 17, 7).join(QLatin1Char(' '));
+
+    int found = 0;
+    QBENCHMARK {
+        for (const QString &keyword : keywords) {
+            if (haystack.indexOf(keyword) >= 0)
+                ++found;
+        }
+    }
+    QCOMPARE(found, 0);
+}
+
+void tst_QString::multiPatternSearch_matcher()
+{
+    QFETCH(int, patternCount);
+    const QMultiStringMatcher matcher(makeKeywords(patternCount));
+    const QString haystack = makeWords(1 << 17, 7).join(QLatin1Char(' '));
+
+    int found = 0;
+    QBENCHMARK {
+        if (matcher.indexIn(haystack) >= 0)
+            ++found;
+    }
+    QCOMPARE(found, 0);
+}
+
+// A needle that only occurs at the very end of a 2 MB haystack, so that
+// the whole haystack is scanned. It starts and ends with uppercase Latin-1
+// letters that the haystack does not contain otherwise, to exercise
+// case-insensitive matching.
+void tst_QString::needleSearch_data()
+{
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QString text = makeWords(1 << 17, 7).join(QLatin1Char(' '));
+    const QString words = makeKeywords(16).join(QString());
+    for (int len : {2, 4, 8, 16, 32, 64, 256}) {
+        const QString needle = QChar(0xc9) + words.left(len - 2) + QChar(0xd8);
+        const QString haystack = text + needle;
+        QTest::addRow("%d-cs", len) << haystack << needle << Qt::CaseSensitive;
+        QTest::addRow("%d-ci", len) << haystack << needle.toLower() << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QString::indexOf()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    int result = -1;
+    QBENCHMARK {
+        result = haystack.indexOf(needle, 0, cs);
+    }
+    QCOMPARE(result, haystack.size() - needle.size());
+}
+
+void tst_QString::indexOf_matcher()
+{
+    QFETCH(QString, haystack);
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+    const QStringMatcher matcher(needle, cs);
+
+    int result = -1;
+    QBENCHMARK {
+        result = matcher.indexIn(haystack);
+    }
+    QCOMPARE(result, haystack.size() - needle.size());
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
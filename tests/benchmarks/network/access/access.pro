@@ -1,6 +1,8 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         qfile_vs_qnetworkaccessmanager \
+        hpack \
+        qhttpconnectionpool \
         qnetworkreply \
         qnetworkreply_from_cache \
         qnetworkdiskcache
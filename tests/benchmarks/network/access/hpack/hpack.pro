@@ -0,0 +1,9 @@
+TEMPLATE = app
+TARGET = tst_bench_hpack
+
+QT -= gui
+QT += core-private network-private testlib
+
+CONFIG += release c++11
+
+SOURCES += tst_bench_hpack.cpp
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+// This file contains benchmarks for the HPACK header compression used by
+// the HTTP/2 protocol handler.
+
+#include <QtTest/QtTest>
+
+#include <QtNetwork/private/bitstreams_p.h>
+#include <QtNetwork/private/hpack_p.h>
+
+#include <vector>
+
+QT_USE_NAMESPACE
+
+using namespace HPack;
+
+class tst_bench_HPack : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void encodeRequest_data();
+    void encodeRequest();
+    void decodeRequest_data();
+    void decodeRequest();
+    void decodeRequestViews_data();
+    void decodeRequestViews();
+    void huffmanDecode();
+
+private:
+    HttpHeader request;
+};
+
+void tst_bench_HPack::initTestCase()
+{
+    request = {{":method", "GET"},
+               {":scheme", "https"},
+               {":path", "/api/v1/items?limit=100&offset=200&sort=modified"},
+               {":authority", "www.example.com"},
+               {"accept", "application/json, text/plain, */*"},
+               {"accept-encoding", "gzip, deflate"},
+               {"accept-language", "en-US,en;q=0.8"},
+               {"user-agent", "Mozilla/5.0 (X11; Linux x86_64) QtNetwork/5.11"},
+               {"cookie", "session=8f14e45fceea167a5a36dedd4bea2543; theme=dark"},
+               {"x-request-id", "7c9e6679-7425-40de-944b-e07fc1f90ae7"}};
+}
+
+void tst_bench_HPack::encodeRequest_data()
+{
+    QTest::addColumn<bool>("compression");
+    QTest::newRow("plain") << false;
+    QTest::newRow("huffman") << true;
+}
+
+void tst_bench_HPack::encodeRequest()
+{
+    QFETCH(bool, compression);
+
+    // A new encoder per request: nothing comes from the dynamic table.
+    std::vector<uchar> buffer;
+    QBENCHMARK {
+        Encoder encoder(4096, compression);
+        buffer.clear();
+        BitOStream outputStream(buffer);
+        encoder.encodeRequest(outputStream, request);
+    }
+}
+
+void tst_bench_HPack::decodeRequest_data()
+{
+    encodeRequest_data();
+}
+
+void tst_bench_HPack::decodeRequest()
+{
+    QFETCH(bool, compression);
+
+    Encoder encoder(4096, compression);
+    std::vector<uchar> buffer;
+    BitOStream outputStream(buffer);
+    QVERIFY(encoder.encodeRequest(outputStream, request));
+
+    QBENCHMARK {
+        Decoder decoder(4096);
+        BitIStream inputStream(outputStream.begin(), outputStream.end());
+        decoder.decodeHeaderFields(inputStream);
+    }
+}
+
+void tst_bench_HPack::decodeRequestViews_data()
+{
+    encodeRequest_data();
+}
+
+void tst_bench_HPack::decodeRequestViews()
+{
+    QFETCH(bool, compression);
+
+    // Literals without indexing, so that no field has to be
+    // copied into the dynamic table.
+    Encoder encoder(4096, compression);
+    std::vector<uchar> buffer;
+    BitOStream outputStream(buffer);
+    QVERIFY(encoder.encodeHeaderFieldsWithoutIndexing(outputStream, request));
+
+    Decoder decoder(4096);
+    QBENCHMARK {
+        BitIStream inputStream(outputStream.begin(), outputStream.end());
+        decoder.decodeHeaderFieldViews(inputStream);
+    }
+}
+
+void tst_bench_HPack::huffmanDecode()
+{
+    QByteArray data;
+    for (int i = 0; i < 64; ++i)
+        data += request[i % request.size()].value;
+
+    std::vector<uchar> buffer;
+    BitOStream outputStream(buffer);
+    outputStream.write(data, true);
+
+    QByteArray decoded;
+    QBENCHMARK {
+        BitIStream inputStream(outputStream.begin(), outputStream.end());
+        inputStream.read(&decoded);
+    }
+    QCOMPARE(decoded, data);
+}
+
+QTEST_MAIN(tst_bench_HPack)
+
+#include "tst_bench_hpack.moc"
@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+// This file contains benchmarks for the HTTP/1.1 connection pool of
+// QNetworkAccessManager, see QHttpConnectionPoolPolicy.
+
+#include <QtTest/QtTest>
+#include <QtNetwork/qhttpconnectionpool.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+
+// A keep-alive HTTP/1.1 server on the loopback interface that answers every
+// request with a small body after a fixed delay, imitating a backend service.
+// It runs in its own thread so that it does not compete with the client for
+// the main event loop.
+class LoopbackHttpServer : public QThread
+{
+    Q_OBJECT
+public:
+    explicit LoopbackHttpServer(int responseDelay)
+        : delay(responseDelay)
+    {
+        start();
+        ready.acquire();
+    }
+
+    ~LoopbackHttpServer()
+    {
+        quit();
+        wait();
+    }
+
+    quint16 serverPort() const { return port; }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        port = server.serverPort();
+        connect(&server, &QTcpServer::newConnection, [&server, this]() {
+            while (QTcpSocket *socket = server.nextPendingConnection())
+                serve(socket);
+        });
+        ready.release();
+        exec();
+    }
+
+private:
+    void serve(QTcpSocket *socket)
+    {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [socket, this]() {
+            QByteArray &buffer = pending[socket];
+            buffer += socket->readAll();
+            int end;
+            while ((end = buffer.indexOf("\r\n\r\n")) >= 0) {
+                buffer.remove(0, end + 4);
+                QPointer<QTcpSocket> target(socket);
+                QTimer::singleShot(delay, Qt::PreciseTimer, socket, [target]() {
+                    if (target)
+                        target->write("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello");
+                });
+            }
+        });
+        connect(socket, &QObject::destroyed, [socket, this]() { pending.remove(socket); });
+    }
+
+    QSemaphore ready;
+    QHash<QTcpSocket *, QByteArray> pending;
+    int delay;
+    quint16 port = 0;
+};
+
+class tst_qhttpconnectionpool : public QObject
+{
+    Q_OBJECT
+private slots:
+    void concurrentRequests_data();
+    void concurrentRequests();
+};
+
+void tst_qhttpconnectionpool::concurrentRequests_data()
+{
+    QTest::addColumn<int>("maximumConnections");
+    QTest::addColumn<int>("prewarmedConnections");
+    QTest::addColumn<int>("requestCount");
+
+    const int requestCount = 1000;
+    for (int connections : {6, 16, 64}) {
+        QTest::addRow("%d-connections", connections) << connections << 0 << requestCount;
+        QTest::addRow("%d-connections-prewarmed", connections)
+                << connections << connections << requestCount;
+    }
+}
+
+void tst_qhttpconnectionpool::concurrentRequests()
+{
+    QFETCH(int, maximumConnections);
+    QFETCH(int, prewarmedConnections);
+    QFETCH(int, requestCount);
+
+    LoopbackHttpServer server(5);
+    const QString host = QStringLiteral("127.0.0.1");
+    QUrl url;
+    url.setScheme(QStringLiteral("http"));
+    url.setHost(host);
+    url.setPort(server.serverPort());
+
+    QHttpConnectionPoolPolicy policy;
+    policy.setMaximumConnections(maximumConnections);
+    policy.setPrewarmedConnections(prewarmedConnections);
+
+    QNetworkAccessManager manager;
+    manager.setConnectionPoolPolicy(host, server.serverPort(), policy);
+
+    QBENCHMARK {
+        // start with a cold pool in every iteration
+        manager.clearConnectionCache();
+
+        int finished = 0;
+        QEventLoop loop;
+        for (int i = 0; i < requestCount; ++i) {
+            QNetworkReply *reply = manager.get(QNetworkRequest(url));
+            connect(reply, &QNetworkReply::finished, &loop, [&finished, &loop, reply, requestCount]() {
+                QCOMPARE(reply->error(), QNetworkReply::NoError);
+                reply->deleteLater();
+                if (++finished == requestCount)
+                    loop.quit();
+            });
+        }
+        QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+        loop.exec();
+        QCOMPARE(finished, requestCount);
+    }
+
+    const QHttpConnectionPoolStatistics statistics
+            = manager.connectionPoolStatistics(host, server.serverPort());
+    qDebug("connections: %lld, reuse rate: %.3f, peak queue depth: %d, average connect latency: %lld ms",
+           statistics.connectionCount(), statistics.reuseRate(), statistics.peakQueueDepth(),
+           statistics.averageConnectLatency());
+}
+
+QTEST_MAIN(tst_qhttpconnectionpool)
+
+#include "tst_qhttpconnectionpool.moc"
@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qcoreapplication.h>
+#include <qudpsocket.h>
+#include <qnetworkdatagram.h>
+#include <qhostaddress.h>
+
+// small enough for all datagrams of one iteration to fit into the
+// default receive buffer
+static const int DatagramCount = 128;
+static const int DatagramSize = 64;
+
+class tst_QUdpSocket : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void send_data();
+    void send();
+    void receive_data();
+    void receive();
+
+private:
+    void sendAll(bool batched);
+    void receiveAll(bool batched);
+
+    QUdpSocket sender;
+    QUdpSocket receiver;
+    QVector<QNetworkDatagram> datagrams;
+};
+
+void tst_QUdpSocket::initTestCase()
+{
+    QVERIFY2(receiver.bind(QHostAddress::LocalHost), qPrintable(receiver.errorString()));
+    QVERIFY2(sender.bind(QHostAddress::LocalHost), qPrintable(sender.errorString()));
+
+    datagrams.reserve(DatagramCount);
+    for (int i = 0; i < DatagramCount; ++i) {
+        datagrams << QNetworkDatagram(QByteArray(DatagramSize, char('a' + i % 26)),
+                                      QHostAddress::LocalHost, receiver.localPort());
+    }
+}
+
+void tst_QUdpSocket::sendAll(bool batched)
+{
+    if (batched) {
+        int sent = 0;
+        while (sent < DatagramCount) {
+            const int n = sender.writeDatagrams(datagrams.mid(sent));
+            QVERIFY2(n > 0, qPrintable(sender.errorString()));
+            sent += n;
+        }
+    } else {
+        for (const QNetworkDatagram &datagram : qAsConst(datagrams))
+            QCOMPARE(sender.writeDatagram(datagram), qint64(DatagramSize));
+    }
+}
+
+void tst_QUdpSocket::receiveAll(bool batched)
+{
+    int received = 0;
+    while (received < DatagramCount) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), qPrintable(receiver.errorString()));
+        if (batched) {
+            received += receiver.receiveDatagrams(DatagramCount - received).size();
+        } else {
+            QVERIFY(receiver.receiveDatagram().isValid());
+            ++received;
+        }
+    }
+}
+
+void tst_QUdpSocket::send_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("writeDatagram") << false;
+    QTest::newRow("writeDatagrams") << true;
+}
+
+// sends DatagramCount datagrams, receiving them in batches
+void tst_QUdpSocket::send()
+{
+    QFETCH(bool, batched);
+
+    QBENCHMARK {
+        sendAll(batched);
+        receiveAll(true);
+    }
+}
+
+void tst_QUdpSocket::receive_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("receiveDatagram") << false;
+    QTest::newRow("receiveDatagrams") << true;
+}
+
+// receives DatagramCount datagrams, sent in batches
+void tst_QUdpSocket::receive()
+{
+    QFETCH(bool, batched);
+
+    QBENCHMARK {
+        sendAll(true);
+        receiveAll(batched);
+    }
+}
+
+QTEST_MAIN(tst_QUdpSocket)
+
+#include "tst_qudpsocket.moc"
@@ -0,0 +1,9 @@
+TEMPLATE = app
+TARGET = tst_bench_qsslsessioncache
+
+QT -= gui
+QT += network testlib
+
+CONFIG += release
+
+SOURCES += tst_qsslsessioncache.cpp
@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtNetwork/qsslsessioncache.h>
+#include <QtNetwork/qsslconfiguration.h>
+#include <QtNetwork/qsslkey.h>
+#include <QtNetwork/qsslsocket.h>
+#include <QtNetwork/qtcpserver.h>
+
+class HandshakeServer : public QTcpServer
+{
+public:
+    QSslConfiguration configuration;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        QSslSocket *socket = new QSslSocket(this);
+        socket->setSslConfiguration(configuration);
+        if (!socket->setSocketDescriptor(socketDescriptor)) {
+            delete socket;
+            return;
+        }
+        connect(socket, &QSslSocket::disconnected, socket, &QObject::deleteLater);
+        socket->startServerEncryption();
+    }
+};
+
+class tst_QSslSessionCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void handshake_data();
+    void handshake();
+
+private:
+    HandshakeServer server;
+    QList<QSslCertificate> caCertificates;
+};
+
+void tst_QSslSessionCache::initTestCase()
+{
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No SSL support");
+
+    const QString certs = QFINDTESTDATA("../../../../auto/network/ssl/qsslsessioncache/certs");
+    QVERIFY(!certs.isEmpty());
+    QFile keyFile(certs + QLatin1String("/server.key"));
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    server.configuration = QSslConfiguration::defaultConfiguration();
+    server.configuration.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa));
+    const QList<QSslCertificate> certificates =
+        QSslCertificate::fromPath(certs + QLatin1String("/server.crt"));
+    QVERIFY(!certificates.isEmpty());
+    server.configuration.setLocalCertificate(certificates.first());
+    caCertificates = certificates;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+}
+
+void tst_QSslSessionCache::handshake_data()
+{
+    QTest::addColumn<bool>("shareSessions");
+    QTest::addColumn<bool>("tickets");
+
+    QTest::newRow("full") << false << true;
+    QTest::newRow("resumed-ticket") << true << true;
+    QTest::newRow("resumed-server-cache") << true << false;
+}
+
+static bool handshakeOnce(const QSslConfiguration &configuration, quint16 port,
+                          QSslSessionCache *waitForSession = nullptr)
+{
+    QSslSocket client;
+    client.setSslConfiguration(configuration);
+    QEventLoop loop;
+    QObject::connect(&client, &QSslSocket::encrypted, &loop, &QEventLoop::quit);
+    QObject::connect(&client, QOverload<QAbstractSocket::SocketError>::of(&QSslSocket::error),
+                     &loop, &QEventLoop::quit);
+    client.connectToHostEncrypted(QStringLiteral("127.0.0.1"), port,
+                                  QStringLiteral("sessioncache.test"));
+    loop.exec();
+    if (!client.isEncrypted())
+        return false;
+    // TLS 1.3 servers send their session ticket after the handshake
+    if (waitForSession)
+        QTest::qWaitFor([waitForSession]() { return waitForSession->size() > 0; }, 5000);
+    client.disconnectFromHost();
+    return true;
+}
+
+void tst_QSslSessionCache::handshake()
+{
+    QFETCH(bool, shareSessions);
+    QFETCH(bool, tickets);
+
+    QSslSessionCache serverCache;
+    QSslSessionCache clientCache;
+    server.configuration.setSslOption(QSsl::SslOptionDisableSessionTickets, !tickets);
+    server.configuration.setSessionCache(shareSessions ? &serverCache : nullptr);
+
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    // Only sessions of verified handshakes are shared
+    configuration.setCaCertificates(caCertificates);
+    if (shareSessions) {
+        configuration.setSessionCache(&clientCache);
+        QVERIFY(handshakeOnce(configuration, server.serverPort(), &clientCache));
+        QCOMPARE(clientCache.size(), 1);
+    }
+
+    QBENCHMARK {
+        QVERIFY(handshakeOnce(configuration, server.serverPort()));
+    }
+
+    if (shareSessions)
+        QVERIFY(clientCache.hitCount() > 0);
+}
+
+QTEST_MAIN(tst_QSslSessionCache)
+#include "tst_qsslsessioncache.moc"
@@ -52,6 +52,14 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkInsertPrepared_data() { generic_data(); }
+    void benchmarkInsertPrepared();
+    void benchmarkInsertBatch_data() { generic_data(); }
+    void benchmarkInsertBatch();
+    void benchmarkSelectValues_data() { generic_data(); }
+    void benchmarkSelectValues();
+    void benchmarkSelectColumns_data() { generic_data(); }
+    void benchmarkSelectColumns();
 
 private:
     // returns all database connections
@@ -59,6 +67,7 @@ private:
     void dropTestTables( QSqlDatabase db );
     void createTestTables( QSqlDatabase db );
     void populateTestTables( QSqlDatabase db );
+    void createSelectTable(QSqlDatabase db, const QString &tableName);
 
     tst_Databases dbs;
 };
@@ -299,4 +308,164 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+static const int bulkInsertRows = 10000;
+
+void tst_QSqlQuery::benchmarkInsertPrepared()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(45), value DOUBLE PRECISION)"));
+
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    QBENCHMARK {
+        // Same transaction semantics as execBatch() on SQLite and PostgreSQL.
+        QVERIFY_SQL(db, transaction());
+        for (int i = 0; i < bulkInsertRows; ++i) {
+            q.bindValue(0, i);
+            q.bindValue(1, QString::number(i));
+            q.bindValue(2, i / 3.0);
+            QVERIFY_SQL(q, exec());
+        }
+        QVERIFY_SQL(db, commit());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkInsertBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(45), value DOUBLE PRECISION)"));
+
+    QVariantList ids;
+    QVariantList names;
+    QVariantList values;
+    for (int i = 0; i < bulkInsertRows; ++i) {
+        ids << i;
+        names << QString::number(i);
+        values << i / 3.0;
+    }
+
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    QBENCHMARK {
+        q.addBindValue(ids);
+        q.addBindValue(names);
+        q.addBindValue(values);
+        QVERIFY_SQL(q, execBatch());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+static const int bulkSelectRows = 100000;
+
+void tst_QSqlQuery::createSelectTable(QSqlDatabase db, const QString &tableName)
+{
+    QSqlQuery q(db);
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(45), value DOUBLE PRECISION)"));
+
+    QVariantList ids;
+    QVariantList names;
+    QVariantList values;
+    for (int i = 0; i < bulkSelectRows; ++i) {
+        ids << i;
+        names << QString::number(i);
+        values << i / 3.0;
+    }
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    q.addBindValue(values);
+    QVERIFY_SQL(q, execBatch());
+}
+
+void tst_QSqlQuery::benchmarkSelectValues()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+    createSelectTable(db, tableName);
+    if (QTest::currentTestFailed())
+        return;
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, prepare("SELECT id, name, value FROM " + tableName));
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec());
+        qint64 ids = 0;
+        int nameLength = 0;
+        double sum = 0;
+        while (q.next()) {
+            ids += q.value(0).toLongLong();
+            nameLength += q.value(1).toString().size();
+            sum += q.value(2).toDouble();
+        }
+        QCOMPARE(ids, qint64(bulkSelectRows) * (bulkSelectRows - 1) / 2);
+        QVERIFY(nameLength > 0 && sum > 0);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkSelectColumns()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+    createSelectTable(db, tableName);
+    if (QTest::currentTestFailed())
+        return;
+
+    QVector<QSqlColumnBuffer> columns;
+    columns << QSqlColumnBuffer(QSqlColumnBuffer::Int64)
+            << QSqlColumnBuffer(QSqlColumnBuffer::String)
+            << QSqlColumnBuffer(QSqlColumnBuffer::Double);
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, prepare("SELECT id, name, value FROM " + tableName));
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec());
+        qint64 ids = 0;
+        int nameLength = 0;
+        double sum = 0;
+        while (int rows = q.fetchColumns(columns, 1024)) {
+            const qint64 *idData = columns.at(0).int64Data();
+            const QString *nameData = columns.at(1).stringData();
+            const double *valueData = columns.at(2).doubleData();
+            for (int i = 0; i < rows; ++i) {
+                ids += idData[i];
+                nameLength += nameData[i].size();
+                sum += valueData[i];
+            }
+        }
+        QCOMPARE(ids, qint64(bulkSelectRows) * (bulkSelectRows - 1) / 2);
+        QVERIFY(nameLength > 0 && sum > 0);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"